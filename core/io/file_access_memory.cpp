@@ -75,6 +75,7 @@ Error FileAccessMemory::open_custom(const uint8_t *p_data, uint64_t p_len) {
 	data = (uint8_t *)p_data;
 	length = p_len;
 	pos = 0;
+	read_only = true;
 	return OK;
 }
 
@@ -90,6 +91,7 @@ Error FileAccessMemory::open_internal(const String &p_path, int p_mode_flags) {
 	data = E->value.ptrw();
 	length = E->value.size();
 	pos = 0;
+	read_only = p_mode_flags == READ;
 
 	return OK;
 }
@@ -37,6 +37,7 @@ class FileAccessMemory : public FileAccess {
 	uint8_t *data = nullptr;
 	uint64_t length = 0;
 	mutable uint64_t pos = 0;
+	bool read_only = false;
 
 	static Ref<FileAccess> create();
 
@@ -58,6 +59,7 @@ public:
 	virtual uint8_t get_8() const override; ///< get a byte
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override; ///< get an array of bytes
+	virtual const uint8_t *get_mapped_buffer() const override { return read_only ? data : nullptr; }
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -136,6 +136,15 @@ public:
 };
 
 class PackedSourcePCK : public PackSource {
+	// Packs that could be memory-mapped. Their unencrypted files are read
+	// straight from the mapping instead of through a separate file handle.
+	struct MappedPack {
+		Ref<FileAccess> file;
+		uint64_t size = 0;
+	};
+
+	HashMap<String, MappedPack> mapped_packs;
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
@@ -149,6 +158,9 @@ class FileAccessPack : public FileAccess {
 	uint64_t off;
 
 	Ref<FileAccess> f;
+	// The mapped pack file is referenced so the mapping outlives a replaced or closed pack.
+	Ref<FileAccess> mapped_pack;
+	const uint8_t *mapped = nullptr;
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override;
 	virtual uint64_t _get_modified_time(const String &p_file) override { return 0; }
 	virtual BitField<FileAccess::UnixPermissionFlags> _get_unix_permissions(const String &p_file) override { return 0; }
@@ -172,6 +184,7 @@ public:
 	virtual uint8_t get_8() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() const override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -186,7 +199,7 @@ public:
 
 	virtual void close() override;
 
-	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file);
+	FileAccessPack(const String &p_path, const PackedData::PackedFile &p_file, const Ref<FileAccess> &p_mapped_pack = Ref<FileAccess>());
 };
 
 Ref<FileAccess> PackedData::try_open_path(const String &p_path) {
@@ -88,6 +88,15 @@ public:
 		tree.params_set_pairing_expansion(p_value);
 	}
 
+	// Allows update() to refit the tree and search for the pairs of changed items on worker threads,
+	// when there are enough of them. Pair and unpair callbacks are still sent from the calling thread,
+	// in the same order as when this is disabled.
+	void params_set_threaded_update(bool p_enable) {
+		BVH_LOCKED_FUNCTION
+		_threaded_update = p_enable;
+		tree._threaded_refit = p_enable;
+	}
+
 	void set_pair_callback(PairCallback p_callback, void *p_userdata) {
 		BVH_LOCKED_FUNCTION
 		pair_callback = p_callback;
@@ -444,26 +453,44 @@ private:
 		params.result_array = nullptr;
 		params.subindex_array = nullptr;
 
-		for (const BVHHandle &h : changed_items) {
+		// The culls only read the tree, which the callbacks below don't change,
+		// so they can all be done up front on worker threads.
+		// The callbacks are then sent in the same order as in the serial path.
+		bool threaded = _threaded_update && changed_items.size() >= THREADED_PAIRING_MIN_ITEMS;
+		if (threaded) {
+			if (_changed_item_hits.size() < changed_items.size()) {
+				_changed_item_hits.resize(changed_items.size());
+			}
+			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &BVH_Manager::_cull_changed_item, nullptr, changed_items.size(), -1, true, SNAME("BVHPairing"));
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+		}
+
+		for (uint32_t i = 0; i < changed_items.size(); i++) {
+			const BVHHandle h = changed_items[i];
+
 			// use the expanded aabb for pairing
 			const BOUNDS &expanded_aabb = tree._pairs[h.id()].expanded_aabb;
 			BVHABB_CLASS abb;
 			abb.from(expanded_aabb);
 
-			tree.item_fill_cullparams(h, params);
-
 			// find all the existing paired aabbs that are no longer
 			// paired, and send callbacks
 			_find_leavers(h, abb, p_full_check);
 
 			uint32_t changed_item_ref_id = h.id();
 
-			params.abb = abb;
+			const LocalVector<uint32_t, uint32_t, true> *hits = &tree._cull_hits;
+			if (threaded) {
+				hits = &_changed_item_hits[i];
+			} else {
+				tree.item_fill_cullparams(h, params);
+				params.abb = abb;
 
-			params.result_count_overall = 0; // might not be needed
-			tree.cull_aabb(params, false);
+				params.result_count_overall = 0; // might not be needed
+				tree.cull_aabb(params, false);
+			}
 
-			for (const uint32_t ref_id : tree._cull_hits) {
+			for (const uint32_t ref_id : *hits) {
 				// don't collide against ourself
 				if (ref_id == changed_item_ref_id) {
 					continue;
@@ -480,6 +507,22 @@ private:
 		_reset();
 	}
 
+	void _cull_changed_item(uint32_t p_index, void *p_userdata) {
+		const BVHHandle &h = changed_items[p_index];
+
+		typename BVHTREE_CLASS::CullParams params;
+		params.result_count_overall = 0;
+		params.result_max = INT_MAX;
+		params.result_array = nullptr;
+		params.subindex_array = nullptr;
+		params.hits = &_changed_item_hits[p_index];
+
+		tree.item_fill_cullparams(h, params);
+		params.abb.from(tree._pairs[h.id()].expanded_aabb);
+
+		tree.cull_aabb(params, false);
+	}
+
 public:
 	void item_get_AABB(BVHHandle p_handle, BOUNDS &r_aabb) {
 		DEV_ASSERT(!p_handle.is_invalid());
@@ -773,6 +816,11 @@ private:
 	LocalVector<BVHHandle, uint32_t, true> changed_items;
 	uint32_t _tick = 1; // Start from 1 so items with 0 indicate never updated.
 
+	// when threaded, the cull hits of each changed item, kept between ticks to reuse the memory
+	static const uint32_t THREADED_PAIRING_MIN_ITEMS = 256;
+	bool _threaded_update = false;
+	LocalVector<LocalVector<uint32_t, uint32_t, true>> _changed_item_hits;
+
 	class BVHLockedFunction {
 	public:
 		BVHLockedFunction(Mutex *p_mutex, bool p_thread_safe) {
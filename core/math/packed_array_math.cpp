@@ -0,0 +1,357 @@
+/**************************************************************************/
+/*  packed_array_math.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "packed_array_math.h"
+
+#include "core/math/simd.h"
+
+void PackedArrayMath::add(const float *p_a, const float *p_b, float *r_result, int64_t p_count) {
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_result + i, _mm_add_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+	}
+#elif defined(SIMD_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_result + i, vaddq_f32(vld1q_f32(p_a + i), vld1q_f32(p_b + i)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_result[i] = p_a[i] + p_b[i];
+	}
+}
+
+void PackedArrayMath::multiply(const float *p_a, const float *p_b, float *r_result, int64_t p_count) {
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	for (; i + 4 <= p_count; i += 4) {
+		_mm_storeu_ps(r_result + i, _mm_mul_ps(_mm_loadu_ps(p_a + i), _mm_loadu_ps(p_b + i)));
+	}
+#elif defined(SIMD_NEON)
+	for (; i + 4 <= p_count; i += 4) {
+		vst1q_f32(r_result + i, vmulq_f32(vld1q_f32(p_a + i), vld1q_f32(p_b + i)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_result[i] = p_a[i] * p_b[i];
+	}
+}
+
+void PackedArrayMath::lerp(const float *p_from, const float *p_to, float p_weight, float *r_result, int64_t p_count) {
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	const __m128 weight = _mm_set1_ps(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 from = _mm_loadu_ps(p_from + i);
+		const __m128 to = _mm_loadu_ps(p_to + i);
+		_mm_storeu_ps(r_result + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), weight)));
+	}
+#elif defined(SIMD_NEON)
+	const float32x4_t weight = vdupq_n_f32(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t from = vld1q_f32(p_from + i);
+		const float32x4_t to = vld1q_f32(p_to + i);
+		vst1q_f32(r_result + i, vaddq_f32(from, vmulq_f32(vsubq_f32(to, from), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_result[i] = Math::lerp(p_from[i], p_to[i], p_weight);
+	}
+}
+
+double PackedArrayMath::sum(const float *p_src, int64_t p_count) {
+	// Element i is added to lane i % 4.
+	double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	__m128d acc_low = _mm_setzero_pd();
+	__m128d acc_high = _mm_setzero_pd();
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 v = _mm_loadu_ps(p_src + i);
+		acc_low = _mm_add_pd(acc_low, _mm_cvtps_pd(v));
+		acc_high = _mm_add_pd(acc_high, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+	_mm_storeu_pd(lanes, acc_low);
+	_mm_storeu_pd(lanes + 2, acc_high);
+#elif defined(SIMD_NEON)
+	float64x2_t acc_low = vdupq_n_f64(0.0);
+	float64x2_t acc_high = vdupq_n_f64(0.0);
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t v = vld1q_f32(p_src + i);
+		acc_low = vaddq_f64(acc_low, vcvt_f64_f32(vget_low_f32(v)));
+		acc_high = vaddq_f64(acc_high, vcvt_high_f64_f32(v));
+	}
+	vst1q_f64(lanes, acc_low);
+	vst1q_f64(lanes + 2, acc_high);
+#endif
+	for (; i < p_count; i++) {
+		lanes[i & 3] += (double)p_src[i];
+	}
+	return (lanes[0] + lanes[2]) + (lanes[1] + lanes[3]);
+}
+
+double PackedArrayMath::dot(const float *p_a, const float *p_b, int64_t p_count) {
+	// Same lanes as sum(). Products of two floats are exact in double precision.
+	double lanes[4] = { 0.0, 0.0, 0.0, 0.0 };
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	__m128d acc_low = _mm_setzero_pd();
+	__m128d acc_high = _mm_setzero_pd();
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 a = _mm_loadu_ps(p_a + i);
+		const __m128 b = _mm_loadu_ps(p_b + i);
+		acc_low = _mm_add_pd(acc_low, _mm_mul_pd(_mm_cvtps_pd(a), _mm_cvtps_pd(b)));
+		acc_high = _mm_add_pd(acc_high, _mm_mul_pd(_mm_cvtps_pd(_mm_movehl_ps(a, a)), _mm_cvtps_pd(_mm_movehl_ps(b, b))));
+	}
+	_mm_storeu_pd(lanes, acc_low);
+	_mm_storeu_pd(lanes + 2, acc_high);
+#elif defined(SIMD_NEON)
+	float64x2_t acc_low = vdupq_n_f64(0.0);
+	float64x2_t acc_high = vdupq_n_f64(0.0);
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t a = vld1q_f32(p_a + i);
+		const float32x4_t b = vld1q_f32(p_b + i);
+		acc_low = vaddq_f64(acc_low, vmulq_f64(vcvt_f64_f32(vget_low_f32(a)), vcvt_f64_f32(vget_low_f32(b))));
+		acc_high = vaddq_f64(acc_high, vmulq_f64(vcvt_high_f64_f32(a), vcvt_high_f64_f32(b)));
+	}
+	vst1q_f64(lanes, acc_low);
+	vst1q_f64(lanes + 2, acc_high);
+#endif
+	for (; i < p_count; i++) {
+		lanes[i & 3] += (double)p_a[i] * (double)p_b[i];
+	}
+	return (lanes[0] + lanes[2]) + (lanes[1] + lanes[3]);
+}
+
+float PackedArrayMath::min(const float *p_src, int64_t p_count) {
+	// `v < m ? v : m` is what _mm_min_ps() computes, NaN elements fail the comparison.
+	float result = p_src[0];
+	int64_t i = 0;
+#if defined(SIMD_SSE2) || defined(SIMD_NEON)
+	if (p_count >= 4) {
+		float lanes[4];
+#if defined(SIMD_SSE2)
+		__m128 m = _mm_set1_ps(result);
+		for (; i + 4 <= p_count; i += 4) {
+			m = _mm_min_ps(_mm_loadu_ps(p_src + i), m);
+		}
+		_mm_storeu_ps(lanes, m);
+#else
+		float32x4_t m = vdupq_n_f32(result);
+		for (; i + 4 <= p_count; i += 4) {
+			const float32x4_t v = vld1q_f32(p_src + i);
+			// vminq_f32() propagates NaN, select instead.
+			m = vbslq_f32(vcltq_f32(v, m), v, m);
+		}
+		vst1q_f32(lanes, m);
+#endif
+		for (int j = 0; j < 4; j++) {
+			result = lanes[j] < result ? lanes[j] : result;
+		}
+	}
+#endif
+	for (; i < p_count; i++) {
+		result = p_src[i] < result ? p_src[i] : result;
+	}
+	return result;
+}
+
+float PackedArrayMath::max(const float *p_src, int64_t p_count) {
+	float result = p_src[0];
+	int64_t i = 0;
+#if defined(SIMD_SSE2) || defined(SIMD_NEON)
+	if (p_count >= 4) {
+		float lanes[4];
+#if defined(SIMD_SSE2)
+		__m128 m = _mm_set1_ps(result);
+		for (; i + 4 <= p_count; i += 4) {
+			m = _mm_max_ps(_mm_loadu_ps(p_src + i), m);
+		}
+		_mm_storeu_ps(lanes, m);
+#else
+		float32x4_t m = vdupq_n_f32(result);
+		for (; i + 4 <= p_count; i += 4) {
+			const float32x4_t v = vld1q_f32(p_src + i);
+			m = vbslq_f32(vcgtq_f32(v, m), v, m);
+		}
+		vst1q_f32(lanes, m);
+#endif
+		for (int j = 0; j < 4; j++) {
+			result = lanes[j] > result ? lanes[j] : result;
+		}
+	}
+#endif
+	for (; i < p_count; i++) {
+		result = p_src[i] > result ? p_src[i] : result;
+	}
+	return result;
+}
+
+#ifndef REAL_T_IS_DOUBLE
+static_assert(sizeof(Vector3) == 3 * sizeof(float), "Vector3 must be three packed floats to be processed as a float array.");
+#endif
+
+void PackedArrayMath::dequantize_lerp(const uint16_t *p_from, const uint16_t *p_to, const float *p_weight, const float *p_position, const float *p_size, float *r_result, int64_t p_count) {
+	int64_t i = 0;
+#if defined(SIMD_SSE2)
+	const __m128 max = _mm_set1_ps(65535.0f);
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 weight = _mm_loadu_ps(p_weight + i);
+		const __m128 position = _mm_loadu_ps(p_position + i);
+		const __m128 size = _mm_loadu_ps(p_size + i);
+		// Zero extend four uint16_t values to int32_t before converting them.
+		const __m128i from_value = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(p_from + i)), zero);
+		const __m128i to_value = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)(p_to + i)), zero);
+		const __m128 from = _mm_add_ps(position, _mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(from_value), max), size));
+		const __m128 to = _mm_add_ps(position, _mm_mul_ps(_mm_div_ps(_mm_cvtepi32_ps(to_value), max), size));
+		_mm_storeu_ps(r_result + i, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), weight)));
+	}
+#elif defined(SIMD_NEON)
+	const float32x4_t max = vdupq_n_f32(65535.0f);
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t weight = vld1q_f32(p_weight + i);
+		const float32x4_t position = vld1q_f32(p_position + i);
+		const float32x4_t size = vld1q_f32(p_size + i);
+		const float32x4_t from_value = vcvtq_f32_u32(vmovl_u16(vld1_u16(p_from + i)));
+		const float32x4_t to_value = vcvtq_f32_u32(vmovl_u16(vld1_u16(p_to + i)));
+		const float32x4_t from = vaddq_f32(position, vmulq_f32(vdivq_f32(from_value, max), size));
+		const float32x4_t to = vaddq_f32(position, vmulq_f32(vdivq_f32(to_value, max), size));
+		vst1q_f32(r_result + i, vaddq_f32(from, vmulq_f32(vsubq_f32(to, from), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		const float from = p_position[i] + (float(p_from[i]) / 65535.0f) * p_size[i];
+		const float to = p_position[i] + (float(p_to[i]) / 65535.0f) * p_size[i];
+		r_result[i] = from + (to - from) * p_weight[i];
+	}
+}
+
+void PackedArrayMath::add(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_result, int64_t p_count) {
+#ifndef REAL_T_IS_DOUBLE
+	add((const float *)p_a, (const float *)p_b, (float *)r_result, p_count * 3);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_result[i] = p_a[i] + p_b[i];
+	}
+#endif
+}
+
+void PackedArrayMath::multiply(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_result, int64_t p_count) {
+#ifndef REAL_T_IS_DOUBLE
+	multiply((const float *)p_a, (const float *)p_b, (float *)r_result, p_count * 3);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_result[i] = p_a[i] * p_b[i];
+	}
+#endif
+}
+
+void PackedArrayMath::lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_result, int64_t p_count) {
+#ifndef REAL_T_IS_DOUBLE
+	lerp((const float *)p_from, (const float *)p_to, p_weight, (float *)r_result, p_count * 3);
+#else
+	for (int64_t i = 0; i < p_count; i++) {
+		r_result[i] = p_from[i].lerp(p_to[i], p_weight);
+	}
+#endif
+}
+
+void PackedArrayMath::xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_result, int64_t p_count) {
+	int64_t i = 0;
+#if !defined(REAL_T_IS_DOUBLE) && (defined(SIMD_SSE2) || defined(SIMD_NEON))
+	const Basis &basis = p_transform.basis;
+	const Vector3 &origin = p_transform.origin;
+	const float *src = (const float *)p_src;
+	float *dst = (float *)r_result;
+#if defined(SIMD_SSE2)
+	__m128 rows[3][3];
+	__m128 offset[3];
+	for (int j = 0; j < 3; j++) {
+		for (int k = 0; k < 3; k++) {
+			rows[j][k] = _mm_set1_ps(basis.rows[j][k]);
+		}
+		offset[j] = _mm_set1_ps(origin[j]);
+	}
+	for (; i + 4 <= p_count; i += 4) {
+		// Four points as x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3, deinterleaved into x, y and z.
+		const __m128 a = _mm_loadu_ps(src + i * 3);
+		const __m128 b = _mm_loadu_ps(src + i * 3 + 4);
+		const __m128 c = _mm_loadu_ps(src + i * 3 + 8);
+		__m128 v[3];
+		v[0] = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+		v[1] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+		v[2] = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0));
+
+		// basis[j].dot(v) + origin[j], as in Transform3D::xform().
+		__m128 r[3];
+		for (int j = 0; j < 3; j++) {
+			r[j] = _mm_add_ps(_mm_mul_ps(rows[j][0], v[0]), _mm_mul_ps(rows[j][1], v[1]));
+			r[j] = _mm_add_ps(_mm_add_ps(r[j], _mm_mul_ps(rows[j][2], v[2])), offset[j]);
+		}
+
+		_mm_storeu_ps(dst + i * 3, _mm_shuffle_ps(_mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(0, 0, 0, 0)), _mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + i * 3 + 4, _mm_shuffle_ps(_mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(1, 1, 1, 1)), _mm_shuffle_ps(r[0], r[1], _MM_SHUFFLE(2, 2, 2, 2)), _MM_SHUFFLE(2, 0, 2, 0)));
+		_mm_storeu_ps(dst + i * 3 + 8, _mm_shuffle_ps(_mm_shuffle_ps(r[2], r[0], _MM_SHUFFLE(3, 3, 2, 2)), _mm_shuffle_ps(r[1], r[2], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+	}
+#else
+	float32x4_t rows[3][3];
+	float32x4_t offset[3];
+	for (int j = 0; j < 3; j++) {
+		for (int k = 0; k < 3; k++) {
+			rows[j][k] = vdupq_n_f32(basis.rows[j][k]);
+		}
+		offset[j] = vdupq_n_f32(origin[j]);
+	}
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4x3_t v = vld3q_f32(src + i * 3);
+		float32x4x3_t r;
+		for (int j = 0; j < 3; j++) {
+			r.val[j] = vaddq_f32(vmulq_f32(rows[j][0], v.val[0]), vmulq_f32(rows[j][1], v.val[1]));
+			r.val[j] = vaddq_f32(vaddq_f32(r.val[j], vmulq_f32(rows[j][2], v.val[2])), offset[j]);
+		}
+		vst3q_f32(dst + i * 3, r);
+	}
+#endif
+#endif
+	for (; i < p_count; i++) {
+		r_result[i] = p_transform.xform(p_src[i]);
+	}
+}
+
+const char *PackedArrayMath::get_simd_name() {
+#if defined(SIMD_SSE2)
+	return "SSE2";
+#elif defined(SIMD_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,65 @@
+/**************************************************************************/
+/*  packed_array_math.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef PACKED_ARRAY_MATH_H
+#define PACKED_ARRAY_MATH_H
+
+#include "core/math/transform_3d.h"
+
+// Bulk kernels behind the math methods of PackedFloat32Array and PackedVector3Array.
+// Vectorized with SSE2 or NEON where the target supports it (Vector3 kernels only when real_t is single precision), scalar otherwise.
+// Result arrays may alias the inputs.
+class PackedArrayMath {
+public:
+	static void add(const float *p_a, const float *p_b, float *r_result, int64_t p_count);
+	static void multiply(const float *p_a, const float *p_b, float *r_result, int64_t p_count);
+	// Same result as Math::lerp() for each element.
+	static void lerp(const float *p_from, const float *p_to, float p_weight, float *r_result, int64_t p_count);
+	// Sums are accumulated in double precision over four interleaved lanes, so they don't depend on the SIMD path.
+	static double sum(const float *p_src, int64_t p_count);
+	static double dot(const float *p_a, const float *p_b, int64_t p_count);
+	// NaN elements are skipped unless the first element is NaN. p_count must be greater than zero.
+	static float min(const float *p_src, int64_t p_count);
+	static float max(const float *p_src, int64_t p_count);
+	// Dequantizes 16-bit values as p_position + value / 65535 * p_size, then interpolates from p_from to p_to by p_weight.
+	// Used to decode compressed animation tracks.
+	static void dequantize_lerp(const uint16_t *p_from, const uint16_t *p_to, const float *p_weight, const float *p_position, const float *p_size, float *r_result, int64_t p_count);
+
+	static void add(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_result, int64_t p_count);
+	static void multiply(const Vector3 *p_a, const Vector3 *p_b, Vector3 *r_result, int64_t p_count);
+	// Same result as Vector3::lerp() for each element.
+	static void lerp(const Vector3 *p_from, const Vector3 *p_to, real_t p_weight, Vector3 *r_result, int64_t p_count);
+	// Same result as Transform3D::xform() for each element.
+	static void xform(const Transform3D &p_transform, const Vector3 *p_src, Vector3 *r_result, int64_t p_count);
+
+	static const char *get_simd_name();
+};
+
+#endif // PACKED_ARRAY_MATH_H
@@ -31,6 +31,7 @@
 #include "transform_3d.h"
 
 #include "core/math/math_funcs.h"
+#include "core/math/packed_array_math.h"
 #include "core/string/ustring.h"
 
 void Transform3D::affine_invert() {
@@ -170,6 +171,13 @@ Transform3D Transform3D::orthogonalized() const {
 	return _copy;
 }
 
+Vector<Vector3> Transform3D::xform(const Vector<Vector3> &p_array) const {
+	Vector<Vector3> array;
+	array.resize(p_array.size());
+	PackedArrayMath::xform(*this, p_array.ptr(), array.ptrw(), p_array.size());
+	return array;
+}
+
 bool Transform3D::is_equal_approx(const Transform3D &p_transform) const {
 	return basis.is_equal_approx(p_transform.basis) && origin.is_equal_approx(p_transform.origin);
 }
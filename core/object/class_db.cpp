@@ -313,6 +313,15 @@ ClassDB::APIType ClassDB::get_api_type(const StringName &p_class) {
 	return ti->api;
 }
 
+bool ClassDB::class_overrides_callp(const StringName &p_class) {
+	OBJTYPE_RLOCK;
+
+	ClassInfo *ti = classes.getptr(p_class);
+
+	ERR_FAIL_NULL_V_MSG(ti, false, "Cannot get class '" + String(p_class) + "'.");
+	return ti->overrides_callp;
+}
+
 uint32_t ClassDB::get_api_hash(APIType p_api) {
 #ifdef DEBUG_METHODS_ENABLED
 	OBJTYPE_WLOCK;
@@ -680,7 +689,7 @@ bool ClassDB::is_virtual(const StringName &p_class) {
 	return (!ti->disabled && ti->creation_func != nullptr && !(ti->gdextension && !ti->gdextension->create_instance) && ti->is_virtual);
 }
 
-void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits) {
+void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherits, bool p_overrides_callp) {
 	OBJTYPE_WLOCK;
 
 	const StringName &name = p_class;
@@ -692,6 +701,7 @@ void ClassDB::_add_class2(const StringName &p_class, const StringName &p_inherit
 	ti.name = name;
 	ti.inherits = p_inherits;
 	ti.api = current_api;
+	ti.overrides_callp = p_overrides_callp;
 
 	if (ti.inherits) {
 		ERR_FAIL_COND(!classes.has(ti.inherits)); //it MUST be registered.
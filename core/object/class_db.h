@@ -100,6 +100,7 @@ public:
 	struct ClassInfo {
 		APIType api = API_NONE;
 		ClassInfo *inherits_ptr = nullptr;
+		bool overrides_callp = false; // The class or one of its bases overrides Object::callp().
 		void *class_ptr = nullptr;
 
 		ObjectGDExtension *gdextension = nullptr;
@@ -163,7 +164,7 @@ public:
 	static APIType current_api;
 	static HashMap<APIType, uint32_t> api_hashes_cache;
 
-	static void _add_class2(const StringName &p_class, const StringName &p_inherits);
+	static void _add_class2(const StringName &p_class, const StringName &p_inherits, bool p_overrides_callp);
 
 	static HashMap<StringName, HashMap<StringName, Variant>> default_values;
 	static HashSet<StringName> default_values_cached;
@@ -189,7 +190,9 @@ public:
 	// DO NOT USE THIS!!!!!! NEEDS TO BE PUBLIC BUT DO NOT USE NO MATTER WHAT!!!
 	template <class T>
 	static void _add_class() {
-		_add_class2(T::get_class_static(), T::get_parent_class_static());
+		// A member function pointer has the type of the class declaring the function,
+		// so this only holds when neither T nor any of its bases overrides callp().
+		_add_class2(T::get_class_static(), T::get_parent_class_static(), !types_are_same_v<decltype(&T::callp), decltype(&Object::callp)>);
 	}
 
 	template <class T>
@@ -293,6 +296,7 @@ public:
 	static void set_object_extension_instance(Object *p_object, const StringName &p_class, GDExtensionClassInstancePtr p_instance);
 
 	static APIType get_api_type(const StringName &p_class);
+	static bool class_overrides_callp(const StringName &p_class);
 
 	static uint32_t get_api_hash(APIType p_api);
 
@@ -34,6 +34,7 @@
 #include "core/core_string_names.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/thread.h"
 
 #include <stdio.h>
 
@@ -60,12 +61,198 @@
 	}
 
 void CallQueue::_add_page() {
-	if (pages_used == page_bytes.size()) {
+	if (pages_used.get() == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
 		page_bytes.push_back(0);
 	}
-	page_bytes[pages_used] = 0;
-	pages_used++;
+	page_bytes[pages_used.get()] = 0;
+	pages_used.increment();
+}
+
+thread_local CallQueue::ThreadLanes CallQueue::thread_lanes;
+SafeNumeric<uint64_t> CallQueue::last_queue_id;
+
+CallQueue::ThreadLanes::~ThreadLanes() {
+	for (Lane *lane : lanes) {
+		if (lane->refcount.unref()) {
+			_free_lane(lane);
+		}
+	}
+}
+
+bool CallQueue::_is_lane_thread() const {
+	return this != MessageQueue::thread_singleton && !Thread::is_main_thread();
+}
+
+CallQueue::Lane *CallQueue::_get_thread_lane() {
+	for (uint32_t i = 0; i < thread_lanes.lanes.size(); i++) {
+		Lane *lane = thread_lanes.lanes[i];
+		if (lane->queue_id == queue_id) {
+			return lane;
+		}
+		if (lane->refcount.get() == 1) {
+			// The queue it belonged to is gone.
+			thread_lanes.lanes.remove_at_unordered(i);
+			_free_lane(lane);
+			i--;
+		}
+	}
+
+	Lane *lane = memnew(Lane);
+	lane->queue_id = queue_id;
+	lane->refcount.init(2);
+	lane->head = memnew(LanePage);
+	lane->tail = lane->head;
+	lane_pages_used.increment();
+	thread_lanes.lanes.push_back(lane);
+
+	MutexLock lock(mutex);
+	lanes.push_back(lane);
+	return lane;
+}
+
+uint8_t *CallQueue::_lane_reserve(Lane *p_lane, uint32_t p_room) {
+	LanePage *page = p_lane->tail;
+	uint32_t bytes = page->bytes.get();
+	if (bytes + p_room > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() + lane_pages_used.get() >= max_pages) {
+			return nullptr;
+		}
+		lane_pages_used.increment();
+		LanePage *new_page = memnew(LanePage);
+		page->next.store(new_page, std::memory_order_release);
+		p_lane->tail = new_page;
+		return new_page->data;
+	}
+	return &page->data[bytes];
+}
+
+void CallQueue::_lane_publish(Lane *p_lane, uint32_t p_room) {
+	LanePage *page = p_lane->tail;
+	page->bytes.set(page->bytes.get() + p_room);
+	p_lane->pushed.increment();
+}
+
+void CallQueue::_consume_lane(Lane *p_lane, bool p_dispatch) {
+	// Only what was pushed so far, so a busy producer can't keep the consumer here.
+	const uint64_t target = p_lane->pushed.get();
+	while (p_lane->consumed.get() < target) {
+		LanePage *page = p_lane->head;
+		if (p_lane->head_offset == page->bytes.get()) {
+			// The remaining messages are on the following pages, which are linked by now.
+			p_lane->head = page->next.load(std::memory_order_acquire);
+			p_lane->head_offset = 0;
+			memdelete(page);
+			lane_pages_used.decrement();
+			continue;
+		}
+
+		Message *message = (Message *)&page->data[p_lane->head_offset];
+		p_lane->head_offset += _get_message_size(message);
+		p_lane->consumed.increment();
+
+		if (p_dispatch) {
+			_dispatch_message(message);
+		} else {
+			_destroy_message(message);
+		}
+	}
+}
+
+void CallQueue::_free_lane(Lane *p_lane) {
+	LanePage *page = p_lane->head;
+	while (page) {
+		LanePage *next = page->next.load(std::memory_order_acquire);
+		memdelete(page);
+		page = next;
+	}
+	memdelete(p_lane);
+}
+
+void CallQueue::_write_call(uint8_t *p_buffer, const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	Message *msg = memnew_placement(p_buffer, Message);
+	msg->args = p_argcount;
+	msg->callable = p_callable;
+	msg->type = TYPE_CALL;
+	if (p_show_error) {
+		msg->type |= FLAG_SHOW_ERROR;
+	}
+	// Support callables of static methods.
+	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
+		msg->type |= FLAG_NULL_IS_OK;
+	}
+
+	uint8_t *buffer_end = p_buffer + sizeof(Message);
+
+	for (int i = 0; i < p_argcount; i++) {
+		Variant *v = memnew_placement(buffer_end, Variant);
+		buffer_end += sizeof(Variant);
+		*v = *p_args[i];
+	}
+}
+
+void CallQueue::_write_set(uint8_t *p_buffer, ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	Message *msg = memnew_placement(p_buffer, Message);
+	msg->args = 1;
+	msg->callable = Callable(p_id, p_prop);
+	msg->type = TYPE_SET;
+
+	Variant *v = memnew_placement(p_buffer + sizeof(Message), Variant);
+	*v = p_value;
+}
+
+void CallQueue::_write_notification(uint8_t *p_buffer, ObjectID p_id, int p_notification) {
+	Message *msg = memnew_placement(p_buffer, Message);
+
+	msg->type = TYPE_NOTIFICATION;
+	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
+	//msg->target;
+	msg->notification = p_notification;
+}
+
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	uint32_t size = sizeof(Message);
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		size += sizeof(Variant) * p_message->args;
+	}
+	return size;
+}
+
+void CallQueue::_destroy_message(Message *p_message) {
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+void CallQueue::_dispatch_message(Message *p_message) {
+	Object *target = p_message->callable.get_object();
+
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_CALL: {
+			if (target || (p_message->type & FLAG_NULL_IS_OK)) {
+				Variant *args = (Variant *)(p_message + 1);
+				_call_function(p_message->callable, args, p_message->args, p_message->type & FLAG_SHOW_ERROR);
+			}
+		} break;
+		case TYPE_NOTIFICATION: {
+			if (target) {
+				target->notification(p_message->notification);
+			}
+		} break;
+		case TYPE_SET: {
+			if (target) {
+				Variant *arg = (Variant *)(p_message + 1);
+				target->set(p_message->callable.get_method(), *arg);
+			}
+		} break;
+	}
+
+	_destroy_message(p_message);
 }
 
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
@@ -89,12 +276,24 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
 
+	if (_is_lane_thread()) {
+		Lane *lane = _get_thread_lane();
+		uint8_t *buffer = _lane_reserve(lane, room_needed);
+		if (!buffer) {
+			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		_write_call(buffer, p_callable, p_args, p_argcount, p_show_error);
+		_lane_publish(lane, room_needed);
+		return OK;
+	}
+
 	LOCK_MUTEX;
 
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() == max_pages) {
 			fprintf(stderr, "Failed method: %s. Message queue out of memory. %s\n", String(p_callable).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -103,31 +302,10 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
+	Page *page = pages[pages_used.get() - 1];
+	_write_call(&page->data[page_bytes[pages_used.get() - 1]], p_callable, p_args, p_argcount, p_show_error);
 
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
-	msg->args = p_argcount;
-	msg->callable = p_callable;
-	msg->type = TYPE_CALL;
-	if (p_show_error) {
-		msg->type |= FLAG_SHOW_ERROR;
-	}
-	// Support callables of static methods.
-	if (p_callable.get_object_id().is_null() && p_callable.is_valid()) {
-		msg->type |= FLAG_NULL_IS_OK;
-	}
-
-	buffer_end += sizeof(Message);
-
-	for (int i = 0; i < p_argcount; i++) {
-		Variant *v = memnew_placement(buffer_end, Variant);
-		buffer_end += sizeof(Variant);
-		*v = *p_args[i];
-	}
-
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[pages_used.get() - 1] += room_needed;
 
 	UNLOCK_MUTEX;
 
@@ -135,13 +313,26 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
+	if (_is_lane_thread()) {
+		Lane *lane = _get_thread_lane();
+		uint8_t *buffer = _lane_reserve(lane, room_needed);
+		if (!buffer) {
+			fprintf(stderr, "Failed set: %s target ID: %s. Message queue out of memory. %s\n", String(p_prop).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		_write_set(buffer, p_id, p_prop, p_value);
+		_lane_publish(lane, room_needed);
+		return OK;
+	}
+
+	LOCK_MUTEX;
+
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() == max_pages) {
 			String type;
 			if (ObjectDB::get_instance(p_id)) {
 				type = ObjectDB::get_instance(p_id)->get_class();
@@ -155,20 +346,10 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
-	msg->args = 1;
-	msg->callable = Callable(p_id, p_prop);
-	msg->type = TYPE_SET;
-
-	buffer_end += sizeof(Message);
-
-	Variant *v = memnew_placement(buffer_end, Variant);
-	*v = p_value;
+	Page *page = pages[pages_used.get() - 1];
+	_write_set(&page->data[page_bytes[pages_used.get() - 1]], p_id, p_prop, p_value);
 
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[pages_used.get() - 1] += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -176,13 +357,26 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
-	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
+	if (_is_lane_thread()) {
+		Lane *lane = _get_thread_lane();
+		uint8_t *buffer = _lane_reserve(lane, room_needed);
+		if (!buffer) {
+			fprintf(stderr, "Failed notification: %s target ID: %s. Message queue out of memory. %s\n", itos(p_notification).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
+			return ERR_OUT_OF_MEMORY;
+		}
+		_write_notification(buffer, p_id, p_notification);
+		_lane_publish(lane, room_needed);
+		return OK;
+	}
+
+	LOCK_MUTEX;
+
 	_ensure_first_page();
 
-	if ((page_bytes[pages_used - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
-		if (pages_used == max_pages) {
+	if ((page_bytes[pages_used.get() - 1] + room_needed) > uint32_t(PAGE_SIZE_BYTES)) {
+		if (pages_used.get() == max_pages) {
 			fprintf(stderr, "Failed notification: %s target ID: %s. Message queue out of memory. %s\n", itos(p_notification).utf8().get_data(), itos(p_id).utf8().get_data(), error_text.utf8().get_data());
 			statistics();
 			UNLOCK_MUTEX;
@@ -191,17 +385,10 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 		_add_page();
 	}
 
-	Page *page = pages[pages_used - 1];
-	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
-
-	Message *msg = memnew_placement(buffer_end, Message);
+	Page *page = pages[pages_used.get() - 1];
+	_write_notification(&page->data[page_bytes[pages_used.get() - 1]], p_id, p_notification);
 
-	msg->type = TYPE_NOTIFICATION;
-	msg->callable = Callable(p_id, CoreStringNames::get_singleton()->notification); //name is meaningless but callable needs it
-	//msg->target;
-	msg->notification = p_notification;
-
-	page_bytes[pages_used - 1] += room_needed;
+	page_bytes[pages_used.get() - 1] += room_needed;
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -242,8 +429,8 @@ Error CallQueue::_transfer_messages_to_main_queue() {
 	// Let's see if our first (likely only) page fits the current target queue page.
 	uint32_t src_page = 0;
 	{
-		if (mq->pages_used) {
-			uint32_t dst_page = mq->pages_used - 1;
+		if (mq->pages_used.get()) {
+			uint32_t dst_page = mq->pages_used.get() - 1;
 			uint32_t dst_offset = mq->page_bytes[dst_page];
 			if (dst_offset + page_bytes[0] < uint32_t(PAGE_SIZE_BYTES)) {
 				memcpy(mq->pages[dst_page]->data + dst_offset, pages[0]->data, page_bytes[0]);
@@ -255,23 +442,23 @@ Error CallQueue::_transfer_messages_to_main_queue() {
 
 	// Any other possibly existing source page needs to be added.
 
-	if (mq->pages_used + (pages_used - src_page) > mq->max_pages) {
+	if (mq->pages_used.get() + (pages_used.get() - src_page) > mq->max_pages) {
 		ERR_PRINT("Failed appending thread queue. Message queue out of memory. " + mq->error_text);
 		mq->statistics();
 		mq->mutex.unlock();
 		return ERR_OUT_OF_MEMORY;
 	}
 
-	for (; src_page < pages_used; src_page++) {
+	for (; src_page < pages_used.get(); src_page++) {
 		mq->_add_page();
-		memcpy(mq->pages[mq->pages_used - 1]->data, pages[src_page]->data, page_bytes[src_page]);
-		mq->page_bytes[mq->pages_used - 1] = page_bytes[src_page];
+		memcpy(mq->pages[mq->pages_used.get() - 1]->data, pages[src_page]->data, page_bytes[src_page]);
+		mq->page_bytes[mq->pages_used.get() - 1] = page_bytes[src_page];
 	}
 
 	mq->mutex.unlock();
 
 	page_bytes[0] = 0;
-	pages_used = 1;
+	pages_used.set(1);
 
 	return OK;
 }
@@ -284,7 +471,7 @@ Error CallQueue::flush() {
 
 	LOCK_MUTEX;
 
-	if (pages.size() == 0) {
+	if (pages.size() == 0 && lanes.is_empty()) {
 		// Never allocated
 		UNLOCK_MUTEX;
 		return OK; // Do nothing.
@@ -296,67 +483,61 @@ Error CallQueue::flush() {
 	}
 
 	flushing = true;
+	_ensure_first_page();
 
 	uint32_t i = 0;
 	uint32_t offset = 0;
+	uint32_t lane_index = 0;
 
-	while (i < pages_used && offset < page_bytes[i]) {
-		Page *page = pages[i];
+	while (true) {
+		if (offset == page_bytes[i] && i + 1 < pages_used.get()) {
+			i++;
+			offset = 0;
+		}
 
-		//lock on each iteration, so a call can re-add itself to the message queue
+		if (offset < page_bytes[i]) {
+			Page *page = pages[i];
 
-		Message *message = (Message *)&page->data[offset];
+			//lock on each iteration, so a call can re-add itself to the message queue
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
+			Message *message = (Message *)&page->data[offset];
 
-		//pre-advance so this function is reentrant
-		offset += advance;
+			//pre-advance so this function is reentrant
+			offset += _get_message_size(message);
 
-		Object *target = message->callable.get_object();
+			UNLOCK_MUTEX;
 
-		UNLOCK_MUTEX;
+			_dispatch_message(message);
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
+			LOCK_MUTEX;
+			continue;
 		}
 
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
+		if (lane_index < lanes.size()) {
+			Lane *lane = lanes[lane_index];
 
-		message->~Message();
+			UNLOCK_MUTEX;
 
-		LOCK_MUTEX;
-		if (offset == page_bytes[i]) {
-			i++;
-			offset = 0;
+			_consume_lane(lane, true);
+
+			LOCK_MUTEX;
+			if (lane->refcount.get() == 1 && lane->consumed.get() == lane->pushed.get()) {
+				// Its thread is gone and everything it pushed was handled.
+				lanes.remove_at(lane_index);
+				lane_pages_used.decrement();
+				lane->refcount.unref();
+				_free_lane(lane);
+			} else {
+				lane_index++;
+			}
+			continue;
 		}
+
+		break;
 	}
 
 	page_bytes[0] = 0;
-	pages_used = 1;
+	pages_used.set(1);
 
 	flushing = false;
 	UNLOCK_MUTEX;
@@ -366,39 +547,30 @@ Error CallQueue::flush() {
 void CallQueue::clear() {
 	LOCK_MUTEX;
 
+	if (!flushing) {
+		// While flushing, lanes are being consumed by the flushing thread.
+		for (Lane *lane : lanes) {
+			_consume_lane(lane, false);
+		}
+	}
+
 	if (pages.size() == 0) {
 		UNLOCK_MUTEX;
 		return; // Nothing to clear.
 	}
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	for (uint32_t i = 0; i < pages_used.get(); i++) {
 		uint32_t offset = 0;
 		while (offset < page_bytes[i]) {
 			Page *page = pages[i];
 
-			//lock on each iteration, so a call can re-add itself to the message queue
-
 			Message *message = (Message *)&page->data[offset];
-
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
-
-			offset += advance;
-
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				Variant *args = (Variant *)(message + 1);
-				for (int k = 0; k < message->args; k++) {
-					args[k].~Variant();
-				}
-			}
-
-			message->~Message();
+			offset += _get_message_size(message);
+			_destroy_message(message);
 		}
 	}
 
-	pages_used = 1;
+	pages_used.set(1);
 	page_bytes[0] = 0;
 
 	UNLOCK_MUTEX;
@@ -411,7 +583,7 @@ void CallQueue::statistics() {
 	HashMap<Callable, int> call_count;
 	int null_count = 0;
 
-	for (uint32_t i = 0; i < pages_used; i++) {
+	for (uint32_t i = 0; i < pages_used.get(); i++) {
 		uint32_t offset = 0;
 		while (offset < page_bytes[i]) {
 			Page *page = pages[i];
@@ -481,7 +653,8 @@ void CallQueue::statistics() {
 		}
 	}
 
-	print_line("TOTAL PAGES: " + itos(pages_used) + " (" + itos(pages_used * PAGE_SIZE_BYTES) + " bytes).");
+	print_line("TOTAL PAGES: " + itos(pages_used.get()) + " (" + itos(pages_used.get() * PAGE_SIZE_BYTES) + " bytes).");
+	print_line("THREAD LANES: " + itos(lanes.size()) + " (" + itos(lane_pages_used.get()) + " pages).");
 	print_line("NULL count: " + itos(null_count));
 
 	for (const KeyValue<StringName, int> &E : set_count) {
@@ -504,10 +677,19 @@ bool CallQueue::is_flushing() const {
 }
 
 bool CallQueue::has_messages() const {
-	if (pages_used == 0) {
+	{
+		MutexLock lock(mutex);
+		for (const Lane *lane : lanes) {
+			if (lane->consumed.get() != lane->pushed.get()) {
+				return true;
+			}
+		}
+	}
+
+	if (pages_used.get() == 0) {
 		return false;
 	}
-	if (pages_used == 1 && page_bytes[0] == 0) {
+	if (pages_used.get() == 1 && page_bytes[0] == 0) {
 		return false;
 	}
 
@@ -528,6 +710,7 @@ CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const
 	}
 	max_pages = p_max_pages;
 	error_text = p_error_text;
+	queue_id = last_queue_id.increment();
 }
 
 CallQueue::~CallQueue() {
@@ -536,6 +719,11 @@ CallQueue::~CallQueue() {
 	for (uint32_t i = 0; i < pages.size(); i++) {
 		allocator->free(pages[i]);
 	}
+	for (Lane *lane : lanes) {
+		if (lane->refcount.unref()) {
+			_free_lane(lane);
+		}
+	}
 	if (!allocator_is_custom) {
 		memdelete(allocator);
 	}
@@ -35,8 +35,11 @@
 #include "core/os/thread_safe.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 
+#include <atomic>
+
 class Object;
 
 class CallQueue {
@@ -74,7 +77,7 @@ private:
 	LocalVector<Page *> pages;
 	LocalVector<uint32_t> page_bytes;
 	uint32_t max_pages = 0;
-	uint32_t pages_used = 0;
+	SafeNumeric<uint32_t> pages_used; // Also read by lane producers to enforce max_pages.
 	bool flushing = false;
 
 #ifdef DEV_ENABLED
@@ -90,11 +93,57 @@ private:
 		};
 	};
 
+	// Messages pushed from threads other than the main one go to a lane owned
+	// by the pushing thread, so producers never wait on the mutex. A lane is a
+	// single-producer, single-consumer chain of pages. flush() handles lanes in
+	// the order their threads first pushed, after the main thread's messages.
+	struct LanePage {
+		SafeNumeric<uint32_t> bytes; // Published by the producer.
+		std::atomic<LanePage *> next = { nullptr };
+		uint8_t data[PAGE_SIZE_BYTES];
+	};
+
+	struct Lane {
+		uint64_t queue_id = 0;
+		SafeRefCount refcount; // One reference for the queue, one for the producer thread.
+		SafeNumeric<uint64_t> pushed;
+		LanePage *tail = nullptr; // Producer side.
+		LanePage *head = nullptr; // Consumer side, from here on.
+		uint32_t head_offset = 0;
+		SafeNumeric<uint64_t> consumed;
+	};
+
+	struct ThreadLanes {
+		LocalVector<Lane *> lanes;
+		~ThreadLanes();
+	};
+
+	static thread_local ThreadLanes thread_lanes;
+	static SafeNumeric<uint64_t> last_queue_id;
+
+	uint64_t queue_id = 0;
+	LocalVector<Lane *> lanes;
+	SafeNumeric<uint32_t> lane_pages_used;
+
+	_FORCE_INLINE_ bool _is_lane_thread() const;
+	Lane *_get_thread_lane();
+	uint8_t *_lane_reserve(Lane *p_lane, uint32_t p_room);
+	void _lane_publish(Lane *p_lane, uint32_t p_room);
+	void _consume_lane(Lane *p_lane, bool p_dispatch);
+	static void _free_lane(Lane *p_lane);
+
+	static void _write_call(uint8_t *p_buffer, const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error);
+	static void _write_set(uint8_t *p_buffer, ObjectID p_id, const StringName &p_prop, const Variant &p_value);
+	static void _write_notification(uint8_t *p_buffer, ObjectID p_id, int p_notification);
+	static uint32_t _get_message_size(const Message *p_message);
+	static void _destroy_message(Message *p_message);
+	void _dispatch_message(Message *p_message);
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
 			page_bytes.push_back(0);
-			pages_used = 1;
+			pages_used.set(1);
 		}
 	}
 
@@ -47,9 +47,11 @@ WorkerThreadPool *WorkerThreadPool::singleton = nullptr;
 thread_local CommandQueueMT *WorkerThreadPool::flushing_cmd_queue = nullptr;
 
 void WorkerThreadPool::_process_task(Task *p_task) {
+	ThreadData *curr_thread_data = nullptr; // Stays null if tasks are run by the thread posting them.
 #ifdef THREADS_ENABLED
 	int pool_thread_index = thread_ids[Thread::get_caller_id()];
 	ThreadData &curr_thread = threads[pool_thread_index];
+	curr_thread_data = &curr_thread;
 	Task *prev_task = nullptr; // In case this is recursively called.
 	bool safe_for_nodes_backup = is_current_thread_safe_for_nodes();
 
@@ -64,62 +66,24 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			ScriptServer::thread_enter();
 			curr_thread.ready_for_scripting = true;
 		}
-		task_mutex.lock();
-		p_task->pool_thread_index = pool_thread_index;
-		prev_task = curr_thread.current_task;
-		curr_thread.current_task = p_task;
-		task_mutex.unlock();
+		prev_task = curr_thread.current_task.load(std::memory_order_relaxed);
+		curr_thread.current_task.store(p_task, std::memory_order_relaxed);
 	}
 #endif
 
+	// Once completed, the task may be freed at any time by the thread waiting for it.
+	bool low_priority = p_task->low_priority;
+
 	if (p_task->group) {
 		// Handling a group
-		bool do_post = false;
-
-		while (true) {
-			uint32_t work_index = p_task->group->index.postincrement();
-
-			if (work_index >= p_task->group->max) {
-				break;
-			}
-			if (p_task->native_group_func) {
-				p_task->native_group_func(p_task->native_func_userdata, work_index);
-			} else if (p_task->template_userdata) {
-				p_task->template_userdata->callback_indexed(work_index);
-			} else {
-				p_task->callable.call(work_index);
-			}
+		_process_group_elements(p_task->group);
 
-			// This is the only way to ensure posting is done when all tasks are really complete.
-			uint32_t completed_amount = p_task->group->completed_index.increment();
-
-			if (completed_amount == p_task->group->max) {
-				do_post = true;
-			}
-		}
-
-		if (do_post && p_task->template_userdata) {
-			memdelete(p_task->template_userdata); // This is no longer needed at this point, so get rid of it.
-		}
-
-		if (do_post) {
-			p_task->group->done_semaphore.post();
-			p_task->group->completed.set_to(true);
-		}
-		uint32_t max_users = p_task->group->tasks_used + 1; // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
+		uint32_t max_users = p_task->group->tasks_used + (p_task->group->detached ? 0 : 1); // Add 1 because the thread waiting for it is also user. Read before to avoid another thread freeing task after increment.
 		uint32_t finished_users = p_task->group->finished.increment();
 
-		if (finished_users == max_users) {
-			// Get rid of the group, because nobody else is using it.
-			task_mutex.lock();
-			group_allocator.free(p_task->group);
-			task_mutex.unlock();
-		}
-
+		// Get rid of the group too if nobody else is using it.
 		// For groups, tasks get rid of themselves.
-
-		task_mutex.lock();
-		task_allocator.free(p_task);
+		_retire_task(curr_thread_data, p_task, finished_users == max_users ? p_task->group : nullptr);
 	} else {
 		if (p_task->native_func) {
 			p_task->native_func(p_task->native_func_userdata);
@@ -130,63 +94,168 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 			p_task->callable.call();
 		}
 
-		task_mutex.lock();
-		p_task->completed = true;
-		p_task->pool_thread_index = -1;
-		if (p_task->waiting_user) {
-			p_task->done_semaphore.post(p_task->waiting_user);
-		}
-		// Let awaiters know.
-		for (uint32_t i = 0; i < threads.size(); i++) {
-			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+		if (p_task->detached) {
+			// Nobody can wait for it, so it gets rid of itself.
+			_retire_task(curr_thread_data, p_task, nullptr);
+		} else if (p_task->state.bit_or(Task::STATE_COMPLETED) & Task::STATE_AWAITED) {
+			// Somebody started waiting before it completed, so they have to be woken up.
+			// Otherwise, whoever waits later will just find it completed.
+			MutexLock lock(task_mutex);
+			p_task->completion_notified = true;
+			if (p_task->waiting_user) {
+				p_task->done_semaphore.post(p_task->waiting_user);
+			}
+			// Let awaiters know.
+			for (uint32_t i = 0; i < threads.size(); i++) {
+				if (threads[i].awaited_task == p_task) {
+					threads[i].cond_var.notify_one();
+					threads[i].signaled = true;
+				}
 			}
 		}
 	}
 
 #ifdef THREADS_ENABLED
 	{
-		curr_thread.current_task = prev_task;
-		if (p_task->low_priority) {
-			low_priority_threads_used--;
-
-			if (_try_promote_low_priority_task()) {
-				if (prev_task) { // Otherwise, this thread will catch it.
-					_notify_threads(&curr_thread, 1, 0);
+		curr_thread.current_task.store(prev_task, std::memory_order_relaxed);
+		if (low_priority) {
+			low_priority_threads_used.fetch_sub(1);
+			if (low_priority_tasks_queued.load() > 0) {
+				MutexLock lock(task_mutex);
+				if (low_priority_threads_used.load() < max_low_priority_threads && _try_promote_low_priority_task()) {
+					if (prev_task) { // Otherwise, this thread will catch it.
+						_notify_threads(&curr_thread, 1, 0);
+					}
 				}
 			}
 		}
-
-		task_mutex.unlock();
 	}
 
 	set_current_thread_safe_for_nodes(safe_for_nodes_backup);
 #endif
 }
 
+void WorkerThreadPool::_process_group_elements(Group *p_group) {
+	bool do_post = false;
+
+	while (true) {
+		uint32_t work_index = p_group->index.postincrement();
+
+		if (work_index >= p_group->max) {
+			break;
+		}
+		if (p_group->native_group_func) {
+			p_group->native_group_func(p_group->native_func_userdata, work_index);
+		} else if (p_group->template_userdata) {
+			p_group->template_userdata->callback_indexed(work_index);
+		} else {
+			p_group->callable.call(work_index);
+		}
+
+		// This is the only way to ensure posting is done when all tasks are really complete.
+		uint32_t completed_amount = p_group->completed_index.increment();
+
+		if (completed_amount == p_group->max) {
+			do_post = true;
+		}
+	}
+
+	if (do_post && p_group->template_userdata) {
+		memdelete(p_group->template_userdata); // This is no longer needed at this point, so get rid of it.
+	}
+
+	if (do_post) {
+		p_group->done_semaphore.post();
+		p_group->completed.set_to(true);
+	}
+}
+
+void WorkerThreadPool::_retire_task(ThreadData *p_thread_data, Task *p_task, Group *p_group) {
+	if (!p_thread_data) {
+		MutexLock lock(task_mutex);
+		task_allocator.free(p_task);
+		if (p_group) {
+			group_allocator.free(p_group);
+		}
+		return;
+	}
+
+	p_thread_data->retired_tasks.push_back(p_task);
+	if (p_group) {
+		p_thread_data->retired_groups.push_back(p_group);
+	}
+	// Busy threads may not go to sleep for a long time, so don't let them pile up.
+	if (p_thread_data->retired_tasks.size() >= TASKS_RETIRED_MAX) {
+		MutexLock lock(task_mutex);
+		_free_retired_tasks(p_thread_data);
+	}
+}
+
+void WorkerThreadPool::_free_retired_tasks(ThreadData *p_thread_data) {
+	for (Task *task : p_thread_data->retired_tasks) {
+		task_allocator.free(task);
+	}
+	p_thread_data->retired_tasks.clear();
+	for (Group *group : p_thread_data->retired_groups) {
+		group_allocator.free(group);
+	}
+	p_thread_data->retired_groups.clear();
+}
+
+void WorkerThreadPool::_queue_task(Task *p_task, uint32_t p_thread_index) {
+	ThreadData &th = threads[p_thread_index];
+	th.queue_lock.lock();
+	th.queue.add_last(&p_task->task_elem);
+	th.queue_lock.unlock();
+	queued_tasks.increment();
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_dequeue_task(const ThreadData *p_thread_data) {
+	if (queued_tasks.get() == 0) {
+		return nullptr;
+	}
+
+	uint32_t thread_count = threads.size();
+	uint32_t start = p_thread_data ? p_thread_data->index : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &th = threads[(start + i) % thread_count];
+		th.queue_lock.lock();
+		SelfList<Task> *first = th.queue.first();
+		if (first) {
+			th.queue.remove(first);
+			th.queue_lock.unlock();
+			queued_tasks.decrement();
+			return first->self();
+		}
+		th.queue_lock.unlock();
+	}
+	return nullptr;
+}
+
 void WorkerThreadPool::_thread_function(void *p_user) {
 	ThreadData *thread_data = (ThreadData *)p_user;
+	WorkerThreadPool *pool = thread_data->pool;
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
-			MutexLock lock(singleton->task_mutex);
-			if (singleton->exit_threads) {
+		// Busy threads keep taking work without going through the pool mutex.
+		Task *task_to_process = pool->_dequeue_task(thread_data);
+		if (!task_to_process) {
+			MutexLock lock(pool->task_mutex);
+			if (pool->exit_threads) {
 				return;
 			}
 			thread_data->signaled = false;
+			pool->_free_retired_tasks(thread_data);
 
-			if (singleton->task_queue.first()) {
-				task_to_process = singleton->task_queue.first()->self();
-				singleton->task_queue.remove(singleton->task_queue.first());
-			} else {
+			// Tasks are queued with the mutex held, so checking again here can't miss a notification.
+			task_to_process = pool->_dequeue_task(thread_data);
+			if (!task_to_process) {
 				thread_data->cond_var.wait(lock);
-				DEV_ASSERT(singleton->exit_threads || thread_data->signaled);
+				DEV_ASSERT(pool->exit_threads || thread_data->signaled);
 			}
 		}
 
 		if (task_to_process) {
-			singleton->_process_task(task_to_process);
+			pool->_process_task(task_to_process);
 		}
 	}
 }
@@ -209,10 +278,14 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
+	// Tasks posted from a pool thread start at its own queue, where the data it just produced is likely still in cache.
+	// Groups are spread over the following queues, so their tasks don't all have to be stolen from one place.
+	uint32_t first_queue = caller_pool_thread ? caller_pool_thread->index : queue_index;
+
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			_queue_task(p_tasks[i], (first_queue + to_process) % threads.size());
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -220,10 +293,21 @@ void WorkerThreadPool::_post_tasks_and_unlock(Task **p_tasks, uint32_t p_count,
 		} else {
 			// Too many threads using low priority, must go to queue.
 			low_priority_task_queue.add_last(&p_tasks[i]->task_elem);
+			low_priority_tasks_queued++;
 			to_promote++;
 		}
 	}
 
+	if (!caller_pool_thread) {
+		queue_index = (queue_index + to_process) % threads.size();
+	}
+
+	// Low priority tasks finish without the mutex, so a slot may have been released since it was checked.
+	while (to_promote && low_priority_threads_used < max_low_priority_threads && _try_promote_low_priority_task()) {
+		to_promote--;
+		to_process++;
+	}
+
 	_notify_threads(caller_pool_thread, to_process, to_promote);
 
 	task_mutex.unlock();
@@ -253,9 +337,11 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.current_task) {
+		Task *current_task = th.current_task.load(std::memory_order_relaxed);
+		if (current_task) {
 			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
+			// An awaiting thread can't finish its current task until it wakes up, so it's safe to look at it.
+			if (to_promote && (th.awaited_task || th.awaited_graph) && current_task->low_priority) {
 				if (likely(&th != p_current_thread_data)) {
 					th.cond_var.notify_one();
 				}
@@ -283,7 +369,7 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 		if (th.signaled) {
 			continue;
 		}
-		if (th.awaited_task) {
+		if (th.awaited_task || th.awaited_graph) {
 			if (likely(&th != p_current_thread_data)) {
 				th.cond_var.notify_one();
 			}
@@ -297,7 +383,9 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
+		low_priority_tasks_queued--;
+		_queue_task(low_prio_task, queue_index);
+		queue_index = (queue_index + 1) % threads.size();
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -309,7 +397,7 @@ WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
 
-WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_detached) {
 	task_mutex.lock();
 	// Get a free task
 	Task *task = task_allocator.alloc();
@@ -320,7 +408,10 @@ WorkerThreadPool::TaskID WorkerThreadPool::_add_task(const Callable &p_callable,
 	task->native_func_userdata = p_userdata;
 	task->description = p_description;
 	task->template_userdata = p_template_userdata;
-	tasks.insert(id, task);
+	task->detached = p_detached;
+	if (!p_detached) {
+		tasks.insert(id, task);
+	}
 
 	_post_tasks_and_unlock(&task, 1, p_high_priority);
 
@@ -339,7 +430,7 @@ bool WorkerThreadPool::is_task_completed(TaskID p_task_id) const {
 		ERR_FAIL_V_MSG(false, "Invalid Task ID"); // Invalid task
 	}
 
-	bool completed = (*taskp)->completed;
+	bool completed = (*taskp)->state.get() & Task::STATE_COMPLETED;
 	task_mutex.unlock();
 
 	return completed;
@@ -354,7 +445,8 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 	Task *task = *taskp;
 
-	if (task->completed) {
+	// If it has completed before anybody waited for it, nobody else will touch it.
+	if (task->state.bit_or(Task::STATE_AWAITED) & Task::STATE_COMPLETED) {
 		if (task->waiting_pool == 0 && task->waiting_user == 0) {
 			tasks.erase(p_task_id);
 			task_allocator.free(task);
@@ -364,7 +456,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	}
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
-	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task->self) {
+	if (caller_pool_thread && p_task_id <= caller_pool_thread->current_task.load(std::memory_order_relaxed)->self) {
 		// Deadlock prevention:
 		// When a pool thread wants to wait for an older task, the following situations can happen:
 		// 1. Awaited task is deep in the stack of the awaiter.
@@ -396,12 +488,12 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 				bool was_signaled = caller_pool_thread->signaled;
 				caller_pool_thread->signaled = false;
 
-				if (task->completed) {
+				if (task->completion_notified) {
 					// This thread was awaken also for some reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
 					if (!exit_threads && was_signaled) {
-						uint32_t to_process = task_queue.first() ? 1 : 0;
-						uint32_t to_promote = caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
+						uint32_t to_process = queued_tasks.get() ? 1 : 0;
+						uint32_t to_promote = caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && low_priority_task_queue.first() ? 1 : 0;
 						if (to_process || to_promote) {
 							// This thread must be left alone since it won't loop again.
 							caller_pool_thread->signaled = true;
@@ -422,16 +514,13 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 					// This is a thread from the pool. It shouldn't just idle.
 					// Let's try to process other tasks while we wait.
 
-					if (caller_pool_thread->current_task->low_priority && low_priority_task_queue.first()) {
+					if (caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && low_priority_task_queue.first()) {
 						if (_try_promote_low_priority_task()) {
 							_notify_threads(caller_pool_thread, 1, 0);
 						}
 					}
 
-					if (singleton->task_queue.first()) {
-						task_to_process = task_queue.first()->self();
-						task_queue.remove(task_queue.first());
-					}
+					task_to_process = _dequeue_task(caller_pool_thread);
 
 					if (!task_to_process) {
 						caller_pool_thread->awaited_task = task;
@@ -444,7 +533,7 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 							flushing_cmd_queue->lock();
 						}
 
-						DEV_ASSERT(exit_threads || caller_pool_thread->signaled || task->completed);
+						DEV_ASSERT(exit_threads || caller_pool_thread->signaled || task->completion_notified);
 						caller_pool_thread->awaited_task = nullptr;
 					}
 				}
@@ -468,8 +557,9 @@ Error WorkerThreadPool::wait_for_task_completion(TaskID p_task_id) {
 	return OK;
 }
 
-WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
+WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, bool p_detached) {
 	ERR_FAIL_COND_V(p_elements < 0, INVALID_TASK_ID);
+	ERR_FAIL_COND_V(p_detached && p_elements == 0, INVALID_TASK_ID); // Nobody would free it.
 	if (p_tasks < 0) {
 		p_tasks = MAX(1u, threads.size());
 	}
@@ -479,6 +569,11 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 	GroupID id = last_task++;
 	group->max = p_elements;
 	group->self = id;
+	group->detached = p_detached;
+	group->callable = p_callable;
+	group->native_group_func = p_func;
+	group->native_func_userdata = p_userdata;
+	group->template_userdata = p_template_userdata;
 
 	Task **tasks_posted = nullptr;
 	if (p_elements == 0) {
@@ -507,7 +602,9 @@ WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_ca
 		}
 	}
 
-	groups[id] = group;
+	if (!p_detached) {
+		groups[id] = group;
+	}
 
 	_post_tasks_and_unlock(tasks_posted, p_tasks, p_high_priority);
 
@@ -557,6 +654,12 @@ void WorkerThreadPool::wait_for_group_task_completion(GroupID p_group) {
 	{
 		Group *group = *groupp;
 
+		if (thread_ids.has(Thread::get_caller_id())) {
+			// A pool thread must not just block: the group tasks may be queued behind it (e.g. low priority
+			// ones while it holds a low priority slot), so it processes the elements left itself.
+			_process_group_elements(group);
+		}
+
 		if (flushing_cmd_queue) {
 			flushing_cmd_queue->unlock();
 		}
@@ -587,6 +690,234 @@ int WorkerThreadPool::get_thread_index() {
 	return singleton->thread_ids.has(tid) ? singleton->thread_ids[tid] : -1;
 }
 
+void WorkerThreadPool::TaskGraph::_run_task(void *p_node) {
+	Node *node = (Node *)p_node;
+	if (node->native_func) {
+		node->native_func(node->native_func_userdata);
+	} else {
+		node->template_userdata->callback();
+	}
+	node->graph->_node_completed(node);
+}
+
+void WorkerThreadPool::TaskGraph::_run_group_element(void *p_node, uint32_t p_index) {
+	Node *node = (Node *)p_node;
+	if (node->native_group_func) {
+		node->native_group_func(node->native_func_userdata, p_index);
+	} else {
+		node->template_userdata->callback_indexed(p_index);
+	}
+	if (node->elements_left.decrement() == 0) {
+		node->graph->_node_completed(node);
+	}
+}
+
+void WorkerThreadPool::TaskGraph::_post(Node *p_node) {
+	if (!p_node->is_group) {
+		singleton->_add_task(Callable(), &TaskGraph::_run_task, p_node, nullptr, high_priority, p_node->description, true);
+	} else if (p_node->elements > 0) {
+		p_node->elements_left.set(p_node->elements);
+		singleton->_add_group_task(Callable(), &TaskGraph::_run_group_element, p_node, nullptr, p_node->elements, p_node->tasks, high_priority, p_node->description, true);
+	} else {
+		_node_completed(p_node);
+	}
+}
+
+void WorkerThreadPool::TaskGraph::_node_completed(Node *p_node) {
+	for (NodeID successor : p_node->successors) {
+		Node *node = nodes[successor];
+		if (node->predecessors_left.decrement() == 0) {
+			_post(node);
+		}
+	}
+	if (nodes_left.decrement() == 0) {
+		// Pool threads waiting for the graph sleep on their own condition variable.
+		MutexLock lock(singleton->task_mutex);
+		for (ThreadData &th : singleton->threads) {
+			if (th.awaited_graph == this) {
+				th.cond_var.notify_one();
+				th.signaled = true;
+			}
+		}
+		done_semaphore.post();
+	}
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::_add_node(Node *p_node) {
+	DEV_ASSERT(!awaiting);
+	p_node->graph = this;
+	nodes.push_back(p_node);
+	return nodes.size() - 1;
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description) {
+	Node *node = memnew(Node);
+	node->native_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->description = p_description;
+	return _add_node(node);
+}
+
+WorkerThreadPool::TaskGraph::NodeID WorkerThreadPool::TaskGraph::add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks, const String &p_description) {
+	ERR_FAIL_COND_V(p_elements < 0, UINT32_MAX);
+	Node *node = memnew(Node);
+	node->native_group_func = p_func;
+	node->native_func_userdata = p_userdata;
+	node->is_group = true;
+	node->elements = p_elements;
+	node->tasks = p_tasks;
+	node->description = p_description;
+	return _add_node(node);
+}
+
+void WorkerThreadPool::TaskGraph::add_dependency(NodeID p_node, NodeID p_predecessor) {
+	ERR_FAIL_UNSIGNED_INDEX(p_node, nodes.size());
+	ERR_FAIL_UNSIGNED_INDEX(p_predecessor, nodes.size());
+	ERR_FAIL_COND_MSG(p_node == p_predecessor, "A task can't depend on itself.");
+	ERR_FAIL_COND(awaiting);
+	nodes[p_predecessor]->successors.push_back(p_node);
+	nodes[p_node]->predecessor_count++;
+}
+
+void WorkerThreadPool::TaskGraph::set_group_task_elements(NodeID p_node, int p_elements) {
+	ERR_FAIL_UNSIGNED_INDEX(p_node, nodes.size());
+	ERR_FAIL_COND(!nodes[p_node]->is_group);
+	ERR_FAIL_COND(p_elements < 0);
+	ERR_FAIL_COND(awaiting);
+	nodes[p_node]->elements = p_elements;
+}
+
+void WorkerThreadPool::TaskGraph::submit(bool p_high_priority) {
+	wait(); // In case it's still running from a previous submission.
+
+	// Find out the start order first, so cycles are rejected before anything runs.
+	LocalVector<NodeID> order;
+	order.reserve(nodes.size());
+	for (uint32_t i = 0; i < nodes.size(); i++) {
+		nodes[i]->predecessors_left.set(nodes[i]->predecessor_count);
+		if (nodes[i]->predecessor_count == 0) {
+			order.push_back(i);
+		}
+	}
+	const uint32_t root_count = order.size();
+	for (uint32_t i = 0; i < order.size(); i++) {
+		for (NodeID successor : nodes[order[i]]->successors) {
+			if (nodes[successor]->predecessors_left.decrement() == 0) {
+				order.push_back(successor);
+			}
+		}
+	}
+	ERR_FAIL_COND_MSG(order.size() != nodes.size(), "Task graph has dependency cycles.");
+
+	if (nodes.is_empty()) {
+		return;
+	}
+
+	for (Node *node : nodes) {
+		node->predecessors_left.set(node->predecessor_count);
+	}
+	high_priority = p_high_priority;
+	nodes_left.set(nodes.size());
+	awaiting = true;
+
+	for (uint32_t i = 0; i < root_count; i++) {
+		_post(nodes[order[i]]);
+	}
+}
+
+bool WorkerThreadPool::TaskGraph::is_completed() const {
+	return nodes_left.get() == 0;
+}
+
+void WorkerThreadPool::TaskGraph::_wait_collaboratively(ThreadData *p_caller_pool_thread) {
+	// Same as waiting for a task from a pool thread: run other tasks until the graph is done.
+	while (true) {
+		Task *task_to_process = nullptr;
+		{
+			MutexLock lock(singleton->task_mutex);
+			bool was_signaled = p_caller_pool_thread->signaled;
+			p_caller_pool_thread->signaled = false;
+
+			if (is_completed()) {
+				// Forward any wake-up this thread got, since it won't loop again.
+				if (!singleton->exit_threads && was_signaled) {
+					uint32_t to_process = singleton->queued_tasks.get() ? 1 : 0;
+					uint32_t to_promote = p_caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && singleton->low_priority_task_queue.first() ? 1 : 0;
+					if (to_process || to_promote) {
+						p_caller_pool_thread->signaled = true;
+						singleton->_notify_threads(p_caller_pool_thread, to_process, to_promote);
+					}
+				}
+				break;
+			}
+
+			if (!singleton->exit_threads) {
+				if (p_caller_pool_thread->current_task.load(std::memory_order_relaxed)->low_priority && singleton->low_priority_task_queue.first()) {
+					if (singleton->_try_promote_low_priority_task()) {
+						singleton->_notify_threads(p_caller_pool_thread, 1, 0);
+					}
+				}
+
+				task_to_process = singleton->_dequeue_task(p_caller_pool_thread);
+				if (!task_to_process) {
+					p_caller_pool_thread->awaited_graph = this;
+
+					if (flushing_cmd_queue) {
+						flushing_cmd_queue->unlock();
+					}
+					p_caller_pool_thread->cond_var.wait(lock);
+					if (flushing_cmd_queue) {
+						flushing_cmd_queue->lock();
+					}
+
+					DEV_ASSERT(singleton->exit_threads || p_caller_pool_thread->signaled || is_completed());
+					p_caller_pool_thread->awaited_graph = nullptr;
+				}
+			}
+		}
+
+		if (task_to_process) {
+			singleton->_process_task(task_to_process);
+		}
+	}
+}
+
+void WorkerThreadPool::TaskGraph::wait() {
+	if (!awaiting) {
+		return;
+	}
+
+	int pool_thread_index = get_thread_index();
+	if (pool_thread_index != -1 && singleton->threads[pool_thread_index].current_task.load(std::memory_order_relaxed)) {
+		_wait_collaboratively(&singleton->threads[pool_thread_index]);
+		done_semaphore.wait(); // Already posted, just consume it.
+	} else {
+		if (flushing_cmd_queue) {
+			flushing_cmd_queue->unlock();
+		}
+		done_semaphore.wait();
+		if (flushing_cmd_queue) {
+			flushing_cmd_queue->lock();
+		}
+	}
+	awaiting = false;
+}
+
+void WorkerThreadPool::TaskGraph::clear() {
+	wait();
+	for (Node *node : nodes) {
+		if (node->template_userdata) {
+			memdelete(node->template_userdata);
+		}
+		memdelete(node);
+	}
+	nodes.clear();
+}
+
+WorkerThreadPool::TaskGraph::~TaskGraph() {
+	clear();
+}
+
 void WorkerThreadPool::thread_enter_command_queue_mt_flush(CommandQueueMT *p_queue) {
 	ERR_FAIL_COND(flushing_cmd_queue != nullptr);
 	flushing_cmd_queue = p_queue;
@@ -608,6 +939,7 @@ void WorkerThreadPool::init(int p_thread_count, float p_low_priority_task_ratio)
 	threads.resize(p_thread_count);
 
 	for (uint32_t i = 0; i < threads.size(); i++) {
+		threads[i].pool = this;
 		threads[i].index = i;
 		threads[i].thread.start(&WorkerThreadPool::_thread_function, &threads[i]);
 		thread_ids.insert(threads[i].thread.get_id(), i);
@@ -644,6 +976,9 @@ void WorkerThreadPool::finish() {
 		for (KeyValue<TaskID, Task *> &E : tasks) {
 			task_allocator.free(E.value);
 		}
+		for (ThreadData &data : threads) {
+			_free_retired_tasks(&data);
+		}
 	}
 
 	threads.clear();
@@ -660,8 +995,10 @@ void WorkerThreadPool::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("wait_for_group_task_completion", "group_id"), &WorkerThreadPool::wait_for_group_task_completion);
 }
 
-WorkerThreadPool::WorkerThreadPool() {
-	singleton = this;
+WorkerThreadPool::WorkerThreadPool(bool p_singleton) {
+	if (p_singleton) {
+		singleton = this;
+	}
 }
 
 WorkerThreadPool::~WorkerThreadPool() {
@@ -35,6 +35,7 @@
 #include "core/os/memory.h"
 #include "core/os/os.h"
 #include "core/os/semaphore.h"
+#include "core/os/spin_lock.h"
 #include "core/os/thread.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
@@ -53,6 +54,8 @@ public:
 	typedef int64_t TaskID;
 	typedef int64_t GroupID;
 
+	class TaskGraph;
+
 private:
 	struct Task;
 
@@ -71,9 +74,20 @@ private:
 		SafeFlag completed;
 		SafeNumeric<uint32_t> finished;
 		uint32_t tasks_used = 0;
+		bool detached = false; // Not awaited by anyone, so it's freed by the last task using it.
+		// Also kept here, so pool threads waiting for the group can process its elements.
+		Callable callable;
+		void (*native_group_func)(void *, uint32_t) = nullptr;
+		void *native_func_userdata = nullptr;
+		BaseTemplateUserdata *template_userdata = nullptr;
 	};
 
 	struct Task {
+		enum {
+			STATE_COMPLETED = 1,
+			STATE_AWAITED = 2, // Somebody has started waiting for it.
+		};
+
 		TaskID self = -1;
 		Callable callable;
 		void (*native_func)(void *) = nullptr;
@@ -81,14 +95,17 @@ private:
 		void *native_func_userdata = nullptr;
 		String description;
 		Semaphore done_semaphore; // For user threads awaiting.
-		bool completed = false;
+		// STATE_* flags. Both sides set theirs with a single atomic operation, so
+		// completing a task only takes the mutex if somebody was already waiting.
+		SafeNumeric<uint32_t> state;
+		bool completion_notified = false; // Set under the mutex, once awaiters have been woken up.
 		Group *group = nullptr;
 		SelfList<Task> task_elem;
 		uint32_t waiting_pool = 0;
 		uint32_t waiting_user = 0;
 		bool low_priority = false;
 		BaseTemplateUserdata *template_userdata = nullptr;
-		int pool_thread_index = -1;
+		bool detached = false; // Not awaited by anyone, so it frees itself on completion.
 
 		void free_template_userdata();
 		Task() :
@@ -97,26 +114,38 @@ private:
 
 	static const uint32_t TASKS_PAGE_SIZE = 1024;
 	static const uint32_t GROUPS_PAGE_SIZE = 256;
+	static const uint32_t TASKS_RETIRED_MAX = 64;
 
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
 
 	BinaryMutex task_mutex;
 
 	struct ThreadData {
+		WorkerThreadPool *pool = nullptr;
 		uint32_t index = 0;
 		Thread thread;
 		bool ready_for_scripting = false;
 		bool signaled = false;
-		Task *current_task = nullptr;
+		// Only written by the thread itself. Others just read it, under the mutex, to decide whom to notify.
+		std::atomic<Task *> current_task = nullptr;
 		Task *awaited_task = nullptr; // Null if not awaiting the condition variable. Special value for idle-waiting.
+		TaskGraph *awaited_graph = nullptr; // Same, but when waiting for a whole task graph.
 		ConditionVariable cond_var;
+		// Tasks ready to run. Each thread takes from its own queue first and
+		// steals from the others, nearest index first, when it runs dry.
+		SpinLock queue_lock;
+		SelfList<Task>::List queue;
+		// Finished tasks and groups, freed in bulk the next time this thread takes the mutex.
+		LocalVector<Task *> retired_tasks;
+		LocalVector<Group *> retired_groups;
 	};
 
 	TightLocalVector<ThreadData> threads;
+	SafeNumeric<uint32_t> queued_tasks; // In all thread queues.
+	uint32_t queue_index = 0; // For spreading tasks posted from outside the pool.
 	bool exit_threads = false;
 
 	HashMap<Thread::ID, int> thread_ids;
@@ -136,7 +165,10 @@ private:
 			groups;
 
 	uint32_t max_low_priority_threads = 0;
-	uint32_t low_priority_threads_used = 0;
+	// Released by finishing tasks without the mutex. Sequentially consistent (unlike SafeNumeric),
+	// so either the finishing task sees a task queued meanwhile or the poster sees the free slot.
+	std::atomic<uint32_t> low_priority_threads_used = 0;
+	std::atomic<uint32_t> low_priority_tasks_queued = 0; // In low_priority_task_queue.
 	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
 
 	uint64_t last_task = 1;
@@ -144,6 +176,11 @@ private:
 	static void _thread_function(void *p_user);
 
 	void _process_task(Task *task);
+	void _process_group_elements(Group *p_group);
+	void _retire_task(ThreadData *p_thread_data, Task *p_task, Group *p_group);
+	void _free_retired_tasks(ThreadData *p_thread_data);
+	void _queue_task(Task *p_task, uint32_t p_thread_index);
+	Task *_dequeue_task(const ThreadData *p_thread_data);
 
 	void _post_tasks_and_unlock(Task **p_tasks, uint32_t p_count, bool p_high_priority);
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
@@ -154,8 +191,8 @@ private:
 
 	static thread_local CommandQueueMT *flushing_cmd_queue;
 
-	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description);
-	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description);
+	TaskID _add_task(const Callable &p_callable, void (*p_func)(void *), void *p_userdata, BaseTemplateUserdata *p_template_userdata, bool p_high_priority, const String &p_description, bool p_detached = false);
+	GroupID _add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description, bool p_detached = false);
 
 	template <class C, class M, class U>
 	struct TaskUserData : public BaseTemplateUserdata {
@@ -181,6 +218,92 @@ protected:
 	static void _bind_methods();
 
 public:
+	// A set of tasks and group tasks with dependencies between them. Each one is
+	// started as soon as all the ones it depends on have completed, so a whole
+	// pipeline can be submitted at once instead of waiting between its phases.
+	// Once completed (and waited for), the graph can be submitted again.
+	class TaskGraph {
+	public:
+		typedef uint32_t NodeID;
+
+	private:
+		struct Node {
+			TaskGraph *graph = nullptr;
+			void (*native_func)(void *) = nullptr;
+			void (*native_group_func)(void *, uint32_t) = nullptr;
+			void *native_func_userdata = nullptr;
+			BaseTemplateUserdata *template_userdata = nullptr;
+			bool is_group = false;
+			int elements = 0;
+			int tasks = -1;
+			String description;
+			LocalVector<NodeID> successors;
+			uint32_t predecessor_count = 0;
+			SafeNumeric<uint32_t> predecessors_left;
+			SafeNumeric<uint32_t> elements_left;
+		};
+
+		LocalVector<Node *> nodes;
+		SafeNumeric<uint32_t> nodes_left;
+		Semaphore done_semaphore;
+		bool high_priority = false;
+		bool awaiting = false; // Submitted, but not waited for yet.
+
+		static void _run_task(void *p_node);
+		static void _run_group_element(void *p_node, uint32_t p_index);
+		void _post(Node *p_node);
+		void _node_completed(Node *p_node);
+		NodeID _add_node(Node *p_node);
+		void _wait_collaboratively(ThreadData *p_caller_pool_thread);
+
+	public:
+		NodeID add_native_task(void (*p_func)(void *), void *p_userdata, const String &p_description = String());
+		NodeID add_native_group_task(void (*p_func)(void *, uint32_t), void *p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String());
+
+		template <class C, class M, class U>
+		NodeID add_template_task(C *p_instance, M p_method, U p_userdata, const String &p_description = String()) {
+			typedef TaskUserData<C, M, U> TUD;
+			TUD *ud = memnew(TUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			Node *node = memnew(Node);
+			node->template_userdata = ud;
+			node->description = p_description;
+			return _add_node(node);
+		}
+
+		template <class C, class M, class U>
+		NodeID add_template_group_task(C *p_instance, M p_method, U p_userdata, int p_elements, int p_tasks = -1, const String &p_description = String()) {
+			typedef GroupUserData<C, M, U> GroupUD;
+			GroupUD *ud = memnew(GroupUD);
+			ud->instance = p_instance;
+			ud->method = p_method;
+			ud->userdata = p_userdata;
+			Node *node = memnew(Node);
+			node->template_userdata = ud;
+			node->is_group = true;
+			node->elements = p_elements;
+			node->tasks = p_tasks;
+			node->description = p_description;
+			return _add_node(node);
+		}
+
+		// p_node will only start after p_predecessor has completed.
+		void add_dependency(NodeID p_node, NodeID p_predecessor);
+		// Lets a graph be reused when the amount of work of a group changes between submissions.
+		void set_group_task_elements(NodeID p_node, int p_elements);
+
+		void submit(bool p_high_priority = false);
+		bool is_completed() const;
+		// Like the other wait functions, it blocks the calling thread, although pool threads
+		// process other tasks meanwhile. Don't call it from a task of the same graph.
+		void wait();
+		void clear();
+
+		~TaskGraph();
+	};
+
 	template <class C, class M, class U>
 	TaskID add_template_task(C *p_instance, M p_method, U p_userdata, bool p_high_priority = false, const String &p_description = String()) {
 		typedef TaskUserData<C, M, U> TUD;
@@ -221,7 +344,7 @@ public:
 
 	void init(int p_thread_count = -1, float p_low_priority_task_ratio = 0.3);
 	void finish();
-	WorkerThreadPool();
+	WorkerThreadPool(bool p_singleton = true);
 	~WorkerThreadPool();
 };
 
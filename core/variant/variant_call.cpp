@@ -35,6 +35,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/packed_array_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/local_vector.h"
@@ -1019,6 +1020,77 @@ struct _VariantCall {
 		return len;
 	}
 
+	static double func_PackedFloat32Array_sum(PackedFloat32Array *p_instance) {
+		return PackedArrayMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_dot(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), 0.0, "Arrays must be the same size.");
+		return PackedArrayMath::dot(p_instance->ptr(), p_with.ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		if (p_instance->is_empty()) {
+			return 0.0;
+		}
+		return PackedArrayMath::min(p_instance->ptr(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		if (p_instance->is_empty()) {
+			return 0.0;
+		}
+		return PackedArrayMath::max(p_instance->ptr(), p_instance->size());
+	}
+
+	static PackedFloat32Array func_PackedFloat32Array_add(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), PackedFloat32Array(), "Arrays must be the same size.");
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::add(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedFloat32Array func_PackedFloat32Array_multiply(PackedFloat32Array *p_instance, const PackedFloat32Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), PackedFloat32Array(), "Arrays must be the same size.");
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::multiply(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedFloat32Array func_PackedFloat32Array_lerp(PackedFloat32Array *p_instance, const PackedFloat32Array &p_to, double p_weight) {
+		ERR_FAIL_COND_V_MSG(p_to.size() != p_instance->size(), PackedFloat32Array(), "Arrays must be the same size.");
+		PackedFloat32Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedVector3Array func_PackedVector3Array_add(PackedVector3Array *p_instance, const PackedVector3Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), PackedVector3Array(), "Arrays must be the same size.");
+		PackedVector3Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::add(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedVector3Array func_PackedVector3Array_multiply(PackedVector3Array *p_instance, const PackedVector3Array &p_with) {
+		ERR_FAIL_COND_V_MSG(p_with.size() != p_instance->size(), PackedVector3Array(), "Arrays must be the same size.");
+		PackedVector3Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::multiply(p_instance->ptr(), p_with.ptr(), ret.ptrw(), ret.size());
+		return ret;
+	}
+
+	static PackedVector3Array func_PackedVector3Array_lerp(PackedVector3Array *p_instance, const PackedVector3Array &p_to, double p_weight) {
+		ERR_FAIL_COND_V_MSG(p_to.size() != p_instance->size(), PackedVector3Array(), "Arrays must be the same size.");
+		PackedVector3Array ret;
+		ret.resize(p_instance->size());
+		PackedArrayMath::lerp(p_instance->ptr(), p_to.ptr(), p_weight, ret.ptrw(), ret.size());
+		return ret;
+	}
+
 	static void func_Callable_call(Variant *v, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_error) {
 		Callable *callable = VariantGetInternalPtr<Callable>::get_ptr(v);
 		callable->callp(p_args, p_argcount, r_ret, r_error);
@@ -2404,6 +2476,13 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedFloat32Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, dot, _VariantCall::func_PackedFloat32Array_dot, sarray("with"), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
+	bind_function(PackedFloat32Array, add, _VariantCall::func_PackedFloat32Array_add, sarray("with"), varray());
+	bind_function(PackedFloat32Array, multiply, _VariantCall::func_PackedFloat32Array_multiply, sarray("with"), varray());
+	bind_function(PackedFloat32Array, lerp, _VariantCall::func_PackedFloat32Array_lerp, sarray("to", "weight"), varray());
 
 	/* Float64 Array */
 
@@ -2500,6 +2579,9 @@ static void _register_variant_builtin_methods() {
 	bind_method(PackedVector3Array, find, sarray("value", "from"), varray(0));
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
+	bind_function(PackedVector3Array, add, _VariantCall::func_PackedVector3Array_add, sarray("with"), varray());
+	bind_function(PackedVector3Array, multiply, _VariantCall::func_PackedVector3Array_multiply, sarray("with"), varray());
+	bind_function(PackedVector3Array, lerp, _VariantCall::func_PackedVector3Array_lerp, sarray("to", "weight"), varray());
 
 	/* Color Array */
 
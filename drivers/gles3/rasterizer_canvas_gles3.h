@@ -373,6 +373,7 @@ public:
 			WARN_PRINT_ONCE("Debug CanvasItem Redraw is not available yet when using the GL Compatibility backend.");
 		}
 	}
+	virtual uint64_t get_rendering_info(RS::RenderingInfo p_info) override { return 0; }
 
 	static RasterizerCanvasGLES3 *get_singleton();
 	RasterizerCanvasGLES3();
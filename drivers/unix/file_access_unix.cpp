@@ -37,6 +37,7 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -137,11 +138,20 @@ Error FileAccessUnix::open_internal(const String &p_path, int p_mode_flags) {
 	return OK;
 }
 
+void FileAccessUnix::_unmap() {
+	if (mapped_data) {
+		munmap(mapped_data, mapped_size);
+		mapped_data = nullptr;
+		mapped_size = 0;
+	}
+}
+
 void FileAccessUnix::_close() {
 	if (!f) {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -282,6 +292,33 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+const uint8_t *FileAccessUnix::get_mapped_buffer() const {
+	ERR_FAIL_NULL_V_MSG(f, nullptr, "File must be opened before use.");
+
+	// Only read-only files are mapped, as writes would invalidate the view.
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	if (mapped_data) {
+		return (const uint8_t *)mapped_data;
+	}
+
+	uint64_t size = get_length();
+	if (size == 0 || size > (uint64_t)SIZE_MAX) {
+		return nullptr;
+	}
+
+	void *ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileno(f), 0);
+	if (ptr == MAP_FAILED) {
+		return nullptr;
+	}
+
+	mapped_data = ptr;
+	mapped_size = size;
+	return (const uint8_t *)mapped_data;
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -49,7 +49,11 @@ class FileAccessUnix : public FileAccess {
 	String path;
 	String path_src;
 
+	mutable void *mapped_data = nullptr;
+	mutable uint64_t mapped_size = 0;
+
 	void _close();
+	void _unmap();
 
 public:
 	static CloseNotificationFunc close_notification_func;
@@ -72,6 +76,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -41,6 +41,7 @@
 #include <windows.h>
 
 #include <errno.h>
+#include <io.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <tchar.h>
@@ -167,11 +168,23 @@ Error FileAccessWindows::open_internal(const String &p_path, int p_mode_flags) {
 	}
 }
 
+void FileAccessWindows::_unmap() {
+	if (mapped_data) {
+		UnmapViewOfFile(mapped_data);
+		mapped_data = nullptr;
+	}
+	if (mapping) {
+		CloseHandle((HANDLE)mapping);
+		mapping = nullptr;
+	}
+}
+
 void FileAccessWindows::_close() {
 	if (!f) {
 		return;
 	}
 
+	_unmap();
 	fclose(f);
 	f = nullptr;
 
@@ -365,6 +378,44 @@ uint64_t FileAccessWindows::get_buffer(uint8_t *p_dst, uint64_t p_length) const
 	return read;
 }
 
+const uint8_t *FileAccessWindows::get_mapped_buffer() const {
+	ERR_FAIL_NULL_V(f, nullptr);
+
+	// Only read-only files are mapped, as writes would invalidate the view.
+	if (flags != READ) {
+		return nullptr;
+	}
+
+	if (mapped_data) {
+		return mapped_data;
+	}
+
+	uint64_t size = get_length();
+	if (size == 0 || size > (uint64_t)SIZE_MAX) {
+		return nullptr;
+	}
+
+	HANDLE handle = (HANDLE)_get_osfhandle(_fileno(f));
+	if (handle == INVALID_HANDLE_VALUE) {
+		return nullptr;
+	}
+
+	HANDLE map = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!map) {
+		return nullptr;
+	}
+
+	const uint8_t *ptr = (const uint8_t *)MapViewOfFile(map, FILE_MAP_READ, 0, 0, 0);
+	if (!ptr) {
+		CloseHandle(map);
+		return nullptr;
+	}
+
+	mapping = map;
+	mapped_data = ptr;
+	return mapped_data;
+}
+
 Error FileAccessWindows::get_error() const {
 	return last_error;
 }
@@ -48,7 +48,11 @@ class FileAccessWindows : public FileAccess {
 	String path_src;
 	String save_path;
 
+	mutable void *mapping = nullptr; // HANDLE returned by CreateFileMappingW.
+	mutable const uint8_t *mapped_data = nullptr;
+
 	void _close();
+	void _unmap();
 
 	static HashSet<String> invalid_files;
 
@@ -74,6 +78,7 @@ public:
 	virtual uint32_t get_32() const override;
 	virtual uint64_t get_64() const override;
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual const uint8_t *get_mapped_buffer() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -1457,6 +1457,7 @@ void GDScript::clear(ClearData *p_clear_data) {
 		return;
 	}
 	clearing = true;
+	GDScriptFunction::invalidate_inline_caches();
 
 	ClearData data;
 	ClearData *clear_data = p_clear_data;
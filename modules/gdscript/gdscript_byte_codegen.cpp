@@ -231,6 +231,11 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_code_size = 0;
 	}
 
+	if (inline_cache_count) {
+		function->inline_caches = memnew_arr(GDScriptFunction::InlineCache, inline_cache_count);
+	}
+	function->_inline_cache_count = inline_cache_count;
+
 	if (function->default_arguments.size()) {
 		function->_default_arg_count = function->default_arguments.size() - 1;
 		function->_default_arg_ptr = &function->default_arguments[0];
@@ -595,6 +600,9 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		// Gather specific operator.
 		Variant::ValidatedOperatorEvaluator op_func = Variant::get_validated_operator_evaluator(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 
+		last_validated_operator_pos = opcodes.size();
+		last_validated_operator_target = p_target;
+
 		append_opcode(GDScriptFunction::OPCODE_OPERATOR_VALIDATED);
 		append(p_left_operand);
 		append(p_right_operand);
@@ -829,6 +837,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -847,6 +856,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1032,6 +1042,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1057,6 +1068,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1265,6 +1277,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1278,6 +1291,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1291,6 +1305,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1407,7 +1422,28 @@ void GDScriptByteCodeGenerator::write_await(const Address &p_target, const Addre
 	append(p_target);
 }
 
+int GDScriptByteCodeGenerator::write_fused_jump_if_not(const Address &p_condition) {
+	// Validated operator is 5 slots long. Its result is still stored, so it stays usable after the jump.
+	if (last_validated_operator_pos < 0 || last_validated_operator_pos + 5 != opcodes.size()) {
+		return -1;
+	}
+	if (p_condition.mode != last_validated_operator_target.mode || p_condition.address != last_validated_operator_target.address) {
+		return -1;
+	}
+	opcodes.write[last_validated_operator_pos] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+	last_validated_operator_pos = -1;
+	int jump_addr = opcodes.size();
+	append(0); // Jump destination, will be patched.
+	return jump_addr;
+}
+
 void GDScriptByteCodeGenerator::write_if(const Address &p_condition) {
+	int fused_jump_addr = write_fused_jump_if_not(p_condition);
+	if (fused_jump_addr >= 0) {
+		if_jmp_addrs.push_back(fused_jump_addr);
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	if_jmp_addrs.push_back(opcodes.size());
@@ -1616,6 +1652,12 @@ void GDScriptByteCodeGenerator::start_while_condition() {
 
 void GDScriptByteCodeGenerator::write_while(const Address &p_condition) {
 	// Condition check.
+	int fused_jump_addr = write_fused_jump_if_not(p_condition);
+	if (fused_jump_addr >= 0) {
+		while_jmp_addrs.push_back(fused_jump_addr);
+		return;
+	}
+
 	append_opcode(GDScriptFunction::OPCODE_JUMP_IF_NOT);
 	append(p_condition);
 	while_jmp_addrs.push_back(opcodes.size());
@@ -139,6 +139,13 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	}
 #endif
 
+	// Last validated operator, if nothing was emitted after it and no jump lands right after it.
+	// Lets a conditional jump on its result be fused into a single instruction.
+	int last_validated_operator_pos = -1;
+	Address last_validated_operator_target;
+
+	int inline_cache_count = 0;
+
 	// Lists since these can be nested.
 	List<int> if_jmp_addrs;
 	List<int> for_jmp_addrs;
@@ -445,8 +452,16 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
+		// The current position is now a jump target, so it can't be fused with the previous instruction.
+		last_validated_operator_pos = -1;
 	}
 
+	void append_inline_cache() {
+		append(inline_cache_count++); // Filled on first run.
+	}
+
+	int write_fused_jump_if_not(const Address &p_condition);
+
 public:
 	virtual uint32_t add_parameter(const StringName &p_name, bool p_is_optional, const GDScriptDataType &p_type) override;
 	virtual uint32_t add_local(const StringName &p_name, const GDScriptDataType &p_type) override;
@@ -32,6 +32,9 @@
 
 #include "gdscript.h"
 
+// Starts at 1 so that empty inline caches never match.
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_generation(1);
+
 Variant GDScriptFunction::get_constant(int p_idx) const {
 	ERR_FAIL_INDEX_V(p_idx, constants.size(), "<errconst>");
 	return constants[p_idx];
@@ -116,11 +119,16 @@ GDScriptFunction::GDScriptFunction() {
 
 GDScriptFunction::~GDScriptFunction() {
 	get_script()->member_functions.erase(name);
+	invalidate_inline_caches();
 
 	for (int i = 0; i < lambdas.size(); i++) {
 		memdelete(lambdas[i]);
 	}
 
+	if (inline_caches) {
+		memdelete_arr(inline_caches);
+	}
+
 	for (int i = 0; i < argument_types.size(); i++) {
 		argument_types.write[i].script_type_ref = Ref<Script>();
 	}
@@ -37,6 +37,7 @@
 #include "core/object/script_language.h"
 #include "core/os/thread.h"
 #include "core/string/string_name.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/pair.h"
 #include "core/templates/self_list.h"
 #include "core/variant/variant.h"
@@ -255,6 +256,7 @@ public:
 		OPCODE_JUMP_IF_NOT,
 		OPCODE_JUMP_TO_DEF_ARGUMENT,
 		OPCODE_JUMP_IF_SHARED,
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
 		OPCODE_RETURN,
 		OPCODE_RETURN_TYPED_BUILTIN,
 		OPCODE_RETURN_TYPED_ARRAY,
@@ -365,6 +367,65 @@ public:
 		ADDR_NIL = ADDR_STACK_NIL | (ADDR_TYPE_STACK << ADDR_BITS),
 	};
 
+	// Monomorphic inline caches of untyped named accesses and calls, filled on first execution.
+	// The code of the instruction holds the index of its cache in the function.
+	enum InlineCacheKind {
+		INLINE_CACHE_EMPTY,
+		INLINE_CACHE_BUILTIN, // Guard: base type (and value type for setters). Target: validated getter or setter.
+		INLINE_CACHE_SCRIPT_MEMBER, // Guard: generation. Key: GDScript. Auxiliary: member index.
+		INLINE_CACHE_SCRIPT_FUNCTION, // Guard: generation. Key: GDScript. Target: GDScriptFunction.
+		INLINE_CACHE_METHOD_BIND, // Guard: generation. Key: native class name. Target: MethodBind.
+		INLINE_CACHE_UNCACHEABLE,
+	};
+
+	struct InlineCacheEntry {
+		InlineCacheKind kind = INLINE_CACHE_EMPTY;
+		uint32_t guard = 0;
+		int aux = 0; // Auxiliary index.
+		const void *key = nullptr;
+		const void *target = nullptr;
+	};
+
+	// The entry of a cache, rewritten in place when refilled so its memory never grows.
+	// Guarded by a sequence lock: readers copy the fields and retry the regular path if a write overlapped.
+	struct InlineCache {
+		std::atomic<uint32_t> sequence = { 0 }; // Odd while being written.
+		std::atomic<uint32_t> kind = { INLINE_CACHE_EMPTY };
+		std::atomic<uint32_t> guard = { 0 };
+		std::atomic<int> aux = { 0 };
+		std::atomic<const void *> key = { nullptr };
+		std::atomic<const void *> target = { nullptr };
+
+		_FORCE_INLINE_ bool read(InlineCacheEntry &r_entry) const {
+			const uint32_t seq = sequence.load(std::memory_order_acquire);
+			if (seq & 1) {
+				return false;
+			}
+			r_entry.kind = InlineCacheKind(kind.load(std::memory_order_relaxed));
+			r_entry.guard = guard.load(std::memory_order_relaxed);
+			r_entry.aux = aux.load(std::memory_order_relaxed);
+			r_entry.key = key.load(std::memory_order_relaxed);
+			r_entry.target = target.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			return sequence.load(std::memory_order_relaxed) == seq;
+		}
+
+		// Writers must be serialized.
+		void write(const InlineCacheEntry &p_entry) {
+			const uint32_t seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			kind.store(p_entry.kind, std::memory_order_relaxed);
+			guard.store(p_entry.guard, std::memory_order_relaxed);
+			aux.store(p_entry.aux, std::memory_order_relaxed);
+			key.store(p_entry.key, std::memory_order_relaxed);
+			target.store(p_entry.target, std::memory_order_relaxed);
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+	};
+
+	static constexpr int INLINE_CACHE_SIZE = 1;
+
 	struct StackDebug {
 		int line;
 		int pos;
@@ -433,6 +494,9 @@ private:
 	int _methods_count = 0;
 	int _lambdas_count = 0;
 
+	InlineCache *inline_caches = nullptr;
+	int _inline_cache_count = 0;
+
 	int *_code_ptr = nullptr;
 	const int *_default_arg_ptr = nullptr;
 	mutable Variant *_constants_ptr = nullptr;
@@ -484,6 +548,13 @@ private:
 	} profile;
 #endif
 
+	static SafeNumeric<uint32_t> inline_cache_generation;
+
+	void _inline_cache_fill(int p_cache, InlineCacheKind p_kind, uint32_t p_guard, int p_aux, const void *p_key, const void *p_target) const;
+	bool _get_named_cached(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_dst) const;
+	bool _set_named_cached(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value) const;
+	bool _call_cached(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const;
+
 	_FORCE_INLINE_ String _get_call_error(const Callable::CallError &p_err, const String &p_where, const Variant **argptrs) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
 
@@ -518,6 +589,9 @@ public:
 	StringName get_global_name(int p_idx) const;
 
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
+
+	// Must be called whenever compiled functions are freed or member layouts change, so inline caches referring to them are refilled.
+	static void invalidate_inline_caches() { inline_cache_generation.increment(); }
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
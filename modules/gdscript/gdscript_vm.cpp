@@ -169,6 +169,237 @@ String GDScriptFunction::_get_call_error(const Callable::CallError &p_err, const
 	return err_text;
 }
 
+static Mutex inline_cache_mutex;
+
+void GDScriptFunction::_inline_cache_fill(int p_cache, InlineCacheKind p_kind, uint32_t p_guard, int p_aux, const void *p_key, const void *p_target) const {
+	InlineCacheEntry entry;
+	entry.kind = p_kind;
+	entry.guard = p_guard;
+	entry.aux = p_aux;
+	entry.key = p_key;
+	entry.target = p_target;
+
+	MutexLock lock(inline_cache_mutex);
+	inline_caches[p_cache].write(entry);
+}
+
+static _FORCE_INLINE_ bool _inline_cache_needs_fill(const GDScriptFunction::InlineCacheEntry &p_entry, uint32_t p_generation) {
+	switch (p_entry.kind) {
+		case GDScriptFunction::INLINE_CACHE_EMPTY:
+			return true;
+		case GDScriptFunction::INLINE_CACHE_SCRIPT_MEMBER:
+		case GDScriptFunction::INLINE_CACHE_SCRIPT_FUNCTION:
+		case GDScriptFunction::INLINE_CACHE_METHOD_BIND:
+			// Scripts were recompiled or freed since, so the cached pointers may be dangling.
+			return p_entry.guard != p_generation;
+		default:
+			return false;
+	}
+}
+
+static _FORCE_INLINE_ GDScriptInstance *_get_gdscript_instance(Object *p_object) {
+	ScriptInstance *si = p_object->get_script_instance();
+	if (!si || si->is_placeholder() || si->get_language() != GDScriptLanguage::get_singleton()) {
+		return nullptr;
+	}
+	return static_cast<GDScriptInstance *>(si);
+}
+
+bool GDScriptFunction::_get_named_cached(int p_cache, const Variant *p_base, const StringName &p_name, Variant *r_dst) const {
+	if (unlikely(p_base == r_dst)) {
+		// Writing the result would destroy the base while it's being read.
+		return false;
+	}
+
+	const uint32_t generation = inline_cache_generation.get();
+	InlineCacheEntry entry;
+	if (unlikely(!inline_caches[p_cache].read(entry))) {
+		return false; // Being refilled by another thread.
+	}
+
+	if (likely(!_inline_cache_needs_fill(entry, generation))) {
+		if (entry.kind == INLINE_CACHE_BUILTIN) {
+			if (likely(entry.guard == uint32_t(p_base->get_type()))) {
+				((Variant::ValidatedGetter)entry.target)(p_base, r_dst);
+				return true;
+			}
+		} else if (entry.kind == INLINE_CACHE_SCRIPT_MEMBER && p_base->get_type() == Variant::OBJECT) {
+			Object *obj = p_base->get_validated_object();
+			GDScriptInstance *instance = obj ? _get_gdscript_instance(obj) : nullptr;
+			if (likely(instance && instance->script.ptr() == entry.key)) {
+				int index = entry.aux;
+				if (likely(index < instance->members.size())) {
+					*r_dst = instance->members[index];
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// First run (or stale cache): take the regular path this time and remember the resolution for the next ones.
+	Variant::Type type = p_base->get_type();
+	if (type == Variant::OBJECT) {
+		Object *obj = p_base->get_validated_object();
+		if (!obj) {
+			return false;
+		}
+		GDScriptInstance *instance = _get_gdscript_instance(obj);
+		const GDScript::MemberInfo *member = instance ? instance->script->member_indices.getptr(p_name) : nullptr;
+		if (member && !member->getter) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_SCRIPT_MEMBER, generation, member->index, instance->script.ptr(), nullptr);
+		} else {
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	} else if (type != Variant::NIL) {
+		Variant::ValidatedGetter getter = Variant::get_member_validated_getter(type, p_name);
+		if (getter) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_BUILTIN, type, 0, nullptr, (const void *)getter);
+		} else {
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	}
+	return false;
+}
+
+bool GDScriptFunction::_set_named_cached(int p_cache, Variant *p_base, const StringName &p_name, const Variant *p_value) const {
+	const uint32_t generation = inline_cache_generation.get();
+	InlineCacheEntry entry;
+	if (unlikely(!inline_caches[p_cache].read(entry))) {
+		return false; // Being refilled by another thread.
+	}
+
+	if (likely(!_inline_cache_needs_fill(entry, generation))) {
+		if (entry.kind == INLINE_CACHE_BUILTIN) {
+			if (likely(entry.guard == uint32_t((p_base->get_type() << 8) | p_value->get_type()))) {
+				((Variant::ValidatedSetter)entry.target)(p_base, p_value);
+				return true;
+			}
+		} else if (entry.kind == INLINE_CACHE_SCRIPT_MEMBER && p_base->get_type() == Variant::OBJECT) {
+			Object *obj = p_base->get_validated_object();
+			GDScriptInstance *instance = obj ? _get_gdscript_instance(obj) : nullptr;
+			if (likely(instance && instance->script.ptr() == entry.key)) {
+				int index = entry.aux;
+				if (likely(index < instance->members.size())) {
+#ifdef TOOLS_ENABLED
+					obj->set_edited(true);
+#endif
+					instance->members.write[index] = *p_value;
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	Variant::Type type = p_base->get_type();
+	if (type == Variant::OBJECT) {
+		Object *obj = p_base->get_validated_object();
+		if (!obj) {
+			return false;
+		}
+		// Typed members and setters need the conversion and call done by GDScriptInstance::set().
+		GDScriptInstance *instance = _get_gdscript_instance(obj);
+		const GDScript::MemberInfo *member = instance ? instance->script->member_indices.getptr(p_name) : nullptr;
+		if (member && !member->setter && !member->data_type.has_type) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_SCRIPT_MEMBER, generation, member->index, instance->script.ptr(), nullptr);
+		} else {
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	} else if (type != Variant::NIL) {
+		// Validated setters expect the exact member type, anything else needs the converting setter.
+		Variant::ValidatedSetter setter = Variant::get_member_validated_setter(type, p_name);
+		if (setter && Variant::get_member_type(type, p_name) == p_value->get_type()) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_BUILTIN, (type << 8) | p_value->get_type(), 0, nullptr, (const void *)setter);
+		} else {
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	}
+	return false;
+}
+
+bool GDScriptFunction::_call_cached(int p_cache, Variant *p_base, const StringName &p_method, const Variant **p_args, int p_argcount, Variant *r_ret, Callable::CallError &r_err) const {
+	if (p_base->get_type() != Variant::OBJECT) {
+		return false;
+	}
+	Object *obj = p_base->get_validated_object();
+	if (!obj) {
+		return false;
+	}
+
+	const uint32_t generation = inline_cache_generation.get();
+	InlineCacheEntry entry;
+	if (unlikely(!inline_caches[p_cache].read(entry))) {
+		return false; // Being refilled by another thread.
+	}
+
+	if (likely(!_inline_cache_needs_fill(entry, generation))) {
+		if (entry.kind == INLINE_CACHE_SCRIPT_FUNCTION) {
+			GDScriptInstance *instance = _get_gdscript_instance(obj);
+			if (likely(instance && instance->script.ptr() == entry.key)) {
+				GDScriptFunction *function = (GDScriptFunction *)entry.target;
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(obj);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				*r_ret = function->call(instance, p_args, p_argcount, r_err);
+				return true;
+			}
+		} else if (entry.kind == INLINE_CACHE_METHOD_BIND) {
+			if (likely(!obj->get_script_instance() && &obj->get_class_name() == entry.key)) {
+				MethodBind *method = (MethodBind *)entry.target;
+#ifdef DEBUG_ENABLED
+				_ObjectDebugLock debug_lock(obj);
+#endif
+				r_err.error = Callable::CallError::CALL_OK;
+				*r_ret = method->call(obj, p_args, p_argcount, r_err);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Mirror the lookup done by Object::callp(), skipping the special cases it handles first.
+	if (p_method == CoreStringNames::get_singleton()->_free || p_method == SNAME("_ready")) {
+		_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		return false;
+	}
+
+	if (obj->get_script_instance()) {
+		GDScriptInstance *instance = _get_gdscript_instance(obj);
+		GDScriptFunction *function = nullptr;
+		for (const GDScript *sptr = instance ? instance->script.ptr() : nullptr; sptr && !function; sptr = sptr->_base) {
+			GDScriptFunction *const *E = sptr->member_functions.getptr(p_method);
+			if (E) {
+				function = *E;
+			}
+		}
+		if (function) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_SCRIPT_FUNCTION, generation, 0, instance->script.ptr(), function);
+		} else {
+			// Native methods on scripted objects depend on the native class the script is attached to.
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	} else {
+		// Extension method binds can be unloaded, only cache the ones owned by the engine.
+		const StringName &class_name = obj->get_class_name();
+		MethodBind *method = nullptr;
+		if (ClassDB::class_exists(class_name)) {
+			ClassDB::APIType api = ClassDB::get_api_type(class_name);
+			// Classes overriding Object::callp() (e.g. JNISingleton) may handle the call themselves.
+			if ((api == ClassDB::API_CORE || api == ClassDB::API_EDITOR) && !ClassDB::class_overrides_callp(class_name)) {
+				method = ClassDB::get_method(class_name, p_method);
+			}
+		}
+		if (method) {
+			_inline_cache_fill(p_cache, INLINE_CACHE_METHOD_BIND, generation, 0, &class_name, method);
+		} else {
+			_inline_cache_fill(p_cache, INLINE_CACHE_UNCACHEABLE, 0, 0, nullptr, nullptr);
+		}
+	}
+	return false;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -271,6 +502,7 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_JUMP_IF_NOT,                          \
 		&&OPCODE_JUMP_TO_DEF_ARGUMENT,                 \
 		&&OPCODE_JUMP_IF_SHARED,                       \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,       \
 		&&OPCODE_RETURN,                               \
 		&&OPCODE_RETURN_TYPED_BUILTIN,                 \
 		&&OPCODE_RETURN_TYPED_ARRAY,                   \
@@ -1074,7 +1306,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(4 + INLINE_CACHE_SIZE);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1084,25 +1316,30 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
-				dst->set_named(*index, *value, valid);
+				int set_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(set_cache < 0 || set_cache >= _inline_cache_count);
+
+				if (!_set_named_cached(set_cache, dst, *index, value)) {
+					bool valid;
+					dst->set_named(*index, *value, valid);
 
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					Object *obj = dst->get_validated_object();
-					bool read_only_property = false;
-					if (obj) {
-						read_only_property = ClassDB::has_property(obj->get_class_name(), *index) && (ClassDB::get_property_setter(obj->get_class_name(), *index) == StringName());
-					}
-					if (read_only_property) {
-						err_text = vformat(R"(Cannot set value into property "%s" (on base "%s") because it is read-only.)", String(*index), _get_var_type(dst));
-					} else {
-						err_text = "Invalid assignment of property or key '" + String(*index) + "' with value of type '" + _get_var_type(value) + "' on a base object of type '" + _get_var_type(dst) + "'.";
+					if (!valid) {
+						Object *obj = dst->get_validated_object();
+						bool read_only_property = false;
+						if (obj) {
+							read_only_property = ClassDB::has_property(obj->get_class_name(), *index) && (ClassDB::get_property_setter(obj->get_class_name(), *index) == StringName());
+						}
+						if (read_only_property) {
+							err_text = vformat(R"(Cannot set value into property "%s" (on base "%s") because it is read-only.)", String(*index), _get_var_type(dst));
+						} else {
+							err_text = "Invalid assignment of property or key '" + String(*index) + "' with value of type '" + _get_var_type(value) + "' on a base object of type '" + _get_var_type(dst) + "'.";
+						}
+						OPCODE_BREAK;
 					}
-					OPCODE_BREAK;
-				}
 #endif
-				ip += 4;
+				}
+				ip += 4 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -1122,7 +1359,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(4 + INLINE_CACHE_SIZE);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1132,22 +1369,27 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int get_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(get_cache < 0 || get_cache >= _inline_cache_count);
+
+				if (!_get_named_cached(get_cache, src, *index, dst)) {
+					bool valid;
 #ifdef DEBUG_ENABLED
-				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+					//allow better error message in cases where src and dst are the same stack position
+					Variant ret = src->get_named(*index, valid);
 
 #else
-				*dst = src->get_named(*index, valid);
+					*dst = src->get_named(*index, valid);
 #endif
 #ifdef DEBUG_ENABLED
-				if (!valid) {
-					err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
-					OPCODE_BREAK;
-				}
-				*dst = ret;
+					if (!valid) {
+						err_text = "Invalid access to property or key '" + index->operator String() + "' on a base object of type '" + _get_var_type(src) + "'.";
+						OPCODE_BREAK;
+					}
+					*dst = ret;
 #endif
-				ip += 4;
+				}
+				ip += 4 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -1673,7 +1915,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(3 + instr_arg_count + INLINE_CACHE_SIZE);
 
 				ip += instr_arg_count;
 
@@ -1699,9 +1941,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 
 				Callable::CallError err;
+				int call_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(call_cache < 0 || call_cache >= _inline_cache_count);
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					if (!_call_cached(call_cache, base, *methodname, (const Variant **)argptrs, argc, ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, *ret, err);
+					}
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
 						if (base_type == Variant::OBJECT) {
@@ -1731,7 +1977,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 #endif
 				} else {
 					Variant ret;
-					base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					if (!_call_cached(call_cache, base, *methodname, (const Variant **)argptrs, argc, &ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, ret, err);
+					}
 				}
 #ifdef DEBUG_ENABLED
 
@@ -1781,7 +2029,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif
 
-				ip += 3;
+				ip += 3 + INLINE_CACHE_SIZE;
 			}
 			DISPATCH_OPCODE;
 
@@ -2440,6 +2688,29 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			}
 			DISPATCH_OPCODE;
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_JUMP_TO_DEF_ARGUMENT) {
 				CHECK_SPACE(2);
 				ip = _default_arg_ptr[defarg];
@@ -0,0 +1,72 @@
+# Untyped accesses and calls are cached after their first execution.
+# Make sure the same instruction still works when the base changes.
+
+class A:
+	var value = 1
+	func get_name_for_test():
+		return "A"
+
+class B:
+	var other = "unused"
+	var value = 2
+	func get_name_for_test():
+		return "B"
+
+class C extends A:
+	var typed: int = 3
+	func get_name_for_test():
+		return "C"
+
+func get_x(base):
+	return base.x
+
+func set_x(base, x):
+	base.x = x
+	return base
+
+func get_value(base):
+	return base.value
+
+func set_value(base, value):
+	base.value = value
+
+func name_of(base):
+	return base.get_name_for_test()
+
+func class_of(base):
+	return base.get_class()
+
+func test():
+	for base in [Vector2(1, 2), Vector2(3, 4), Vector3(5, 6, 7), { x = 8 }, Vector2i(9, 10)]:
+		print(get_x(base))
+
+	for x in [1.5, 2, 3.5]:
+		print(set_x(Vector2(), x))
+	print(set_x(Vector3i(), 4))
+
+	var a := A.new()
+	var b := B.new()
+	var c := C.new()
+	for base in [a, a, b, c, a]:
+		print(get_value(base))
+		print(name_of(base))
+	for base in [a, b, c]:
+		set_value(base, 10)
+		print(base.value)
+
+	for base in [Node.new(), Node.new(), RefCounted.new(), a]:
+		print(class_of(base))
+		if base is Node:
+			base.free()
+
+	var x = 0
+	for i in 5:
+		if i < 3:
+			x += 1
+	while x < 10:
+		x += 2
+	print(x)
+
+	var v = Vector2(11, 12)
+	v = v.x
+	print(v)
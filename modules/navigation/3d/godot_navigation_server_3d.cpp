@@ -1257,6 +1257,9 @@ void GodotNavigationServer3D::map_force_update(RID p_map) {
 	NavMap *map = map_owner.get_or_null(p_map);
 	ERR_FAIL_NULL(map);
 
+	// The pending path queries read the maps that flushing may free and syncing modifies.
+	_finish_path_query_batches();
+
 	flush_queries();
 
 	map->sync();
@@ -1278,6 +1281,9 @@ void GodotNavigationServer3D::sync() {
 }
 
 void GodotNavigationServer3D::process(real_t p_delta_time) {
+	// Deliver the path queries of the last frame before the maps are modified.
+	_finish_path_query_batches();
+
 	flush_queries();
 
 	if (!active) {
@@ -1335,6 +1341,7 @@ void GodotNavigationServer3D::init() {
 }
 
 void GodotNavigationServer3D::finish() {
+	_finish_path_query_batches();
 	flush_queries();
 #ifndef _3D_DISABLED
 	if (navmesh_generator_3d) {
@@ -1346,17 +1353,21 @@ void GodotNavigationServer3D::finish() {
 }
 
 PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &p_parameters) const {
-	PathQueryResult r_query_result;
-
 	const NavMap *map = map_owner.get_or_null(p_parameters.map);
-	ERR_FAIL_NULL_V(map, r_query_result);
+	ERR_FAIL_NULL_V(map, PathQueryResult());
+
+	return _query_path_on_map(map, p_parameters);
+}
+
+PathQueryResult GodotNavigationServer3D::_query_path_on_map(const NavMap *p_map, const PathQueryParameters &p_parameters) {
+	PathQueryResult r_query_result;
 
 	// run the pathfinding
 
 	if (p_parameters.pathfinding_algorithm == PathfindingAlgorithm::PATHFINDING_ALGORITHM_ASTAR) {
 		// while postprocessing is still part of map.get_path() need to check and route it here for the correct "optimize" post-processing
 		if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_CORRIDORFUNNEL) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					true,
@@ -1365,7 +1376,7 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_RIDS) ? &r_query_result.path_rids : nullptr,
 					p_parameters.metadata_flags.has_flag(PathMetadataFlags::PATH_INCLUDE_OWNERS) ? &r_query_result.path_owner_ids : nullptr);
 		} else if (p_parameters.path_postprocessing == PathPostProcessing::PATH_POSTPROCESSING_EDGECENTERED) {
-			r_query_result.path = map->get_path(
+			r_query_result.path = p_map->get_path(
 					p_parameters.start_position,
 					p_parameters.target_position,
 					false,
@@ -1385,6 +1396,79 @@ PathQueryResult GodotNavigationServer3D::_query_path(const PathQueryParameters &
 	return r_query_result;
 }
 
+void GodotNavigationServer3D::query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback) {
+	ERR_FAIL_COND_MSG(p_query_parameters.size() != p_query_results.size(), "The number of query parameters and query results must match.");
+
+	PathQueryBatch *batch = memnew(PathQueryBatch);
+	batch->maps.resize(p_query_parameters.size());
+	batch->parameters.resize(p_query_parameters.size());
+	batch->results.resize(p_query_parameters.size());
+	batch->query_results = p_query_results;
+	batch->callback = p_callback;
+
+	{
+		// Maps are only freed while flushing the commands, after the pending batches are finished.
+		MutexLock lock(operations_mutex);
+		for (int i = 0; i < p_query_parameters.size(); i++) {
+			const Ref<NavigationPathQueryParameters3D> query_parameters = p_query_parameters[i];
+			const Ref<NavigationPathQueryResult3D> query_result = p_query_results[i];
+			if (query_parameters.is_null() || query_result.is_null()) {
+				memdelete(batch);
+				ERR_FAIL_MSG(vformat("Invalid query parameters or query result at index %d.", i));
+			}
+			batch->parameters[i] = query_parameters->get_parameters();
+			batch->maps[i] = map_owner.get_or_null(batch->parameters[i].map);
+			if (!batch->maps[i]) {
+				memdelete(batch);
+				ERR_FAIL_MSG(vformat("Invalid navigation map in query parameters at index %d.", i));
+			}
+		}
+	}
+
+	if (batch->parameters.size() > 0) {
+		batch->group_id = WorkerThreadPool::get_singleton()->add_template_group_task(this, &GodotNavigationServer3D::_process_path_query, batch, batch->parameters.size(), -1, true, SNAME("NavigationPathQueries"));
+	}
+
+	MutexLock lock(path_query_batches_mutex);
+	path_query_batches.push_back(batch);
+}
+
+void GodotNavigationServer3D::_process_path_query(uint32_t p_index, PathQueryBatch *p_batch) {
+	// Maps only change during sync, which takes their write lock, so each query sees one consistent iteration.
+	p_batch->results[p_index] = _query_path_on_map(p_batch->maps[p_index], p_batch->parameters[p_index]);
+}
+
+void GodotNavigationServer3D::_finish_path_query_batches() {
+	LocalVector<PathQueryBatch *> finished_batches;
+	{
+		MutexLock lock(path_query_batches_mutex);
+		SWAP(finished_batches, path_query_batches);
+	}
+
+	for (PathQueryBatch *batch : finished_batches) {
+		if (batch->group_id != -1) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(batch->group_id);
+		}
+
+		for (uint32_t i = 0; i < batch->results.size(); i++) {
+			Ref<NavigationPathQueryResult3D> query_result = batch->query_results[i];
+			const PathQueryResult &result = batch->results[i];
+			query_result->set_path(result.path);
+			query_result->set_path_types(result.path_types);
+			query_result->set_path_rids(result.path_rids);
+			query_result->set_path_owner_ids(result.path_owner_ids);
+		}
+
+		if (batch->callback.is_valid()) {
+			Callable::CallError ce;
+			Variant result;
+			batch->callback.callp(nullptr, 0, result, ce);
+		}
+
+		memdelete(batch);
+	}
+}
+
 int GodotNavigationServer3D::get_process_info(ProcessInfo p_info) const {
 	switch (p_info) {
 		case INFO_ACTIVE_MAPS: {
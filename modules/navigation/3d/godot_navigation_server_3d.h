@@ -72,6 +72,19 @@ class GodotNavigationServer3D : public NavigationServer3D {
 
 	LocalVector<SetCommand *> commands;
 
+	/// Path queries submitted together by `query_paths_async`.
+	struct PathQueryBatch {
+		LocalVector<const NavMap *> maps;
+		LocalVector<NavigationUtilities::PathQueryParameters> parameters;
+		LocalVector<NavigationUtilities::PathQueryResult> results;
+		TypedArray<NavigationPathQueryResult3D> query_results;
+		Callable callback;
+		WorkerThreadPool::GroupID group_id = -1;
+	};
+
+	Mutex path_query_batches_mutex;
+	LocalVector<PathQueryBatch *> path_query_batches;
+
 	mutable RID_Owner<NavLink> link_owner;
 	mutable RID_Owner<NavMap> map_owner;
 	mutable RID_Owner<NavRegion> region_owner;
@@ -275,12 +288,17 @@ public:
 	virtual void finish() override;
 
 	virtual NavigationUtilities::PathQueryResult _query_path(const NavigationUtilities::PathQueryParameters &p_parameters) const override;
+	virtual void query_paths_async(const TypedArray<NavigationPathQueryParameters3D> &p_query_parameters, const TypedArray<NavigationPathQueryResult3D> &p_query_results, const Callable &p_callback = Callable()) override;
 
 	int get_process_info(ProcessInfo p_info) const override;
 
 private:
 	void internal_free_agent(RID p_object);
 	void internal_free_obstacle(RID p_object);
+
+	static NavigationUtilities::PathQueryResult _query_path_on_map(const NavMap *p_map, const NavigationUtilities::PathQueryParameters &p_parameters);
+	void _process_path_query(uint32_t p_index, PathQueryBatch *p_batch);
+	void _finish_path_query_batches();
 };
 
 #undef COMMAND_1
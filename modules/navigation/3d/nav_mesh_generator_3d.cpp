@@ -70,6 +70,32 @@ bool NavMeshGenerator3D::baking_use_multiple_threads = true;
 bool NavMeshGenerator3D::baking_use_high_priority_threads = true;
 HashSet<Ref<NavigationMesh>> NavMeshGenerator3D::baking_navmeshes;
 HashMap<WorkerThreadPool::TaskID, NavMeshGenerator3D::NavMeshGeneratorTask3D *> NavMeshGenerator3D::generator_tasks;
+Mutex NavMeshGenerator3D::tile_cache_mutex;
+HashMap<ObjectID, HashMap<Vector2i, NavMeshGenerator3D::NavMeshGeneratorBakedTile3D>> NavMeshGenerator3D::tile_caches;
+SafeNumeric<uint64_t> NavMeshGenerator3D::baked_tile_count;
+SafeNumeric<uint64_t> NavMeshGenerator3D::reused_tile_count;
+
+struct NavMeshGenerator3D::NavMeshGeneratorTiledBake3D {
+	Ref<NavigationMesh> navigation_mesh;
+	rcConfig cfg;
+	uint32_t settings_hash = 0;
+
+	const float *verts = nullptr;
+	int nverts = 0;
+	const int *tris = nullptr;
+
+	int tile_cells = 0;
+	int tile_border = 0;
+	/// Whether the tiles are clipped to the bake bounds, which only happens when they come from the filter baking AABB.
+	bool clip_tiles = false;
+
+	LocalVector<Vector2i> tile_coords;
+	LocalVector<LocalVector<int>> tile_triangles;
+	LocalVector<NavMeshGeneratorBakedTile3D> tiles;
+
+	/// Tiles of the previous bake of this navigation mesh.
+	HashMap<Vector2i, NavMeshGeneratorBakedTile3D> cached_tiles;
+};
 
 NavMeshGenerator3D *NavMeshGenerator3D::get_singleton() {
 	return singleton;
@@ -138,6 +164,10 @@ void NavMeshGenerator3D::cleanup() {
 	}
 	generator_tasks.clear();
 
+	tile_cache_mutex.lock();
+	tile_caches.clear();
+	tile_cache_mutex.unlock();
+
 	generator_task_mutex.unlock();
 	baking_navmesh_mutex.unlock();
 }
@@ -605,13 +635,6 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 		return;
 	}
 
-	rcHeightfield *hf = nullptr;
-	rcCompactHeightfield *chf = nullptr;
-	rcContourSet *cset = nullptr;
-	rcPolyMesh *poly_mesh = nullptr;
-	rcPolyMeshDetail *detail_mesh = nullptr;
-	rcContext ctx;
-
 	// added to keep track of steps, no functionality right now
 	String bake_state = "";
 
@@ -694,6 +717,12 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 	bake_state = "Calculating grid size..."; // step #2
 	rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
 
+	if (p_navigation_mesh->get_tile_size() > 0.0) {
+		generator_bake_tiled(p_navigation_mesh, cfg, verts, nverts, tris, ntris);
+		bake_state = "Baking finished."; // step #12
+		return;
+	}
+
 	// ~30000000 seems to be around sweetspot where Editor baking breaks
 	if ((cfg.width * cfg.height) > 30000000) {
 		WARN_PRINT("NavigationMesh baking process will likely fail."
@@ -702,92 +731,329 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 				   "\nIt is advised to increase Cell Size and/or Cell Height in the NavMesh Resource bake settings or reduce the size / scale of the source geometry.");
 	}
 
-	bake_state = "Creating heightfield..."; // step #3
+	bake_state = "Baking heightfield..."; // step #3 to #9
+
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	if (!generator_bake_heightfield(p_navigation_mesh, cfg, verts, nverts, tris, ntris, nav_vertices, nav_polygons)) {
+		return;
+	}
+
+	bake_state = "Converting to native navigation mesh..."; // step #10
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
+
+	bake_state = "Baking finished."; // step #12
+}
+
+void NavMeshGenerator3D::generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris) {
+	NavMeshGeneratorTiledBake3D tiled_bake;
+	tiled_bake.navigation_mesh = p_navigation_mesh;
+	tiled_bake.cfg = p_cfg;
+	tiled_bake.verts = p_verts;
+	tiled_bake.nverts = p_nverts;
+	tiled_bake.tris = p_tris;
+
+	// The border makes the tiles see the geometry of their neighbors, so that the tile edges match.
+	tiled_bake.tile_cells = MAX(1, (int)Math::ceil(p_navigation_mesh->get_tile_size() / p_cfg.cs));
+	tiled_bake.tile_border = p_cfg.walkableRadius + 3;
+	tiled_bake.clip_tiles = p_navigation_mesh->get_filter_baking_aabb().has_volume();
+
+	// Tiles are anchored to a fixed world grid instead of the bake bounds, so that
+	// geometry changing in one place doesn't move the tiles everywhere else.
+	const float tile_world_size = tiled_bake.tile_cells * p_cfg.cs;
+	const float tile_world_border = tiled_bake.tile_border * p_cfg.cs;
+	const int tile_x_begin = (int)Math::floor(p_cfg.bmin[0] / tile_world_size);
+	const int tile_x_end = (int)Math::floor(p_cfg.bmax[0] / tile_world_size);
+	const int tile_z_begin = (int)Math::floor(p_cfg.bmin[2] / tile_world_size);
+	const int tile_z_end = (int)Math::floor(p_cfg.bmax[2] / tile_world_size);
+	const int tiles_x = tile_x_end - tile_x_begin + 1;
+	const int tiles_z = tile_z_end - tile_z_begin + 1;
+
+	// Bucket the triangles in all the tiles they overlap, border included.
+	LocalVector<LocalVector<int>> grid_triangles;
+	grid_triangles.resize(tiles_x * tiles_z);
+	for (int i = 0; i < p_ntris; i++) {
+		float tri_min[2] = { FLT_MAX, FLT_MAX };
+		float tri_max[2] = { -FLT_MAX, -FLT_MAX };
+		for (int j = 0; j < 3; j++) {
+			const float *v = &p_verts[p_tris[i * 3 + j] * 3];
+			tri_min[0] = MIN(tri_min[0], v[0]);
+			tri_min[1] = MIN(tri_min[1], v[2]);
+			tri_max[0] = MAX(tri_max[0], v[0]);
+			tri_max[1] = MAX(tri_max[1], v[2]);
+		}
+
+		const int x_begin = MAX(tile_x_begin, (int)Math::floor((tri_min[0] - tile_world_border) / tile_world_size));
+		const int x_end = MIN(tile_x_end, (int)Math::floor((tri_max[0] + tile_world_border) / tile_world_size));
+		const int z_begin = MAX(tile_z_begin, (int)Math::floor((tri_min[1] - tile_world_border) / tile_world_size));
+		const int z_end = MIN(tile_z_end, (int)Math::floor((tri_max[1] + tile_world_border) / tile_world_size));
+		for (int z = z_begin; z <= z_end; z++) {
+			for (int x = x_begin; x <= x_end; x++) {
+				grid_triangles[(z - tile_z_begin) * tiles_x + (x - tile_x_begin)].push_back(i);
+			}
+		}
+	}
+
+	for (int z = 0; z < tiles_z; z++) {
+		for (int x = 0; x < tiles_x; x++) {
+			LocalVector<int> &triangles = grid_triangles[z * tiles_x + x];
+			if (triangles.is_empty()) {
+				continue;
+			}
+			tiled_bake.tile_coords.push_back(Vector2i(tile_x_begin + x, tile_z_begin + z));
+			tiled_bake.tile_triangles.push_back(LocalVector<int>());
+			SWAP(tiled_bake.tile_triangles[tiled_bake.tile_triangles.size() - 1], triangles);
+		}
+	}
+	tiled_bake.tiles.resize(tiled_bake.tile_coords.size());
+
+	// Settings used by the bake that are not part of the Recast config.
+	uint32_t settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_sample_partition_type());
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_low_hanging_obstacles(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_ledge_spans(), settings_hash);
+	settings_hash = hash_murmur3_one_32(p_navigation_mesh->get_filter_walkable_low_height_spans(), settings_hash);
+	tiled_bake.settings_hash = settings_hash;
+
+	const ObjectID navigation_mesh_id = p_navigation_mesh->get_instance_id();
+	tile_cache_mutex.lock();
+	HashMap<ObjectID, HashMap<Vector2i, NavMeshGeneratorBakedTile3D>>::Iterator E = tile_caches.find(navigation_mesh_id);
+	if (E) {
+		tiled_bake.cached_tiles = E->value;
+	}
+	tile_cache_mutex.unlock();
+
+	if (use_threads && tiled_bake.tiles.size() > 1) {
+		WorkerThreadPool::GroupID group_id = WorkerThreadPool::get_singleton()->add_native_group_task(&NavMeshGenerator3D::generator_thread_bake_tile, &tiled_bake, tiled_bake.tiles.size(), -1, baking_use_high_priority_threads, SNAME("NavMeshGeneratorBakeTiles3D"));
+		// Async bakes run in a pool task, which bakes the tiles not picked up yet itself while waiting,
+		// so it can't starve on its own tile tasks when low priority threads are all taken.
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_id);
+	} else {
+		for (uint32_t i = 0; i < tiled_bake.tiles.size(); i++) {
+			generator_thread_bake_tile(&tiled_bake, i);
+		}
+	}
+
+	// Merge the tiles, welding the vertices they share on their edges.
+	Vector<Vector3> nav_vertices;
+	Vector<Vector<int>> nav_polygons;
+	HashMap<Vector3, int> nav_vertex_ids;
+	HashMap<Vector2i, NavMeshGeneratorBakedTile3D> new_cached_tiles;
+	for (uint32_t i = 0; i < tiled_bake.tiles.size(); i++) {
+		const NavMeshGeneratorBakedTile3D &tile = tiled_bake.tiles[i];
+
+		LocalVector<int> vertex_ids;
+		vertex_ids.resize(tile.vertices.size());
+		for (int j = 0; j < tile.vertices.size(); j++) {
+			const Vector3 &vertex = tile.vertices[j];
+			HashMap<Vector3, int>::Iterator V = nav_vertex_ids.find(vertex);
+			if (!V) {
+				V = nav_vertex_ids.insert(vertex, nav_vertices.size());
+				nav_vertices.push_back(vertex);
+			}
+			vertex_ids[j] = V->value;
+		}
+
+		for (const Vector<int> &polygon : tile.polygons) {
+			Vector<int> nav_polygon;
+			nav_polygon.resize(polygon.size());
+			for (int j = 0; j < polygon.size(); j++) {
+				nav_polygon.write[j] = vertex_ids[polygon[j]];
+			}
+			nav_polygons.push_back(nav_polygon);
+		}
+
+		new_cached_tiles.insert(tiled_bake.tile_coords[i], tile);
+	}
+
+	p_navigation_mesh->set_vertices(nav_vertices);
+	p_navigation_mesh->clear_polygons();
+	for (const Vector<int> &nav_polygon : nav_polygons) {
+		p_navigation_mesh->add_polygon(nav_polygon);
+	}
+
+	tile_cache_mutex.lock();
+	// Drop the caches of the freed navigation meshes.
+	LocalVector<ObjectID> freed_navigation_mesh_ids;
+	for (const KeyValue<ObjectID, HashMap<Vector2i, NavMeshGeneratorBakedTile3D>> &C : tile_caches) {
+		if (!ObjectDB::get_instance(C.key)) {
+			freed_navigation_mesh_ids.push_back(C.key);
+		}
+	}
+	for (const ObjectID &freed_navigation_mesh_id : freed_navigation_mesh_ids) {
+		tile_caches.erase(freed_navigation_mesh_id);
+	}
+	tile_caches[navigation_mesh_id] = new_cached_tiles;
+	tile_cache_mutex.unlock();
+}
+
+void NavMeshGenerator3D::generator_thread_bake_tile(void *p_arg, uint32_t p_index) {
+	NavMeshGeneratorTiledBake3D *tiled_bake = static_cast<NavMeshGeneratorTiledBake3D *>(p_arg);
+	const Vector2i &tile_coord = tiled_bake->tile_coords[p_index];
+	const LocalVector<int> &triangles = tiled_bake->tile_triangles[p_index];
+
+	// Everything in the tile config only depends on the tile itself, not on the bake bounds.
+	// Otherwise, geometry changing elsewhere would change the hash of every tile.
+	rcConfig cfg = tiled_bake->cfg;
+	cfg.tileSize = tiled_bake->tile_cells;
+	cfg.borderSize = tiled_bake->tile_border;
+
+	// In cells of the world grid, so that clipped tiles stay aligned with their neighbors.
+	int cell_min[2] = { tile_coord.x * cfg.tileSize, tile_coord.y * cfg.tileSize };
+	int cell_max[2] = { cell_min[0] + cfg.tileSize, cell_min[1] + cfg.tileSize };
+	if (tiled_bake->clip_tiles) {
+		cell_min[0] = MAX(cell_min[0], (int)Math::floor(tiled_bake->cfg.bmin[0] / cfg.cs));
+		cell_min[1] = MAX(cell_min[1], (int)Math::floor(tiled_bake->cfg.bmin[2] / cfg.cs));
+		cell_max[0] = MIN(cell_max[0], (int)Math::ceil(tiled_bake->cfg.bmax[0] / cfg.cs));
+		cell_max[1] = MIN(cell_max[1], (int)Math::ceil(tiled_bake->cfg.bmax[2] / cfg.cs));
+	}
+	NavMeshGeneratorBakedTile3D &tile = tiled_bake->tiles[p_index];
+	if (cell_max[0] <= cell_min[0] || cell_max[1] <= cell_min[1]) {
+		return;
+	}
+	cfg.width = cell_max[0] - cell_min[0] + cfg.borderSize * 2;
+	cfg.height = cell_max[1] - cell_min[1] + cfg.borderSize * 2;
+	cfg.bmin[0] = (cell_min[0] - cfg.borderSize) * cfg.cs;
+	cfg.bmin[2] = (cell_min[1] - cfg.borderSize) * cfg.cs;
+	cfg.bmax[0] = (cell_max[0] + cfg.borderSize) * cfg.cs;
+	cfg.bmax[2] = (cell_max[1] + cfg.borderSize) * cfg.cs;
+
+	LocalVector<int> tile_tris;
+	tile_tris.resize(triangles.size() * 3);
+
+	// The tile only needs a new bake when its config or the triangles it sees changed.
+	float height_min = FLT_MAX;
+	float height_max = -FLT_MAX;
+	uint32_t hash = tiled_bake->settings_hash;
+	for (uint32_t i = 0; i < triangles.size(); i++) {
+		for (int j = 0; j < 3; j++) {
+			const int vertex_index = tiled_bake->tris[triangles[i] * 3 + j];
+			tile_tris[i * 3 + j] = vertex_index;
+			const float *v = &tiled_bake->verts[vertex_index * 3];
+			height_min = MIN(height_min, v[1]);
+			height_max = MAX(height_max, v[1]);
+			hash = hash_murmur3_one_float(v[0], hash);
+			hash = hash_murmur3_one_float(v[1], hash);
+			hash = hash_murmur3_one_float(v[2], hash);
+		}
+	}
+
+	// Heights are snapped to the cells too, so the spans of neighbor tiles line up.
+	cfg.bmin[1] = Math::floor(height_min / cfg.ch) * cfg.ch;
+	cfg.bmax[1] = Math::ceil(height_max / cfg.ch) * cfg.ch;
+	if (tiled_bake->clip_tiles) {
+		cfg.bmin[1] = MAX(cfg.bmin[1], tiled_bake->cfg.bmin[1]);
+		cfg.bmax[1] = MIN(cfg.bmax[1], tiled_bake->cfg.bmax[1]);
+	}
+	hash = hash_murmur3_buffer(&cfg, sizeof(rcConfig), hash);
+	hash = hash_fmix32(hash);
+
+	const NavMeshGeneratorBakedTile3D *cached_tile = tiled_bake->cached_tiles.getptr(tile_coord);
+	if (cached_tile && cached_tile->hash == hash) {
+		tile = *cached_tile;
+		reused_tile_count.increment();
+		return;
+	}
+
+	baked_tile_count.increment();
+
+	if (generator_bake_heightfield(tiled_bake->navigation_mesh, cfg, tiled_bake->verts, tiled_bake->nverts, tile_tris.ptr(), triangles.size(), tile.vertices, tile.polygons)) {
+		tile.hash = hash;
+	} else {
+		// Do not cache failed tiles.
+		tile.vertices.clear();
+		tile.polygons.clear();
+	}
+}
+
+bool NavMeshGenerator3D::generator_bake_heightfield(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons) {
+	rcHeightfield *hf = nullptr;
+	rcCompactHeightfield *chf = nullptr;
+	rcContourSet *cset = nullptr;
+	rcPolyMesh *poly_mesh = nullptr;
+	rcPolyMeshDetail *detail_mesh = nullptr;
+	rcContext ctx;
+
+	// Creating heightfield (step #3).
 	hf = rcAllocHeightfield();
 
-	ERR_FAIL_NULL(hf);
-	ERR_FAIL_COND(!rcCreateHeightfield(&ctx, *hf, cfg.width, cfg.height, cfg.bmin, cfg.bmax, cfg.cs, cfg.ch));
+	ERR_FAIL_NULL_V(hf, false);
+	ERR_FAIL_COND_V(!rcCreateHeightfield(&ctx, *hf, p_cfg.width, p_cfg.height, p_cfg.bmin, p_cfg.bmax, p_cfg.cs, p_cfg.ch), false);
 
-	bake_state = "Marking walkable triangles..."; // step #4
+	// Marking walkable triangles (step #4).
 	{
 		Vector<unsigned char> tri_areas;
-		tri_areas.resize(ntris);
+		tri_areas.resize(p_ntris);
 
-		ERR_FAIL_COND(tri_areas.is_empty());
+		ERR_FAIL_COND_V(tri_areas.is_empty(), false);
 
-		memset(tri_areas.ptrw(), 0, ntris * sizeof(unsigned char));
-		rcMarkWalkableTriangles(&ctx, cfg.walkableSlopeAngle, verts, nverts, tris, ntris, tri_areas.ptrw());
+		memset(tri_areas.ptrw(), 0, p_ntris * sizeof(unsigned char));
+		rcMarkWalkableTriangles(&ctx, p_cfg.walkableSlopeAngle, p_verts, p_nverts, p_tris, p_ntris, tri_areas.ptrw());
 
-		ERR_FAIL_COND(!rcRasterizeTriangles(&ctx, verts, nverts, tris, tri_areas.ptr(), ntris, *hf, cfg.walkableClimb));
+		ERR_FAIL_COND_V(!rcRasterizeTriangles(&ctx, p_verts, p_nverts, p_tris, tri_areas.ptr(), p_ntris, *hf, p_cfg.walkableClimb), false);
 	}
 
 	if (p_navigation_mesh->get_filter_low_hanging_obstacles()) {
-		rcFilterLowHangingWalkableObstacles(&ctx, cfg.walkableClimb, *hf);
+		rcFilterLowHangingWalkableObstacles(&ctx, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_ledge_spans()) {
-		rcFilterLedgeSpans(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf);
+		rcFilterLedgeSpans(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf);
 	}
 	if (p_navigation_mesh->get_filter_walkable_low_height_spans()) {
-		rcFilterWalkableLowHeightSpans(&ctx, cfg.walkableHeight, *hf);
+		rcFilterWalkableLowHeightSpans(&ctx, p_cfg.walkableHeight, *hf);
 	}
 
-	bake_state = "Constructing compact heightfield..."; // step #5
-
+	// Constructing compact heightfield (step #5).
 	chf = rcAllocCompactHeightfield();
 
-	ERR_FAIL_NULL(chf);
-	ERR_FAIL_COND(!rcBuildCompactHeightfield(&ctx, cfg.walkableHeight, cfg.walkableClimb, *hf, *chf));
+	ERR_FAIL_NULL_V(chf, false);
+	ERR_FAIL_COND_V(!rcBuildCompactHeightfield(&ctx, p_cfg.walkableHeight, p_cfg.walkableClimb, *hf, *chf), false);
 
 	rcFreeHeightField(hf);
 	hf = nullptr;
 
-	bake_state = "Eroding walkable area..."; // step #6
-
-	ERR_FAIL_COND(!rcErodeWalkableArea(&ctx, cfg.walkableRadius, *chf));
-
-	bake_state = "Partitioning..."; // step #7
+	// Eroding walkable area (step #6).
+	ERR_FAIL_COND_V(!rcErodeWalkableArea(&ctx, p_cfg.walkableRadius, *chf), false);
 
+	// Partitioning (step #7).
 	if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_WATERSHED) {
-		ERR_FAIL_COND(!rcBuildDistanceField(&ctx, *chf));
-		ERR_FAIL_COND(!rcBuildRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildDistanceField(&ctx, *chf), false);
+		ERR_FAIL_COND_V(!rcBuildRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else if (p_navigation_mesh->get_sample_partition_type() == NavigationMesh::SAMPLE_PARTITION_MONOTONE) {
-		ERR_FAIL_COND(!rcBuildRegionsMonotone(&ctx, *chf, cfg.borderSize, cfg.minRegionArea, cfg.mergeRegionArea));
+		ERR_FAIL_COND_V(!rcBuildRegionsMonotone(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea, p_cfg.mergeRegionArea), false);
 	} else {
-		ERR_FAIL_COND(!rcBuildLayerRegions(&ctx, *chf, cfg.borderSize, cfg.minRegionArea));
+		ERR_FAIL_COND_V(!rcBuildLayerRegions(&ctx, *chf, p_cfg.borderSize, p_cfg.minRegionArea), false);
 	}
 
-	bake_state = "Creating contours..."; // step #8
-
+	// Creating contours (step #8).
 	cset = rcAllocContourSet();
 
-	ERR_FAIL_NULL(cset);
-	ERR_FAIL_COND(!rcBuildContours(&ctx, *chf, cfg.maxSimplificationError, cfg.maxEdgeLen, *cset));
-
-	bake_state = "Creating polymesh..."; // step #9
+	ERR_FAIL_NULL_V(cset, false);
+	ERR_FAIL_COND_V(!rcBuildContours(&ctx, *chf, p_cfg.maxSimplificationError, p_cfg.maxEdgeLen, *cset), false);
 
+	// Creating polymesh (step #9).
 	poly_mesh = rcAllocPolyMesh();
-	ERR_FAIL_NULL(poly_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMesh(&ctx, *cset, cfg.maxVertsPerPoly, *poly_mesh));
+	ERR_FAIL_NULL_V(poly_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMesh(&ctx, *cset, p_cfg.maxVertsPerPoly, *poly_mesh), false);
 
 	detail_mesh = rcAllocPolyMeshDetail();
-	ERR_FAIL_NULL(detail_mesh);
-	ERR_FAIL_COND(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, cfg.detailSampleDist, cfg.detailSampleMaxError, *detail_mesh));
+	ERR_FAIL_NULL_V(detail_mesh, false);
+	ERR_FAIL_COND_V(!rcBuildPolyMeshDetail(&ctx, *poly_mesh, *chf, p_cfg.detailSampleDist, p_cfg.detailSampleMaxError, *detail_mesh), false);
 
 	rcFreeCompactHeightfield(chf);
 	chf = nullptr;
 	rcFreeContourSet(cset);
 	cset = nullptr;
 
-	bake_state = "Converting to native navigation mesh..."; // step #10
-
-	Vector<Vector3> nav_vertices;
-
+	// Converting to native navigation mesh (step #10).
 	for (int i = 0; i < detail_mesh->nverts; i++) {
 		const float *v = &detail_mesh->verts[i * 3];
-		nav_vertices.push_back(Vector3(v[0], v[1], v[2]));
+		r_vertices.push_back(Vector3(v[0], v[1], v[2]));
 	}
-	p_navigation_mesh->set_vertices(nav_vertices);
-	p_navigation_mesh->clear_polygons();
 
 	for (int i = 0; i < detail_mesh->nmeshes; i++) {
 		const unsigned int *detail_mesh_m = &detail_mesh->meshes[i * 4];
@@ -802,18 +1068,14 @@ void NavMeshGenerator3D::generator_bake_from_source_geometry_data(Ref<Navigation
 			nav_indices.write[0] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 0]));
 			nav_indices.write[1] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 2]));
 			nav_indices.write[2] = ((int)(detail_mesh_bverts + detail_mesh_tris[j * 4 + 1]));
-			p_navigation_mesh->add_polygon(nav_indices);
+			r_polygons.push_back(nav_indices);
 		}
 	}
 
-	bake_state = "Cleanup..."; // step #11
-
 	rcFreePolyMesh(poly_mesh);
-	poly_mesh = nullptr;
 	rcFreePolyMeshDetail(detail_mesh);
-	detail_mesh = nullptr;
 
-	bake_state = "Baking finished."; // step #12
+	return true;
 }
 
 bool NavMeshGenerator3D::generator_emit_callback(const Callable &p_callback) {
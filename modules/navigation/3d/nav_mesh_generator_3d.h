@@ -40,6 +40,7 @@
 class Node;
 class NavigationMesh;
 class NavigationMeshSourceGeometryData3D;
+struct rcConfig;
 
 class NavMeshGenerator3D : public Object {
 	static NavMeshGenerator3D *singleton;
@@ -73,9 +74,27 @@ class NavMeshGenerator3D : public Object {
 
 	static HashSet<Ref<NavigationMesh>> baking_navmeshes;
 
+	/// Result of a tile of a tiled bake, kept to skip the tiles whose input did not change on the next bake.
+	struct NavMeshGeneratorBakedTile3D {
+		uint32_t hash = 0;
+		Vector<Vector3> vertices;
+		Vector<Vector<int>> polygons;
+	};
+
+	struct NavMeshGeneratorTiledBake3D;
+
+	static Mutex tile_cache_mutex;
+	static HashMap<ObjectID, HashMap<Vector2i, NavMeshGeneratorBakedTile3D>> tile_caches;
+	static SafeNumeric<uint64_t> baked_tile_count;
+	static SafeNumeric<uint64_t> reused_tile_count;
+
+	static void generator_thread_bake_tile(void *p_arg, uint32_t p_index);
+
 	static void generator_parse_geometry_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node, bool p_recurse_children);
 	static void generator_parse_source_geometry_data(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_root_node);
 	static void generator_bake_from_source_geometry_data(Ref<NavigationMesh> p_navigation_mesh, const Ref<NavigationMeshSourceGeometryData3D> &p_source_geometry_data);
+	static void generator_bake_tiled(Ref<NavigationMesh> p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris);
+	static bool generator_bake_heightfield(const Ref<NavigationMesh> &p_navigation_mesh, const rcConfig &p_cfg, const float *p_verts, int p_nverts, const int *p_tris, int p_ntris, Vector<Vector3> &r_vertices, Vector<Vector<int>> &r_polygons);
 
 	static void generator_parse_meshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
 	static void generator_parse_multimeshinstance3d_node(const Ref<NavigationMesh> &p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, Node *p_node);
@@ -101,6 +120,10 @@ public:
 	static void bake_from_source_geometry_data_async(Ref<NavigationMesh> p_navigation_mesh, Ref<NavigationMeshSourceGeometryData3D> p_source_geometry_data, const Callable &p_callback = Callable());
 	static bool is_baking(Ref<NavigationMesh> p_navigation_mesh);
 
+	// Totals of the tiles of tiled bakes that were baked or taken from the previous bake.
+	static uint64_t get_baked_tile_count() { return baked_tile_count.get(); }
+	static uint64_t get_reused_tile_count() { return reused_tile_count.get(); }
+
 	NavMeshGenerator3D();
 	~NavMeshGenerator3D();
 };
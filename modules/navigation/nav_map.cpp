@@ -219,6 +219,10 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 		return path;
 	}
 
+	// When the route leaves the start region, only search the regions along the coarse route found on the cluster graph.
+	LocalVector<bool> cluster_corridor;
+	bool use_cluster_corridor = use_hierarchical_pathfinding && begin_poly->cluster_id != end_poly->cluster_id && _get_cluster_corridor(begin_poly, begin_point, end_poly, end_point, p_navigation_layers, cluster_corridor);
+
 	// List of all reachable navigation polys.
 	LocalVector<gd::NavigationPoly> navigation_polys;
 	navigation_polys.reserve(polygons.size() * 0.75);
@@ -256,6 +260,11 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 					continue;
 				}
 
+				// Skip the polygons outside of the coarse route.
+				if (use_cluster_corridor && !cluster_corridor[connection.polygon->cluster_id]) {
+					continue;
+				}
+
 				const gd::NavigationPoly &least_cost_poly = navigation_polys[least_cost_id];
 				real_t poly_enter_cost = 0.0;
 				real_t poly_travel_cost = least_cost_poly.poly->owner->get_travel_cost();
@@ -305,6 +314,24 @@ Vector<Vector3> NavMap::get_path(Vector3 p_origin, Vector3 p_destination, bool p
 
 		// When the list of polygons to visit is empty at this point it means the End Polygon is not reachable
 		if (to_visit.size() == 0) {
+			if (use_cluster_corridor) {
+				// The coarse route is not walkable with the polygons it contains, search the whole map instead.
+				use_cluster_corridor = false;
+
+				gd::NavigationPoly np = navigation_polys[0];
+				navigation_polys.clear();
+				navigation_polys.push_back(np);
+				to_visit.clear();
+				to_visit.push_back(0);
+				least_cost_id = 0;
+				prev_least_cost_id = -1;
+
+				reachable_end = nullptr;
+				reachable_d = FLT_MAX;
+
+				continue;
+			}
+
 			// Thus use the further reachable polygon
 			ERR_BREAK_MSG(is_reachable == false, "It's not expect to not find the most reachable polygons");
 			is_reachable = false;
@@ -1174,6 +1201,8 @@ void NavMap::sync() {
 			}
 		}
 
+		_update_clusters(link_poly_idx);
+
 		// Some code treats 0 as a failure case, so we avoid returning 0 and modulo wrap UINT32_MAX manually.
 		iteration_id = iteration_id % UINT32_MAX + 1;
 	}
@@ -1334,38 +1363,41 @@ void NavMap::compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent)
 	(*(agent + index))->update();
 }
 
+void NavMap::_compute_avoidance_step_2d(uint32_t p_index, void *p_userdata) {
+	compute_single_avoidance_step_2d(p_index, active_2d_avoidance_agents.ptr());
+}
+
+void NavMap::_compute_avoidance_step_3d(uint32_t p_index, void *p_userdata) {
+	compute_single_avoidance_step_3d(p_index, active_3d_avoidance_agents.ptr());
+}
+
 void NavMap::step(real_t p_deltatime) {
 	deltatime = p_deltatime;
 
 	rvo_simulation_2d.setTimeStep(float(deltatime));
 	rvo_simulation_3d.setTimeStep(float(deltatime));
 
-	if (active_2d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_2d, active_2d_avoidance_agents.ptr(), active_2d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents2D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_2d_avoidance_agents) {
-				agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
-				agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
-				agent->update();
-			}
-		}
+	if (use_threads && avoidance_use_multiple_threads) {
+		// 2D and 3D agents don't interact, so both simulations run at the same time.
+		avoidance_graph.set_group_task_elements(avoidance_graph_2d, active_2d_avoidance_agents.size());
+		avoidance_graph.set_group_task_elements(avoidance_graph_3d, active_3d_avoidance_agents.size());
+		avoidance_graph.submit(true);
+		avoidance_graph.wait();
+		return;
 	}
 
-	if (active_3d_avoidance_agents.size() > 0) {
-		if (use_threads && avoidance_use_multiple_threads) {
-			WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &NavMap::compute_single_avoidance_step_3d, active_3d_avoidance_agents.ptr(), active_3d_avoidance_agents.size(), -1, true, SNAME("RVOAvoidanceAgents3D"));
-			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
-		} else {
-			for (NavAgent *agent : active_3d_avoidance_agents) {
-				agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
-				agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
-				agent->update();
-			}
-		}
+	for (NavAgent *agent : active_2d_avoidance_agents) {
+		agent->get_rvo_agent_2d()->computeNeighbors(&rvo_simulation_2d);
+		agent->get_rvo_agent_2d()->computeNewVelocity(&rvo_simulation_2d);
+		agent->get_rvo_agent_2d()->update(&rvo_simulation_2d);
+		agent->update();
+	}
+
+	for (NavAgent *agent : active_3d_avoidance_agents) {
+		agent->get_rvo_agent_3d()->computeNeighbors(&rvo_simulation_3d);
+		agent->get_rvo_agent_3d()->computeNewVelocity(&rvo_simulation_3d);
+		agent->get_rvo_agent_3d()->update(&rvo_simulation_3d);
+		agent->update();
 	}
 }
 
@@ -1417,9 +1449,147 @@ void NavMap::_update_merge_rasterizer_cell_dimensions() {
 	merge_rasterizer_cell_height = cell_height * merge_rasterizer_cell_scale;
 }
 
+void NavMap::_update_clusters(uint32_t p_link_polygon_count) {
+	clusters.clear();
+	if (!use_hierarchical_pathfinding) {
+		return;
+	}
+
+	// Every region and every link forms one cluster of the coarse graph.
+	HashMap<const NavBase *, uint32_t> cluster_ids;
+
+	LocalVector<gd::Polygon> *polygon_lists[2] = { &polygons, &link_polygons };
+	const uint32_t polygon_list_sizes[2] = { polygons.size(), p_link_polygon_count };
+
+	for (uint32_t list_index = 0; list_index < 2; list_index++) {
+		LocalVector<gd::Polygon> &list = *polygon_lists[list_index];
+		for (uint32_t i = 0; i < polygon_list_sizes[list_index]; i++) {
+			gd::Polygon &poly = list[i];
+
+			HashMap<const NavBase *, uint32_t>::Iterator E = cluster_ids.find(poly.owner);
+			if (!E) {
+				gd::Cluster cluster;
+				cluster.owner = poly.owner;
+				E = cluster_ids.insert(poly.owner, clusters.size());
+				clusters.push_back(cluster);
+			}
+			poly.cluster_id = E->value;
+		}
+	}
+
+	// Every connection crossing into another region or link is a portal of the coarse graph.
+	for (uint32_t list_index = 0; list_index < 2; list_index++) {
+		const LocalVector<gd::Polygon> &list = *polygon_lists[list_index];
+		for (uint32_t i = 0; i < polygon_list_sizes[list_index]; i++) {
+			const gd::Polygon &poly = list[i];
+			for (const gd::Edge &edge : poly.edges) {
+				for (const gd::Edge::Connection &connection : edge.connections) {
+					if (connection.polygon->cluster_id == poly.cluster_id) {
+						continue;
+					}
+					gd::ClusterPortal portal;
+					portal.cluster = connection.polygon->cluster_id;
+					portal.position = (connection.pathway_start + connection.pathway_end) * 0.5;
+					clusters[poly.cluster_id].portals.push_back(portal);
+				}
+			}
+		}
+	}
+}
+
+bool NavMap::_get_cluster_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<bool> &r_corridor) const {
+	if (clusters.is_empty()) {
+		return false;
+	}
+
+	struct ClusterNode {
+		real_t traveled_distance = FLT_MAX;
+		Vector3 entry;
+		int64_t back_cluster_id = -1;
+		bool closed = false;
+	};
+
+	LocalVector<ClusterNode> nodes;
+	nodes.resize(clusters.size());
+
+	const uint32_t begin_cluster_id = p_begin_poly->cluster_id;
+	const uint32_t end_cluster_id = p_end_poly->cluster_id;
+	nodes[begin_cluster_id].traveled_distance = 0.0;
+	nodes[begin_cluster_id].entry = p_begin_point;
+
+	LocalVector<uint32_t> to_visit;
+	to_visit.push_back(begin_cluster_id);
+
+	// A* over the clusters, with the same costs as the polygon search but using the portals as entry points.
+	bool found_route = false;
+	while (!to_visit.is_empty()) {
+		uint32_t least_cost_index = 0;
+		real_t least_cost = FLT_MAX;
+		for (uint32_t i = 0; i < to_visit.size(); i++) {
+			const ClusterNode &node = nodes[to_visit[i]];
+			const real_t cost = node.traveled_distance + node.entry.distance_to(p_end_point) * clusters[to_visit[i]].owner->get_travel_cost();
+			if (cost < least_cost) {
+				least_cost_index = i;
+				least_cost = cost;
+			}
+		}
+
+		const uint32_t cluster_id = to_visit[least_cost_index];
+		to_visit.remove_at_unordered(least_cost_index);
+		if (cluster_id == end_cluster_id) {
+			found_route = true;
+			break;
+		}
+
+		ClusterNode &node = nodes[cluster_id];
+		node.closed = true;
+
+		const gd::Cluster &cluster = clusters[cluster_id];
+		const real_t travel_cost = cluster.owner->get_travel_cost();
+		for (const gd::ClusterPortal &portal : cluster.portals) {
+			const gd::Cluster &other_cluster = clusters[portal.cluster];
+			if ((p_navigation_layers & other_cluster.owner->get_navigation_layers()) == 0) {
+				continue;
+			}
+
+			ClusterNode &other_node = nodes[portal.cluster];
+			if (other_node.closed) {
+				continue;
+			}
+
+			const real_t new_distance = node.traveled_distance + node.entry.distance_to(portal.position) * travel_cost + other_cluster.owner->get_enter_cost();
+			if (new_distance < other_node.traveled_distance) {
+				if (other_node.traveled_distance == FLT_MAX) {
+					to_visit.push_back(portal.cluster);
+				}
+				other_node.traveled_distance = new_distance;
+				other_node.entry = portal.position;
+				other_node.back_cluster_id = cluster_id;
+			}
+		}
+	}
+
+	if (!found_route) {
+		return false;
+	}
+
+	r_corridor.resize(clusters.size());
+	for (uint32_t i = 0; i < r_corridor.size(); i++) {
+		r_corridor[i] = false;
+	}
+	for (int64_t cluster_id = end_cluster_id; cluster_id != -1; cluster_id = nodes[cluster_id].back_cluster_id) {
+		r_corridor[cluster_id] = true;
+	}
+	return true;
+}
+
 NavMap::NavMap() {
+	use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
 	avoidance_use_multiple_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_multiple_threads");
 	avoidance_use_high_priority_threads = GLOBAL_GET("navigation/avoidance/thread_model/avoidance_use_high_priority_threads");
+
+	avoidance_graph_2d = avoidance_graph.add_template_group_task(this, &NavMap::_compute_avoidance_step_2d, (void *)nullptr, 0, -1, SNAME("RVOAvoidanceAgents2D"));
+	avoidance_graph_3d = avoidance_graph.add_template_group_task(this, &NavMap::_compute_avoidance_step_3d, (void *)nullptr, 0, -1, SNAME("RVOAvoidanceAgents3D"));
 }
 
 NavMap::~NavMap() {
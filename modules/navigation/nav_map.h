@@ -84,6 +84,10 @@ class NavMap : public NavRid {
 	/// Map polygons
 	LocalVector<gd::Polygon> polygons;
 
+	/// Coarse graph of the map, one cluster per region or link.
+	bool use_hierarchical_pathfinding = false;
+	LocalVector<gd::Cluster> clusters;
+
 	/// RVO avoidance worlds
 	RVO2D::RVOSimulator2D rvo_simulation_2d;
 	RVO3D::RVOSimulator3D rvo_simulation_3d;
@@ -114,6 +118,11 @@ class NavMap : public NavRid {
 	bool avoidance_use_multiple_threads = true;
 	bool avoidance_use_high_priority_threads = true;
 
+	/// Runs the 2D and 3D avoidance simulations of a step. Built once, submitted again every step.
+	WorkerThreadPool::TaskGraph avoidance_graph;
+	WorkerThreadPool::TaskGraph::NodeID avoidance_graph_2d = 0;
+	WorkerThreadPool::TaskGraph::NodeID avoidance_graph_3d = 0;
+
 	// Performance Monitor
 	int pm_region_count = 0;
 	int pm_agent_count = 0;
@@ -222,6 +231,8 @@ private:
 
 	void compute_single_avoidance_step_2d(uint32_t index, NavAgent **agent);
 	void compute_single_avoidance_step_3d(uint32_t index, NavAgent **agent);
+	void _compute_avoidance_step_2d(uint32_t p_index, void *p_userdata);
+	void _compute_avoidance_step_3d(uint32_t p_index, void *p_userdata);
 
 	void clip_path(const LocalVector<gd::NavigationPoly> &p_navigation_polys, Vector<Vector3> &path, const gd::NavigationPoly *from_poly, const Vector3 &p_to_point, const gd::NavigationPoly *p_to_poly, Vector<int32_t> *r_path_types, TypedArray<RID> *r_path_rids, Vector<int64_t> *r_path_owners) const;
 	void _update_rvo_simulation();
@@ -230,6 +241,9 @@ private:
 	void _update_rvo_agents_tree_3d();
 
 	void _update_merge_rasterizer_cell_dimensions();
+
+	void _update_clusters(uint32_t p_link_polygon_count);
+	bool _get_cluster_corridor(const gd::Polygon *p_begin_poly, const Vector3 &p_begin_point, const gd::Polygon *p_end_poly, const Vector3 &p_end_point, uint32_t p_navigation_layers, LocalVector<bool> &r_corridor) const;
 };
 
 #endif // NAV_MAP_H
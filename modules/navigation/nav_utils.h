@@ -114,6 +114,26 @@ struct Polygon {
 	Vector3 center;
 
 	real_t surface_area = 0.0;
+
+	/// Index of the cluster of the hierarchical pathfinding graph containing this `Polygon`.
+	uint32_t cluster_id = UINT32_MAX;
+};
+
+/// A gateway between two clusters of the hierarchical pathfinding graph.
+struct ClusterPortal {
+	/// Cluster that this portal leads to.
+	uint32_t cluster = 0;
+
+	/// Middle of the pathway crossing into the other cluster.
+	Vector3 position;
+};
+
+struct Cluster {
+	/// Navigation region or link whose polygons form this cluster.
+	const NavBase *owner = nullptr;
+
+	/// Gateways to the neighbor clusters.
+	LocalVector<ClusterPortal> portals;
 };
 
 struct NavigationPoly {
@@ -0,0 +1,88 @@
+/**************************************************************************/
+/*  test_nav_mesh_generator_3d.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_NAV_MESH_GENERATOR_3D_H
+#define TEST_NAV_MESH_GENERATOR_3D_H
+
+#include "../3d/nav_mesh_generator_3d.h"
+
+#include "scene/resources/3d/primitive_meshes.h"
+#include "scene/resources/navigation_mesh.h"
+#include "scene/resources/navigation_mesh_source_geometry_data_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestNavMeshGenerator3D {
+
+TEST_CASE("[NavMeshGenerator3D] Tiled bakes only rebake the tiles whose geometry changed") {
+	Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+	navigation_mesh->set_tile_size(2.5);
+	Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+	Array arr;
+	arr.resize(RS::ARRAY_MAX);
+	BoxMesh::create_mesh_array(arr, Vector3(20.0, 0.001, 20.0));
+	source_geometry->add_mesh_array(arr, Transform3D());
+
+	uint64_t baked = NavMeshGenerator3D::get_baked_tile_count();
+	uint64_t reused = NavMeshGenerator3D::get_reused_tile_count();
+	NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, source_geometry);
+	const uint64_t tile_count = NavMeshGenerator3D::get_baked_tile_count() - baked;
+	CHECK(tile_count > 4);
+	CHECK_EQ(NavMeshGenerator3D::get_reused_tile_count(), reused);
+
+	SUBCASE("Unchanged geometry should reuse every tile") {
+		baked = NavMeshGenerator3D::get_baked_tile_count();
+		reused = NavMeshGenerator3D::get_reused_tile_count();
+		NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, source_geometry);
+		CHECK_EQ(NavMeshGenerator3D::get_baked_tile_count(), baked);
+		CHECK_EQ(NavMeshGenerator3D::get_reused_tile_count() - reused, tile_count);
+	}
+
+	SUBCASE("Geometry changed in a corner should only rebake the tiles around it") {
+		// Also raises and widens the bake bounds, which must not affect the other tiles.
+		Array obstacle_arr;
+		obstacle_arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(obstacle_arr, Vector3(1.0, 2.0, 1.0));
+		source_geometry->add_mesh_array(obstacle_arr, Transform3D(Basis(), Vector3(10.0, 1.0, 10.0)));
+
+		baked = NavMeshGenerator3D::get_baked_tile_count();
+		reused = NavMeshGenerator3D::get_reused_tile_count();
+		NavMeshGenerator3D::bake_from_source_geometry_data(navigation_mesh, source_geometry);
+		const uint64_t rebaked_count = NavMeshGenerator3D::get_baked_tile_count() - baked;
+		CHECK(rebaked_count > 0);
+		CHECK(rebaked_count < tile_count / 2);
+		CHECK(NavMeshGenerator3D::get_reused_tile_count() - reused > tile_count / 2);
+	}
+}
+
+} // namespace TestNavMeshGenerator3D
+
+#endif // TEST_NAV_MESH_GENERATOR_3D_H
@@ -31,6 +31,7 @@
 #include "skeleton_3d.h"
 #include "skeleton_3d.compat.inc"
 
+#include "core/object/worker_thread_pool.h"
 #include "core/variant/type_info.h"
 #include "scene/3d/physics/physical_bone_3d.h"
 #include "scene/3d/physics/physics_body_3d.h"
@@ -250,6 +251,23 @@ void Skeleton3D::_update_process_order() {
 		}
 	}
 
+	// Breadth first from each root, so parents are always updated before their children.
+	bone_process_order.clear();
+	bone_process_order.reserve(len);
+	for (int i = 0; i < parentless_bones.size(); i++) {
+		uint32_t begin = bone_process_order.size();
+		bone_process_order.push_back(parentless_bones[i]);
+		for (uint32_t j = begin; j < bone_process_order.size(); j++) {
+			const Bone &b = bonesptr[bone_process_order[j]];
+			for (int k = 0; k < b.child_bones.size(); k++) {
+				bone_process_order.push_back(b.child_bones[k]);
+			}
+		}
+	}
+
+	bone_global_pose_dirty.resize(len);
+	all_global_poses_dirty = true;
+
 	process_order_dirty = false;
 }
 
@@ -261,6 +279,10 @@ void Skeleton3D::_notification(int p_what) {
 			}
 		} break;
 		case NOTIFICATION_UPDATE_SKELETON: {
+			if (!update_batch.is_empty() && Thread::is_main_thread() && !is_group_processing()) {
+				_update_batch_global_poses();
+			}
+
 			RenderingServer *rs = RenderingServer::get_singleton();
 			Bone *bonesptr = bones.ptrw();
 
@@ -268,7 +290,11 @@ void Skeleton3D::_notification(int p_what) {
 			dirty = false;
 
 			// Update bone transforms.
-			force_update_all_bone_transforms();
+			_update_bone_global_poses();
+			for (uint32_t i = 0; i < updated_bones.size(); i++) {
+				emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, updated_bones[i]);
+			}
+			updated_bones.clear();
 
 			// Update skins.
 			for (SkinReference *E : skin_bindings) {
@@ -356,6 +382,7 @@ void Skeleton3D::clear_bones_global_pose_override() {
 		bones.write[i].global_pose_override_amount = 0;
 		bones.write[i].global_pose_override_reset = true;
 	}
+	all_global_poses_dirty = true;
 	_make_dirty();
 }
 
@@ -365,6 +392,7 @@ void Skeleton3D::set_bone_global_pose_override(int p_bone, const Transform3D &p_
 	bones.write[p_bone].global_pose_override_amount = p_amount;
 	bones.write[p_bone].global_pose_override = p_pose;
 	bones.write[p_bone].global_pose_override_reset = !p_persistent;
+	_make_bone_dirty(p_bone);
 	_make_dirty();
 }
 
@@ -559,6 +587,7 @@ void Skeleton3D::set_bone_enabled(int p_bone, bool p_enabled) {
 
 	bones.write[p_bone].enabled = p_enabled;
 	emit_signal(SceneStringNames::get_singleton()->bone_enabled_changed, p_bone);
+	_make_bone_dirty(p_bone);
 	_make_dirty();
 }
 
@@ -571,6 +600,7 @@ bool Skeleton3D::is_bone_enabled(int p_bone) const {
 void Skeleton3D::set_show_rest_only(bool p_enabled) {
 	show_rest_only = p_enabled;
 	emit_signal(SceneStringNames::get_singleton()->show_rest_only_changed);
+	all_global_poses_dirty = true;
 	_make_dirty();
 }
 
@@ -594,6 +624,7 @@ void Skeleton3D::set_bone_pose_position(int p_bone, const Vector3 &p_position) {
 
 	bones.write[p_bone].pose_position = p_position;
 	bones.write[p_bone].pose_cache_dirty = true;
+	_make_bone_dirty(p_bone);
 	if (is_inside_tree()) {
 		_make_dirty();
 	}
@@ -604,6 +635,7 @@ void Skeleton3D::set_bone_pose_rotation(int p_bone, const Quaternion &p_rotation
 
 	bones.write[p_bone].pose_rotation = p_rotation;
 	bones.write[p_bone].pose_cache_dirty = true;
+	_make_bone_dirty(p_bone);
 	if (is_inside_tree()) {
 		_make_dirty();
 	}
@@ -614,6 +646,7 @@ void Skeleton3D::set_bone_pose_scale(int p_bone, const Vector3 &p_scale) {
 
 	bones.write[p_bone].pose_scale = p_scale;
 	bones.write[p_bone].pose_cache_dirty = true;
+	_make_bone_dirty(p_bone);
 	if (is_inside_tree()) {
 		_make_dirty();
 	}
@@ -665,10 +698,21 @@ void Skeleton3D::_make_dirty() {
 
 	if (is_inside_tree()) {
 		notify_deferred_thread_group(NOTIFICATION_UPDATE_SKELETON);
+		if (!in_update_batch && Thread::is_main_thread() && !is_group_processing()) {
+			// The first of these notifications to run computes the poses of all batched skeletons.
+			update_batch.push_back(get_instance_id());
+			in_update_batch = true;
+		}
 	}
 	dirty = true;
 }
 
+void Skeleton3D::_make_bone_dirty(int p_bone) {
+	if ((uint32_t)p_bone < bone_global_pose_dirty.size()) {
+		bone_global_pose_dirty[p_bone] = 1;
+	} // Otherwise the process order is outdated and all bones get updated.
+}
+
 void Skeleton3D::localize_rests() {
 	Vector<int> bones_to_process = get_parentless_bones();
 	while (bones_to_process.size() > 0) {
@@ -933,14 +977,107 @@ void Skeleton3D::force_update_all_dirty_bones() {
 }
 
 void Skeleton3D::force_update_all_bone_transforms() {
+	all_global_poses_dirty = true;
+	_update_bone_global_poses();
+	for (uint32_t i = 0; i < updated_bones.size(); i++) {
+		emit_signal(SceneStringNames::get_singleton()->bone_pose_changed, updated_bones[i]);
+	}
+	updated_bones.clear();
+}
+
+void Skeleton3D::_update_bone_global_poses() {
+	// Only touches this skeleton's data, so different skeletons can update in parallel.
 	_update_process_order();
 
-	for (int i = 0; i < parentless_bones.size(); i++) {
-		force_update_bone_children_transforms(parentless_bones[i]);
+	Bone *bonesptr = bones.ptrw();
+	uint8_t *dirtyptr = bone_global_pose_dirty.ptr();
+	const bool update_all = all_global_poses_dirty || rest_dirty;
+
+	for (const int bone_idx : bone_process_order) {
+		Bone &b = bonesptr[bone_idx];
+		if (!update_all && !dirtyptr[bone_idx]) {
+			if (b.parent < 0 || !dirtyptr[b.parent]) {
+				continue;
+			}
+			dirtyptr[bone_idx] = 1; // Moved along with the parent.
+		}
+
+		bool bone_enabled = b.enabled && !show_rest_only;
+
+		if (bone_enabled) {
+			b.update_pose_cache();
+			Transform3D pose = b.pose_cache;
+
+			if (b.parent >= 0) {
+				b.pose_global = bonesptr[b.parent].pose_global * pose;
+				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * pose;
+			} else {
+				b.pose_global = pose;
+				b.pose_global_no_override = pose;
+			}
+		} else {
+			if (b.parent >= 0) {
+				b.pose_global = bonesptr[b.parent].pose_global * b.rest;
+				b.pose_global_no_override = bonesptr[b.parent].pose_global_no_override * b.rest;
+			} else {
+				b.pose_global = b.rest;
+				b.pose_global_no_override = b.rest;
+			}
+		}
+		if (rest_dirty) {
+			b.global_rest = b.parent >= 0 ? bonesptr[b.parent].global_rest * b.rest : b.rest;
+		}
+
+		if (b.global_pose_override_amount >= CMP_EPSILON) {
+			b.pose_global = b.pose_global.interpolate_with(b.global_pose_override, b.global_pose_override_amount);
+			if (b.global_pose_override_reset) {
+				dirtyptr[bone_idx] = 2; // Recompute without the override next time.
+			}
+		}
+
+		if (b.global_pose_override_reset) {
+			b.global_pose_override_amount = 0.0;
+		}
+
+		updated_bones.push_back(bone_idx);
+	}
+
+	for (uint8_t &bone_dirty : bone_global_pose_dirty) {
+		bone_dirty = bone_dirty == 2 ? 1 : 0;
 	}
+	all_global_poses_dirty = false;
 	rest_dirty = false;
 }
 
+LocalVector<ObjectID> Skeleton3D::update_batch;
+
+void Skeleton3D::_update_batch_global_poses_task(void *p_userdata, uint32_t p_index) {
+	static_cast<Skeleton3D **>(p_userdata)[p_index]->_update_bone_global_poses();
+}
+
+void Skeleton3D::_update_batch_global_poses() {
+	LocalVector<Skeleton3D *> skeletons;
+	skeletons.reserve(update_batch.size());
+	for (const ObjectID &id : update_batch) {
+		Skeleton3D *skeleton = Object::cast_to<Skeleton3D>(ObjectDB::get_instance(id));
+		if (skeleton) {
+			skeleton->in_update_batch = false;
+			if (skeleton->dirty) {
+				skeletons.push_back(skeleton);
+			}
+		}
+	}
+	update_batch.clear();
+
+	// Each skeleton emits its signals and updates its skins in its own notification, as before.
+	if (skeletons.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&Skeleton3D::_update_batch_global_poses_task, skeletons.ptr(), skeletons.size(), -1, true, SNAME("Skeleton3DUpdatePoses"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (skeletons.size() == 1) {
+		skeletons[0]->_update_bone_global_poses();
+	}
+}
+
 void Skeleton3D::force_update_bone_children_transforms(int p_bone_idx) {
 	const int bone_size = bones.size();
 	ERR_FAIL_INDEX(p_bone_idx, bone_size);
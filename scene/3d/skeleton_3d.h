@@ -127,10 +127,24 @@ private:
 	Vector<int> parentless_bones;
 	HashMap<String, int> name_to_bone_index;
 
+	// Global poses are only recomputed for dirty bones and their children.
+	LocalVector<int> bone_process_order; // Parents before children, rebuilt by _update_process_order().
+	LocalVector<uint8_t> bone_global_pose_dirty; // Indexed by bone, 1 if dirty, 2 if it must stay dirty for the next update.
+	bool all_global_poses_dirty = true;
+	LocalVector<int> updated_bones; // For emitting bone_pose_changed.
+
 	void _make_dirty();
+	void _make_bone_dirty(int p_bone);
+	void _update_bone_global_poses();
 	bool dirty = false;
 	bool rest_dirty = false;
 
+	// Skeletons dirtied on the main thread, their poses are computed together on the WorkerThreadPool.
+	static LocalVector<ObjectID> update_batch;
+	bool in_update_batch = false;
+	static void _update_batch_global_poses();
+	static void _update_batch_global_poses_task(void *p_userdata, uint32_t p_index);
+
 	bool show_rest_only = false;
 	float motion_scale = 1.0;
 
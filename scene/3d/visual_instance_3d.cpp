@@ -57,7 +57,10 @@ void VisualInstance3D::_notification(int p_what) {
 
 		case NOTIFICATION_TRANSFORM_CHANGED: {
 			Transform3D gt = get_global_transform();
-			RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			// Sent along with the other instances moved in this flush of transform notifications, if there is one.
+			if (!is_inside_tree() || !get_tree()->_queue_instance_transform(instance, gt)) {
+				RenderingServer::get_singleton()->instance_set_transform(instance, gt);
+			}
 		} break;
 
 		case NOTIFICATION_EXIT_WORLD: {
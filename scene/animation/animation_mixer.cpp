@@ -33,6 +33,7 @@
 
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/3d/node_3d.h"
 #include "scene/3d/skeleton_3d.h"
@@ -519,6 +520,20 @@ AnimationMixer::AnimationCallbackModeDiscrete AnimationMixer::get_callback_mode_
 	return callback_mode_discrete;
 }
 
+void AnimationMixer::set_parallel_evaluation(bool p_enabled) {
+	if (parallel_evaluation == p_enabled) {
+		return;
+	}
+	if (parallel_evaluation_pending) {
+		_finish_parallel_evaluation();
+	}
+	parallel_evaluation = p_enabled;
+}
+
+bool AnimationMixer::is_parallel_evaluation() const {
+	return parallel_evaluation;
+}
+
 void AnimationMixer::set_audio_max_polyphony(int p_audio_max_polyphony) {
 	ERR_FAIL_COND(p_audio_max_polyphony < 0 || p_audio_max_polyphony > 128);
 	audio_max_polyphony = p_audio_max_polyphony;
@@ -609,6 +624,7 @@ void AnimationMixer::_init_root_motion_cache() {
 
 bool AnimationMixer::_update_caches() {
 	setup_pass++;
+	parallel_evaluation_safe = true;
 
 	root_motion_cache.loc = Vector3(0, 0, 0);
 	root_motion_cache.rot = Quaternion(0, 0, 0, 1);
@@ -890,6 +906,15 @@ bool AnimationMixer::_update_caches() {
 			}
 
 			track->setup_pass = setup_pass;
+
+			// Method, audio, animation and discrete value tracks act on other objects while blending.
+			if (track_src_type == Animation::TYPE_METHOD || track_src_type == Animation::TYPE_AUDIO || track_src_type == Animation::TYPE_ANIMATION) {
+				parallel_evaluation_safe = false;
+			} else if (track_cache_type == Animation::TYPE_VALUE) {
+				if (!static_cast<TrackCacheValue *>(track)->is_variant_interpolatable || (track_src_type == Animation::TYPE_VALUE && anim->value_track_get_update_mode(i) == Animation::UPDATE_DISCRETE)) {
+					parallel_evaluation_safe = false;
+				}
+			}
 		}
 	}
 
@@ -928,6 +953,10 @@ bool AnimationMixer::_update_caches() {
 /* -------------------------------------------- */
 
 void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
+	if (parallel_evaluation_pending) {
+		// Seeked or advanced by hand before the batch ran, finish the previous frame first.
+		_finish_parallel_evaluation();
+	}
 	_blend_init();
 	if (_blend_pre_process(p_delta, track_count, track_map)) {
 		_blend_capture(p_delta);
@@ -939,6 +968,100 @@ void AnimationMixer::_process_animation(double p_delta, bool p_update_only) {
 	clear_animation_instances();
 }
 
+LocalVector<ObjectID> AnimationMixer::parallel_batch;
+
+void AnimationMixer::_process_animation_parallel(double p_delta) {
+	if (parallel_evaluation_pending) {
+		_finish_parallel_evaluation();
+	}
+	if (!Thread::is_main_thread() || GDVIRTUAL_IS_OVERRIDDEN(_post_process_key_value)) {
+		_process_animation(p_delta);
+		return;
+	}
+
+	_blend_init();
+	if (!_blend_pre_process(p_delta, track_count, track_map)) {
+		clear_animation_instances();
+		return;
+	}
+	_blend_capture(p_delta);
+
+	if (!cache_valid || !parallel_evaluation_safe) {
+		// Blending would touch other objects, so it can't leave the main thread.
+		_blend_evaluate(p_delta);
+		_blend_apply();
+		_blend_post_process();
+		clear_animation_instances();
+		return;
+	}
+
+	// Evaluated on the WorkerThreadPool together with the other mixers processed this frame,
+	// then applied in queue order once all of them are done.
+	parallel_evaluation_pending = true;
+	parallel_evaluation_delta = p_delta;
+	if (parallel_evaluation_queued) {
+		return; // Processed twice before the batch ran, e.g. on several physics steps.
+	}
+
+	parallel_evaluation_queued = true;
+	parallel_batch.push_back(get_instance_id());
+	if (parallel_batch.size() == 1) {
+		callable_mp_static(&AnimationMixer::_process_parallel_batch).call_deferred();
+	}
+}
+
+void AnimationMixer::_finish_parallel_evaluation() {
+	if (!parallel_evaluation_evaluated) {
+		_blend_evaluate(parallel_evaluation_delta);
+	}
+	_blend_apply();
+	parallel_evaluation_pending = false;
+	parallel_evaluation_evaluated = false;
+	_blend_post_process();
+	clear_animation_instances();
+}
+
+void AnimationMixer::_process_parallel_batch_task(void *p_userdata, uint32_t p_index) {
+	AnimationMixer *mixer = static_cast<AnimationMixer **>(p_userdata)[p_index];
+	mixer->_blend_evaluate(mixer->parallel_evaluation_delta);
+	mixer->parallel_evaluation_evaluated = true;
+}
+
+void AnimationMixer::_process_parallel_batch() {
+	LocalVector<ObjectID> batch = parallel_batch;
+	parallel_batch.clear();
+
+	// Mixers may have been freed or finished by a seek since they were queued.
+	LocalVector<AnimationMixer *> mixers;
+	mixers.reserve(batch.size());
+	for (const ObjectID &id : batch) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (!mixer) {
+			continue;
+		}
+		mixer->parallel_evaluation_queued = false;
+		if (mixer->parallel_evaluation_pending) {
+			mixers.push_back(mixer);
+		}
+	}
+
+	if (mixers.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&AnimationMixer::_process_parallel_batch_task, mixers.ptr(), mixers.size(), -1, true, SNAME("AnimationMixerEvaluate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (mixers.size() == 1) {
+		_process_parallel_batch_task(mixers.ptr(), 0);
+	}
+
+	// Applying sets properties and emits signals, keep it ordered on the main thread.
+	// Those can free or seek mixers further down the batch, so look them up again.
+	for (const ObjectID &id : batch) {
+		AnimationMixer *mixer = Object::cast_to<AnimationMixer>(ObjectDB::get_instance(id));
+		if (mixer && mixer->parallel_evaluation_pending) {
+			mixer->_finish_parallel_evaluation();
+		}
+	}
+}
+
 Variant AnimationMixer::post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx) {
 	Variant res;
 	if (GDVIRTUAL_CALL(_post_process_key_value, p_anim, p_track, p_value, p_object_id, p_object_sub_idx, res)) {
@@ -1094,6 +1217,40 @@ void AnimationMixer::_blend_calc_total_weight() {
 	}
 }
 
+void AnimationMixer::_blend_evaluate(double p_delta) {
+	_blend_calc_total_weight();
+	_blend_process(p_delta);
+}
+
+// The compressed tracks that _blend_process() reads, with the same filtering.
+void AnimationMixer::_get_blended_compressed_tracks(const Ref<Animation> &p_animation, real_t p_weight, const Vector<real_t> &p_track_weights, LocalVector<int> &r_tracks) const {
+	r_tracks.clear();
+	for (int i = 0; i < p_animation->get_track_count(); i++) {
+		if (!p_animation->track_is_enabled(i) || p_animation->track_get_compressed_index(i) < 0) {
+			continue;
+		}
+		TrackCache *const *track = track_cache.getptr(p_animation->track_get_type_hash(i));
+		if (!track) {
+			continue;
+		}
+		const int *blend_idx = track_map.getptr((*track)->path);
+		if (!blend_idx || *blend_idx < 0 || *blend_idx >= track_count) {
+			continue;
+		}
+		real_t blend = *blend_idx < p_track_weights.size() ? p_track_weights[*blend_idx] * p_weight : p_weight;
+		if (!deterministic) {
+			if (Math::is_zero_approx((*track)->total_weight)) {
+				continue;
+			}
+			blend = blend / (*track)->total_weight;
+		}
+		if (Math::is_zero_approx(blend)) {
+			continue; // Nothing to blend.
+		}
+		r_tracks.push_back(i);
+	}
+}
+
 void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 	// Apply value/transform/blend/bezier blends to track caches and execute method/audio/animation tracks.
 #ifdef TOOLS_ENABLED
@@ -1112,6 +1269,18 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 #ifndef _3D_DISABLED
 		bool calc_root = !seeked || is_external_seeking;
 #endif // _3D_DISABLED
+#ifndef _3D_DISABLED
+		// Decode the compressed tracks blended below at once, they are read back from the sample.
+		// Tracks filtered out are not decoded, and when only a few are left interpolating them one by one is cheaper.
+		bool use_compressed_sample = false;
+		if (a->is_compressed()) {
+			_get_blended_compressed_tracks(a, weight, track_weights, compressed_sample_tracks);
+			use_compressed_sample = compressed_sample_tracks.size() >= 4;
+			if (use_compressed_sample) {
+				a->sample_compressed_tracks(time, compressed_sample, &compressed_sample_tracks);
+			}
+		}
+#endif // _3D_DISABLED
 
 		for (int i = 0; i < a->get_track_count(); i++) {
 			if (!a->track_is_enabled(i)) {
@@ -1216,7 +1385,8 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 loc;
-						Error err = a->try_position_track_interpolate(i, time, &loc);
+						int compressed_index = use_compressed_sample ? a->track_get_compressed_index(i) : -1;
+						Error err = compressed_index >= 0 ? (compressed_sample.get_vector3(compressed_index, loc) ? OK : ERR_UNAVAILABLE) : a->try_position_track_interpolate(i, time, &loc);
 						if (err != OK) {
 							continue;
 						}
@@ -1303,7 +1473,8 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Quaternion rot;
-						Error err = a->try_rotation_track_interpolate(i, time, &rot);
+						int compressed_index = use_compressed_sample ? a->track_get_compressed_index(i) : -1;
+						Error err = compressed_index >= 0 ? (compressed_sample.get_quaternion(compressed_index, rot) ? OK : ERR_UNAVAILABLE) : a->try_rotation_track_interpolate(i, time, &rot);
 						if (err != OK) {
 							continue;
 						}
@@ -1391,7 +1562,8 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					{
 						Vector3 scale;
-						Error err = a->try_scale_track_interpolate(i, time, &scale);
+						int compressed_index = use_compressed_sample ? a->track_get_compressed_index(i) : -1;
+						Error err = compressed_index >= 0 ? (compressed_sample.get_vector3(compressed_index, scale) ? OK : ERR_UNAVAILABLE) : a->try_scale_track_interpolate(i, time, &scale);
 						if (err != OK) {
 							continue;
 						}
@@ -1407,7 +1579,8 @@ void AnimationMixer::_blend_process(double p_delta, bool p_update_only) {
 					}
 					TrackCacheBlendShape *t = static_cast<TrackCacheBlendShape *>(track);
 					float value;
-					Error err = a->try_blend_shape_track_interpolate(i, time, &value);
+					int compressed_index = use_compressed_sample ? a->track_get_compressed_index(i) : -1;
+					Error err = compressed_index >= 0 ? (compressed_sample.get_float(compressed_index, value) ? OK : ERR_UNAVAILABLE) : a->try_blend_shape_track_interpolate(i, time, &value);
 					//ERR_CONTINUE(err!=OK); //used for testing, should be removed
 					if (err != OK) {
 						continue;
@@ -2144,13 +2317,21 @@ void AnimationMixer::_notification(int p_what) {
 
 		case NOTIFICATION_INTERNAL_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_IDLE) {
-				_process_animation(get_process_delta_time());
+				if (parallel_evaluation) {
+					_process_animation_parallel(get_process_delta_time());
+				} else {
+					_process_animation(get_process_delta_time());
+				}
 			}
 		} break;
 
 		case NOTIFICATION_INTERNAL_PHYSICS_PROCESS: {
 			if (active && callback_mode_process == ANIMATION_CALLBACK_MODE_PROCESS_PHYSICS) {
-				_process_animation(get_physics_process_delta_time());
+				if (parallel_evaluation) {
+					_process_animation_parallel(get_physics_process_delta_time());
+				} else {
+					_process_animation(get_physics_process_delta_time());
+				}
 			}
 		} break;
 
@@ -2214,6 +2395,9 @@ void AnimationMixer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_callback_mode_discrete", "mode"), &AnimationMixer::set_callback_mode_discrete);
 	ClassDB::bind_method(D_METHOD("get_callback_mode_discrete"), &AnimationMixer::get_callback_mode_discrete);
 
+	ClassDB::bind_method(D_METHOD("set_parallel_evaluation", "enabled"), &AnimationMixer::set_parallel_evaluation);
+	ClassDB::bind_method(D_METHOD("is_parallel_evaluation"), &AnimationMixer::is_parallel_evaluation);
+
 	ClassDB::bind_method(D_METHOD("set_audio_max_polyphony", "max_polyphony"), &AnimationMixer::set_audio_max_polyphony);
 	ClassDB::bind_method(D_METHOD("get_audio_max_polyphony"), &AnimationMixer::get_audio_max_polyphony);
 
@@ -2235,6 +2419,7 @@ void AnimationMixer::_bind_methods() {
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "is_active");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deterministic"), "set_deterministic", "is_deterministic");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "parallel_evaluation"), "set_parallel_evaluation", "is_parallel_evaluation");
 
 	/* ---- Reset on save ---- */
 	ClassDB::bind_method(D_METHOD("set_reset_on_save_enabled", "enabled"), &AnimationMixer::set_reset_on_save_enabled);
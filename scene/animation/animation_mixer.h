@@ -312,6 +312,19 @@ protected:
 	HashMap<NodePath, int> track_map;
 	int track_count = 0;
 	bool deterministic = false;
+	Animation::CompressedSample compressed_sample; // Scratch buffers for _blend_process().
+	LocalVector<int> compressed_sample_tracks;
+
+	/* ---- Parallel evaluation ---- */
+	bool parallel_evaluation = false;
+	bool parallel_evaluation_safe = false; // Updated by _update_caches(), false if blending touches anything but the track caches.
+	bool parallel_evaluation_pending = false;
+	bool parallel_evaluation_evaluated = false;
+	bool parallel_evaluation_queued = false;
+	double parallel_evaluation_delta = 0.0;
+	static LocalVector<ObjectID> parallel_batch; // Only touched on the main thread.
+	static void _process_parallel_batch();
+	static void _process_parallel_batch_task(void *p_userdata, uint32_t p_index);
 
 	/* ---- Root motion accumulator for Skeleton3D ---- */
 	NodePath root_motion_track;
@@ -342,6 +355,8 @@ protected:
 
 	/* ---- Blending processor ---- */
 	virtual void _process_animation(double p_delta, bool p_update_only = false);
+	void _process_animation_parallel(double p_delta);
+	void _finish_parallel_evaluation();
 	virtual Variant _post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx = -1);
 	Variant post_process_key_value(const Ref<Animation> &p_anim, int p_track, Variant p_value, ObjectID p_object_id, int p_object_sub_idx = -1);
 	GDVIRTUAL5RC(Variant, _post_process_key_value, Ref<Animation>, int, Variant, ObjectID, int);
@@ -351,6 +366,8 @@ protected:
 	virtual void _blend_capture(double p_delta);
 	void _blend_calc_total_weight(); // For undeterministic blending.
 	void _blend_process(double p_delta, bool p_update_only = false);
+	void _get_blended_compressed_tracks(const Ref<Animation> &p_animation, real_t p_weight, const Vector<real_t> &p_track_weights, LocalVector<int> &r_tracks) const;
+	void _blend_evaluate(double p_delta); // Weight and process, only touches the track caches.
 	void _blend_apply();
 	virtual void _blend_post_process();
 	void _call_object(ObjectID p_object_id, const StringName &p_method, const Vector<Variant> &p_params, bool p_deferred);
@@ -419,6 +436,9 @@ public:
 	void set_callback_mode_discrete(AnimationCallbackModeDiscrete p_mode);
 	AnimationCallbackModeDiscrete get_callback_mode_discrete() const;
 
+	void set_parallel_evaluation(bool p_enabled);
+	bool is_parallel_evaluation() const;
+
 	void set_audio_max_polyphony(int p_audio_max_polyphony);
 	int get_audio_max_polyphony() const;
 
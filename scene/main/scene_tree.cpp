@@ -181,6 +181,12 @@ void SceneTree::make_group_changed(const StringName &p_group) {
 void SceneTree::flush_transform_notifications() {
 	_THREAD_SAFE_METHOD_
 
+	// Only the main thread batches, the batch isn't guarded.
+	bool batch_instance_transforms = Thread::is_main_thread();
+	if (batch_instance_transforms) {
+		flushing_transform_notifications = true;
+	}
+
 	SelfList<Node> *n = xform_change_list.first();
 	while (n) {
 		Node *node = n->self();
@@ -189,6 +195,56 @@ void SceneTree::flush_transform_notifications() {
 		n = nx;
 		node->notification(NOTIFICATION_TRANSFORM_CHANGED);
 	}
+
+	if (batch_instance_transforms) {
+		flushing_transform_notifications = false;
+		_flush_instance_transforms();
+	}
+}
+
+bool SceneTree::_queue_instance_transform(RID p_instance, const Transform3D &p_transform) {
+#ifdef REAL_T_IS_DOUBLE
+	// The batch is single precision, send the transform on its own to keep its precision.
+	return false;
+#else
+	if (!flushing_transform_notifications || !Thread::is_main_thread()) {
+		return false;
+	}
+
+	instance_transform_ids.push_back(p_instance.get_id());
+
+	// Same layout as multimesh buffers.
+	uint32_t from = instance_transform_data.size();
+	instance_transform_data.resize(from + 12);
+	float *data = &instance_transform_data[from];
+	for (int i = 0; i < 3; i++) {
+		data[i * 4 + 0] = p_transform.basis.rows[i][0];
+		data[i * 4 + 1] = p_transform.basis.rows[i][1];
+		data[i * 4 + 2] = p_transform.basis.rows[i][2];
+		data[i * 4 + 3] = p_transform.origin[i];
+	}
+
+	return true;
+#endif
+}
+
+void SceneTree::_flush_instance_transforms() {
+	if (instance_transform_ids.is_empty()) {
+		return;
+	}
+
+	PackedInt64Array ids;
+	ids.resize(instance_transform_ids.size());
+	memcpy(ids.ptrw(), instance_transform_ids.ptr(), instance_transform_ids.size() * sizeof(int64_t));
+
+	PackedFloat32Array data;
+	data.resize(instance_transform_data.size());
+	memcpy(data.ptrw(), instance_transform_data.ptr(), instance_transform_data.size() * sizeof(float));
+
+	RS::get_singleton()->instances_set_transforms(ids, data);
+
+	instance_transform_ids.clear();
+	instance_transform_data.clear();
 }
 
 void SceneTree::_flush_ugc() {
@@ -1725,6 +1781,8 @@ SceneTree::SceneTree() {
 
 	GLOBAL_DEF("debug/shapes/collision/draw_2d_outlines", true);
 
+	SceneState::set_threaded_instantiation(GLOBAL_DEF("application/run/threaded_scene_instantiation", false));
+
 	process_group_call_queue_allocator = memnew(CallQueue::Allocator(64));
 	Math::randomize();
 
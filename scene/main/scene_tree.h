@@ -232,9 +232,19 @@ private:
 	friend class CanvasItem;
 	friend class Node3D;
 	friend class Viewport;
+	friend class VisualInstance3D;
 
 	SelfList<Node>::List xform_change_list;
 
+	// Instance transforms changed while flushing transform notifications,
+	// sent to the RenderingServer in one call once the flush is done.
+	bool flushing_transform_notifications = false;
+	LocalVector<int64_t> instance_transform_ids;
+	LocalVector<float> instance_transform_data;
+
+	bool _queue_instance_transform(RID p_instance, const Transform3D &p_transform);
+	void _flush_instance_transforms();
+
 #ifdef DEBUG_ENABLED // No live editor in release build.
 	friend class LiveEditor;
 #endif
@@ -33,6 +33,7 @@
 
 #include "core/io/marshalls.h"
 #include "core/math/geometry_3d.h"
+#include "core/math/packed_array_math.h"
 #include "scene/scene_string_names.h"
 
 bool Animation::_set(const StringName &p_name, const Variant &p_value) {
@@ -2151,6 +2152,29 @@ real_t Animation::track_get_key_transition(int p_track, int p_key_idx) const {
 	ERR_FAIL_V(0);
 }
 
+int Animation::track_get_compressed_index(int p_track) const {
+	ERR_FAIL_INDEX_V(p_track, tracks.size(), -1);
+	Track *t = tracks[p_track];
+
+	switch (t->type) {
+		case TYPE_POSITION_3D: {
+			return static_cast<PositionTrack *>(t)->compressed_track;
+		} break;
+		case TYPE_ROTATION_3D: {
+			return static_cast<RotationTrack *>(t)->compressed_track;
+		} break;
+		case TYPE_SCALE_3D: {
+			return static_cast<ScaleTrack *>(t)->compressed_track;
+		} break;
+		case TYPE_BLEND_SHAPE: {
+			return static_cast<BlendShapeTrack *>(t)->compressed_track;
+		} break;
+		default: {
+			return -1;
+		}
+	}
+}
+
 bool Animation::track_is_compressed(int p_track) const {
 	ERR_FAIL_INDEX_V(p_track, tracks.size(), false);
 	Track *t = tracks[p_track];
@@ -5104,12 +5128,14 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 	ERR_FAIL_COND_V(!compression.enabled, false);
 	ERR_FAIL_UNSIGNED_INDEX_V(p_compressed_track, compression.bounds.size(), false);
 	p_time = CLAMP(p_time, 0, length);
-	if (key_index) {
-		*key_index = 0;
-	}
 
-	double frame_to_sec = 1.0 / double(compression.fps);
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
 
+	return _fetch_compressed_in_page<COMPONENTS>(p_compressed_track, page_index, p_time, r_current_value, r_current_time, r_next_value, r_next_time, key_index);
+}
+
+int32_t Animation::_find_compressed_page(double p_time) const {
 	int32_t page_index = -1;
 	for (uint32_t i = 0; i < compression.pages.size(); i++) {
 		if (compression.pages[i].time_offset > p_time) {
@@ -5117,8 +5143,17 @@ bool Animation::_fetch_compressed(uint32_t p_compressed_track, double p_time, Ve
 		}
 		page_index = i;
 	}
+	return page_index;
+}
 
-	ERR_FAIL_COND_V(page_index == -1, false); //should not happen
+template <uint32_t COMPONENTS>
+bool Animation::_fetch_compressed_in_page(uint32_t p_compressed_track, int32_t p_page_index, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index) const {
+	if (key_index) {
+		*key_index = 0;
+	}
+
+	double frame_to_sec = 1.0 / double(compression.fps);
+	int32_t page_index = p_page_index;
 
 	double page_base_time = compression.pages[page_index].time_offset;
 	const uint8_t *page_data = compression.pages[page_index].data.ptr();
@@ -5362,6 +5397,118 @@ float Animation::_uncompress_blend_shape(const Vector3i &p_value) const {
 	return (bsn * 2.0 - 1.0) * float(Compression::BLEND_SHAPE_RANGE);
 }
 
+bool Animation::is_compressed() const {
+	return compression.enabled;
+}
+
+void Animation::sample_compressed_tracks(double p_time, CompressedSample &r_sample, const LocalVector<int> *p_tracks) const {
+	const uint32_t count = compression.enabled ? compression.bounds.size() : 0;
+	r_sample.x.resize(count);
+	r_sample.y.resize(count);
+	r_sample.z.resize(count);
+	r_sample.w.resize(count);
+	r_sample.valid.resize(count);
+	r_sample.lane_index.clear();
+	r_sample.lane_weight.clear();
+	for (int j = 0; j < 3; j++) {
+		r_sample.lane_from[j].clear();
+		r_sample.lane_to[j].clear();
+		r_sample.lane_position[j].clear();
+		r_sample.lane_size[j].clear();
+	}
+	if (count == 0) {
+		return;
+	}
+	memset(r_sample.valid.ptr(), 0, count);
+
+	p_time = CLAMP(p_time, 0, length);
+	// Pages cover all compressed tracks, so look the page up once rather than once per track.
+	int32_t page_index = _find_compressed_page(p_time);
+	ERR_FAIL_COND(page_index == -1); //should not happen
+
+	Vector3i current;
+	Vector3i next;
+	double time_current;
+	double time_next;
+
+	const uint32_t track_count = p_tracks ? p_tracks->size() : uint32_t(tracks.size());
+	for (uint32_t k = 0; k < track_count; k++) {
+		const int i = p_tracks ? (*p_tracks)[k] : int(k);
+		ERR_CONTINUE(i < 0 || i >= tracks.size());
+		const Track *t = tracks[i];
+		int32_t compressed_track = track_get_compressed_index(i);
+		if (compressed_track < 0) {
+			continue;
+		}
+
+		bool fetched = t->type == TYPE_BLEND_SHAPE
+				? _fetch_compressed_in_page<1>(compressed_track, page_index, p_time, current, time_current, next, time_next)
+				: _fetch_compressed_in_page<3>(compressed_track, page_index, p_time, current, time_current, next, time_next);
+		if (!fetched) {
+			continue;
+		}
+
+		// Same key selection as the _*_interpolate_compressed() functions, a weight of zero returns the current key as is.
+		double c = 0.0;
+		if (time_current >= p_time || time_current == time_next) {
+			next = current;
+		} else if (p_time >= time_next) {
+			current = next;
+		} else {
+			c = (p_time - time_current) / (time_next - time_current);
+		}
+
+		switch (t->type) {
+			case TYPE_ROTATION_3D: {
+				// Octahedral decoding and slerp don't vectorize well, keep them per track.
+				Quaternion rotation = _uncompress_quaternion(current);
+				if (c != 0.0) {
+					rotation = rotation.slerp(_uncompress_quaternion(next), c);
+				}
+				r_sample.x[compressed_track] = rotation.x;
+				r_sample.y[compressed_track] = rotation.y;
+				r_sample.z[compressed_track] = rotation.z;
+				r_sample.w[compressed_track] = rotation.w;
+				r_sample.valid[compressed_track] = 1;
+			} break;
+			case TYPE_BLEND_SHAPE: {
+				float value = _uncompress_blend_shape(current);
+				if (c != 0.0) {
+					value = Math::lerp(value, _uncompress_blend_shape(next), float(c));
+				}
+				r_sample.x[compressed_track] = value;
+				r_sample.valid[compressed_track] = 1;
+			} break;
+			default: {
+				const AABB &bounds = compression.bounds[compressed_track];
+				r_sample.lane_index.push_back(compressed_track);
+				r_sample.lane_weight.push_back(float(c));
+				for (int j = 0; j < 3; j++) {
+					r_sample.lane_from[j].push_back(current[j]);
+					r_sample.lane_to[j].push_back(next[j]);
+					r_sample.lane_position[j].push_back(float(bounds.position[j]));
+					r_sample.lane_size[j].push_back(float(bounds.size[j]));
+				}
+			} break;
+		}
+	}
+
+	// Position and scale are dequantized and interpolated together, one component of all the tracks at a time.
+	const uint32_t lane_count = r_sample.lane_index.size();
+	for (int j = 0; j < 3; j++) {
+		r_sample.lane_result[j].resize(lane_count);
+		PackedArrayMath::dequantize_lerp(r_sample.lane_from[j].ptr(), r_sample.lane_to[j].ptr(), r_sample.lane_weight.ptr(), r_sample.lane_position[j].ptr(), r_sample.lane_size[j].ptr(), r_sample.lane_result[j].ptr(), lane_count);
+	}
+
+	for (uint32_t i = 0; i < lane_count; i++) {
+		const uint32_t compressed_track = r_sample.lane_index[i];
+		r_sample.x[compressed_track] = r_sample.lane_result[0][i];
+		r_sample.y[compressed_track] = r_sample.lane_result[1][i];
+		r_sample.z[compressed_track] = r_sample.lane_result[2][i];
+		r_sample.valid[compressed_track] = 1;
+	}
+}
+
 template <uint32_t COMPONENTS>
 bool Animation::_fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const {
 	ERR_FAIL_COND_V(!compression.enabled, false);
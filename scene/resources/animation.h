@@ -343,6 +343,9 @@ private:
 	bool _blend_shape_interpolate_compressed(uint32_t p_compressed_track, double p_time, float &r_ret) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed(uint32_t p_compressed_track, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
+	int32_t _find_compressed_page(double p_time) const;
+	template <uint32_t COMPONENTS>
+	bool _fetch_compressed_in_page(uint32_t p_compressed_track, int32_t p_page_index, double p_time, Vector3i &r_current_value, double &r_current_time, Vector3i &r_next_value, double &r_next_time, uint32_t *key_index = nullptr) const;
 	template <uint32_t COMPONENTS>
 	bool _fetch_compressed_by_index(uint32_t p_compressed_track, int p_index, Vector3i &r_value, double &r_time) const;
 	int _get_compressed_key_count(uint32_t p_compressed_track) const;
@@ -422,6 +425,7 @@ public:
 	double track_get_key_time(int p_track, int p_key_idx) const;
 	real_t track_get_key_transition(int p_track, int p_key_idx) const;
 	bool track_is_compressed(int p_track) const;
+	int track_get_compressed_index(int p_track) const;
 
 	int position_track_insert_key(int p_track, double p_time, const Vector3 &p_position);
 	Error position_track_get_key(int p_track, int p_key, Vector3 *r_position) const;
@@ -502,6 +506,53 @@ public:
 	void optimize(real_t p_allowed_velocity_err = 0.01, real_t p_allowed_angular_err = 0.01, int p_precision = 3);
 	void compress(uint32_t p_page_size = 8192, uint32_t p_fps = 120, float p_split_tolerance = 4.0); // 4.0 seems to be the split tolerance sweet spot from many tests.
 
+	// Values of every compressed track at a given time, as structure of arrays indexed by track_get_compressed_index().
+	// Position and scale use x, y and z, rotation x, y, z and w, blend shape x.
+	struct CompressedSample {
+		LocalVector<real_t> x;
+		LocalVector<real_t> y;
+		LocalVector<real_t> z;
+		LocalVector<real_t> w;
+		LocalVector<uint8_t> valid;
+
+		// Position and scale keys dequantized and interpolated together, one lane per track.
+		// Single precision, the keys are only quantized to 16 bits.
+		LocalVector<uint32_t> lane_index;
+		LocalVector<uint16_t> lane_from[3];
+		LocalVector<uint16_t> lane_to[3];
+		LocalVector<float> lane_weight;
+		LocalVector<float> lane_position[3];
+		LocalVector<float> lane_size[3];
+		LocalVector<float> lane_result[3];
+
+		_FORCE_INLINE_ bool get_vector3(int p_index, Vector3 &r_value) const {
+			if (!valid[p_index]) {
+				return false;
+			}
+			r_value = Vector3(x[p_index], y[p_index], z[p_index]);
+			return true;
+		}
+		_FORCE_INLINE_ bool get_quaternion(int p_index, Quaternion &r_value) const {
+			if (!valid[p_index]) {
+				return false;
+			}
+			r_value = Quaternion(x[p_index], y[p_index], z[p_index], w[p_index]);
+			return true;
+		}
+		_FORCE_INLINE_ bool get_float(int p_index, float &r_value) const {
+			if (!valid[p_index]) {
+				return false;
+			}
+			r_value = x[p_index];
+			return true;
+		}
+	};
+
+	bool is_compressed() const;
+	// Decodes compressed tracks with a single page lookup, faster than interpolating them one by one.
+	// If p_tracks is given, only those tracks are decoded and the others are left invalid in the sample.
+	void sample_compressed_tracks(double p_time, CompressedSample &r_sample, const LocalVector<int> *p_tracks = nullptr) const;
+
 	// Helper functions for Variant.
 	static bool is_variant_interpolatable(const Variant p_value);
 
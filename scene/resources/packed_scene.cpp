@@ -35,6 +35,7 @@
 #include "core/core_string_names.h"
 #include "core/io/missing_resource.h"
 #include "core/io/resource_loader.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/templates/local_vector.h"
 #include "scene/2d/node_2d.h"
 #include "scene/3d/node_3d.h"
@@ -42,9 +43,14 @@
 #include "scene/main/instance_placeholder.h"
 #include "scene/main/missing_node.h"
 #include "scene/property_utils.h"
+#include "servers/rendering_server.h"
 
 #define PACKED_SCENE_VERSION 3
 
+// Threaded instantiation is only worth it for large scenes.
+#define THREADED_INSTANTIATION_MIN_NODES 1024
+#define THREADED_INSTANTIATION_MIN_BATCH_NODES 64
+
 #ifdef TOOLS_ENABLED
 SceneState::InstantiationWarningNotify SceneState::instantiation_warn_notify = nullptr;
 #endif
@@ -164,9 +170,31 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 	LocalVector<DeferredNodePathProperties> deferred_node_paths;
 
+	ThreadedInstantiation threaded;
+	bool use_threads = threaded_instantiation && p_edit_state == GEN_EDIT_STATE_DISABLED && _plan_threaded_instantiation(threaded);
+
+	if (use_threads) {
+		memset(ret_nodes, 0, sizeof(Node *) * nc);
+		threaded.nodes = ret_nodes;
+
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &SceneState::_instantiate_batch_threaded, &threaded, threaded.batches.size(), -1, true, SNAME("SceneStateInstantiate"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+		// Without a separate render thread, the RenderingServer calls made by worker threads are queued
+		// for this (main) thread, while its own calls run immediately. Flush them before touching the nodes.
+		if (OS::get_singleton()->get_render_thread_mode() != OS::RENDER_SEPARATE_THREAD && RenderingServer::get_singleton()) {
+			RenderingServer::get_singleton()->sync();
+		}
+		threaded_instantiation_count.increment();
+	}
+
 	for (int i = 0; i < nc; i++) {
 		const NodeData &n = nd[i];
 
+		// Set if the node, its non-deferred properties and its subtree were already built by a worker thread.
+		bool prebuilt = use_threads && ret_nodes[i] != nullptr;
+		int first_property = prebuilt ? threaded.first_deferred_property[i] : 0;
+
 		Node *parent = nullptr;
 		String old_parent_path;
 
@@ -190,7 +218,9 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 		Node *node = nullptr;
 		MissingNode *missing_node = nullptr;
 
-		if (i == 0 && base_scene_idx >= 0) {
+		if (prebuilt) {
+			node = ret_nodes[i];
+		} else if (i == 0 && base_scene_idx >= 0) {
 			// Scene inheritance on root node.
 			Ref<PackedScene> sdata = props[base_scene_idx];
 			ERR_FAIL_COND_V(!sdata.is_valid(), nullptr);
@@ -300,13 +330,13 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 
 			//properties
 			int nprop_count = n.properties.size();
-			if (nprop_count) {
+			if (nprop_count > first_property) {
 				const NodeData::Property *nprops = &n.properties[0];
 
 				Dictionary missing_resource_properties;
 				HashMap<Ref<Resource>, Ref<Resource>> resources_local_to_sub_scene; // Record the mappings in the sub-scene.
 
-				for (int j = 0; j < nprop_count; j++) {
+				for (int j = first_property; j < nprop_count; j++) {
 					bool valid;
 
 					ERR_FAIL_INDEX_V(nprops[j].value, prop_count, nullptr);
@@ -418,12 +448,16 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 			//name
 
 			//groups
-			for (int j = 0; j < n.groups.size(); j++) {
-				ERR_FAIL_INDEX_V(n.groups[j], sname_count, nullptr);
-				node->add_to_group(snames[n.groups[j]], true);
+			if (!prebuilt || first_property < nprop_count) {
+				// Worker threads only add groups when no property was left for this thread.
+				for (int j = 0; j < n.groups.size(); j++) {
+					ERR_FAIL_INDEX_V(n.groups[j], sname_count, nullptr);
+					node->add_to_group(snames[n.groups[j]], true);
+				}
 			}
 
-			if (n.instance >= 0 || n.type != TYPE_INSTANTIATED || i == 0) {
+			// Worker threads already parented every prebuilt node except the children of the root.
+			if ((n.instance >= 0 || n.type != TYPE_INSTANTIATED || i == 0) && (!prebuilt || n.parent == 0)) {
 				//if node was not part of instance, must set its name, parenthood and ownership
 				if (i > 0) {
 					if (parent) {
@@ -589,6 +623,215 @@ Node *SceneState::instantiate(GenEditState p_edit_state) const {
 	return ret_nodes[0];
 }
 
+bool SceneState::_is_type_thread_safe_to_instantiate(const StringName &p_type) {
+	// Only built-in classes are considered, extensions may do anything in their constructors.
+	if (ClassDB::get_api_type(p_type) != ClassDB::API_CORE) {
+		return false;
+	}
+
+	// Built-in nodes only call the RenderingServer and NavigationServers while being created and set up
+	// outside of the tree. Both accept calls from any thread: RenderingServer calls are queued and navigation
+	// resources are created under a mutex. These nodes also use servers that don't, such as the PhysicsServers,
+	// or create viewports and worlds, so they are always created by the calling thread.
+	static const char *const unsafe_types[] = {
+		"Camera3D",
+		"CollisionObject2D",
+		"CollisionObject3D",
+		"CSGShape3D",
+		"GridMap",
+		"Joint2D",
+		"Joint3D",
+		"SoftBody3D",
+		"TileMap",
+		"TileMapLayer",
+		"Viewport",
+	};
+	for (const char *unsafe_type : unsafe_types) {
+		if (ClassDB::is_parent_class(p_type, unsafe_type)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SceneState::_plan_threaded_instantiation(ThreadedInstantiation &r_threaded) const {
+	int nc = nodes.size();
+	if (nc < THREADED_INSTANTIATION_MIN_NODES || Engine::get_singleton()->is_editor_hint() || !Thread::is_main_thread()) {
+		return false;
+	}
+
+	WorkerThreadPool *wtp = WorkerThreadPool::get_singleton();
+	if (!wtp || wtp->get_thread_count() < 2) {
+		return false;
+	}
+
+	const StringName *snames = names.ptr();
+	int sname_count = names.size();
+	const Variant *props = variants.ptr();
+	int prop_count = variants.size();
+	const NodeData *nd = nodes.ptr();
+
+	r_threaded.first_deferred_property.resize(nc);
+
+	// Whether a type can be created on a worker thread, cached per name index.
+	HashMap<int, bool> type_cache;
+	const StringName node_class = SNAME("Node");
+
+	// Nodes are stored in tree order, so the subtree of a child of the root is the contiguous range of nodes
+	// whose parents are inside it. Such a subtree is only eligible if all its nodes are plain nodes, as instances
+	// and nodes coming from inherited or instantiated scenes need the rest of the tree to be resolved.
+	auto is_node_eligible = [&](int p_idx) -> bool {
+		const NodeData &n = nd[p_idx];
+		if (n.type == TYPE_INSTANTIATED || n.instance >= 0 || n.type < 0 || n.type >= sname_count || n.name < 0 || n.name >= sname_count) {
+			return false;
+		}
+
+		bool *cached = type_cache.getptr(n.type);
+		if (!cached) {
+			const StringName &type = snames[n.type];
+			cached = &type_cache.insert(n.type, ClassDB::can_instantiate(type) && ClassDB::is_parent_class(type, node_class) && _is_type_thread_safe_to_instantiate(type))->value;
+		}
+		if (!*cached) {
+			return false;
+		}
+
+		for (int j = 0; j < n.groups.size(); j++) {
+			if (n.groups[j] < 0 || n.groups[j] >= sname_count) {
+				return false;
+			}
+		}
+
+		int nprop_count = n.properties.size();
+		int first_deferred = nprop_count;
+		for (int j = 0; j < nprop_count; j++) {
+			const NodeData::Property &prop = n.properties[j];
+			if ((prop.name & FLAG_PATH_PROPERTY_IS_NODE) || prop.name < 0 || prop.name >= sname_count || prop.value < 0 || prop.value >= prop_count || snames[prop.name] == CoreStringNames::get_singleton()->_script) {
+				first_deferred = j;
+				break;
+			}
+			Variant::Type type = props[prop.value].get_type();
+			if (type == Variant::OBJECT || type == Variant::ARRAY || type == Variant::DICTIONARY) {
+				first_deferred = j;
+				break;
+			}
+		}
+		r_threaded.first_deferred_property[p_idx] = first_deferred;
+		return true;
+	};
+
+	LocalVector<ThreadedInstantiation::Batch> subtrees;
+	int eligible_nodes = 0;
+
+	int i = 1;
+	while (i < nc) {
+		if (nd[i].parent != 0 || !is_node_eligible(i)) {
+			i++;
+			continue;
+		}
+
+		int end = i + 1;
+		bool eligible = true;
+		while (end < nc) {
+			int parent = nd[end].parent;
+			if ((parent & FLAG_ID_IS_PATH) || parent < i || parent >= end) {
+				break; // Not part of this subtree.
+			}
+			if (!is_node_eligible(end)) {
+				eligible = false;
+				break;
+			}
+			end++;
+		}
+
+		if (eligible) {
+			ThreadedInstantiation::Batch subtree;
+			subtree.from = i;
+			subtree.to = end;
+			subtrees.push_back(subtree);
+			eligible_nodes += end - i;
+			i = end;
+		} else {
+			i++;
+		}
+	}
+
+	if (eligible_nodes < THREADED_INSTANTIATION_MIN_NODES) {
+		return false;
+	}
+
+	// Merge consecutive subtrees into batches, so each worker gets a reasonable amount of nodes.
+	int batch_nodes = MAX(THREADED_INSTANTIATION_MIN_BATCH_NODES, eligible_nodes / (wtp->get_thread_count() * 4));
+	for (const ThreadedInstantiation::Batch &subtree : subtrees) {
+		if (!r_threaded.batches.is_empty()) {
+			ThreadedInstantiation::Batch &last = r_threaded.batches[r_threaded.batches.size() - 1];
+			if (last.to == subtree.from && last.to - last.from < batch_nodes) {
+				last.to = subtree.to;
+				continue;
+			}
+		}
+		r_threaded.batches.push_back(subtree);
+	}
+
+	return r_threaded.batches.size() > 1;
+}
+
+void SceneState::_instantiate_batch_threaded(uint32_t p_index, ThreadedInstantiation *p_threaded) const {
+	ThreadedInstantiation::Batch &batch = p_threaded->batches[p_index];
+	const StringName *snames = names.ptr();
+	const Variant *props = variants.ptr();
+	const NodeData *nd = nodes.ptr();
+	Node **ret_nodes = p_threaded->nodes;
+
+	for (int i = batch.from; i < batch.to; i++) {
+		const NodeData &n = nd[i];
+
+		Object *obj = ClassDB::instantiate(snames[n.type]);
+		Node *node = Object::cast_to<Node>(obj);
+		if (!node) {
+			if (obj) {
+				memdelete(obj);
+			}
+			batch.failed = true;
+			break;
+		}
+
+		int first_deferred = p_threaded->first_deferred_property[i];
+		const NodeData::Property *nprops = n.properties.ptr();
+		for (int j = 0; j < first_deferred; j++) {
+			node->set(snames[nprops[j].name], props[nprops[j].value]);
+		}
+
+		if (first_deferred == n.properties.size()) {
+			for (int j = 0; j < n.groups.size(); j++) {
+				node->add_to_group(snames[n.groups[j]], true);
+			}
+		}
+
+		// Children of the root are added by the calling thread, to keep the sibling order of the scene.
+		if (n.parent != 0) {
+			Node *parent = ret_nodes[n.parent];
+			parent->_add_child_nocheck(node, snames[n.name]);
+			if (n.index >= 0 && n.index < parent->get_child_count() - 1) {
+				parent->move_child(node, n.index);
+			}
+		}
+
+		ret_nodes[i] = node;
+	}
+
+	if (batch.failed) {
+		// Let the calling thread instantiate this batch as usual, which also takes care of reporting the error.
+		for (int i = batch.from; i < batch.to; i++) {
+			if (ret_nodes[i] && nd[i].parent == 0) {
+				memdelete(ret_nodes[i]);
+			}
+		}
+		for (int i = batch.from; i < batch.to; i++) {
+			ret_nodes[i] = nullptr;
+		}
+	}
+}
+
 Variant SceneState::make_local_resource(Variant &p_value, const SceneState::NodeData &p_node_data, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_sub_scene, Node *p_node, const StringName p_sname, HashMap<Ref<Resource>, Ref<Resource>> &p_resources_local_to_scene, int p_i, Node **p_ret_nodes, SceneState::GenEditState p_edit_state) const {
 	Ref<Resource> res = p_value;
 	if (res.is_null() || !res->is_local_to_scene()) {
@@ -1365,6 +1608,21 @@ void SceneState::set_disable_placeholders(bool p_disable) {
 	disable_placeholders = p_disable;
 }
 
+bool SceneState::threaded_instantiation = false;
+SafeNumeric<uint64_t> SceneState::threaded_instantiation_count;
+
+void SceneState::set_threaded_instantiation(bool p_enable) {
+	threaded_instantiation = p_enable;
+}
+
+bool SceneState::is_threaded_instantiation_enabled() {
+	return threaded_instantiation;
+}
+
+uint64_t SceneState::get_threaded_instantiation_count() {
+	return threaded_instantiation_count.get();
+}
+
 bool SceneState::is_connection(int p_node, const StringName &p_signal, int p_to_node, const StringName &p_to_method) const {
 	ERR_FAIL_COND_V(p_node < 0, false);
 	ERR_FAIL_COND_V(p_to_node < 0, false);
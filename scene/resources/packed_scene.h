@@ -32,6 +32,7 @@
 #define PACKED_SCENE_H
 
 #include "core/io/resource.h"
+#include "core/templates/local_vector.h"
 #include "scene/main/node.h"
 
 class SceneState : public RefCounted {
@@ -97,6 +98,29 @@ class SceneState : public RefCounted {
 	uint64_t last_modified_time = 0;
 
 	static bool disable_placeholders;
+	static bool threaded_instantiation;
+	static SafeNumeric<uint64_t> threaded_instantiation_count;
+
+	// Subtrees of the root node that can be built off-tree on worker threads
+	// and stitched into the scene by the thread calling instantiate().
+	struct ThreadedInstantiation {
+		struct Batch {
+			int from = 0; // First node of the batch, always a child of the root node.
+			int to = 0; // One past the last node of the batch.
+			bool failed = false;
+		};
+
+		LocalVector<Batch> batches;
+		// Per node, index of the first property that must be set on the calling thread.
+		// Resources, scripts and containers (which may reference objects shared with other
+		// subtrees) are never assigned from worker threads.
+		LocalVector<int> first_deferred_property;
+		Node **nodes = nullptr;
+	};
+
+	static bool _is_type_thread_safe_to_instantiate(const StringName &p_type);
+	bool _plan_threaded_instantiation(ThreadedInstantiation &r_threaded) const;
+	void _instantiate_batch_threaded(uint32_t p_index, ThreadedInstantiation *p_threaded) const;
 
 	Vector<String> _get_node_groups(int p_idx) const;
 
@@ -136,6 +160,10 @@ public:
 	};
 
 	static void set_disable_placeholders(bool p_disable);
+	static void set_threaded_instantiation(bool p_enable);
+	static bool is_threaded_instantiation_enabled();
+	// Number of instantiations that built part of the scene on worker threads.
+	static uint64_t get_threaded_instantiation_count();
 	static Ref<Resource> get_remap_resource(const Ref<Resource> &p_resource, HashMap<Ref<Resource>, Ref<Resource>> &remap_cache, const Ref<Resource> &p_fallback, Node *p_for_scene);
 
 	int find_node_by_path(const NodePath &p_node) const;
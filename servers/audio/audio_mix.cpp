@@ -0,0 +1,285 @@
+/**************************************************************************/
+/*  audio_mix.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "audio_mix.h"
+
+#include "core/math/simd.h"
+
+static_assert(sizeof(AudioFrame) == 2 * sizeof(float), "AudioFrame must be made of two packed floats.");
+
+template <bool t_accumulate>
+static _FORCE_INLINE_ void _ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol_start, const AudioFrame &p_vol_final, uint32_t p_frames) {
+	uint32_t frame_idx = 0;
+
+#if defined(SIMD_SSE2)
+	// Two frames per vector: left, right, left, right.
+	const __m128 vol_start = _mm_setr_ps(p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right);
+	const __m128 vol_final = _mm_setr_ps(p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 two = _mm_set1_ps(2.0f);
+	const __m128 frames = _mm_set1_ps((float)p_frames);
+	__m128 index = _mm_setr_ps(0.0f, 0.0f, 1.0f, 1.0f);
+
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		__m128 lerp_param = _mm_div_ps(index, frames);
+		__m128 vol = _mm_add_ps(_mm_mul_ps(vol_final, lerp_param), _mm_mul_ps(_mm_sub_ps(one, lerp_param), vol_start));
+		__m128 mixed = _mm_mul_ps(vol, _mm_loadu_ps(&p_src[frame_idx].left));
+		if (t_accumulate) {
+			mixed = _mm_add_ps(_mm_loadu_ps(&p_dst[frame_idx].left), mixed);
+		}
+		_mm_storeu_ps(&p_dst[frame_idx].left, mixed);
+		index = _mm_add_ps(index, two);
+	}
+#elif defined(SIMD_NEON)
+	const float32x4_t vol_start = { p_vol_start.left, p_vol_start.right, p_vol_start.left, p_vol_start.right };
+	const float32x4_t vol_final = { p_vol_final.left, p_vol_final.right, p_vol_final.left, p_vol_final.right };
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t two = vdupq_n_f32(2.0f);
+	const float32x4_t frames = vdupq_n_f32((float)p_frames);
+	float32x4_t index = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float32x4_t lerp_param = vdivq_f32(index, frames);
+		float32x4_t vol = vaddq_f32(vmulq_f32(vol_final, lerp_param), vmulq_f32(vsubq_f32(one, lerp_param), vol_start));
+		float32x4_t mixed = vmulq_f32(vol, vld1q_f32(&p_src[frame_idx].left));
+		if (t_accumulate) {
+			mixed = vaddq_f32(vld1q_f32(&p_dst[frame_idx].left), mixed);
+		}
+		vst1q_f32(&p_dst[frame_idx].left, mixed);
+		index = vaddq_f32(index, two);
+	}
+#endif
+
+	for (; frame_idx < p_frames; frame_idx++) {
+		// Make this buffer size invariant if buffer_size ever becomes a project setting.
+		float lerp_param = (float)frame_idx / p_frames;
+		AudioFrame mixed = (p_vol_final * lerp_param + (1 - lerp_param) * p_vol_start) * p_src[frame_idx];
+		if (t_accumulate) {
+			p_dst[frame_idx] += mixed;
+		} else {
+			p_dst[frame_idx] = mixed;
+		}
+	}
+}
+
+void AudioMix::mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol_start, const AudioFrame &p_vol_final, uint32_t p_frames) {
+	_ramp<true>(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+void AudioMix::ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol_start, const AudioFrame &p_vol_final, uint32_t p_frames) {
+	_ramp<false>(p_dst, p_src, p_vol_start, p_vol_final, p_frames);
+}
+
+void AudioMix::accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames) {
+	uint32_t frame_idx = 0;
+
+#if defined(SIMD_SSE2)
+	for (; frame_idx + 4 <= p_frames; frame_idx += 4) {
+		__m128 a = _mm_add_ps(_mm_loadu_ps(&p_dst[frame_idx].left), _mm_loadu_ps(&p_src[frame_idx].left));
+		__m128 b = _mm_add_ps(_mm_loadu_ps(&p_dst[frame_idx + 2].left), _mm_loadu_ps(&p_src[frame_idx + 2].left));
+		_mm_storeu_ps(&p_dst[frame_idx].left, a);
+		_mm_storeu_ps(&p_dst[frame_idx + 2].left, b);
+	}
+#elif defined(SIMD_NEON)
+	for (; frame_idx + 4 <= p_frames; frame_idx += 4) {
+		float32x4_t a = vaddq_f32(vld1q_f32(&p_dst[frame_idx].left), vld1q_f32(&p_src[frame_idx].left));
+		float32x4_t b = vaddq_f32(vld1q_f32(&p_dst[frame_idx + 2].left), vld1q_f32(&p_src[frame_idx + 2].left));
+		vst1q_f32(&p_dst[frame_idx].left, a);
+		vst1q_f32(&p_dst[frame_idx + 2].left, b);
+	}
+#endif
+
+	for (; frame_idx < p_frames; frame_idx++) {
+		p_dst[frame_idx] += p_src[frame_idx];
+	}
+}
+
+AudioFrame AudioMix::scale_and_peak(AudioFrame *p_buf, float p_volume, uint32_t p_frames) {
+	AudioFrame peak = AudioFrame(0, 0);
+	uint32_t frame_idx = 0;
+
+#if defined(SIMD_SSE2)
+	const __m128 volume = _mm_set1_ps(p_volume);
+	const __m128 sign_mask = _mm_set1_ps(-0.0f);
+	__m128 peak_vec = _mm_setzero_ps();
+
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		__m128 v = _mm_mul_ps(_mm_loadu_ps(&p_buf[frame_idx].left), volume);
+		_mm_storeu_ps(&p_buf[frame_idx].left, v);
+		// With this operand order a NaN sample keeps the previous peak, like the scalar comparison.
+		peak_vec = _mm_max_ps(_mm_andnot_ps(sign_mask, v), peak_vec);
+	}
+
+	float lanes[4];
+	_mm_storeu_ps(lanes, peak_vec);
+	peak = AudioFrame(MAX(lanes[0], lanes[2]), MAX(lanes[1], lanes[3]));
+#elif defined(SIMD_NEON)
+	const float32x4_t volume = vdupq_n_f32(p_volume);
+	float32x4_t peak_vec = vdupq_n_f32(0.0f);
+
+	for (; frame_idx + 2 <= p_frames; frame_idx += 2) {
+		float32x4_t v = vmulq_f32(vld1q_f32(&p_buf[frame_idx].left), volume);
+		vst1q_f32(&p_buf[frame_idx].left, v);
+		// vmaxq_f32() propagates NaN, select on the comparison to match the scalar path.
+		float32x4_t a = vabsq_f32(v);
+		peak_vec = vbslq_f32(vcgtq_f32(a, peak_vec), a, peak_vec);
+	}
+
+	float lanes[4];
+	vst1q_f32(lanes, peak_vec);
+	peak = AudioFrame(MAX(lanes[0], lanes[2]), MAX(lanes[1], lanes[3]));
+#endif
+
+	for (; frame_idx < p_frames; frame_idx++) {
+		p_buf[frame_idx] *= p_volume;
+
+		float l = ABS(p_buf[frame_idx].left);
+		if (l > peak.left) {
+			peak.left = l;
+		}
+		float r = ABS(p_buf[frame_idx].right);
+		if (r > peak.right) {
+			peak.right = r;
+		}
+	}
+
+	return peak;
+}
+
+#if defined(SIMD_SSE2)
+static _FORCE_INLINE_ void _store_pair(__m128 p_vec, float &r_left, float &r_right) {
+	float lanes[4];
+	_mm_storeu_ps(lanes, p_vec);
+	r_left = lanes[0];
+	r_right = lanes[1];
+}
+#elif defined(SIMD_NEON)
+static _FORCE_INLINE_ void _store_pair(float32x2_t p_vec, float &r_left, float &r_right) {
+	r_left = vget_lane_f32(p_vec, 0);
+	r_right = vget_lane_f32(p_vec, 1);
+}
+#endif
+
+void AudioMix::filter_stereo_interp(AudioFilterSW::Processor *p_left, AudioFilterSW::Processor *p_right, AudioFrame *p_buf, uint32_t p_frames) {
+	AudioFilterSW::Processor &l = *p_left;
+	AudioFilterSW::Processor &r = *p_right;
+
+#if defined(SIMD_SSE2)
+	// The filter recursion is serial in time, so vectorize across channels instead, upper lanes are unused.
+	__m128 b0 = _mm_setr_ps(l.coeffs.b0, r.coeffs.b0, 0, 0);
+	__m128 b1 = _mm_setr_ps(l.coeffs.b1, r.coeffs.b1, 0, 0);
+	__m128 b2 = _mm_setr_ps(l.coeffs.b2, r.coeffs.b2, 0, 0);
+	__m128 a1 = _mm_setr_ps(l.coeffs.a1, r.coeffs.a1, 0, 0);
+	__m128 a2 = _mm_setr_ps(l.coeffs.a2, r.coeffs.a2, 0, 0);
+	const __m128 incr_b0 = _mm_setr_ps(l.incr_coeffs.b0, r.incr_coeffs.b0, 0, 0);
+	const __m128 incr_b1 = _mm_setr_ps(l.incr_coeffs.b1, r.incr_coeffs.b1, 0, 0);
+	const __m128 incr_b2 = _mm_setr_ps(l.incr_coeffs.b2, r.incr_coeffs.b2, 0, 0);
+	const __m128 incr_a1 = _mm_setr_ps(l.incr_coeffs.a1, r.incr_coeffs.a1, 0, 0);
+	const __m128 incr_a2 = _mm_setr_ps(l.incr_coeffs.a2, r.incr_coeffs.a2, 0, 0);
+	__m128 ha1 = _mm_setr_ps(l.ha1, r.ha1, 0, 0);
+	__m128 ha2 = _mm_setr_ps(l.ha2, r.ha2, 0, 0);
+	__m128 hb1 = _mm_setr_ps(l.hb1, r.hb1, 0, 0);
+	__m128 hb2 = _mm_setr_ps(l.hb2, r.hb2, 0, 0);
+
+	for (uint32_t frame_idx = 0; frame_idx < p_frames; frame_idx++) {
+		__m128 pre = _mm_castpd_ps(_mm_load_sd((const double *)&p_buf[frame_idx]));
+		__m128 sample = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(pre, b0), _mm_mul_ps(hb1, b1)), _mm_mul_ps(hb2, b2)), _mm_mul_ps(ha1, a1)), _mm_mul_ps(ha2, a2));
+		_mm_store_sd((double *)&p_buf[frame_idx], _mm_castps_pd(sample));
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = sample;
+
+		b0 = _mm_add_ps(b0, incr_b0);
+		b1 = _mm_add_ps(b1, incr_b1);
+		b2 = _mm_add_ps(b2, incr_b2);
+		a1 = _mm_add_ps(a1, incr_a1);
+		a2 = _mm_add_ps(a2, incr_a2);
+	}
+#elif defined(SIMD_NEON)
+	float32x2_t b0 = { l.coeffs.b0, r.coeffs.b0 };
+	float32x2_t b1 = { l.coeffs.b1, r.coeffs.b1 };
+	float32x2_t b2 = { l.coeffs.b2, r.coeffs.b2 };
+	float32x2_t a1 = { l.coeffs.a1, r.coeffs.a1 };
+	float32x2_t a2 = { l.coeffs.a2, r.coeffs.a2 };
+	const float32x2_t incr_b0 = { l.incr_coeffs.b0, r.incr_coeffs.b0 };
+	const float32x2_t incr_b1 = { l.incr_coeffs.b1, r.incr_coeffs.b1 };
+	const float32x2_t incr_b2 = { l.incr_coeffs.b2, r.incr_coeffs.b2 };
+	const float32x2_t incr_a1 = { l.incr_coeffs.a1, r.incr_coeffs.a1 };
+	const float32x2_t incr_a2 = { l.incr_coeffs.a2, r.incr_coeffs.a2 };
+	float32x2_t ha1 = { l.ha1, r.ha1 };
+	float32x2_t ha2 = { l.ha2, r.ha2 };
+	float32x2_t hb1 = { l.hb1, r.hb1 };
+	float32x2_t hb2 = { l.hb2, r.hb2 };
+
+	for (uint32_t frame_idx = 0; frame_idx < p_frames; frame_idx++) {
+		float32x2_t pre = vld1_f32(&p_buf[frame_idx].left);
+		float32x2_t sample = vadd_f32(vadd_f32(vadd_f32(vadd_f32(vmul_f32(pre, b0), vmul_f32(hb1, b1)), vmul_f32(hb2, b2)), vmul_f32(ha1, a1)), vmul_f32(ha2, a2));
+		vst1_f32(&p_buf[frame_idx].left, sample);
+		ha2 = ha1;
+		hb2 = hb1;
+		hb1 = pre;
+		ha1 = sample;
+
+		b0 = vadd_f32(b0, incr_b0);
+		b1 = vadd_f32(b1, incr_b1);
+		b2 = vadd_f32(b2, incr_b2);
+		a1 = vadd_f32(a1, incr_a1);
+		a2 = vadd_f32(a2, incr_a2);
+	}
+#endif
+
+#if defined(SIMD_SSE2) || defined(SIMD_NEON)
+	_store_pair(b0, l.coeffs.b0, r.coeffs.b0);
+	_store_pair(b1, l.coeffs.b1, r.coeffs.b1);
+	_store_pair(b2, l.coeffs.b2, r.coeffs.b2);
+	_store_pair(a1, l.coeffs.a1, r.coeffs.a1);
+	_store_pair(a2, l.coeffs.a2, r.coeffs.a2);
+	_store_pair(ha1, l.ha1, r.ha1);
+	_store_pair(ha2, l.ha2, r.ha2);
+	_store_pair(hb1, l.hb1, r.hb1);
+	_store_pair(hb2, l.hb2, r.hb2);
+#else
+	for (uint32_t frame_idx = 0; frame_idx < p_frames; frame_idx++) {
+		l.process_one_interp(p_buf[frame_idx].left);
+		r.process_one_interp(p_buf[frame_idx].right);
+	}
+#endif
+}
+
+const char *AudioMix::get_simd_name() {
+#if defined(SIMD_SSE2)
+	return "SSE2";
+#elif defined(SIMD_NEON)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,54 @@
+/**************************************************************************/
+/*  audio_mix.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef AUDIO_MIX_H
+#define AUDIO_MIX_H
+
+#include "core/math/audio_frame.h"
+#include "servers/audio/audio_filter_sw.h"
+
+// Bulk AudioFrame operations used by the mixer.
+// Vectorized with SSE2 or NEON where the target supports it, scalar otherwise.
+class AudioMix {
+public:
+	// p_dst[i] += lerp(p_vol_start, p_vol_final, i / p_frames) * p_src[i].
+	static void mix_ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol_start, const AudioFrame &p_vol_final, uint32_t p_frames);
+	// Same ramp as mix_ramp(), stored instead of accumulated.
+	static void ramp(AudioFrame *p_dst, const AudioFrame *p_src, const AudioFrame &p_vol_start, const AudioFrame &p_vol_final, uint32_t p_frames);
+	static void accumulate(AudioFrame *p_dst, const AudioFrame *p_src, uint32_t p_frames);
+	// Scales the buffer in place and returns the absolute peak of each channel.
+	static AudioFrame scale_and_peak(AudioFrame *p_buf, float p_volume, uint32_t p_frames);
+	// Runs AudioFilterSW::Processor::process_one_interp() on both channels at once.
+	static void filter_stereo_interp(AudioFilterSW::Processor *p_left, AudioFilterSW::Processor *p_right, AudioFrame *p_buf, uint32_t p_frames);
+
+	static const char *get_simd_name();
+};
+
+#endif // AUDIO_MIX_H
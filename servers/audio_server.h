@@ -271,6 +271,7 @@ private:
 
 	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
 	Vector<AudioFrame> mix_buffer;
+	Vector<AudioFrame> filter_buffer; // Filtered playback mix, before being added to the bus.
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
 
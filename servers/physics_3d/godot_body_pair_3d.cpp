@@ -66,10 +66,10 @@ void GodotBodyPair3D::contact_added_callback(const Vector3 &p_point_A, int p_ind
 		Contact &c = contacts[i];
 		if (c.local_A.distance_squared_to(local_A) < (contact_recycle_radius * contact_recycle_radius) &&
 				c.local_B.distance_squared_to(local_B) < (contact_recycle_radius * contact_recycle_radius)) {
+			// Warm start with the impulses from the previous step. Friction is only kept along the new tangent plane,
+			// and bias impulses aren't carried over since biased velocities are reset every step.
 			contact.acc_normal_impulse = c.acc_normal_impulse;
-			contact.acc_bias_impulse = c.acc_bias_impulse;
-			contact.acc_bias_impulse_center_of_mass = c.acc_bias_impulse_center_of_mass;
-			contact.acc_tangent_impulse = c.acc_tangent_impulse;
+			contact.acc_tangent_impulse = c.acc_tangent_impulse - contact.normal * contact.normal.dot(c.acc_tangent_impulse);
 			c = contact;
 			return;
 		}
@@ -307,6 +307,13 @@ bool GodotBodyPair3D::setup(real_t p_step) {
 			return true;
 		}
 
+		if (contact_count > 0 && !report_contacts_only) {
+			// Contacts from the previous step are still within the max separation, solve them as speculative
+			// contacts so bodies resting on each other don't lose their accumulated impulses when barely apart.
+			collided = true;
+			return true;
+		}
+
 		return false;
 	}
 
@@ -337,6 +344,7 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	}
 
 	real_t max_penetration = space->get_contact_max_allowed_penetration();
+	real_t max_separation = space->get_contact_max_separation();
 
 	real_t bias = 0.8;
 
@@ -374,6 +382,8 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 	for (int i = 0; i < contact_count; i++) {
 		Contact &c = contacts[i];
 		c.active = false;
+		c.acc_bias_impulse = 0.0;
+		c.acc_bias_impulse_center_of_mass = 0.0;
 
 		Vector3 global_A = basis_A.xform(c.local_A);
 		Vector3 global_B = basis_B.xform(c.local_B) + offset_B;
@@ -381,12 +391,13 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		Vector3 axis = global_A - global_B;
 		real_t depth = axis.dot(c.normal);
 
-		if (depth <= 0.0) {
+		c.speculative = depth <= 0.0;
+		if (c.speculative && (report_contacts_only || depth < -max_separation)) {
 			continue;
 		}
 
 #ifdef DEBUG_ENABLED
-		if (space->is_debugging_contacts()) {
+		if (!c.speculative && space->is_debugging_contacts()) {
 			space->add_debug_contact(global_A + offset_A);
 			space->add_debug_contact(global_B + offset_A);
 		}
@@ -402,7 +413,14 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 		kNormal += c.normal.dot(inertia_A.cross(c.rA)) + c.normal.dot(inertia_B.cross(c.rB));
 		c.mass_normal = 1.0f / kNormal;
 
-		c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
+		if (c.speculative) {
+			// Only allowed to close the gap within this step.
+			c.bias = 0.0;
+			c.speculative_velocity = -depth * inv_dt;
+		} else {
+			c.bias = -bias * inv_dt * MIN(0.0f, -depth + max_penetration);
+			c.speculative_velocity = 0.0;
+		}
 		c.depth = depth;
 
 		Vector3 j_vec = c.normal * c.acc_normal_impulse + c.acc_tangent_impulse;
@@ -411,7 +429,7 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 
 		// contact query reporting...
 
-		if (A->can_report_contacts() || B->can_report_contacts()) {
+		if (!c.speculative && (A->can_report_contacts() || B->can_report_contacts())) {
 			Vector3 crB = B->get_angular_velocity().cross(c.rB) + B->get_linear_velocity();
 			Vector3 crA = A->get_angular_velocity().cross(c.rA) + A->get_linear_velocity();
 
@@ -439,7 +457,7 @@ bool GodotBodyPair3D::pre_solve(real_t p_step) {
 			B->apply_impulse(j_vec, c.rB + B->get_center_of_mass());
 		}
 
-		c.bounce = combine_bounce(A, B);
+		c.bounce = c.speculative ? 0.0 : combine_bounce(A, B);
 		if (c.bounce) {
 			Vector3 crA = A->get_prev_angular_velocity().cross(c.rA);
 			Vector3 crB = B->get_prev_angular_velocity().cross(c.rB);
@@ -483,7 +501,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 
 		real_t vbn = dbv.dot(c.normal);
 
-		if (Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
+		if (!c.speculative && Math::abs(-vbn + c.bias) > MIN_VELOCITY) {
 			real_t jbn = (-vbn + c.bias) * c.mass_normal;
 			real_t jbnOld = c.acc_bias_impulse;
 			c.acc_bias_impulse = MAX(jbnOld + jbn, 0.0f);
@@ -526,7 +544,7 @@ void GodotBodyPair3D::solve(real_t p_step) {
 		Vector3 dv = B->get_linear_velocity() + crB - A->get_linear_velocity() - crA;
 
 		//normal impulse
-		real_t vn = dv.dot(c.normal);
+		real_t vn = dv.dot(c.normal) + c.speculative_velocity;
 
 		if (Math::abs(vn) > MIN_VELOCITY) {
 			real_t jn = -(c.bounce + vn) * c.mass_normal;
@@ -52,9 +52,11 @@ protected:
 		real_t mass_normal = 0.0;
 		real_t bias = 0.0;
 		real_t bounce = 0.0;
+		real_t speculative_velocity = 0.0; // Closing velocity allowed for contacts that are still apart.
 
 		real_t depth = 0.0;
 		bool active = false;
+		bool speculative = false; // Apart, but kept from the previous step to prevent closing the gap and to keep its impulses.
 		bool used = false;
 		Vector3 rA, rB; // Offset in world orientation with respect to center of mass
 	};
@@ -31,6 +31,7 @@
 #include "godot_collision_solver_3d_sat.h"
 
 #include "gjk_epa.h"
+#include "godot_collision_solver_3d_simd.h"
 
 #include "core/math/geometry_3d.h"
 
@@ -612,6 +613,20 @@ static void _generate_contacts_from_supports(const Vector3 *p_points_A, int p_po
 	contacts_func(points_A, pointcount_A, points_B, pointcount_B, p_callback);
 }
 
+// Projects a shape onto a batch of axes, given both as vectors and laid out as three arrays (x, y, z).
+template <class Shape>
+static _FORCE_INLINE_ void _project_ranges(const Shape *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const real_t *const p_axes_soa[3], int p_count, real_t *r_min, real_t *r_max) {
+	for (int i = 0; i < p_count; i++) {
+		r_min[i] = 0.0;
+		r_max[i] = 0.0;
+		p_shape->project_range(p_axes[i], p_transform, r_min[i], r_max[i]);
+	}
+}
+
+static _FORCE_INLINE_ void _project_ranges(const GodotBoxShape3D *p_shape, const Transform3D &p_transform, const Vector3 *p_axes, const real_t *const p_axes_soa[3], int p_count, real_t *r_min, real_t *r_max) {
+	GodotCollisionSolver3DSIMD::project_box(p_transform, p_shape->get_half_extents(), p_axes_soa, p_count, r_min, r_max);
+}
+
 template <class ShapeA, class ShapeB, bool withMargin = false>
 class SeparatorAxisTest {
 	const ShapeA *shape_A = nullptr;
@@ -624,30 +639,7 @@ class SeparatorAxisTest {
 	real_t margin_B = 0.0;
 	Vector3 separator_axis;
 
-public:
-	Vector3 best_axis;
-
-	_FORCE_INLINE_ bool test_previous_axis() {
-		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
-			return test_axis(*callback->prev_axis);
-		} else {
-			return true;
-		}
-	}
-
-	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
-		Vector3 axis = p_axis;
-
-		if (axis.is_zero_approx()) {
-			// strange case, try an upwards separator
-			axis = Vector3(0.0, 1.0, 0.0);
-		}
-
-		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
-
-		shape_A->project_range(axis, *transform_A, min_A, max_A);
-		shape_B->project_range(axis, *transform_B, min_B, max_B);
-
+	_FORCE_INLINE_ bool _test_ranges(const Vector3 &axis, real_t min_A, real_t max_A, real_t min_B, real_t max_B) {
 		if (withMargin) {
 			min_A -= margin_A;
 			max_A += margin_A;
@@ -687,6 +679,71 @@ public:
 		return true;
 	}
 
+public:
+	Vector3 best_axis;
+
+	_FORCE_INLINE_ bool test_previous_axis() {
+		if (callback && callback->prev_axis && *callback->prev_axis != Vector3()) {
+			return test_axis(*callback->prev_axis);
+		} else {
+			return true;
+		}
+	}
+
+	_FORCE_INLINE_ bool test_axis(const Vector3 &p_axis) {
+		Vector3 axis = p_axis;
+
+		if (axis.is_zero_approx()) {
+			// strange case, try an upwards separator
+			axis = Vector3(0.0, 1.0, 0.0);
+		}
+
+		real_t min_A = 0.0, max_A = 0.0, min_B = 0.0, max_B = 0.0;
+
+		shape_A->project_range(axis, *transform_A, min_A, max_A);
+		shape_B->project_range(axis, *transform_B, min_B, max_B);
+
+		return _test_ranges(axis, min_A, max_A, min_B, max_B);
+	}
+
+	// Same as calling test_axis() on each axis in order, but the shapes are projected
+	// onto a batch of axes at once so box projections can be vectorized.
+	bool test_axes(const Vector3 *p_axes, int p_count) {
+		static const int batch_size = 16;
+
+		Vector3 axes[batch_size];
+		real_t axes_soa[3][batch_size];
+		const real_t *const axes_soa_ptrs[3] = { axes_soa[0], axes_soa[1], axes_soa[2] };
+		real_t min_A[batch_size], max_A[batch_size], min_B[batch_size], max_B[batch_size];
+
+		for (int from = 0; from < p_count; from += batch_size) {
+			int count = MIN(batch_size, p_count - from);
+
+			for (int i = 0; i < count; i++) {
+				Vector3 axis = p_axes[from + i];
+				if (axis.is_zero_approx()) {
+					// strange case, try an upwards separator
+					axis = Vector3(0.0, 1.0, 0.0);
+				}
+				axes[i] = axis;
+				axes_soa[0][i] = axis.x;
+				axes_soa[1][i] = axis.y;
+				axes_soa[2][i] = axis.z;
+			}
+
+			_project_ranges(shape_A, *transform_A, axes, axes_soa_ptrs, count, min_A, max_A);
+			_project_ranges(shape_B, *transform_B, axes, axes_soa_ptrs, count, min_B, max_B);
+
+			for (int i = 0; i < count; i++) {
+				if (!_test_ranges(axes[i], min_A[i], max_A[i], min_B[i], max_B[i])) {
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
 	static _FORCE_INLINE_ void test_contact_points(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
 		SeparatorAxisTest<ShapeA, ShapeB, withMargin> *separator = (SeparatorAxisTest<ShapeA, ShapeB, withMargin> *)p_userdata;
 		Vector3 axis = (p_point_B - p_point_A);
@@ -1079,27 +1136,20 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 		return;
 	}
 
-	// test faces of A
+	// test faces of A and B
 
+	Vector3 axes[9];
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[i] = p_transform_a.basis.get_column(i).normalized();
+		axes[i + 3] = p_transform_b.basis.get_column(i).normalized();
 	}
 
-	// test faces of B
-
-	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_b.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+	if (!separator.test_axes(axes, 6)) {
+		return;
 	}
 
 	// test combined edges
+	int axis_count = 0;
 	for (int i = 0; i < 3; i++) {
 		for (int j = 0; j < 3; j++) {
 			Vector3 axis = p_transform_a.basis.get_column(i).cross(p_transform_b.basis.get_column(j));
@@ -1107,14 +1157,14 @@ static void _collision_box_box(const GodotShape3D *p_a, const Transform3D &p_tra
 			if (Math::is_zero_approx(axis.length_squared())) {
 				continue;
 			}
-			axis.normalize();
-
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			axes[axis_count++] = axis.normalized();
 		}
 	}
 
+	if (!separator.test_axes(axes, axis_count)) {
+		return;
+	}
+
 	if (withMargin) {
 		//add endpoint test between closest vertices and edges
 
@@ -1397,13 +1447,14 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 	const Vector3 *vertices = mesh.vertices.ptr();
 	int vertex_count = mesh.vertices.size();
 
+	// The axes are tested in batches, so the box is projected onto several of them at once.
+	static const int max_axes = 16;
+	Vector3 axes[max_axes];
+	int axis_count = 0;
+
 	// faces of A
 	for (int i = 0; i < 3; i++) {
-		Vector3 axis = p_transform_a.basis.get_column(i).normalized();
-
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[axis_count++] = p_transform_a.basis.get_column(i).normalized();
 	}
 
 	// Precalculating this makes the transforms faster.
@@ -1411,10 +1462,13 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 
 	// faces of B
 	for (int i = 0; i < face_count; i++) {
-		Vector3 axis = b_xform_normal.xform(faces[i].plane.normal).normalized();
+		axes[axis_count++] = b_xform_normal.xform(faces[i].plane.normal).normalized();
 
-		if (!separator.test_axis(axis)) {
-			return;
+		if (axis_count == max_axes) {
+			if (!separator.test_axes(axes, axis_count)) {
+				return;
+			}
+			axis_count = 0;
 		}
 	}
 
@@ -1425,14 +1479,21 @@ static void _collision_box_convex_polygon(const GodotShape3D *p_a, const Transfo
 		for (int j = 0; j < edge_count; j++) {
 			Vector3 e2 = p_transform_b.basis.xform(vertices[edges[j].vertex_a]) - p_transform_b.basis.xform(vertices[edges[j].vertex_b]);
 
-			Vector3 axis = e1.cross(e2).normalized();
+			axes[axis_count++] = e1.cross(e2).normalized();
 
-			if (!separator.test_axis(axis)) {
-				return;
+			if (axis_count == max_axes) {
+				if (!separator.test_axes(axes, axis_count)) {
+					return;
+				}
+				axis_count = 0;
 			}
 		}
 	}
 
+	if (!separator.test_axes(axes, axis_count)) {
+		return;
+	}
+
 	if (withMargin) {
 		// calculate closest points between vertices and box edges
 		for (int v = 0; v < vertex_count; v++) {
@@ -1510,9 +1571,10 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 
 	Vector3 normal = (vertex[0] - vertex[2]).cross(vertex[0] - vertex[1]).normalized();
 
-	if (!separator.test_axis(normal)) {
-		return;
-	}
+	// The face normal, the faces of A and the combined edges are tested as one batch.
+	Vector3 axes[13];
+	int axis_count = 0;
+	axes[axis_count++] = normal;
 
 	// faces of A
 	for (int i = 0; i < 3; i++) {
@@ -1521,9 +1583,7 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 			axis *= -1.0;
 		}
 
-		if (!separator.test_axis(axis)) {
-			return;
-		}
+		axes[axis_count++] = axis;
 	}
 
 	// combined edges
@@ -1537,12 +1597,14 @@ static void _collision_box_face(const GodotShape3D *p_a, const Transform3D &p_tr
 				axis *= -1.0;
 			}
 
-			if (!separator.test_axis(axis)) {
-				return;
-			}
+			axes[axis_count++] = axis;
 		}
 	}
 
+	if (!separator.test_axes(axes, axis_count)) {
+		return;
+	}
+
 	if (withMargin) {
 		// calculate closest points between vertices and box edges
 		for (int v = 0; v < 3; v++) {
@@ -2090,6 +2152,17 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 
 	// A<->B edges
 
+	// The edges of B and their face normals are transformed once, rather than once per edge of A.
+	LocalVector<Vector3> edge_data_B;
+	edge_data_B.resize(edge_count_B * 3);
+	for (int j = 0; j < edge_count_B; j++) {
+		Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
+		Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
+		edge_data_B[j * 3 + 0] = q2 - p2;
+		edge_data_B[j * 3 + 1] = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
+		edge_data_B[j * 3 + 2] = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+	}
+
 	for (int i = 0; i < edge_count_A; i++) {
 		Vector3 p1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_a]);
 		Vector3 q1 = p_transform_a.xform(vertices_A[edges_A[i].vertex_b]);
@@ -2098,11 +2171,9 @@ static void _collision_convex_polygon_convex_polygon(const GodotShape3D *p_a, co
 		Vector3 v1 = p_transform_a.basis.xform(faces_A[edges_A[i].face_b].plane.normal).normalized();
 
 		for (int j = 0; j < edge_count_B; j++) {
-			Vector3 p2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_a]);
-			Vector3 q2 = p_transform_b.xform(vertices_B[edges_B[j].vertex_b]);
-			Vector3 e2 = q2 - p2;
-			Vector3 u2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_a].plane.normal).normalized();
-			Vector3 v2 = p_transform_b.basis.xform(faces_B[edges_B[j].face_b].plane.normal).normalized();
+			const Vector3 &e2 = edge_data_B[j * 3 + 0];
+			const Vector3 &u2 = edge_data_B[j * 3 + 1];
+			const Vector3 &v2 = edge_data_B[j * 3 + 2];
 
 			if (is_minkowski_face(u1, v1, -e1, -u2, -v2, -e2)) {
 				Vector3 axis = e1.cross(e2).normalized();
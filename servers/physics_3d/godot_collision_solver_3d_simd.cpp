@@ -0,0 +1,161 @@
+/**************************************************************************/
+/*  godot_collision_solver_3d_simd.cpp                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "godot_collision_solver_3d_simd.h"
+
+#include "core/math/simd.h"
+
+void GodotCollisionSolver3DSIMD::project_box(const Transform3D &p_transform, const Vector3 &p_half_extents, const real_t *const p_axes[3], uint32_t p_count, real_t *r_min, real_t *r_max) {
+	const Basis &basis = p_transform.basis;
+	const Vector3 &origin = p_transform.origin;
+	uint32_t i = 0;
+
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	// Clearing the sign bit is Math::abs().
+	const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	for (; i + 4 <= p_count; i += 4) {
+		const __m128 x = _mm_loadu_ps(p_axes[0] + i);
+		const __m128 y = _mm_loadu_ps(p_axes[1] + i);
+		const __m128 z = _mm_loadu_ps(p_axes[2] + i);
+
+		// Basis::xform_inv(), one column of the basis per local component.
+		__m128 length = _mm_setzero_ps();
+		for (int j = 0; j < 3; j++) {
+			__m128 l = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(basis.rows[0][j]), x), _mm_mul_ps(_mm_set1_ps(basis.rows[1][j]), y));
+			l = _mm_add_ps(l, _mm_mul_ps(_mm_set1_ps(basis.rows[2][j]), z));
+			l = _mm_mul_ps(_mm_and_ps(l, abs_mask), _mm_set1_ps(p_half_extents[j]));
+			length = j == 0 ? l : _mm_add_ps(length, l);
+		}
+
+		__m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(origin.x)), _mm_mul_ps(y, _mm_set1_ps(origin.y)));
+		distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(origin.z)));
+
+		_mm_storeu_ps(r_min + i, _mm_sub_ps(distance, length));
+		_mm_storeu_ps(r_max + i, _mm_add_ps(distance, length));
+	}
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	for (; i + 4 <= p_count; i += 4) {
+		const float32x4_t x = vld1q_f32(p_axes[0] + i);
+		const float32x4_t y = vld1q_f32(p_axes[1] + i);
+		const float32x4_t z = vld1q_f32(p_axes[2] + i);
+
+		// Basis::xform_inv(), one column of the basis per local component.
+		float32x4_t length = vdupq_n_f32(0.0f);
+		for (int j = 0; j < 3; j++) {
+			float32x4_t l = vaddq_f32(vmulq_n_f32(x, basis.rows[0][j]), vmulq_n_f32(y, basis.rows[1][j]));
+			l = vaddq_f32(l, vmulq_n_f32(z, basis.rows[2][j]));
+			l = vmulq_n_f32(vabsq_f32(l), p_half_extents[j]);
+			length = j == 0 ? l : vaddq_f32(length, l);
+		}
+
+		float32x4_t distance = vaddq_f32(vmulq_n_f32(x, origin.x), vmulq_n_f32(y, origin.y));
+		distance = vaddq_f32(distance, vmulq_n_f32(z, origin.z));
+
+		vst1q_f32(r_min + i, vsubq_f32(distance, length));
+		vst1q_f32(r_max + i, vaddq_f32(distance, length));
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		const Vector3 axis(p_axes[0][i], p_axes[1][i], p_axes[2][i]);
+		const Vector3 local_axis = basis.xform_inv(axis);
+
+		real_t length = local_axis.abs().dot(p_half_extents);
+		real_t distance = axis.dot(origin);
+
+		r_min[i] = distance - length;
+		r_max[i] = distance + length;
+	}
+}
+
+void GodotCollisionSolver3DSIMD::project_points(const real_t *const p_points[3], uint32_t p_count, const Vector3 &p_dir, real_t &r_min, real_t &r_max) {
+	uint32_t i = 0;
+	real_t min = 0.0;
+	real_t max = 0.0;
+
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	if (p_count >= 4) {
+		const __m128 dx = _mm_set1_ps(p_dir.x);
+		const __m128 dy = _mm_set1_ps(p_dir.y);
+		const __m128 dz = _mm_set1_ps(p_dir.z);
+		__m128 min4 = _mm_set1_ps(1e30f);
+		__m128 max4 = _mm_set1_ps(-1e30f);
+		for (; i + 4 <= p_count; i += 4) {
+			__m128 d = _mm_add_ps(_mm_mul_ps(dx, _mm_loadu_ps(p_points[0] + i)), _mm_mul_ps(dy, _mm_loadu_ps(p_points[1] + i)));
+			d = _mm_add_ps(d, _mm_mul_ps(dz, _mm_loadu_ps(p_points[2] + i)));
+			min4 = _mm_min_ps(min4, d);
+			max4 = _mm_max_ps(max4, d);
+		}
+		min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(1, 0, 3, 2)));
+		min4 = _mm_min_ps(min4, _mm_shuffle_ps(min4, min4, _MM_SHUFFLE(2, 3, 0, 1)));
+		max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(1, 0, 3, 2)));
+		max4 = _mm_max_ps(max4, _mm_shuffle_ps(max4, max4, _MM_SHUFFLE(2, 3, 0, 1)));
+		min = _mm_cvtss_f32(min4);
+		max = _mm_cvtss_f32(max4);
+	}
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	if (p_count >= 4) {
+		float32x4_t min4 = vdupq_n_f32(1e30f);
+		float32x4_t max4 = vdupq_n_f32(-1e30f);
+		for (; i + 4 <= p_count; i += 4) {
+			float32x4_t d = vaddq_f32(vmulq_n_f32(vld1q_f32(p_points[0] + i), p_dir.x), vmulq_n_f32(vld1q_f32(p_points[1] + i), p_dir.y));
+			d = vaddq_f32(d, vmulq_n_f32(vld1q_f32(p_points[2] + i), p_dir.z));
+			min4 = vminq_f32(min4, d);
+			max4 = vmaxq_f32(max4, d);
+		}
+		min = vminvq_f32(min4);
+		max = vmaxvq_f32(max4);
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		real_t d = p_dir.dot(Vector3(p_points[0][i], p_points[1][i], p_points[2][i]));
+
+		if (i == 0 || d > max) {
+			max = d;
+		}
+		if (i == 0 || d < min) {
+			min = d;
+		}
+	}
+
+	r_min = min;
+	r_max = max;
+}
+
+const char *GodotCollisionSolver3DSIMD::get_simd_name() {
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	return "SSE2";
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,50 @@
+/**************************************************************************/
+/*  godot_collision_solver_3d_simd.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef GODOT_COLLISION_SOLVER_3D_SIMD_H
+#define GODOT_COLLISION_SOLVER_3D_SIMD_H
+
+#include "core/math/transform_3d.h"
+
+// Projection kernels used by the separating axis tests of GodotCollisionSolver3D.
+// Vectorized with SSE2 or NEON where the target supports it and real_t is single precision, scalar otherwise.
+class GodotCollisionSolver3DSIMD {
+public:
+	// Projects a box onto p_count axes laid out as three arrays (x, y, z).
+	// Same result as GodotBoxShape3D::project_range() for each axis.
+	static void project_box(const Transform3D &p_transform, const Vector3 &p_half_extents, const real_t *const p_axes[3], uint32_t p_count, real_t *r_min, real_t *r_max);
+	// Returns the range of the dot product of p_dir with p_count points laid out as three arrays (x, y, z).
+	// p_count must be greater than zero.
+	static void project_points(const real_t *const p_points[3], uint32_t p_count, const Vector3 &p_dir, real_t &r_min, real_t &r_max);
+
+	static const char *get_simd_name();
+};
+
+#endif // GODOT_COLLISION_SOLVER_3D_SIMD_H
@@ -30,6 +30,8 @@
 
 #include "godot_shape_3d.h"
 
+#include "godot_collision_solver_3d_simd.h"
+
 #include "core/io/image.h"
 #include "core/math/convex_hull.h"
 #include "core/math/geometry_3d.h"
@@ -827,8 +829,6 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		return;
 	}
 
-	const Vector3 *vrts = &mesh.vertices[0];
-
 	if (vertex_count > 3 * extreme_vertices.size()) {
 		// For a large mesh, two calls to get_support() is faster than a full
 		// scan over all vertices.
@@ -837,16 +837,14 @@ void GodotConvexPolygonShape3D::project_range(const Vector3 &p_normal, const Tra
 		r_min = p_normal.dot(p_transform.xform(get_support(-n)));
 		r_max = p_normal.dot(p_transform.xform(get_support(n)));
 	} else {
-		for (uint32_t i = 0; i < vertex_count; i++) {
-			real_t d = p_normal.dot(p_transform.xform(vrts[i]));
+		// Project the local vertices onto the normal in local space, so the
+		// vertices don't need to be transformed one by one.
+		const real_t *const points[3] = { &vertices_soa[0], &vertices_soa[vertex_count], &vertices_soa[vertex_count * 2] };
+		GodotCollisionSolver3DSIMD::project_points(points, vertex_count, p_transform.basis.xform_inv(p_normal), r_min, r_max);
 
-			if (i == 0 || d > r_max) {
-				r_max = d;
-			}
-			if (i == 0 || d < r_min) {
-				r_min = d;
-			}
-		}
+		real_t distance = p_normal.dot(p_transform.origin);
+		r_min += distance;
+		r_max += distance;
 	}
 }
 
@@ -1114,6 +1112,14 @@ void GodotConvexPolygonShape3D::_setup(const Vector<Vector3> &p_vertices) {
 
 	configure(_aabb);
 
+	uint32_t vertex_count = mesh.vertices.size();
+	vertices_soa.resize(vertex_count * 3);
+	for (uint32_t i = 0; i < vertex_count; i++) {
+		vertices_soa[i] = mesh.vertices[i].x;
+		vertices_soa[vertex_count + i] = mesh.vertices[i].y;
+		vertices_soa[vertex_count * 2 + i] = mesh.vertices[i].z;
+	}
+
 	// Pre-compute the extreme vertices in 26 directions.  This will be used
 	// to speed up get_support() by letting us quickly get a good guess for
 	// the support vertex.
@@ -279,6 +279,8 @@ struct GodotConvexPolygonShape3D : public GodotShape3D {
 	Geometry3D::MeshData mesh;
 	LocalVector<int> extreme_vertices;
 	LocalVector<LocalVector<int>> vertex_neighbors;
+	// Vertices laid out as all x, then all y, then all z for the projection kernel.
+	LocalVector<real_t> vertices_soa;
 
 	void _setup(const Vector<Vector3> &p_vertices);
 
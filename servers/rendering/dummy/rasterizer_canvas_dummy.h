@@ -56,6 +56,7 @@ public:
 	void update() override {}
 
 	virtual void set_debug_redraw(bool p_enabled, double p_time, const Color &p_color) override {}
+	virtual uint64_t get_rendering_info(RS::RenderingInfo p_info) override { return 0; }
 
 	RasterizerCanvasDummy() {}
 	~RasterizerCanvasDummy() {}
@@ -0,0 +1,489 @@
+/**************************************************************************/
+/*  raster_occlusion_cull.cpp                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "raster_occlusion_cull.h"
+
+#include "core/object/worker_thread_pool.h"
+
+#ifndef REAL_T_IS_DOUBLE
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RASTER_OCCLUSION_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define RASTER_OCCLUSION_NEON
+#include <arm_neon.h>
+#endif
+#endif // REAL_T_IS_DOUBLE
+
+// Rasterizes the pixels [p_from, p_to] of a row of a tile, p_from being a multiple of 4.
+// Pixels are covered when their center lies inside the three edges, and keep the closest depth.
+static _FORCE_INLINE_ void _rasterize_row(const RasterOcclusionCull::RasterHZBuffer::Triangle &p_tri, int p_tile_x, int p_y, int p_from, int p_to, float *r_depth) {
+	const float py = p_y + 0.5f;
+	const float edge_row[3] = {
+		p_tri.edge_b[0] * py + p_tri.edge_c[0],
+		p_tri.edge_b[1] * py + p_tri.edge_c[1],
+		p_tri.edge_b[2] * py + p_tri.edge_c[2],
+	};
+	const float depth_over_w_row = p_tri.depth_over_w[1] * py + p_tri.depth_over_w[2];
+	const float inv_w_row = p_tri.inv_w[1] * py + p_tri.inv_w[2];
+
+#if defined(RASTER_OCCLUSION_SSE2)
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 lane_offsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128 edge_a0 = _mm_set1_ps(p_tri.edge_a[0]);
+	const __m128 edge_a1 = _mm_set1_ps(p_tri.edge_a[1]);
+	const __m128 edge_a2 = _mm_set1_ps(p_tri.edge_a[2]);
+	const __m128 edge_row0 = _mm_set1_ps(edge_row[0]);
+	const __m128 edge_row1 = _mm_set1_ps(edge_row[1]);
+	const __m128 edge_row2 = _mm_set1_ps(edge_row[2]);
+	const __m128 depth_over_w_a = _mm_set1_ps(p_tri.depth_over_w[0]);
+	const __m128 depth_over_w_r = _mm_set1_ps(depth_over_w_row);
+	const __m128 inv_w_a = _mm_set1_ps(p_tri.inv_w[0]);
+	const __m128 inv_w_r = _mm_set1_ps(inv_w_row);
+
+	for (int x = p_from; x <= p_to; x += 4) {
+		const __m128 px = _mm_add_ps(_mm_set1_ps(float(p_tile_x + x)), lane_offsets);
+
+		__m128 inside = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a0, px), edge_row0), zero);
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a1, px), edge_row1), zero));
+		inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edge_a2, px), edge_row2), zero));
+		if (_mm_movemask_ps(inside) == 0) {
+			continue;
+		}
+
+		const __m128 depth = _mm_div_ps(_mm_add_ps(_mm_mul_ps(depth_over_w_a, px), depth_over_w_r), _mm_add_ps(_mm_mul_ps(inv_w_a, px), inv_w_r));
+		const __m128 current = _mm_loadu_ps(r_depth + x);
+		_mm_storeu_ps(r_depth + x, _mm_or_ps(_mm_and_ps(inside, _mm_min_ps(current, depth)), _mm_andnot_ps(inside, current)));
+	}
+#elif defined(RASTER_OCCLUSION_NEON)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	const float lane_values[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+	const float32x4_t lane_offsets = vld1q_f32(lane_values);
+	const float32x4_t edge_row0 = vdupq_n_f32(edge_row[0]);
+	const float32x4_t edge_row1 = vdupq_n_f32(edge_row[1]);
+	const float32x4_t edge_row2 = vdupq_n_f32(edge_row[2]);
+	const float32x4_t depth_over_w_r = vdupq_n_f32(depth_over_w_row);
+	const float32x4_t inv_w_r = vdupq_n_f32(inv_w_row);
+
+	for (int x = p_from; x <= p_to; x += 4) {
+		const float32x4_t px = vaddq_f32(vdupq_n_f32(float(p_tile_x + x)), lane_offsets);
+
+		uint32x4_t inside = vcgeq_f32(vaddq_f32(vmulq_n_f32(px, p_tri.edge_a[0]), edge_row0), zero);
+		inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(vmulq_n_f32(px, p_tri.edge_a[1]), edge_row1), zero));
+		inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(vmulq_n_f32(px, p_tri.edge_a[2]), edge_row2), zero));
+		if (vmaxvq_u32(inside) == 0) {
+			continue;
+		}
+
+		const float32x4_t depth = vdivq_f32(vaddq_f32(vmulq_n_f32(px, p_tri.depth_over_w[0]), depth_over_w_r), vaddq_f32(vmulq_n_f32(px, p_tri.inv_w[0]), inv_w_r));
+		const float32x4_t current = vld1q_f32(r_depth + x);
+		vst1q_f32(r_depth + x, vbslq_f32(inside, vminq_f32(current, depth), current));
+	}
+#else
+	for (int x = p_from; x <= p_to; x++) {
+		const float px = p_tile_x + x + 0.5f;
+		if (p_tri.edge_a[0] * px + edge_row[0] < 0.0f || p_tri.edge_a[1] * px + edge_row[1] < 0.0f || p_tri.edge_a[2] * px + edge_row[2] < 0.0f) {
+			continue;
+		}
+
+		const float depth = (p_tri.depth_over_w[0] * px + depth_over_w_row) / (p_tri.inv_w[0] * px + inv_w_row);
+		r_depth[x] = MIN(r_depth[x], depth);
+	}
+#endif
+}
+
+void RasterOcclusionCull::RasterHZBuffer::clear() {
+	HZBuffer::clear();
+
+	triangles.clear();
+	tile_triangles.clear();
+	tile_grid_size = Size2i();
+}
+
+void RasterOcclusionCull::RasterHZBuffer::resize(const Size2i &p_size) {
+	if (p_size == Size2i()) {
+		clear();
+		return;
+	}
+
+	if (!sizes.is_empty() && p_size == sizes[0]) {
+		return; // Size didn't change
+	}
+
+	HZBuffer::resize(p_size);
+
+	tile_grid_size = Size2i((p_size.x + TILE_SIZE - 1) / TILE_SIZE, (p_size.y + TILE_SIZE - 1) / TILE_SIZE);
+	tile_triangles.clear();
+	tile_triangles.resize(tile_grid_size.x * tile_grid_size.y);
+}
+
+void RasterOcclusionCull::RasterHZBuffer::begin() {
+	triangles.clear();
+	for (LocalVector<uint32_t> &tile : tile_triangles) {
+		tile.clear();
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::add_occluder(const Vector3 *p_vertices, uint32_t p_vertex_count, const int32_t *p_indices, uint32_t p_index_count, const Transform3D &p_view_transform, const Projection &p_cam_projection) {
+	ERR_FAIL_COND(is_empty());
+
+	clip_vertices.resize(p_vertex_count);
+	view_depths.resize(p_vertex_count);
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		const Vector3 view = p_view_transform.xform(p_vertices[i]);
+		clip_vertices[i] = p_cam_projection.xform(Vector4(view.x, view.y, view.z, 1.0));
+		view_depths[i] = -view.z;
+	}
+
+	for (uint32_t i = 0; i + 2 < p_index_count; i += 3) {
+		const uint32_t i0 = p_indices[i];
+		const uint32_t i1 = p_indices[i + 1];
+		const uint32_t i2 = p_indices[i + 2];
+		ERR_CONTINUE(i0 >= p_vertex_count || i1 >= p_vertex_count || i2 >= p_vertex_count);
+
+		const Vector4 &a = clip_vertices[i0];
+		const Vector4 &b = clip_vertices[i1];
+		const Vector4 &c = clip_vertices[i2];
+
+		// Skip triangles fully outside of one of the side planes.
+		if ((a.x > a.w && b.x > b.w && c.x > c.w) || (a.x < -a.w && b.x < -b.w && c.x < -c.w) ||
+				(a.y > a.w && b.y > b.w && c.y > c.w) || (a.y < -a.w && b.y < -b.w && c.y < -c.w)) {
+			continue;
+		}
+
+		const int behind_near = int(a.z < -a.w) + int(b.z < -b.w) + int(c.z < -c.w);
+		if (behind_near == 3) {
+			continue;
+		}
+
+		if (behind_near == 0) {
+			const Vector4 clip[3] = { a, b, c };
+			const float depth[3] = { view_depths[i0], view_depths[i1], view_depths[i2] };
+			_add_triangle(clip, depth);
+		} else {
+			_add_clipped_triangle(a, b, c, view_depths[i0], view_depths[i1], view_depths[i2]);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_clipped_triangle(const Vector4 &p_a, const Vector4 &p_b, const Vector4 &p_c, float p_depth_a, float p_depth_b, float p_depth_c) {
+	// Clip against the near plane, which leaves a polygon of at most 4 vertices.
+	const Vector4 in_clip[3] = { p_a, p_b, p_c };
+	const float in_depth[3] = { p_depth_a, p_depth_b, p_depth_c };
+	Vector4 out_clip[4];
+	float out_depth[4];
+	int out_count = 0;
+
+	for (int i = 0; i < 3; i++) {
+		const int j = (i + 1) % 3;
+		const real_t distance_i = in_clip[i].z + in_clip[i].w;
+		const real_t distance_j = in_clip[j].z + in_clip[j].w;
+
+		if (distance_i >= 0) {
+			out_clip[out_count] = in_clip[i];
+			out_depth[out_count] = in_depth[i];
+			out_count++;
+		}
+		if ((distance_i >= 0) != (distance_j >= 0)) {
+			const real_t t = distance_i / (distance_i - distance_j);
+			out_clip[out_count] = in_clip[i] + (in_clip[j] - in_clip[i]) * t;
+			out_depth[out_count] = in_depth[i] + (in_depth[j] - in_depth[i]) * t;
+			out_count++;
+		}
+	}
+
+	for (int i = 1; i + 1 < out_count; i++) {
+		const Vector4 clip[3] = { out_clip[0], out_clip[i], out_clip[i + 1] };
+		const float depth[3] = { out_depth[0], out_depth[i], out_depth[i + 1] };
+		_add_triangle(clip, depth);
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_add_triangle(const Vector4 *p_clip, const float *p_depth) {
+	const Size2i &size = sizes[0];
+
+	float x[3];
+	float y[3];
+	float depth_over_w[3];
+	float inv_w[3];
+	for (int i = 0; i < 3; i++) {
+		inv_w[i] = 1.0f / p_clip[i].w;
+		x[i] = (p_clip[i].x * inv_w[i] * 0.5f + 0.5f) * size.x;
+		y[i] = (p_clip[i].y * inv_w[i] * 0.5f + 0.5f) * size.y;
+		depth_over_w[i] = p_depth[i] * inv_w[i];
+	}
+
+	float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+	if (!(Math::abs(area) > CMP_EPSILON)) {
+		return; // Degenerate, or not a number.
+	}
+
+	// Occluders are double-sided, wind every triangle counter-clockwise so the inside is positive.
+	int order[3] = { 0, 1, 2 };
+	if (area < 0) {
+		SWAP(order[1], order[2]);
+		area = -area;
+	}
+
+	Triangle tri;
+	const float inv_area = 1.0f / area;
+	for (int i = 0; i < 3; i++) {
+		tri.depth_over_w[i] = 0.0f;
+		tri.inv_w[i] = 0.0f;
+	}
+
+	for (int e = 0; e < 3; e++) {
+		const int from = order[e];
+		const int to = order[(e + 1) % 3];
+		const int opposite = order[(e + 2) % 3];
+
+		// Triangles sharing an edge must compute exactly opposite values for it, otherwise rounding
+		// leaves holes along the edge. Evaluate it in a canonical direction, and flip the result.
+		const bool flip = x[to] < x[from] || (x[to] == x[from] && y[to] < y[from]);
+		const int start = flip ? to : from;
+		const int end = flip ? from : to;
+		const float sign = flip ? -1.0f : 1.0f;
+		tri.edge_a[e] = (y[start] - y[end]) * sign;
+		tri.edge_b[e] = (x[end] - x[start]) * sign;
+		tri.edge_c[e] = -((y[start] - y[end]) * x[start] + (x[end] - x[start]) * y[start]) * sign;
+
+		// The edge function divided by the area is the barycentric weight of the opposite vertex.
+		const float edge[3] = { tri.edge_a[e], tri.edge_b[e], tri.edge_c[e] };
+		for (int k = 0; k < 3; k++) {
+			tri.depth_over_w[k] += depth_over_w[opposite] * edge[k] * inv_area;
+			tri.inv_w[k] += inv_w[opposite] * edge[k] * inv_area;
+		}
+	}
+
+	// Pixels whose center is within the triangle bounds, clamped in floating point first as projected
+	// coordinates can be huge for vertices close to the camera plane.
+	const float min_x = MIN(MIN(x[0], x[1]), x[2]);
+	const float max_x = MAX(MAX(x[0], x[1]), x[2]);
+	const float min_y = MIN(MIN(y[0], y[1]), y[2]);
+	const float max_y = MAX(MAX(y[0], y[1]), y[2]);
+	tri.min_x = Math::ceil(CLAMP(min_x - 0.5f, 0.0f, float(size.x)));
+	tri.max_x = Math::floor(CLAMP(max_x - 0.5f, -1.0f, float(size.x - 1)));
+	tri.min_y = Math::ceil(CLAMP(min_y - 0.5f, 0.0f, float(size.y)));
+	tri.max_y = Math::floor(CLAMP(max_y - 0.5f, -1.0f, float(size.y - 1)));
+	if (tri.min_x > tri.max_x || tri.min_y > tri.max_y) {
+		return;
+	}
+
+	const uint32_t index = triangles.size();
+	triangles.push_back(tri);
+
+	for (int tile_y = tri.min_y / TILE_SIZE; tile_y <= tri.max_y / TILE_SIZE; tile_y++) {
+		for (int tile_x = tri.min_x / TILE_SIZE; tile_x <= tri.max_x / TILE_SIZE; tile_x++) {
+			tile_triangles[tile_y * tile_grid_size.x + tile_x].push_back(index);
+		}
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::_rasterize_tile(uint32_t p_tile, const RasterizeData *p_data) {
+	const Size2i &size = sizes[0];
+	const int tile_x = (p_tile % tile_grid_size.x) * TILE_SIZE;
+	const int tile_y = (p_tile / tile_grid_size.x) * TILE_SIZE;
+
+	float depth[TILE_SIZE * TILE_SIZE];
+	for (int i = 0; i < TILE_SIZE * TILE_SIZE; i++) {
+		depth[i] = p_data->clear_depth;
+	}
+
+	for (const uint32_t &index : tile_triangles[p_tile]) {
+		const Triangle &tri = triangles[index];
+		const int from_x = MAX(tri.min_x, tile_x) - tile_x;
+		const int to_x = MIN(tri.max_x, tile_x + TILE_SIZE - 1) - tile_x;
+		const int from_y = MAX(tri.min_y, tile_y) - tile_y;
+		const int to_y = MIN(tri.max_y, tile_y + TILE_SIZE - 1) - tile_y;
+
+		for (int y = from_y; y <= to_y; y++) {
+			_rasterize_row(tri, tile_x, tile_y + y, from_x & ~3, to_x, &depth[y * TILE_SIZE]);
+		}
+	}
+
+	const int width = MIN(TILE_SIZE, size.x - tile_x);
+	const int height = MIN(TILE_SIZE, size.y - tile_y);
+	for (int y = 0; y < height; y++) {
+		memcpy(&mips[0][(tile_y + y) * size.x + tile_x], &depth[y * TILE_SIZE], width * sizeof(float));
+	}
+}
+
+void RasterOcclusionCull::RasterHZBuffer::rasterize(float p_clear_depth) {
+	ERR_FAIL_COND(is_empty());
+
+	RasterizeData rd;
+	rd.clear_depth = p_clear_depth;
+	debug_tex_range = p_clear_depth;
+
+	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RasterHZBuffer::_rasterize_tile, (const RasterizeData *)&rd, tile_triangles.size(), -1, true, SNAME("RasterOcclusionCullRasterize"));
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+
+	update_mips();
+}
+
+////////////////////////////////////////////////////////
+
+bool RasterOcclusionCull::is_occluder(RID p_rid) {
+	return occluder_owner.owns(p_rid);
+}
+
+RID RasterOcclusionCull::occluder_allocate() {
+	return occluder_owner.allocate_rid();
+}
+
+void RasterOcclusionCull::occluder_initialize(RID p_occluder) {
+	Occluder *occluder = memnew(Occluder);
+	occluder_owner.initialize_rid(p_occluder, occluder);
+}
+
+void RasterOcclusionCull::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+
+	occluder->vertices = p_vertices;
+	occluder->indices = p_indices;
+
+	occluder->aabb = AABB();
+	for (int i = 0; i < p_vertices.size(); i++) {
+		if (i == 0) {
+			occluder->aabb.position = p_vertices[i];
+		} else {
+			occluder->aabb.expand_to(p_vertices[i]);
+		}
+	}
+}
+
+void RasterOcclusionCull::free_occluder(RID p_occluder) {
+	Occluder *occluder = occluder_owner.get_or_null(p_occluder);
+	ERR_FAIL_NULL(occluder);
+	memdelete(occluder);
+	occluder_owner.free(p_occluder);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_scenario(RID p_scenario) {
+	ERR_FAIL_COND(scenarios.has(p_scenario));
+	scenarios[p_scenario] = Scenario();
+}
+
+void RasterOcclusionCull::remove_scenario(RID p_scenario) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios.erase(p_scenario);
+}
+
+void RasterOcclusionCull::scenario_set_instance(RID p_scenario, RID p_instance, RID p_occluder, const Transform3D &p_xform, bool p_enabled) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	OccluderInstance &instance = scenarios[p_scenario].instances[p_instance];
+	instance.occluder = p_occluder;
+	instance.xform = p_xform;
+	instance.enabled = p_enabled;
+}
+
+void RasterOcclusionCull::scenario_remove_instance(RID p_scenario, RID p_instance) {
+	ERR_FAIL_COND(!scenarios.has(p_scenario));
+	scenarios[p_scenario].instances.erase(p_instance);
+}
+
+////////////////////////////////////////////////////////
+
+void RasterOcclusionCull::add_buffer(RID p_buffer) {
+	ERR_FAIL_COND(buffers.has(p_buffer));
+	buffers[p_buffer] = RasterHZBuffer();
+}
+
+void RasterOcclusionCull::remove_buffer(RID p_buffer) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers.erase(p_buffer);
+}
+
+void RasterOcclusionCull::buffer_set_scenario(RID p_buffer, RID p_scenario) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	ERR_FAIL_COND(p_scenario.is_valid() && !scenarios.has(p_scenario));
+	buffers[p_buffer].scenario_rid = p_scenario;
+}
+
+void RasterOcclusionCull::buffer_set_size(RID p_buffer, const Vector2i &p_size) {
+	ERR_FAIL_COND(!buffers.has(p_buffer));
+	buffers[p_buffer].resize(p_size);
+}
+
+void RasterOcclusionCull::buffer_update(RID p_buffer, const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal) {
+	if (!buffers.has(p_buffer)) {
+		return;
+	}
+
+	RasterHZBuffer &buffer = buffers[p_buffer];
+
+	if (buffer.is_empty() || !scenarios.has(buffer.scenario_rid)) {
+		return;
+	}
+
+	const Scenario &scenario = scenarios[buffer.scenario_rid];
+	const Transform3D inv_cam_transform = p_cam_transform.affine_inverse();
+	const Vector<Plane> planes = p_cam_projection.get_projection_planes(p_cam_transform);
+	Vector3 endpoints[8];
+	p_cam_projection.get_endpoints(p_cam_transform, endpoints);
+
+	buffer.begin();
+
+	for (const KeyValue<RID, OccluderInstance> &E : scenario.instances) {
+		const OccluderInstance &instance = E.value;
+		if (!instance.enabled) {
+			continue;
+		}
+
+		const Occluder *occluder = occluder_owner.get_or_null(instance.occluder);
+		if (!occluder || occluder->indices.size() < 3) {
+			continue;
+		}
+
+		if (!instance.xform.xform(occluder->aabb).intersects_convex_shape(planes.ptr(), planes.size(), endpoints, 8)) {
+			continue;
+		}
+
+		buffer.add_occluder(occluder->vertices.ptr(), occluder->vertices.size(), occluder->indices.ptr(), occluder->indices.size(), inv_cam_transform * instance.xform, p_cam_projection);
+	}
+
+	// Same depth as a ray that doesn't hit anything in the raycast implementation.
+	buffer.rasterize(p_cam_projection.get_z_far() * 1.05f);
+}
+
+RasterOcclusionCull::HZBuffer *RasterOcclusionCull::buffer_get_ptr(RID p_buffer) {
+	if (!buffers.has(p_buffer)) {
+		return nullptr;
+	}
+	return &buffers[p_buffer];
+}
+
+RID RasterOcclusionCull::buffer_get_debug_texture(RID p_buffer) {
+	ERR_FAIL_COND_V(!buffers.has(p_buffer), RID());
+	return buffers[p_buffer].get_debug_texture();
+}
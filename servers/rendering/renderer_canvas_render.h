@@ -526,6 +526,7 @@ public:
 	virtual void update() = 0;
 
 	virtual void set_debug_redraw(bool p_enabled, double p_time, const Color &p_color) = 0;
+	virtual uint64_t get_rendering_info(RS::RenderingInfo p_info) = 0;
 
 	RendererCanvasRender() { singleton = this; }
 	virtual ~RendererCanvasRender() {}
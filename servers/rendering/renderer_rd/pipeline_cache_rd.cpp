@@ -30,16 +30,130 @@
 
 #include "pipeline_cache_rd.h"
 
+#include "core/io/file_access.h"
 #include "core/os/memory.h"
+#include "core/os/os.h"
 
-RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
-	RD::PipelineMultisampleState multisample_state_version = multisample_state;
-	multisample_state_version.sample_count = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
+bool PipelineCacheRD::async_compile = false;
+PipelineCacheRD::Manifest *PipelineCacheRD::manifest = nullptr;
+
+Mutex PipelineCacheRD::format_mutex;
+HashMap<RD::FramebufferFormatID, uint32_t> PipelineCacheRD::framebuffer_format_hashes;
+HashMap<RD::VertexFormatID, uint32_t> PipelineCacheRD::vertex_format_hashes;
+HashMap<uint32_t, RD::FramebufferFormatID> PipelineCacheRD::framebuffer_formats_by_hash;
+HashMap<uint32_t, RD::VertexFormatID> PipelineCacheRD::vertex_formats_by_hash;
+LocalVector<PipelineCacheRD *> PipelineCacheRD::prewarm_caches;
+
+/* MANIFEST */
+
+#define MANIFEST_MAGIC 0x4D435047 // "GPCM"
+#define MANIFEST_VERSION 1
+
+void PipelineCacheRD::Manifest::record(const ManifestKey &p_key) {
+	MutexLock lock(mutex);
+	LocalVector<ManifestKey> &cache_keys = keys[p_key.cache_hash];
+	if (cache_keys.find(p_key) != -1) {
+		return;
+	}
+	cache_keys.push_back(p_key);
+	key_count++;
+	dirty = true;
+}
+
+LocalVector<PipelineCacheRD::ManifestKey> PipelineCacheRD::Manifest::get_keys(uint32_t p_cache_hash) const {
+	MutexLock lock(mutex);
+	HashMap<uint32_t, LocalVector<ManifestKey>>::ConstIterator E = keys.find(p_cache_hash);
+	if (!E) {
+		return LocalVector<ManifestKey>();
+	}
+	return E->value;
+}
+
+uint32_t PipelineCacheRD::Manifest::get_key_count() const {
+	MutexLock lock(mutex);
+	return key_count;
+}
+
+bool PipelineCacheRD::Manifest::is_dirty() const {
+	MutexLock lock(mutex);
+	return dirty;
+}
 
-	bool wireframe = p_wireframe;
+void PipelineCacheRD::Manifest::clear() {
+	MutexLock lock(mutex);
+	keys.clear();
+	key_count = 0;
+	dirty = false;
+}
+
+Error PipelineCacheRD::Manifest::save(const String &p_path) {
+	MutexLock lock(mutex);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, "Can't save pipeline manifest to: " + p_path);
+
+	f->store_32(MANIFEST_MAGIC);
+	f->store_32(MANIFEST_VERSION);
+	f->store_32(key_count);
+	for (const KeyValue<uint32_t, LocalVector<ManifestKey>> &E : keys) {
+		for (const ManifestKey &key : E.value) {
+			f->store_32(key.cache_hash);
+			f->store_32(key.framebuffer_format_hash);
+			f->store_32(key.vertex_format_hash);
+			f->store_32(key.render_pass);
+			f->store_32(key.bool_specializations);
+			f->store_32(key.wireframe);
+		}
+	}
+
+	dirty = false;
+	return OK;
+}
+
+Error PipelineCacheRD::Manifest::load(const String &p_path) {
+	MutexLock lock(mutex);
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ, &err);
+	if (f.is_null()) {
+		return err;
+	}
+
+	ERR_FAIL_COND_V_MSG(f->get_32() != MANIFEST_MAGIC || f->get_32() != MANIFEST_VERSION, ERR_FILE_UNRECOGNIZED, "Invalid pipeline manifest: " + p_path);
+	uint32_t count = f->get_32();
+	ERR_FAIL_COND_V_MSG(uint64_t(count) * 6 * sizeof(uint32_t) > f->get_length() - f->get_position(), ERR_FILE_CORRUPT, "Truncated pipeline manifest: " + p_path);
+
+	keys.clear();
+	key_count = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		ManifestKey key;
+		key.cache_hash = f->get_32();
+		key.framebuffer_format_hash = f->get_32();
+		key.vertex_format_hash = f->get_32();
+		key.render_pass = f->get_32();
+		key.bool_specializations = f->get_32();
+		key.wireframe = f->get_32() != 0;
+
+		LocalVector<ManifestKey> &cache_keys = keys[key.cache_hash];
+		if (cache_keys.find(key) == -1) {
+			cache_keys.push_back(key);
+			key_count++;
+		}
+	}
+
+	dirty = false;
+	return OK;
+}
+
+/* PIPELINE CACHE */
+
+RID PipelineCacheRD::_create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RD::TextureSamples p_samples) {
+	RD::PipelineMultisampleState multisample_state_version = multisample_state;
+	multisample_state_version.sample_count = p_samples;
 
 	RD::PipelineRasterizationState raster_state_version = rasterization_state;
-	raster_state_version.wireframe = wireframe;
+	raster_state_version.wireframe = p_wireframe;
 
 	Vector<RD::PipelineSpecializationConstant> specialization_constants = base_specialization_constants;
 
@@ -57,25 +171,383 @@ RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD
 		bool_index++;
 	}
 
-	RID pipeline = RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+	return RD::get_singleton()->render_pipeline_create(shader, p_framebuffer_format_id, p_vertex_format_id, render_primitive, raster_state_version, multisample_state_version, depth_stencil_state, blend_state, dynamic_state_flags, p_render_pass, specialization_constants);
+}
+
+RID PipelineCacheRD::_generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	RD::TextureSamples samples = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
+	RID pipeline = _create_pipeline(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations, samples);
 	ERR_FAIL_COND_V(pipeline.is_null(), RID());
 	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
 	versions[version_count].framebuffer_id = p_framebuffer_format_id;
 	versions[version_count].vertex_id = p_vertex_format_id;
-	versions[version_count].wireframe = wireframe;
+	versions[version_count].wireframe = p_wireframe;
 	versions[version_count].pipeline = pipeline;
 	versions[version_count].render_pass = p_render_pass;
 	versions[version_count].bool_specializations = p_bool_specializations;
+	versions[version_count].task = WorkerThreadPool::INVALID_TASK_ID;
 	version_count++;
 	return pipeline;
 }
 
+void PipelineCacheRD::_compile_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	AsyncCompile *compile = memnew(AsyncCompile);
+	compile->cache = this;
+	compile->vertex_id = p_vertex_format_id;
+	compile->framebuffer_id = p_framebuffer_format_id;
+	compile->wireframe = p_wireframe;
+	compile->render_pass = p_render_pass;
+	compile->bool_specializations = p_bool_specializations;
+	// Queried here, format lookups are not meant to happen from other threads.
+	compile->samples = RD::get_singleton()->framebuffer_format_get_texture_samples(p_framebuffer_format_id, p_render_pass);
+
+	versions = static_cast<Version *>(memrealloc(versions, sizeof(Version) * (version_count + 1)));
+	versions[version_count].framebuffer_id = p_framebuffer_format_id;
+	versions[version_count].vertex_id = p_vertex_format_id;
+	versions[version_count].wireframe = p_wireframe;
+	versions[version_count].pipeline = RID();
+	versions[version_count].render_pass = p_render_pass;
+	versions[version_count].bool_specializations = p_bool_specializations;
+	versions[version_count].task = WorkerThreadPool::get_singleton()->add_native_task(&PipelineCacheRD::_compile_async_task, compile, false, SNAME("PipelineCacheRD::compile"));
+	version_count++;
+}
+
+void PipelineCacheRD::_compile_async_task(void *p_userdata) {
+	AsyncCompile *compile = static_cast<AsyncCompile *>(p_userdata);
+	PipelineCacheRD *cache = compile->cache;
+
+	// The cache state can't change until this task is awaited, see _clear().
+	RID pipeline = cache->_create_pipeline(compile->vertex_id, compile->framebuffer_id, compile->wireframe, compile->render_pass, compile->bool_specializations, compile->samples);
+
+	cache->spin_lock.lock();
+	for (uint32_t i = 0; i < cache->version_count; i++) {
+		Version &version = cache->versions[i];
+		if (version.vertex_id == compile->vertex_id && version.framebuffer_id == compile->framebuffer_id && version.wireframe == compile->wireframe && version.render_pass == compile->render_pass && version.bool_specializations == compile->bool_specializations) {
+			version.pipeline = pipeline;
+			break;
+		}
+	}
+	cache->spin_lock.unlock();
+
+	memdelete(compile);
+}
+
+RID PipelineCacheRD::_find_fallback(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	// Another specialization of the same shader is the closest match.
+	for (uint32_t i = 0; i < version_count; i++) {
+		if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].pipeline.is_valid()) {
+			return versions[i].pipeline;
+		}
+	}
+
+	if (async_fallback == nullptr || async_fallback == this) {
+		return RID();
+	}
+
+	// Only use what the fallback already compiled, compiling it here would defeat the purpose.
+	RID result;
+	async_fallback->spin_lock.lock();
+	for (uint32_t i = 0; i < async_fallback->version_count; i++) {
+		const Version &version = async_fallback->versions[i];
+		if (version.vertex_id == p_vertex_format_id && version.framebuffer_id == p_framebuffer_format_id && version.wireframe == p_wireframe && version.render_pass == p_render_pass && version.pipeline.is_valid()) {
+			result = version.pipeline;
+			if (version.bool_specializations == p_bool_specializations) {
+				break;
+			}
+		}
+	}
+	async_fallback->spin_lock.unlock();
+	return result;
+}
+
+RID PipelineCacheRD::_request_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	if (manifest) {
+		// Done first, as it may compile versions other caches recorded for these formats.
+		_register_formats(p_vertex_format_id, p_framebuffer_format_id);
+		_record(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	}
+
+	bool async_failed = false;
+	while (true) {
+		spin_lock.lock();
+
+		Version *version = nullptr;
+		for (uint32_t i = 0; i < version_count; i++) {
+			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+				version = &versions[i];
+				break;
+			}
+		}
+
+		if (version == nullptr) {
+			break; // Not requested before, generated below with the lock held.
+		}
+
+		// A finished task is awaited right away instead, so failures are noticed.
+		if (version->pipeline.is_null() && (version->task == WorkerThreadPool::INVALID_TASK_ID || !WorkerThreadPool::get_singleton()->is_task_completed(version->task))) {
+			RID fallback = _find_fallback(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+			if (fallback.is_valid()) {
+				spin_lock.unlock();
+				return fallback;
+			}
+		}
+
+		if (version->task == WorkerThreadPool::INVALID_TASK_ID) {
+			if (version->pipeline.is_valid()) {
+				RID result = version->pipeline;
+				spin_lock.unlock();
+				return result;
+			}
+			// Another thread is waiting for this compilation.
+			spin_lock.unlock();
+			OS::get_singleton()->delay_usec(1);
+			continue;
+		}
+
+		// Claim the task, it can only be awaited once.
+		WorkerThreadPool::TaskID task = version->task;
+		version->task = WorkerThreadPool::INVALID_TASK_ID;
+		spin_lock.unlock();
+
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(task); // Returns right away if the compilation is done.
+
+		RID result;
+		spin_lock.lock();
+		for (uint32_t i = 0; i < version_count; i++) {
+			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+				result = versions[i].pipeline;
+				if (result.is_null()) {
+					versions[i] = versions[version_count - 1];
+					version_count--;
+				}
+				break;
+			}
+		}
+
+		if (result.is_valid()) {
+			spin_lock.unlock();
+			return result;
+		}
+
+		// Failed to compile, compile it again below so the error is reported like a synchronous compilation.
+		async_failed = true;
+		break;
+	}
+
+	RID result;
+	if (async_compile && !async_failed) {
+		result = _find_fallback(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	}
+	if (result.is_valid()) {
+		_compile_async(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	} else {
+		// Nothing to draw with in the meantime.
+		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
+	}
+	spin_lock.unlock();
+
+	if (manifest && !prewarm_keys.is_empty()) {
+		MutexLock lock(format_mutex);
+		spin_lock.lock();
+		_prewarm();
+		spin_lock.unlock();
+	}
+
+	return result;
+}
+
+uint32_t PipelineCacheRD::_hash_state() const {
+	uint32_t h = hash_murmur3_one_32(RD::get_singleton()->shader_get_binary_hash(shader));
+	h = hash_murmur3_one_32(render_primitive, h);
+
+	h = hash_murmur3_one_32(rasterization_state.enable_depth_clamp, h);
+	h = hash_murmur3_one_32(rasterization_state.discard_primitives, h);
+	h = hash_murmur3_one_32(rasterization_state.wireframe, h);
+	h = hash_murmur3_one_32(rasterization_state.cull_mode, h);
+	h = hash_murmur3_one_32(rasterization_state.front_face, h);
+	h = hash_murmur3_one_32(rasterization_state.depth_bias_enabled, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_constant_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_clamp, h);
+	h = hash_murmur3_one_float(rasterization_state.depth_bias_slope_factor, h);
+	h = hash_murmur3_one_float(rasterization_state.line_width, h);
+	h = hash_murmur3_one_32(rasterization_state.patch_control_points, h);
+
+	h = hash_murmur3_one_32(multisample_state.enable_sample_shading, h);
+	h = hash_murmur3_one_float(multisample_state.min_sample_shading, h);
+	for (uint32_t mask : multisample_state.sample_mask) {
+		h = hash_murmur3_one_32(mask, h);
+	}
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_coverage, h);
+	h = hash_murmur3_one_32(multisample_state.enable_alpha_to_one, h);
+
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_test, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_write, h);
+	h = hash_murmur3_one_32(depth_stencil_state.depth_compare_operator, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_depth_range, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_min, h);
+	h = hash_murmur3_one_float(depth_stencil_state.depth_range_max, h);
+	h = hash_murmur3_one_32(depth_stencil_state.enable_stencil, h);
+	const RD::PipelineDepthStencilState::StencilOperationState *stencil_ops[2] = { &depth_stencil_state.front_op, &depth_stencil_state.back_op };
+	for (const RD::PipelineDepthStencilState::StencilOperationState *op : stencil_ops) {
+		h = hash_murmur3_one_32(op->fail, h);
+		h = hash_murmur3_one_32(op->pass, h);
+		h = hash_murmur3_one_32(op->depth_fail, h);
+		h = hash_murmur3_one_32(op->compare, h);
+		h = hash_murmur3_one_32(op->compare_mask, h);
+		h = hash_murmur3_one_32(op->write_mask, h);
+		h = hash_murmur3_one_32(op->reference, h);
+	}
+
+	h = hash_murmur3_one_32(blend_state.enable_logic_op, h);
+	h = hash_murmur3_one_32(blend_state.logic_op, h);
+	for (const RD::PipelineColorBlendState::Attachment &attachment : blend_state.attachments) {
+		h = hash_murmur3_one_32(attachment.enable_blend, h);
+		h = hash_murmur3_one_32(attachment.src_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_color_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.color_blend_op, h);
+		h = hash_murmur3_one_32(attachment.src_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.dst_alpha_blend_factor, h);
+		h = hash_murmur3_one_32(attachment.alpha_blend_op, h);
+		h = hash_murmur3_one_32(attachment.write_r | (attachment.write_g << 1) | (attachment.write_b << 2) | (attachment.write_a << 3), h);
+	}
+
+	h = hash_murmur3_one_32(dynamic_state_flags, h);
+	for (const RD::PipelineSpecializationConstant &sc : base_specialization_constants) {
+		h = hash_murmur3_one_32(sc.type, h);
+		h = hash_murmur3_one_32(sc.constant_id, h);
+		h = hash_murmur3_one_32(sc.int_value, h);
+	}
+
+	return hash_fmix32(h);
+}
+
+bool PipelineCacheRD::register_format_hashes(RD::VertexFormatID p_vertex_format_id, uint32_t p_vertex_format_hash, RD::FramebufferFormatID p_framebuffer_format_id, uint32_t p_framebuffer_format_hash) {
+	MutexLock lock(format_mutex);
+
+	bool new_format = false;
+	if (!framebuffer_format_hashes.has(p_framebuffer_format_id)) {
+		framebuffer_format_hashes.insert(p_framebuffer_format_id, p_framebuffer_format_hash);
+		framebuffer_formats_by_hash.insert(p_framebuffer_format_hash, p_framebuffer_format_id);
+		new_format = true;
+	}
+	if (!vertex_format_hashes.has(p_vertex_format_id)) {
+		vertex_format_hashes.insert(p_vertex_format_id, p_vertex_format_hash);
+		vertex_formats_by_hash.insert(p_vertex_format_hash, p_vertex_format_id);
+		new_format = true;
+	}
+	return new_format;
+}
+
+void PipelineCacheRD::clear_formats() {
+	MutexLock lock(format_mutex);
+	framebuffer_format_hashes.clear();
+	vertex_format_hashes.clear();
+	framebuffer_formats_by_hash.clear();
+	vertex_formats_by_hash.clear();
+}
+
+void PipelineCacheRD::resolve_prewarm_keys(LocalVector<ManifestKey> &r_keys, bool p_wireframe, LocalVector<PrewarmVersion> &r_versions) {
+	MutexLock lock(format_mutex);
+
+	for (uint32_t i = 0; i < r_keys.size(); i++) {
+		const ManifestKey &key = r_keys[i];
+		HashMap<uint32_t, RD::FramebufferFormatID>::Iterator F = framebuffer_formats_by_hash.find(key.framebuffer_format_hash);
+		HashMap<uint32_t, RD::VertexFormatID>::Iterator V = vertex_formats_by_hash.find(key.vertex_format_hash);
+		if (!F || !V) {
+			continue; // Formats not used yet in this run.
+		}
+
+		PrewarmVersion version;
+		version.vertex_id = V->value;
+		version.framebuffer_id = F->value;
+		version.render_pass = key.render_pass;
+		version.bool_specializations = key.bool_specializations;
+		version.wireframe = key.wireframe || p_wireframe;
+		r_versions.push_back(version);
+
+		r_keys.remove_at_unordered(i);
+		i--;
+	}
+}
+
+void PipelineCacheRD::_register_formats(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id) {
+	MutexLock lock(format_mutex);
+
+	HashMap<RD::FramebufferFormatID, uint32_t>::Iterator F = framebuffer_format_hashes.find(p_framebuffer_format_id);
+	HashMap<RD::VertexFormatID, uint32_t>::Iterator V = vertex_format_hashes.find(p_vertex_format_id);
+	if (F && V) {
+		return;
+	}
+
+	uint32_t framebuffer_format_hash = F ? F->value : (p_framebuffer_format_id == RD::INVALID_ID ? 0 : RD::get_singleton()->framebuffer_format_get_hash(p_framebuffer_format_id));
+	uint32_t vertex_format_hash = V ? V->value : (p_vertex_format_id == RD::INVALID_ID ? 0 : RD::get_singleton()->vertex_format_get_hash(p_vertex_format_id));
+	register_format_hashes(p_vertex_format_id, vertex_format_hash, p_framebuffer_format_id, framebuffer_format_hash);
+
+	// Versions recorded by a previous run may have been waiting for these formats.
+	for (int64_t i = int64_t(prewarm_caches.size()) - 1; i >= 0; i--) {
+		PipelineCacheRD *cache = prewarm_caches[i];
+		cache->spin_lock.lock();
+		cache->_prewarm();
+		cache->spin_lock.unlock();
+	}
+}
+
+void PipelineCacheRD::_record(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations) {
+	ManifestKey key;
+	key.cache_hash = cache_hash;
+	{
+		MutexLock lock(format_mutex);
+		key.framebuffer_format_hash = framebuffer_format_hashes[p_framebuffer_format_id];
+		key.vertex_format_hash = vertex_format_hashes[p_vertex_format_id];
+	}
+	key.render_pass = p_render_pass;
+	key.bool_specializations = p_bool_specializations;
+	key.wireframe = p_wireframe;
+	manifest->record(key);
+}
+
+void PipelineCacheRD::_prewarm() {
+	// Called with format_mutex and spin_lock held, in that order.
+	LocalVector<PrewarmVersion> prewarm_versions;
+	resolve_prewarm_keys(prewarm_keys, rasterization_state.wireframe, prewarm_versions);
+
+	for (const PrewarmVersion &prewarm_version : prewarm_versions) {
+		bool exists = false;
+		for (uint32_t j = 0; j < version_count; j++) {
+			if (versions[j].vertex_id == prewarm_version.vertex_id && versions[j].framebuffer_id == prewarm_version.framebuffer_id && versions[j].wireframe == prewarm_version.wireframe && versions[j].render_pass == prewarm_version.render_pass && versions[j].bool_specializations == prewarm_version.bool_specializations) {
+				exists = true;
+				break;
+			}
+		}
+		if (!exists) {
+			_compile_async(prewarm_version.vertex_id, prewarm_version.framebuffer_id, prewarm_version.wireframe, prewarm_version.render_pass, prewarm_version.bool_specializations);
+		}
+	}
+
+	if (prewarm_keys.is_empty()) {
+		prewarm_caches.erase(this);
+	}
+}
+
 void PipelineCacheRD::_clear() {
+	if (!prewarm_keys.is_empty()) {
+		MutexLock lock(format_mutex);
+		prewarm_caches.erase(this);
+		prewarm_keys.clear();
+	}
+
 	// TODO: Clear should probably recompile all the variants already compiled instead to avoid stalls? Needs discussion.
 	if (versions) {
+		// Background compilations use the current state, so they must finish first.
+		for (uint32_t i = 0; i < version_count; i++) {
+			if (versions[i].task != WorkerThreadPool::INVALID_TASK_ID) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(versions[i].task);
+				versions[i].task = WorkerThreadPool::INVALID_TASK_ID;
+			}
+		}
 		for (uint32_t i = 0; i < version_count; i++) {
 			//shader may be gone, so this may not be valid
-			if (RD::get_singleton()->render_pipeline_is_valid(versions[i].pipeline)) {
+			if (versions[i].pipeline.is_valid() && RD::get_singleton()->render_pipeline_is_valid(versions[i].pipeline)) {
 				RD::get_singleton()->free(versions[i].pipeline);
 			}
 		}
@@ -97,10 +569,27 @@ void PipelineCacheRD::setup(RID p_shader, RD::RenderPrimitive p_primitive, const
 	blend_state = p_blend_state;
 	dynamic_state_flags = p_dynamic_state_flags;
 	base_specialization_constants = p_base_specialization_constants;
+
+	if (manifest) {
+		cache_hash = _hash_state();
+		prewarm_keys = manifest->get_keys(cache_hash);
+		if (!prewarm_keys.is_empty()) {
+			MutexLock lock(format_mutex);
+			spin_lock.lock();
+			_prewarm();
+			if (!prewarm_keys.is_empty()) {
+				prewarm_caches.push_back(this);
+			}
+			spin_lock.unlock();
+		}
+	}
 }
 void PipelineCacheRD::update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants) {
-	base_specialization_constants = p_base_specialization_constants;
 	_clear();
+	base_specialization_constants = p_base_specialization_constants;
+	if (manifest) {
+		cache_hash = _hash_state();
+	}
 }
 
 void PipelineCacheRD::update_shader(RID p_shader) {
@@ -31,10 +31,58 @@
 #ifndef PIPELINE_CACHE_RD_H
 #define PIPELINE_CACHE_RD_H
 
+#include "core/object/worker_thread_pool.h"
+#include "core/os/mutex.h"
 #include "core/os/spin_lock.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
 #include "servers/rendering/rendering_device.h"
 
 class PipelineCacheRD {
+public:
+	// Describes a version with hashes of the shader binary, the pipeline state and the formats,
+	// so it remains valid across runs (unlike RIDs and format IDs).
+	struct ManifestKey {
+		uint32_t cache_hash = 0;
+		uint32_t framebuffer_format_hash = 0;
+		uint32_t vertex_format_hash = 0;
+		uint32_t render_pass = 0;
+		uint32_t bool_specializations = 0;
+		bool wireframe = false;
+
+		bool operator==(const ManifestKey &p_key) const {
+			return cache_hash == p_key.cache_hash && framebuffer_format_hash == p_key.framebuffer_format_hash && vertex_format_hash == p_key.vertex_format_hash && render_pass == p_key.render_pass && bool_specializations == p_key.bool_specializations && wireframe == p_key.wireframe;
+		}
+	};
+
+	// Records the versions used during a run, so the next run can compile them ahead of time.
+	class Manifest {
+		mutable Mutex mutex;
+		HashMap<uint32_t, LocalVector<ManifestKey>> keys; // By cache hash.
+		uint32_t key_count = 0;
+		bool dirty = false;
+
+	public:
+		void record(const ManifestKey &p_key);
+		LocalVector<ManifestKey> get_keys(uint32_t p_cache_hash) const;
+		uint32_t get_key_count() const;
+		bool is_dirty() const;
+		void clear();
+
+		Error save(const String &p_path);
+		Error load(const String &p_path);
+	};
+
+	// A recorded version resolved to the formats of this run.
+	struct PrewarmVersion {
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass = 0;
+		uint32_t bool_specializations = 0;
+		bool wireframe = false;
+	};
+
+private:
 	SpinLock spin_lock;
 
 	RID shader;
@@ -55,20 +103,72 @@ class PipelineCacheRD {
 		bool wireframe;
 		uint32_t bool_specializations;
 		RID pipeline;
+		WorkerThreadPool::TaskID task; // Compiling in the background while valid, pipeline is set once done.
 	};
 
 	Version *versions = nullptr;
 	uint32_t version_count;
 
+	struct AsyncCompile {
+		PipelineCacheRD *cache = nullptr;
+		RD::VertexFormatID vertex_id;
+		RD::FramebufferFormatID framebuffer_id;
+		uint32_t render_pass;
+		bool wireframe;
+		uint32_t bool_specializations;
+		RD::TextureSamples samples;
+	};
+
+	uint32_t cache_hash = 0; // Only computed when a manifest is in use.
+	LocalVector<ManifestKey> prewarm_keys; // Recorded by a previous run, compiled once their formats are known.
+	PipelineCacheRD *async_fallback = nullptr;
+
+	static bool async_compile;
+	static Manifest *manifest;
+
+	// Formats seen this run, so the format hashes stored in a manifest can be resolved to IDs.
+	static Mutex format_mutex;
+	static HashMap<RD::FramebufferFormatID, uint32_t> framebuffer_format_hashes;
+	static HashMap<RD::VertexFormatID, uint32_t> vertex_format_hashes;
+	static HashMap<uint32_t, RD::FramebufferFormatID> framebuffer_formats_by_hash;
+	static HashMap<uint32_t, RD::VertexFormatID> vertex_formats_by_hash;
+	static LocalVector<PipelineCacheRD *> prewarm_caches;
+
 	RID _generate_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations = 0);
+	RID _create_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations, RD::TextureSamples p_samples);
+	RID _request_version(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _compile_async(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	static void _compile_async_task(void *p_userdata);
+	RID _find_fallback(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+
+	uint32_t _hash_state() const;
+	void _record(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe, uint32_t p_render_pass, uint32_t p_bool_specializations);
+	void _prewarm();
+	static void _register_formats(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id);
 
 	void _clear();
 
 public:
+	static void set_async_compile(bool p_enable) { async_compile = p_enable; }
+	static bool is_async_compile_enabled() { return async_compile; }
+	static void set_manifest(Manifest *p_manifest) { manifest = p_manifest; }
+	static Manifest *get_manifest() { return manifest; }
+
+	// Formats are registered as pipelines request them, and cleared along with the RenderingDevice they belong to.
+	// Returns true if either format wasn't registered yet.
+	static bool register_format_hashes(RD::VertexFormatID p_vertex_format_id, uint32_t p_vertex_format_hash, RD::FramebufferFormatID p_framebuffer_format_id, uint32_t p_framebuffer_format_hash);
+	static void clear_formats();
+	// Moves the keys whose formats have been registered from r_keys to r_versions.
+	static void resolve_prewarm_keys(LocalVector<ManifestKey> &r_keys, bool p_wireframe, LocalVector<PrewarmVersion> &r_versions);
+
 	void setup(RID p_shader, RD::RenderPrimitive p_primitive, const RD::PipelineRasterizationState &p_rasterization_state, RD::PipelineMultisampleState p_multisample, const RD::PipelineDepthStencilState &p_depth_stencil_state, const RD::PipelineColorBlendState &p_blend_state, int p_dynamic_state_flags = 0, const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants = Vector<RD::PipelineSpecializationConstant>());
 	void update_specialization_constants(const Vector<RD::PipelineSpecializationConstant> &p_base_specialization_constants);
 	void update_shader(RID p_shader);
 
+	// Used while a version is compiling asynchronously and no other specialization of it is available yet.
+	// Must be compatible with the same formats, e.g. the equivalent pipeline of a default material.
+	void set_async_fallback(PipelineCacheRD *p_fallback) { async_fallback = p_fallback; }
+
 	_FORCE_INLINE_ RID get_render_pipeline(RD::VertexFormatID p_vertex_format_id, RD::FramebufferFormatID p_framebuffer_format_id, bool p_wireframe = false, uint32_t p_render_pass = 0, uint32_t p_bool_specializations = 0) {
 #ifdef DEBUG_ENABLED
 		ERR_FAIL_COND_V_MSG(shader.is_null(), RID(),
@@ -81,14 +181,16 @@ public:
 		RID result;
 		for (uint32_t i = 0; i < version_count; i++) {
 			if (versions[i].vertex_id == p_vertex_format_id && versions[i].framebuffer_id == p_framebuffer_format_id && versions[i].wireframe == p_wireframe && versions[i].render_pass == p_render_pass && versions[i].bool_specializations == p_bool_specializations) {
+				if (versions[i].task != WorkerThreadPool::INVALID_TASK_ID || versions[i].pipeline.is_null()) {
+					break; // Still compiling, or done but not awaited yet.
+				}
 				result = versions[i].pipeline;
 				spin_lock.unlock();
 				return result;
 			}
 		}
-		result = _generate_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 		spin_lock.unlock();
-		return result;
+		return _request_version(p_vertex_format_id, p_framebuffer_format_id, p_wireframe, p_render_pass, p_bool_specializations);
 	}
 
 	_FORCE_INLINE_ uint64_t get_vertex_input_mask() {
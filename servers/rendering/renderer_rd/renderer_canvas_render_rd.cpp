@@ -322,6 +322,45 @@ RendererCanvasRender::PolygonID RendererCanvasRenderRD::request_polygon(const Ve
 
 	pb.vertex_format_id = vertex_id;
 
+	bool skinned = (uint32_t)p_bones.size() == vertex_count * 4 && (uint32_t)p_weights.size() == vertex_count * 4;
+	uint32_t index_count = p_indices.size() ? p_indices.size() : vertex_count;
+	if (!skinned && index_count <= MAX_BATCHED_POLYGON_INDICES) {
+		pb.batchable = true;
+
+		for (int i = 0; i < p_indices.size(); i++) {
+			if (p_indices[i] < 0 || (uint32_t)p_indices[i] >= vertex_count) {
+				pb.batchable = false; // Drawing it as usual will report the error.
+				break;
+			}
+		}
+	}
+
+	if (pb.batchable) {
+		pb.batch_indices.resize(p_indices.size());
+		for (int i = 0; i < p_indices.size(); i++) {
+			pb.batch_indices[i] = p_indices[i];
+		}
+
+		pb.batch_points.resize(vertex_count);
+		for (uint32_t i = 0; i < vertex_count; i++) {
+			pb.batch_points[i] = p_points[i];
+		}
+
+		if ((uint32_t)p_colors.size() == vertex_count || p_colors.size() == 1) {
+			pb.batch_colors.resize(p_colors.size());
+			for (int i = 0; i < p_colors.size(); i++) {
+				pb.batch_colors[i] = p_colors[i];
+			}
+		}
+
+		if ((uint32_t)p_uvs.size() == vertex_count) {
+			pb.batch_uvs.resize(vertex_count);
+			for (uint32_t i = 0; i < vertex_count; i++) {
+				pb.batch_uvs[i] = p_uvs[i];
+			}
+		}
+	}
+
 	PolygonID id = polygon_buffers.last_id++;
 
 	polygon_buffers.polygons[id] = pb;
@@ -406,7 +445,7 @@ _FORCE_INLINE_ static uint32_t _indices_to_primitives(RS::PrimitiveType p_primit
 	return (p_indices - subtractor[p_primitive]) / divisor[p_primitive];
 }
 
-void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used, const Point2 &p_offset, RenderingMethod::RenderInfo *r_render_info) {
+void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RD::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used, const Point2 &p_offset, const BatchSpan *p_batch_spans, uint32_t p_batch_span_count, RenderingMethod::RenderInfo *r_render_info) {
 	//create an empty push constant
 	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
@@ -446,8 +485,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	push_constant.color_texture_pixel_size[0] = 0;
 	push_constant.color_texture_pixel_size[1] = 0;
 
-	push_constant.pad[0] = 0;
-	push_constant.pad[1] = 0;
+	push_constant.batch_offset = 0;
+	push_constant.pad = 0;
 
 	push_constant.lights[0] = 0;
 	push_constant.lights[1] = 0;
@@ -457,30 +496,10 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	uint32_t base_flags = 0;
 	base_flags |= use_linear_colors ? FLAGS_CONVERT_ATTRIBUTES_TO_LINEAR : 0;
 
-	uint16_t light_count = 0;
-	PipelineLightMode light_mode;
-
-	{
-		Light *light = p_lights;
-
-		while (light) {
-			if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
-				uint32_t light_index = light->render_index_cache;
-				push_constant.lights[light_count >> 2] |= light_index << ((light_count & 3) * 8);
-
-				light_count++;
-
-				if (light_count == MAX_LIGHTS_PER_ITEM - 1) {
-					break;
-				}
-			}
-			light = light->next_ptr;
-		}
-
-		base_flags |= light_count << FLAGS_LIGHT_COUNT_SHIFT;
-	}
+	uint32_t light_count = _get_item_lights(p_item, p_lights, push_constant.lights);
+	base_flags |= light_count << FLAGS_LIGHT_COUNT_SHIFT;
 
-	light_mode = (light_count > 0 || using_directional_lights) ? PIPELINE_LIGHT_MODE_ENABLED : PIPELINE_LIGHT_MODE_DISABLED;
+	PipelineLightMode light_mode = (light_count > 0 || using_directional_lights) ? PIPELINE_LIGHT_MODE_ENABLED : PIPELINE_LIGHT_MODE_DISABLED;
 
 	PipelineVariants *pipeline_variants = p_pipeline_variants;
 
@@ -490,6 +509,7 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 	Size2 texpixel_size;
 
 	bool skipping = false;
+	uint32_t batch_span_index = 0;
 
 	const Item::Command *c = p_item->commands;
 	while (c) {
@@ -500,6 +520,33 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 
 		push_constant.flags = base_flags | (push_constant.flags & (FLAGS_DEFAULT_NORMAL_MAP_USED | FLAGS_DEFAULT_SPECULAR_MAP_USED)); // Reset on each command for safety, keep canvastexture binding config.
 
+		if (batch_span_index < p_batch_span_count && p_batch_spans[batch_span_index].first == c) {
+			// Commands gathered by _gather_batches(), the whole batch is drawn when its first span is reached.
+			const BatchSpan &span = p_batch_spans[batch_span_index++];
+			if (span.batch >= 0) {
+				_render_batch(p_draw_list, state.batch_builder.batches[span.batch], pipeline_variants, light_mode, p_framebuffer_format, last_texture, push_constant, texpixel_size, r_render_info);
+			}
+
+			// Step over the span, transforms and tiling inside it still apply to the commands after it.
+			while (true) {
+				if (c->type == Item::Command::TYPE_TRANSFORM) {
+					const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
+					draw_transform = transform->xform;
+					_update_transform_2d_to_mat2x3(base_transform * transform->xform, push_constant.world);
+				} else if (c->type == Item::Command::TYPE_RECT && (static_cast<const Item::CommandRect *>(c)->flags & CANVAS_RECT_TILE)) {
+					current_repeat = RenderingServer::CanvasItemTextureRepeat::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+				}
+
+				if (c == span.last) {
+					break;
+				}
+				c = c->next;
+			}
+
+			c = c->next;
+			continue;
+		}
+
 		switch (c->type) {
 			case Item::Command::TYPE_RECT: {
 				const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
@@ -605,6 +652,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
 
+				state.batch_stats.unbatched_commands++;
+
 				if (r_render_info) {
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME]++;
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += 2;
@@ -680,6 +729,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
 				RD::get_singleton()->draw_list_draw(p_draw_list, true);
 
+				state.batch_stats.unbatched_commands++;
+
 				if (r_render_info) {
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME]++;
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += 2;
@@ -736,6 +787,8 @@ void RendererCanvasRenderRD::_render_item(RD::DrawListID p_draw_list, RID p_rend
 				}
 				RD::get_singleton()->draw_list_draw(p_draw_list, pb->indices.is_valid());
 
+				state.batch_stats.unbatched_commands++;
+
 				if (r_render_info) {
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME]++;
 					r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += _indices_to_primitives(polygon->primitive, pb->primitive_count);
@@ -1147,6 +1200,540 @@ RID RendererCanvasRenderRD::_create_base_uniform_set(RID p_to_render_target, boo
 	return uniform_set;
 }
 
+RID RendererCanvasRenderRD::_get_item_material(const Item *p_item) const {
+	RID material = p_item->material_owner == nullptr ? p_item->material : p_item->material_owner->material;
+
+	if (p_item->use_canvas_group) {
+		if (p_item->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_AND_DRAW) {
+			material = default_clip_children_material;
+		} else {
+			if (material.is_null()) {
+				if (p_item->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_ONLY) {
+					material = default_clip_children_material;
+				} else {
+					material = default_canvas_group_material;
+				}
+			}
+		}
+	}
+
+	return material;
+}
+
+bool RendererCanvasRenderRD::BatchKey::operator==(const BatchKey &p_key) const {
+	return type == p_key.type && material == p_key.material && clip == p_key.clip && use_lighting == p_key.use_lighting && texture == p_key.texture && filter == p_key.filter && repeat == p_key.repeat && msdf == p_key.msdf && px_range == p_key.px_range && outline == p_key.outline;
+}
+
+void RendererCanvasRenderRD::BatchBuilder::clear() {
+	instances.clear();
+	batches.clear();
+	spans.clear();
+	open = false;
+}
+
+RendererCanvasRenderRD::BatchInstance *RendererCanvasRenderRD::BatchBuilder::add_command(const BatchKey &p_key, uint32_t p_item, const Item::Command *p_command, uint32_t p_instance_count) {
+	if (open && batches[batches.size() - 1].key != p_key) {
+		break_batch();
+	}
+
+	if (!open) {
+		Batch batch;
+		batch.key = p_key;
+		batch.instance_offset = instances.size();
+		batch.first_span = spans.size();
+		batches.push_back(batch);
+		open = true;
+	}
+
+	uint32_t batch_index = batches.size() - 1;
+	Batch &batch = batches[batch_index];
+
+	if (spans.size() == batch.first_span || spans[spans.size() - 1].item != p_item) {
+		BatchSpan span;
+		span.item = p_item;
+		span.first = p_command;
+		span.batch = spans.size() == batch.first_span ? int32_t(batch_index) : -1;
+		spans.push_back(span);
+	}
+	spans[spans.size() - 1].last = p_command;
+
+	batch.command_count++;
+	batch.instance_count += p_instance_count;
+
+	uint32_t offset = instances.size();
+	instances.resize(offset + p_instance_count);
+	return instances.ptr() + offset;
+}
+
+void RendererCanvasRenderRD::BatchBuilder::break_batch() {
+	if (!open) {
+		return;
+	}
+	open = false;
+
+	const Batch &batch = batches[batches.size() - 1];
+	if (batch.command_count < 2) {
+		// Nothing to merge, the command is drawn as usual.
+		instances.resize(batch.instance_offset);
+		spans.resize(batch.first_span);
+		batches.resize(batches.size() - 1);
+	}
+}
+
+uint32_t RendererCanvasRenderRD::_get_item_lights(const Item *p_item, Light *p_lights, uint32_t *r_lights) const {
+	uint32_t light_count = 0;
+
+	for (int i = 0; i < 4; i++) {
+		r_lights[i] = 0;
+	}
+
+	Light *light = p_lights;
+
+	while (light) {
+		if (light->render_index_cache >= 0 && p_item->light_mask & light->item_mask && p_item->z_final >= light->z_min && p_item->z_final <= light->z_max && p_item->global_rect_cache.intersects_transformed(light->xform_cache, light->rect_cache)) {
+			uint32_t light_index = light->render_index_cache;
+			r_lights[light_count >> 2] |= light_index << ((light_count & 3) * 8);
+
+			light_count++;
+
+			if (light_count == MAX_LIGHTS_PER_ITEM - 1) {
+				break;
+			}
+		}
+		light = light->next_ptr;
+	}
+
+	return light_count;
+}
+
+// Part of one axis of a stretched nine-patch, in the same layout map_ninepatch_axis() uses in canvas.glsl.
+struct NinePatchAxisPart {
+	real_t dst_begin = 0.0;
+	real_t dst_size = 0.0;
+	real_t src_begin = 0.0;
+	real_t src_size = 0.0;
+	bool center = false;
+};
+
+// Splits a stretched nine-patch axis in its begin margin, center and end margin. Returns -1 if it can't be drawn as rects.
+static int _get_ninepatch_axis_parts(real_t p_draw_size, real_t p_source_size, real_t p_margin_begin, real_t p_margin_end, NinePatchAxisPart *r_parts) {
+	if (p_margin_begin < 0 || p_margin_end < 0 || p_source_size < p_margin_begin + p_margin_end) {
+		return -1;
+	}
+
+	int count = 0;
+
+	real_t begin_end = MIN(p_margin_begin, p_draw_size);
+	if (begin_end > 0) {
+		r_parts[count].dst_begin = 0;
+		r_parts[count].dst_size = begin_end;
+		r_parts[count].src_begin = 0;
+		r_parts[count].src_size = begin_end;
+		count++;
+	}
+
+	real_t end_begin = MAX(p_margin_begin, p_draw_size - p_margin_end);
+	if (end_begin > p_margin_begin) {
+		r_parts[count].dst_begin = p_margin_begin;
+		r_parts[count].dst_size = end_begin - p_margin_begin;
+		r_parts[count].src_begin = p_margin_begin;
+		r_parts[count].src_size = p_source_size - p_margin_begin - p_margin_end;
+		r_parts[count].center = true;
+		count++;
+	}
+
+	if (end_begin < p_draw_size) {
+		r_parts[count].dst_begin = end_begin;
+		r_parts[count].dst_size = p_draw_size - end_begin;
+		r_parts[count].src_begin = p_source_size - (p_draw_size - end_begin);
+		r_parts[count].src_size = p_draw_size - end_begin;
+		count++;
+	}
+
+	return count;
+}
+
+void RendererCanvasRenderRD::_gather_batches(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights) {
+	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
+	RendererRD::MaterialStorage *material_storage = RendererRD::MaterialStorage::get_singleton();
+
+	BatchBuilder &builder = state.batch_builder;
+	builder.clear();
+
+	bool use_linear_colors = texture_storage->render_target_is_using_hdr(p_to_render_target);
+
+	for (int i = 0; i < p_item_count; i++) {
+		const Item *ci = items[i];
+
+		if (ci->repeat_size.x || ci->repeat_size.y) {
+			builder.break_batch(); // Drawn once per repetition, each with its own offset.
+			continue;
+		}
+
+#ifdef DEBUG_ENABLED
+		if (debug_redraw && ci->debug_redraw_time > 0.0) {
+			builder.break_batch(); // The redraw overlay must be drawn after the item, and before the next ones.
+			continue;
+		}
+#endif
+
+		BatchKey key;
+		key.material = _get_item_material(ci);
+		if (key.material.is_valid()) {
+			CanvasMaterialData *material_data = static_cast<CanvasMaterialData *>(material_storage->material_get_data(key.material, RendererRD::MaterialStorage::SHADER_TYPE_2D));
+			if (material_data && material_data->shader_data->valid && (material_data->shader_data->uses_instance_id || material_data->shader_data->uses_vertex_id)) {
+				builder.break_batch(); // INSTANCE_ID and VERTEX_ID would no longer match the unbatched values.
+				continue;
+			}
+		}
+		key.clip = ci->final_clip_owner;
+		key.filter = ci->texture_filter != RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? ci->texture_filter : default_filter;
+
+		RS::CanvasItemTextureRepeat current_repeat = ci->texture_repeat != RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? ci->texture_repeat : default_repeat;
+
+		BatchInstance base_instance;
+		uint32_t light_count = _get_item_lights(ci, p_lights, base_instance.lights);
+		key.use_lighting = light_count > 0 || using_directional_lights;
+		base_instance.flags = light_count << FLAGS_LIGHT_COUNT_SHIFT;
+		base_instance.pad = 0;
+
+		Transform2D base_transform = p_canvas_transform_inverse * ci->final_transform;
+		_update_transform_2d_to_mat2x3(base_transform, base_instance.world);
+
+		Color base_color = ci->final_modulate;
+
+		bool item_batchable = true;
+		for (const Item::Command *c = ci->commands; c && item_batchable; c = c->next) {
+			switch (c->type) {
+				case Item::Command::TYPE_RECT: {
+					const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+
+					if (rect->flags & CANVAS_RECT_TILE) {
+						current_repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+					}
+
+					if (rect->flags & CANVAS_RECT_LCD) {
+						builder.break_batch(); // Needs its own blend constants.
+						break;
+					}
+
+					key.type = BATCH_TYPE_RECTS;
+					key.texture = rect->texture;
+					key.repeat = current_repeat;
+					key.msdf = rect->flags & CANVAS_RECT_MSDF;
+					key.px_range = key.msdf ? rect->px_range : 0.0;
+					key.outline = key.msdf ? rect->outline : 0.0;
+
+					BatchInstance *instance = builder.add_command(key, i, c, 1);
+					*instance = base_instance;
+
+					Rect2 src_rect = Rect2(0, 0, 1, 1);
+					Rect2 dst_rect = Rect2(rect->rect.position, rect->rect.size);
+
+					if (dst_rect.size.width < 0) {
+						dst_rect.position.x += dst_rect.size.width;
+						dst_rect.size.width *= -1;
+					}
+					if (dst_rect.size.height < 0) {
+						dst_rect.position.y += dst_rect.size.height;
+						dst_rect.size.height *= -1;
+					}
+
+					if (rect->texture != RID()) {
+						if (rect->flags & CANVAS_RECT_REGION) {
+							// Texture size is only known once bound, the shader scales the region to UV.
+							src_rect = rect->source;
+							instance->flags |= FLAGS_REGION_IN_PIXELS;
+						}
+
+						if (rect->flags & CANVAS_RECT_FLIP_H) {
+							src_rect.size.x *= -1;
+							instance->flags |= FLAGS_FLIP_H;
+						}
+
+						if (rect->flags & CANVAS_RECT_FLIP_V) {
+							src_rect.size.y *= -1;
+							instance->flags |= FLAGS_FLIP_V;
+						}
+
+						if (rect->flags & CANVAS_RECT_TRANSPOSE) {
+							instance->flags |= FLAGS_TRANSPOSE_RECT;
+						}
+
+						if (rect->flags & CANVAS_RECT_CLIP_UV) {
+							instance->flags |= FLAGS_CLIP_RECT_UV;
+						}
+					}
+
+					Color modulated = rect->modulate * base_color;
+					if (use_linear_colors) {
+						modulated = modulated.srgb_to_linear();
+					}
+
+					instance->modulation[0] = modulated.r;
+					instance->modulation[1] = modulated.g;
+					instance->modulation[2] = modulated.b;
+					instance->modulation[3] = modulated.a;
+
+					instance->src_rect[0] = src_rect.position.x;
+					instance->src_rect[1] = src_rect.position.y;
+					instance->src_rect[2] = src_rect.size.width;
+					instance->src_rect[3] = src_rect.size.height;
+
+					instance->dst_rect[0] = dst_rect.position.x;
+					instance->dst_rect[1] = dst_rect.position.y;
+					instance->dst_rect[2] = dst_rect.size.width;
+					instance->dst_rect[3] = dst_rect.size.height;
+				} break;
+				case Item::Command::TYPE_NINEPATCH: {
+					const Item::CommandNinePatch *np = static_cast<const Item::CommandNinePatch *>(c);
+
+					// Only stretched nine-patches can be split in rects, tiling needs the nine-patch shader.
+					if (np->axis_x != RS::NINE_PATCH_STRETCH || np->axis_y != RS::NINE_PATCH_STRETCH || np->rect.size.x < 0 || np->rect.size.y < 0) {
+						builder.break_batch();
+						break;
+					}
+
+					Rect2 source = np->source;
+					if (np->texture.is_valid() && source == Rect2()) {
+						source.size = texture_storage->texture_2d_get_size(np->texture);
+					}
+					if (np->texture.is_valid() && (source.size.x <= 0 || source.size.y <= 0)) {
+						builder.break_batch(); // Not a plain 2D texture, its size is only known once bound.
+						break;
+					}
+
+					// Margins are mapped in pixels of the source, the same as an untextured nine-patch with a 1x1 texture.
+					Size2 source_size = np->texture.is_valid() ? source.size : np->rect.size;
+
+					NinePatchAxisPart parts_x[3];
+					NinePatchAxisPart parts_y[3];
+					int count_x = _get_ninepatch_axis_parts(np->rect.size.x, source_size.x, np->margin[SIDE_LEFT], np->margin[SIDE_RIGHT], parts_x);
+					int count_y = _get_ninepatch_axis_parts(np->rect.size.y, source_size.y, np->margin[SIDE_TOP], np->margin[SIDE_BOTTOM], parts_y);
+					if (count_x < 0 || count_y < 0) {
+						builder.break_batch();
+						break;
+					}
+
+					uint32_t rect_count = 0;
+					for (int y = 0; y < count_y; y++) {
+						for (int x = 0; x < count_x; x++) {
+							if (np->draw_center || !parts_x[x].center || !parts_y[y].center) {
+								rect_count++;
+							}
+						}
+					}
+					if (rect_count == 0) {
+						break; // Nothing visible.
+					}
+
+					key.type = BATCH_TYPE_RECTS;
+					key.texture = np->texture;
+					key.repeat = current_repeat;
+					key.msdf = false;
+					key.px_range = 0.0;
+					key.outline = 0.0;
+
+					Color modulated = np->color * base_color;
+					if (use_linear_colors) {
+						modulated = modulated.srgb_to_linear();
+					}
+
+					BatchInstance *instance = builder.add_command(key, i, c, rect_count);
+					for (int y = 0; y < count_y; y++) {
+						for (int x = 0; x < count_x; x++) {
+							if (!np->draw_center && parts_x[x].center && parts_y[y].center) {
+								continue;
+							}
+
+							*instance = base_instance;
+
+							instance->modulation[0] = modulated.r;
+							instance->modulation[1] = modulated.g;
+							instance->modulation[2] = modulated.b;
+							instance->modulation[3] = modulated.a;
+
+							instance->dst_rect[0] = np->rect.position.x + parts_x[x].dst_begin;
+							instance->dst_rect[1] = np->rect.position.y + parts_y[y].dst_begin;
+							instance->dst_rect[2] = parts_x[x].dst_size;
+							instance->dst_rect[3] = parts_y[y].dst_size;
+
+							if (np->texture.is_valid()) {
+								instance->flags |= FLAGS_REGION_IN_PIXELS;
+								instance->src_rect[0] = source.position.x + parts_x[x].src_begin;
+								instance->src_rect[1] = source.position.y + parts_y[y].src_begin;
+								instance->src_rect[2] = parts_x[x].src_size;
+								instance->src_rect[3] = parts_y[y].src_size;
+							} else {
+								instance->src_rect[0] = 0;
+								instance->src_rect[1] = 0;
+								instance->src_rect[2] = 1;
+								instance->src_rect[3] = 1;
+							}
+
+							instance++;
+						}
+					}
+				} break;
+				case Item::Command::TYPE_POLYGON: {
+					const Item::CommandPolygon *polygon = static_cast<const Item::CommandPolygon *>(c);
+
+					const PolygonBuffers *pb = polygon_buffers.polygons.getptr(polygon->polygon.polygon_id);
+					if (!pb || !pb->batchable || (polygon->primitive != RS::PRIMITIVE_TRIANGLES && polygon->primitive != RS::PRIMITIVE_TRIANGLE_STRIP)) {
+						builder.break_batch();
+						break;
+					}
+
+					uint32_t index_count = pb->batch_indices.is_empty() ? pb->batch_points.size() : pb->batch_indices.size();
+					uint32_t vertex_count;
+					if (polygon->primitive == RS::PRIMITIVE_TRIANGLES) {
+						vertex_count = index_count - index_count % 3;
+					} else {
+						vertex_count = index_count >= 3 ? (index_count - 2) * 3 : 0; // Strips are expanded to a triangle list.
+					}
+					if (vertex_count == 0) {
+						builder.break_batch();
+						break;
+					}
+
+					key.type = BATCH_TYPE_VERTICES;
+					key.texture = polygon->texture;
+					key.repeat = current_repeat;
+					key.msdf = false;
+					key.px_range = 0.0;
+					key.outline = 0.0;
+
+					Color modulation = base_color;
+					if (use_linear_colors) {
+						modulation = modulation.srgb_to_linear();
+					}
+
+					BatchInstance *instance = builder.add_command(key, i, c, vertex_count);
+					for (uint32_t j = 0; j < vertex_count; j++) {
+						// Strip triangle t is made of elements t, t + 1 and t + 2, winding doesn't matter as canvas doesn't cull.
+						uint32_t element = polygon->primitive == RS::PRIMITIVE_TRIANGLES ? j : j / 3 + j % 3;
+						uint32_t index = pb->batch_indices.is_empty() ? element : uint32_t(pb->batch_indices[element]);
+
+						instance[j] = base_instance;
+
+						Color color = Color(1, 1, 1, 1);
+						if (pb->batch_colors.size() == 1) {
+							color = pb->batch_colors[0];
+						} else if (!pb->batch_colors.is_empty()) {
+							color = pb->batch_colors[index];
+						}
+						if (use_linear_colors) {
+							color = color.srgb_to_linear();
+						}
+						color *= modulation;
+
+						instance[j].modulation[0] = color.r;
+						instance[j].modulation[1] = color.g;
+						instance[j].modulation[2] = color.b;
+						instance[j].modulation[3] = color.a;
+
+						Vector2 uv = pb->batch_uvs.is_empty() ? Vector2() : pb->batch_uvs[index];
+
+						instance[j].dst_rect[0] = pb->batch_points[index].x;
+						instance[j].dst_rect[1] = pb->batch_points[index].y;
+						instance[j].dst_rect[2] = 0;
+						instance[j].dst_rect[3] = 0;
+
+						instance[j].src_rect[0] = uv.x;
+						instance[j].src_rect[1] = uv.y;
+						instance[j].src_rect[2] = 0;
+						instance[j].src_rect[3] = 0;
+					}
+				} break;
+				case Item::Command::TYPE_TRANSFORM: {
+					const Item::CommandTransform *transform = static_cast<const Item::CommandTransform *>(c);
+					_update_transform_2d_to_mat2x3(base_transform * transform->xform, base_instance.world);
+				} break;
+				case Item::Command::TYPE_CLIP_IGNORE:
+				case Item::Command::TYPE_ANIMATION_SLICE: {
+					// Scissor and visibility of the following commands are only known while drawing.
+					builder.break_batch();
+					item_batchable = false;
+				} break;
+				default: {
+					builder.break_batch();
+				} break;
+			}
+		}
+	}
+
+	builder.break_batch();
+
+	if (builder.instances.is_empty()) {
+		return;
+	}
+
+	if (builder.instances.size() > state.batch_buffer_size) {
+		if (state.batch_buffer.is_valid()) {
+			RD::get_singleton()->free(state.batch_buffer); // Also frees the uniform set depending on it.
+		}
+
+		state.batch_buffer_size = MAX(nearest_power_of_2_templated(builder.instances.size()), 256u);
+		state.batch_buffer = RD::get_singleton()->storage_buffer_create(sizeof(BatchInstance) * state.batch_buffer_size);
+
+		Vector<RD::Uniform> uniforms;
+		{
+			RD::Uniform u;
+			u.uniform_type = RD::UNIFORM_TYPE_STORAGE_BUFFER;
+			u.binding = 0;
+			u.append_id(state.batch_buffer);
+			uniforms.push_back(u);
+		}
+
+		state.batch_uniform_set = RD::get_singleton()->uniform_set_create(uniforms, shader.default_version_rd_shader, TRANSFORMS_UNIFORM_SET);
+	}
+
+	RD::get_singleton()->buffer_update(state.batch_buffer, 0, sizeof(BatchInstance) * builder.instances.size(), builder.instances.ptr());
+}
+
+void RendererCanvasRenderRD::_render_batch(RD::DrawListID p_draw_list, const Batch &p_batch, PipelineVariants *p_pipeline_variants, PipelineLightMode p_light_mode, RD::FramebufferFormatID p_framebuffer_format, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size, RenderingMethod::RenderInfo *r_render_info) {
+	RID pipeline = p_pipeline_variants->variants[p_light_mode][PIPELINE_VARIANT_QUAD_BATCHED].get_render_pipeline(RD::INVALID_ID, p_framebuffer_format);
+	RD::get_singleton()->draw_list_bind_render_pipeline(p_draw_list, pipeline);
+
+	_bind_canvas_texture(p_draw_list, p_batch.key.texture, p_batch.key.filter, p_batch.key.repeat, r_last_texture, push_constant, r_texpixel_size, p_batch.key.msdf);
+
+	if (p_batch.key.msdf) {
+		push_constant.flags |= FLAGS_USE_MSDF;
+		push_constant.msdf[0] = p_batch.key.px_range; // Pixel range.
+		push_constant.msdf[1] = p_batch.key.outline; // Outline size.
+		push_constant.msdf[2] = 0.f; // Reserved.
+		push_constant.msdf[3] = 0.f; // Reserved.
+	}
+
+	push_constant.batch_offset = p_batch.instance_offset;
+
+	RD::get_singleton()->draw_list_bind_uniform_set(p_draw_list, state.batch_uniform_set, TRANSFORMS_UNIFORM_SET);
+
+	uint32_t primitives;
+	if (p_batch.key.type == BATCH_TYPE_VERTICES) {
+		push_constant.flags |= FLAGS_BATCH_VERTICES;
+		RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+		RD::get_singleton()->draw_list_draw(p_draw_list, false, 1, p_batch.instance_count);
+		primitives = p_batch.instance_count / 3;
+	} else {
+		RD::get_singleton()->draw_list_set_push_constant(p_draw_list, &push_constant, sizeof(PushConstant));
+		RD::get_singleton()->draw_list_bind_index_array(p_draw_list, shader.quad_index_array);
+		RD::get_singleton()->draw_list_draw(p_draw_list, true, p_batch.instance_count);
+		primitives = 2 * p_batch.instance_count;
+	}
+
+	push_constant.batch_offset = 0;
+
+	state.batch_stats.batches++;
+	state.batch_stats.batched_commands += p_batch.command_count;
+
+	if (r_render_info) {
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_OBJECTS_IN_FRAME] += p_batch.command_count;
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += primitives;
+		r_render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_CANVAS][RS::VIEWPORT_RENDER_INFO_DRAW_CALLS_IN_FRAME]++;
+	}
+}
+
 void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer, RenderingMethod::RenderInfo *r_render_info) {
 	RendererRD::MaterialStorage *material_storage = RendererRD::MaterialStorage::get_singleton();
 	RendererRD::TextureStorage *texture_storage = RendererRD::TextureStorage::get_singleton();
@@ -1182,6 +1769,8 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	RD::FramebufferFormatID fb_format = RD::get_singleton()->framebuffer_get_format(framebuffer);
 
+	_gather_batches(p_to_render_target, p_item_count, canvas_transform_inverse, p_lights);
+
 	RD::DrawListID draw_list = RD::get_singleton()->draw_list_begin(framebuffer, clear ? RD::INITIAL_ACTION_CLEAR : RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_STORE, RD::INITIAL_ACTION_LOAD, RD::FINAL_ACTION_DISCARD, clear_colors);
 
 	RD::get_singleton()->draw_list_bind_uniform_set(draw_list, fb_uniform_set, BASE_UNIFORM_SET);
@@ -1191,6 +1780,9 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 	PipelineVariants *pipeline_variants = &shader.pipeline_variants;
 
+	const LocalVector<BatchSpan> &batch_spans = state.batch_builder.spans;
+	uint32_t batch_span_index = 0;
+
 	for (int i = 0; i < p_item_count; i++) {
 		Item *ci = items[i];
 
@@ -1206,21 +1798,7 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 			}
 		}
 
-		RID material = ci->material_owner == nullptr ? ci->material : ci->material_owner->material;
-
-		if (ci->use_canvas_group) {
-			if (ci->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_AND_DRAW) {
-				material = default_clip_children_material;
-			} else {
-				if (material.is_null()) {
-					if (ci->canvas_group->mode == RS::CANVAS_GROUP_MODE_CLIP_ONLY) {
-						material = default_clip_children_material;
-					} else {
-						material = default_canvas_group_material;
-					}
-				}
-			}
-		}
+		RID material = _get_item_material(ci);
 
 		if (material != prev_material) {
 			CanvasMaterialData *material_data = nullptr;
@@ -1245,8 +1823,15 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 			}
 		}
 
+		uint32_t first_batch_span = batch_span_index;
+		while (batch_span_index < batch_spans.size() && batch_spans[batch_span_index].item == uint32_t(i)) {
+			batch_span_index++;
+		}
+		const BatchSpan *item_batch_spans = batch_spans.ptr() + first_batch_span;
+		uint32_t item_batch_span_count = batch_span_index - first_batch_span;
+
 		if (!ci->repeat_size.x && !ci->repeat_size.y) {
-			_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, r_sdf_used, Point2(), r_render_info);
+			_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, r_sdf_used, Point2(), item_batch_spans, item_batch_span_count, r_render_info);
 		} else {
 			Point2 start_pos = ci->repeat_size * -(ci->repeat_times / 2);
 			Point2 end_pos = ci->repeat_size * ci->repeat_times + ci->repeat_size + start_pos;
@@ -1254,7 +1839,7 @@ void RendererCanvasRenderRD::_render_items(RID p_to_render_target, int p_item_co
 
 			do {
 				do {
-					_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, r_sdf_used, pos, r_render_info);
+					_render_item(draw_list, p_to_render_target, ci, fb_format, canvas_transform_inverse, current_clip, p_lights, pipeline_variants, r_sdf_used, pos, item_batch_spans, item_batch_span_count, r_render_info);
 					pos.y += ci->repeat_size.y;
 				} while (pos.y < end_pos.y);
 
@@ -1275,6 +1860,14 @@ void RendererCanvasRenderRD::canvas_render_items(RID p_to_render_target, Item *p
 	RendererRD::MeshStorage *mesh_storage = RendererRD::MeshStorage::get_singleton();
 
 	r_sdf_used = false;
+
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	if (state.batch_stats_frame != frame) {
+		// Publish the totals of the previous frame, unless no canvas was drawn in it.
+		state.last_batch_stats = state.batch_stats_frame + 1 == frame ? state.batch_stats : BatchStats();
+		state.batch_stats = BatchStats();
+		state.batch_stats_frame = frame;
+	}
 	int item_count = 0;
 
 	//setup canvas state uniforms if needed
@@ -2162,6 +2755,8 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 	uses_screen_texture_mipmaps = false;
 	uses_sdf = false;
 	uses_time = false;
+	uses_instance_id = false;
+	uses_vertex_id = false;
 
 	if (code.is_empty()) {
 		return; //just invalid, but no error
@@ -2185,6 +2780,8 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 
 	actions.usage_flag_pointers["texture_sdf"] = &uses_sdf;
 	actions.usage_flag_pointers["TIME"] = &uses_time;
+	actions.usage_flag_pointers["INSTANCE_ID"] = &uses_instance_id;
+	actions.usage_flag_pointers["VERTEX_ID"] = &uses_vertex_id;
 
 	actions.uniforms = &uniforms;
 
@@ -2317,6 +2914,7 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 				RD::RENDER_PRIMITIVE_LINESTRIPS,
 				RD::RENDER_PRIMITIVE_POINTS,
 				RD::RENDER_PRIMITIVE_TRIANGLES,
+				RD::RENDER_PRIMITIVE_TRIANGLES,
 			};
 
 			ShaderVariant shader_variants[PIPELINE_LIGHT_MODE_MAX][PIPELINE_VARIANT_MAX] = {
@@ -2333,6 +2931,7 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 						SHADER_VARIANT_ATTRIBUTES,
 						SHADER_VARIANT_ATTRIBUTES_POINTS,
 						SHADER_VARIANT_QUAD,
+						SHADER_VARIANT_QUAD_BATCHED,
 				},
 				{
 						//lit
@@ -2347,6 +2946,7 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 						SHADER_VARIANT_ATTRIBUTES_LIGHT,
 						SHADER_VARIANT_ATTRIBUTES_POINTS_LIGHT,
 						SHADER_VARIANT_QUAD_LIGHT,
+						SHADER_VARIANT_QUAD_BATCHED_LIGHT,
 				},
 			};
 
@@ -2356,6 +2956,8 @@ void RendererCanvasRenderRD::CanvasShaderData::set_code(const String &p_code) {
 			} else {
 				pipeline_variants.variants[i][j].setup(shader_variant, primitive[j], RD::PipelineRasterizationState(), RD::PipelineMultisampleState(), RD::PipelineDepthStencilState(), blend_state, 0);
 			}
+			// Draw with the default shader while compiling in the background.
+			pipeline_variants.variants[i][j].set_async_fallback(&canvas_singleton->shader.pipeline_variants.variants[i][j]);
 		}
 	}
 
@@ -2457,6 +3059,9 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 		variants.push_back("#define USE_LIGHTING\n#define USE_PRIMITIVE\n#define USE_POINT_SIZE\n"); //points need point size
 		variants.push_back("#define USE_LIGHTING\n#define USE_ATTRIBUTES\n"); // attributes for vertex arrays
 		variants.push_back("#define USE_LIGHTING\n#define USE_ATTRIBUTES\n#define USE_POINT_SIZE\n"); //attributes with point size
+		//batched rect variants
+		variants.push_back("#define USE_BATCHING\n"); //rects read from the batch instance buffer
+		variants.push_back("#define USE_LIGHTING\n#define USE_BATCHING\n"); //lit batched rects
 
 		shader.canvas_shader.initialize(variants, global_defines);
 
@@ -2503,6 +3108,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 					RD::RENDER_PRIMITIVE_LINESTRIPS,
 					RD::RENDER_PRIMITIVE_POINTS,
 					RD::RENDER_PRIMITIVE_TRIANGLES,
+					RD::RENDER_PRIMITIVE_TRIANGLES,
 				};
 
 				ShaderVariant shader_variants[PIPELINE_LIGHT_MODE_MAX][PIPELINE_VARIANT_MAX] = {
@@ -2519,6 +3125,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 							SHADER_VARIANT_ATTRIBUTES,
 							SHADER_VARIANT_ATTRIBUTES_POINTS,
 							SHADER_VARIANT_QUAD,
+							SHADER_VARIANT_QUAD_BATCHED,
 					},
 					{
 							//lit
@@ -2533,6 +3140,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 							SHADER_VARIANT_ATTRIBUTES_LIGHT,
 							SHADER_VARIANT_ATTRIBUTES_POINTS_LIGHT,
 							SHADER_VARIANT_QUAD_LIGHT,
+							SHADER_VARIANT_QUAD_BATCHED_LIGHT,
 					},
 				};
 
@@ -2621,7 +3229,7 @@ RendererCanvasRenderRD::RendererCanvasRenderRD() {
 		actions.base_uniform_string = "material.";
 		actions.default_filter = ShaderLanguage::FILTER_LINEAR;
 		actions.default_repeat = ShaderLanguage::REPEAT_DISABLE;
-		actions.base_varying_index = 4;
+		actions.base_varying_index = 7;
 
 		actions.global_buffer_array_variable = "global_shader_uniforms.data";
 
@@ -2830,6 +3438,7 @@ void fragment() {
 	}
 
 	static_assert(sizeof(PushConstant) == 128);
+	static_assert(sizeof(BatchInstance) == 96); // Read as 6 vec4 per instance by the batched shader variant.
 }
 
 bool RendererCanvasRenderRD::free(RID p_rid) {
@@ -2879,6 +3488,19 @@ void RendererCanvasRenderRD::set_debug_redraw(bool p_enabled, double p_time, con
 	debug_redraw_color = p_color;
 }
 
+uint64_t RendererCanvasRenderRD::get_rendering_info(RS::RenderingInfo p_info) {
+	switch (p_info) {
+		case RS::RENDERING_INFO_CANVAS_BATCHES_IN_FRAME:
+			return state.last_batch_stats.batches;
+		case RS::RENDERING_INFO_CANVAS_BATCHED_COMMANDS_IN_FRAME:
+			return state.last_batch_stats.batched_commands;
+		case RS::RENDERING_INFO_CANVAS_UNBATCHED_COMMANDS_IN_FRAME:
+			return state.last_batch_stats.unbatched_commands;
+		default:
+			return 0;
+	}
+}
+
 RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 	RendererRD::MaterialStorage *material_storage = RendererRD::MaterialStorage::get_singleton();
 	//canvas state
@@ -2896,6 +3518,10 @@ RendererCanvasRenderRD::~RendererCanvasRenderRD() {
 
 		memdelete_arr(state.light_uniforms);
 		RD::get_singleton()->free(state.lights_uniform_buffer);
+
+		if (state.batch_buffer.is_valid()) {
+			RD::get_singleton()->free(state.batch_buffer);
+		}
 	}
 
 	//shadow rendering
@@ -31,6 +31,7 @@
 #ifndef RENDERER_CANVAS_RENDER_RD_H
 #define RENDERER_CANVAS_RENDER_RD_H
 
+#include "core/templates/local_vector.h"
 #include "servers/rendering/renderer_canvas_render.h"
 #include "servers/rendering/renderer_compositor.h"
 #include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
@@ -41,6 +42,81 @@
 #include "servers/rendering/shader_compiler.h"
 
 class RendererCanvasRenderRD : public RendererCanvasRender {
+public:
+	// Per frame totals, published once the next frame starts rendering.
+	struct BatchStats {
+		uint32_t batches = 0; // Draw calls made for batches.
+		uint32_t batched_commands = 0; // Rects, nine-patches and polygons drawn as part of a batch.
+		uint32_t unbatched_commands = 0; // Rects, nine-patches and polygons drawn on their own.
+	};
+
+	enum BatchType {
+		BATCH_TYPE_RECTS, // One instanced quad per rect.
+		BATCH_TYPE_VERTICES, // Triangle list, one instance entry per vertex.
+	};
+
+	// State that must match for consecutive commands to share a batch. Batches can span items,
+	// so per item state (transform, modulation and lights) is stored per instance instead.
+	struct BatchKey {
+		BatchType type = BATCH_TYPE_RECTS;
+		RID material;
+		const Item *clip = nullptr;
+		bool use_lighting = false;
+		RID texture;
+		RS::CanvasItemTextureFilter filter = RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT;
+		RS::CanvasItemTextureRepeat repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT;
+		bool msdf = false;
+		float px_range = 0.0; // MSDF only.
+		float outline = 0.0; // MSDF only.
+
+		bool operator==(const BatchKey &p_key) const;
+		bool operator!=(const BatchKey &p_key) const { return !(*this == p_key); }
+	};
+
+	// Read as 6 vec4 per rect or polygon vertex by the batched shader variant.
+	struct BatchInstance {
+		float modulation[4];
+		float dst_rect[4]; // Polygon vertices store their position in xy.
+		float src_rect[4]; // Polygon vertices store their UV in xy.
+		float world[6];
+		uint32_t flags;
+		uint32_t pad;
+		uint32_t lights[4];
+	};
+
+	struct Batch {
+		BatchKey key;
+		uint32_t instance_offset = 0;
+		uint32_t instance_count = 0;
+		uint32_t command_count = 0;
+		uint32_t first_span = 0;
+	};
+
+	// Commands of one item that belong to a batch, from first to last. The batch is drawn when its first span is
+	// reached and the commands of all its spans are skipped, except transforms which still apply to later commands.
+	struct BatchSpan {
+		uint32_t item = 0;
+		const Item::Command *first = nullptr;
+		const Item::Command *last = nullptr;
+		int32_t batch = -1; // Batch drawn at this span, -1 if an earlier span of the batch already drew it.
+	};
+
+	// Groups batchable commands in drawing order. A run of a single command is not kept as a batch,
+	// that command is drawn through its regular path instead.
+	struct BatchBuilder {
+		LocalVector<BatchInstance> instances;
+		LocalVector<Batch> batches;
+		LocalVector<BatchSpan> spans;
+		bool open = false;
+
+		void clear();
+		// Adds a command to the open batch, or starts a new one if the key differs. Returns the instances to fill.
+		BatchInstance *add_command(const BatchKey &p_key, uint32_t p_item, const Item::Command *p_command, uint32_t p_instance_count);
+		// Closes the open batch, for commands that can't be batched or state that can't be shared.
+		void break_batch();
+	};
+
+private:
 	enum {
 		BASE_UNIFORM_SET = 0,
 		MATERIAL_UNIFORM_SET = 1,
@@ -63,6 +139,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		SHADER_VARIANT_PRIMITIVE_POINTS_LIGHT,
 		SHADER_VARIANT_ATTRIBUTES_LIGHT,
 		SHADER_VARIANT_ATTRIBUTES_POINTS_LIGHT,
+		SHADER_VARIANT_QUAD_BATCHED,
+		SHADER_VARIANT_QUAD_BATCHED_LIGHT,
 		SHADER_VARIANT_MAX
 	};
 
@@ -79,11 +157,13 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		FLAGS_NINEPACH_DRAW_CENTER = (1 << 12),
 		FLAGS_USING_PARTICLES = (1 << 13),
+		FLAGS_REGION_IN_PIXELS = (1 << 14), // Batched rects only, source rect must be scaled by the texture pixel size.
 
 		FLAGS_USE_SKELETON = (1 << 15),
 		FLAGS_NINEPATCH_H_MODE_SHIFT = 16,
 		FLAGS_NINEPATCH_V_MODE_SHIFT = 18,
 		FLAGS_LIGHT_COUNT_SHIFT = 20,
+		FLAGS_BATCH_VERTICES = (1 << 24), // Batched draws only, instances are polygon vertices instead of rects.
 
 		FLAGS_DEFAULT_NORMAL_MAP_USED = (1 << 26),
 		FLAGS_DEFAULT_SPECULAR_MAP_USED = (1 << 27),
@@ -112,7 +192,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		MAX_RENDER_ITEMS = 256 * 1024,
 		MAX_LIGHT_TEXTURES = 1024,
 		MAX_LIGHTS_PER_ITEM = 16,
-		DEFAULT_MAX_LIGHTS_PER_RENDER = 256
+		DEFAULT_MAX_LIGHTS_PER_RENDER = 256,
+		MAX_BATCHED_POLYGON_INDICES = 256,
 	};
 
 	/****************/
@@ -131,6 +212,7 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		PIPELINE_VARIANT_ATTRIBUTE_LINES_STRIP,
 		PIPELINE_VARIANT_ATTRIBUTE_POINTS,
 		PIPELINE_VARIANT_QUAD_LCD_BLEND,
+		PIPELINE_VARIANT_QUAD_BATCHED,
 		PIPELINE_VARIANT_MAX
 	};
 	enum PipelineLightMode {
@@ -179,6 +261,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		bool uses_screen_texture_mipmaps = false;
 		bool uses_sdf = false;
 		bool uses_time = false;
+		bool uses_instance_id = false;
+		bool uses_vertex_id = false;
 
 		virtual void set_code(const String &p_Code);
 		virtual bool is_animated() const;
@@ -230,6 +314,13 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 		RID index_buffer;
 		RID indices;
 		uint32_t primitive_count = 0;
+
+		// Small polygons without skinning keep their arrays, so they can be merged into batches.
+		bool batchable = false;
+		LocalVector<int> batch_indices; // Empty if not indexed.
+		LocalVector<Vector2> batch_points;
+		LocalVector<Color> batch_colors; // Empty, a single color or one per point.
+		LocalVector<Vector2> batch_uvs; // Empty or one per point.
 	};
 
 	struct {
@@ -370,6 +461,17 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 
 		RID default_transforms_uniform_set;
 
+		// Consecutive compatible rects, nine-patches and polygons are drawn with a single draw call, even across items.
+		// Batches are gathered for all items before the draw list begins, as buffers can't be updated while it's open.
+		BatchBuilder batch_builder;
+		RID batch_buffer;
+		RID batch_uniform_set;
+		uint32_t batch_buffer_size = 0; // In instances.
+
+		BatchStats batch_stats; // Frame being rendered.
+		BatchStats last_batch_stats; // Last complete frame.
+		uint64_t batch_stats_frame = 0;
+
 		uint32_t max_lights_per_render;
 		uint32_t max_lights_per_item;
 
@@ -391,7 +493,8 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 				};
 				float dst_rect[4];
 				float src_rect[4];
-				float pad[2];
+				uint32_t batch_offset; // First instance of a batch.
+				uint32_t pad;
 			};
 			//primitive
 			struct {
@@ -424,7 +527,11 @@ class RendererCanvasRenderRD : public RendererCanvasRender {
 	double debug_redraw_time = 1.0;
 
 	inline void _bind_canvas_texture(RD::DrawListID p_draw_list, RID p_texture, RS::CanvasItemTextureFilter p_base_filter, RS::CanvasItemTextureRepeat p_base_repeat, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size, bool p_texture_is_data = false); //recursive, so regular inline used instead.
-	void _render_item(RenderingDevice::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used, const Point2 &p_offset, RenderingMethod::RenderInfo *r_render_info = nullptr);
+	RID _get_item_material(const Item *p_item) const;
+	uint32_t _get_item_lights(const Item *p_item, Light *p_lights, uint32_t *r_lights) const;
+	void _gather_batches(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights);
+	void _render_batch(RD::DrawListID p_draw_list, const Batch &p_batch, PipelineVariants *p_pipeline_variants, PipelineLightMode p_light_mode, RD::FramebufferFormatID p_framebuffer_format, RID &r_last_texture, PushConstant &push_constant, Size2 &r_texpixel_size, RenderingMethod::RenderInfo *r_render_info);
+	void _render_item(RenderingDevice::DrawListID p_draw_list, RID p_render_target, const Item *p_item, RenderingDevice::FramebufferFormatID p_framebuffer_format, const Transform2D &p_canvas_transform_inverse, Item *&current_clip, Light *p_lights, PipelineVariants *p_pipeline_variants, bool &r_sdf_used, const Point2 &p_offset, const BatchSpan *p_batch_spans, uint32_t p_batch_span_count, RenderingMethod::RenderInfo *r_render_info = nullptr);
 	void _render_items(RID p_to_render_target, int p_item_count, const Transform2D &p_canvas_transform_inverse, Light *p_lights, bool &r_sdf_used, bool p_to_backbuffer = false, RenderingMethod::RenderInfo *r_render_info = nullptr);
 
 	_FORCE_INLINE_ void _update_transform_2d_to_mat2x4(const Transform2D &p_transform, float *p_mat2x4);
@@ -457,6 +564,9 @@ public:
 
 	void set_debug_redraw(bool p_enabled, double p_time, const Color &p_color) override;
 
+	const BatchStats &get_batch_stats() const { return state.last_batch_stats; }
+	virtual uint64_t get_rendering_info(RS::RenderingInfo p_info) override;
+
 	void set_time(double p_time);
 	void update() override;
 	bool free(RID p_rid) override;
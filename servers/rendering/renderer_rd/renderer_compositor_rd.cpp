@@ -158,6 +158,17 @@ void RendererCompositorRD::finalize() {
 	memdelete(texture_storage);
 	memdelete(utilities);
 
+	if (pipeline_manifest) {
+		// All pipeline caches are gone at this point, so nothing is recorded anymore.
+		if (pipeline_manifest->is_dirty()) {
+			pipeline_manifest->save(pipeline_manifest_path);
+		}
+		PipelineCacheRD::set_manifest(nullptr);
+		PipelineCacheRD::clear_formats();
+		memdelete(pipeline_manifest);
+		pipeline_manifest = nullptr;
+	}
+
 	//only need to erase these, the rest are erased by cascade
 	blit.shader.version_free(blit.shader_version);
 	RD::get_singleton()->free(blit.index_buffer);
@@ -276,6 +287,15 @@ RendererCompositorRD::RendererCompositorRD() {
 			} else {
 				shader_cache_dir = shader_cache_dir.path_join("shader_cache");
 
+				if (GLOBAL_GET("rendering/rendering_device/pipeline_cache/use_prewarm_manifest")) {
+					// Not disabled along with the shader cache, it only lists what to compile ahead of time.
+					String rendering_method = OS::get_singleton()->get_current_rendering_method();
+					pipeline_manifest_path = shader_cache_dir.path_join("pipelines." + rendering_method + (Engine::get_singleton()->is_editor_hint() ? ".editor" : "") + ".manifest");
+					pipeline_manifest = memnew(PipelineCacheRD::Manifest);
+					pipeline_manifest->load(pipeline_manifest_path);
+					PipelineCacheRD::set_manifest(pipeline_manifest);
+				}
+
 				bool shader_cache_enabled = GLOBAL_GET("rendering/shader_compiler/shader_cache/enabled");
 				if (!Engine::get_singleton()->is_editor_hint() && !shader_cache_enabled) {
 					shader_cache_dir = String(); //disable only if not editor
@@ -295,6 +315,8 @@ RendererCompositorRD::RendererCompositorRD() {
 		}
 	}
 
+	PipelineCacheRD::set_async_compile(GLOBAL_GET("rendering/rendering_device/pipeline_cache/async_compile"));
+
 	singleton = this;
 
 	utilities = memnew(RendererRD::Utilities);
@@ -34,6 +34,7 @@
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
 #include "core/object/worker_thread_pool.h"
+#include "core/os/thread.h"
 #include "core/version.h"
 #include "renderer_compositor_rd.h"
 #include "servers/rendering/rendering_device.h"
@@ -167,9 +168,6 @@ void ShaderRD::_clear_version(Version *p_version) {
 		}
 
 		memdelete_arr(p_version->variants);
-		if (p_version->variant_data) {
-			memdelete_arr(p_version->variant_data);
-		}
 		p_version->variants = nullptr;
 	}
 }
@@ -220,95 +218,98 @@ void ShaderRD::_build_variant_code(StringBuilder &builder, uint32_t p_variant, c
 	}
 }
 
-void ShaderRD::_compile_variant(uint32_t p_variant, const CompileData *p_data) {
-	uint32_t variant = group_to_variant_map[p_data->group][p_variant];
+void ShaderRD::_compile_variant(uint32_t p_index, const CompileData *p_data) {
+	uint32_t variant = p_data->variants[p_index];
 
-	if (!variants_enabled[variant]) {
-		return; // Variant is disabled, return.
+	String stage_sources[STAGE_TYPE_MAX];
+	for (int i = 0; i < STAGE_TYPE_MAX; i++) {
+		if ((i == STAGE_TYPE_COMPUTE) != is_compute) {
+			continue;
+		}
+		StringBuilder builder;
+		_build_variant_code(builder, variant, p_data->version, stage_templates[i]);
+		stage_sources[i] = builder.as_string();
 	}
 
-	Vector<RD::ShaderStageSPIRVData> stages;
+	// The cache is addressed by the final source of the variant, so it is only invalidated by changes that affect it.
+	String cache_path;
+	Vector<uint8_t> shader_data;
+	bool from_cache = false;
+	if (shader_cache_dir_valid) {
+		cache_path = _get_cache_file_path(get_variant_sha256(base_sha256, stage_sources));
+		from_cache = load_from_cache_file(cache_path, shader_data);
+	}
 
-	String error;
-	String current_source;
-	RD::ShaderStage current_stage = RD::SHADER_STAGE_VERTEX;
-	bool build_ok = true;
+	if (!from_cache) {
+		shader_data = _compile_variant_binary(variant, stage_sources);
+		if (shader_data.is_empty()) {
+			return;
+		}
 
-	if (!is_compute) {
-		//vertex stage
+		if (shader_cache_dir_valid) {
+			save_to_cache_file(cache_path, shader_data);
+		}
+	}
 
-		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_VERTEX]);
+	{
+		MutexLock lock(variant_set_mutex);
 
-		current_source = builder.as_string();
-		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_VERTEX, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_VERTEX;
-			stages.push_back(stage);
+		RID shader = RD::get_singleton()->shader_create_from_bytecode(shader_data, p_data->version->variants[variant]);
+		if (shader.is_valid() || !from_cache) {
+			p_data->version->variants[variant] = shader;
+			return;
 		}
 	}
 
-	if (!is_compute && build_ok) {
-		//fragment stage
-		current_stage = RD::SHADER_STAGE_FRAGMENT;
+	// The cached binary was rejected by the driver (e.g. it was written by a different driver version),
+	// so compile the variant from source and overwrite the stale cache entry.
+	print_verbose("Shader cache entry for " + name + ", variant #" + itos(variant) + " was rejected by the driver, recompiling: " + cache_path);
 
-		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_FRAGMENT]);
+	shader_data = _compile_variant_binary(variant, stage_sources);
+	if (shader_data.is_empty()) {
+		return;
+	}
 
-		current_source = builder.as_string();
-		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_FRAGMENT, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
-		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_FRAGMENT;
-			stages.push_back(stage);
-		}
+	save_to_cache_file(cache_path, shader_data);
+
+	{
+		MutexLock lock(variant_set_mutex);
+
+		p_data->version->variants[variant] = RD::get_singleton()->shader_create_from_bytecode(shader_data, p_data->version->variants[variant]);
 	}
+}
 
-	if (is_compute) {
-		//compute stage
-		current_stage = RD::SHADER_STAGE_COMPUTE;
+Vector<uint8_t> ShaderRD::_compile_variant_binary(uint32_t p_variant, const String *p_stage_sources) {
+	static const RD::ShaderStage rd_stages[STAGE_TYPE_MAX] = { RD::SHADER_STAGE_VERTEX, RD::SHADER_STAGE_FRAGMENT, RD::SHADER_STAGE_COMPUTE };
 
-		StringBuilder builder;
-		_build_variant_code(builder, variant, p_data->version, stage_templates[STAGE_TYPE_COMPUTE]);
+	Vector<RD::ShaderStageSPIRVData> stages;
 
-		current_source = builder.as_string();
+	for (int i = 0; i < STAGE_TYPE_MAX; i++) {
+		if ((i == STAGE_TYPE_COMPUTE) != is_compute) {
+			continue;
+		}
 
+		String error;
 		RD::ShaderStageSPIRVData stage;
-		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(RD::SHADER_STAGE_COMPUTE, current_source, RD::SHADER_LANGUAGE_GLSL, &error);
+		stage.spirv = RD::get_singleton()->shader_compile_spirv_from_source(rd_stages[i], p_stage_sources[i], RD::SHADER_LANGUAGE_GLSL, &error);
 		if (stage.spirv.size() == 0) {
-			build_ok = false;
-		} else {
-			stage.shader_stage = RD::SHADER_STAGE_COMPUTE;
-			stages.push_back(stage);
-		}
-	}
-
-	if (!build_ok) {
-		MutexLock lock(variant_set_mutex); //properly print the errors
-		ERR_PRINT("Error compiling " + String(current_stage == RD::SHADER_STAGE_COMPUTE ? "Compute " : (current_stage == RD::SHADER_STAGE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(variant) + " (" + variant_defines[variant].text.get_data() + ").");
-		ERR_PRINT(error);
+			MutexLock lock(variant_set_mutex); //properly print the errors
+			ERR_PRINT("Error compiling " + String(i == STAGE_TYPE_COMPUTE ? "Compute " : (i == STAGE_TYPE_VERTEX ? "Vertex" : "Fragment")) + " shader, variant #" + itos(p_variant) + " (" + variant_defines[p_variant].text.get_data() + ").");
+			ERR_PRINT(error);
 
 #ifdef DEBUG_ENABLED
-		ERR_PRINT("code:\n" + current_source.get_with_code_lines());
+			ERR_PRINT("code:\n" + p_stage_sources[i].get_with_code_lines());
 #endif
-		return;
+			return Vector<uint8_t>();
+		}
+		stage.shader_stage = rd_stages[i];
+		stages.push_back(stage);
 	}
 
-	Vector<uint8_t> shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(stages, name + ":" + itos(variant));
-
-	ERR_FAIL_COND(shader_data.is_empty());
-
-	{
-		MutexLock lock(variant_set_mutex);
+	Vector<uint8_t> shader_data = RD::get_singleton()->shader_compile_binary_from_spirv(stages, name + ":" + itos(p_variant));
+	ERR_FAIL_COND_V(shader_data.is_empty(), Vector<uint8_t>());
 
-		p_data->version->variants[variant] = RD::get_singleton()->shader_create_from_bytecode(shader_data, p_data->version->variants[variant]);
-		p_data->version->variant_data[variant] = shader_data;
-	}
+	return shader_data;
 }
 
 RS::ShaderNativeSourceCode ShaderRD::version_get_native_source_code(RID p_version) {
@@ -362,49 +363,31 @@ RS::ShaderNativeSourceCode ShaderRD::version_get_native_source_code(RID p_versio
 	return source_code;
 }
 
-String ShaderRD::_version_get_sha1(Version *p_version) const {
+String ShaderRD::get_variant_sha256(const String &p_base_sha256, const String *p_stage_sources) {
 	StringBuilder hash_build;
 
-	hash_build.append("[uniforms]");
-	hash_build.append(p_version->uniforms.get_data());
-	hash_build.append("[vertex_globals]");
-	hash_build.append(p_version->vertex_globals.get_data());
-	hash_build.append("[fragment_globals]");
-	hash_build.append(p_version->fragment_globals.get_data());
-	hash_build.append("[compute_globals]");
-	hash_build.append(p_version->compute_globals.get_data());
-
-	Vector<StringName> code_sections;
-	for (const KeyValue<StringName, CharString> &E : p_version->code_sections) {
-		code_sections.push_back(E.key);
-	}
-	code_sections.sort_custom<StringName::AlphCompare>();
-
-	for (int i = 0; i < code_sections.size(); i++) {
-		hash_build.append(String("[code:") + String(code_sections[i]) + "]");
-		hash_build.append(p_version->code_sections[code_sections[i]].get_data());
-	}
-	for (int i = 0; i < p_version->custom_defines.size(); i++) {
-		hash_build.append("[custom_defines:" + itos(i) + "]");
-		hash_build.append(p_version->custom_defines[i].get_data());
+	hash_build.append("[base_hash]");
+	hash_build.append(p_base_sha256);
+	for (int i = 0; i < STAGE_TYPE_MAX; i++) {
+		hash_build.append("[stage:" + itos(i) + "]");
+		hash_build.append(p_stage_sources[i]);
 	}
 
-	return hash_build.as_string().sha1_text();
+	return hash_build.as_string().sha256_text();
 }
 
 static const char *shader_file_header = "GDSC";
-static const uint32_t cache_file_version = 3;
+static const uint32_t cache_file_version = 4;
 
-String ShaderRD::_get_cache_file_path(Version *p_version, int p_group) {
-	const String &sha1 = _version_get_sha1(p_version);
+String ShaderRD::_get_cache_file_path(const String &p_variant_sha256) const {
+	// Sharded by the first byte of the hash, as a shader can have many variants and materials.
 	const String &api_safe_name = String(RD::get_singleton()->get_device_api_name()).validate_filename().to_lower();
-	const String &path = shader_cache_dir.path_join(name).path_join(group_sha256[p_group]).path_join(sha1) + "." + api_safe_name + ".cache";
+	const String &path = shader_cache_dir.path_join(name).path_join(p_variant_sha256.substr(0, 2)).path_join(p_variant_sha256.substr(2)) + "." + api_safe_name + ".cache";
 	return path;
 }
 
-bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
-	const String &path = _get_cache_file_path(p_version, p_group);
-	Ref<FileAccess> f = FileAccess::open(path, FileAccess::READ);
+bool ShaderRD::load_from_cache_file(const String &p_path, Vector<uint8_t> &r_shader_data) {
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::READ);
 	if (f.is_null()) {
 		return false;
 	}
@@ -418,69 +401,48 @@ bool ShaderRD::_load_from_cache(Version *p_version, int p_group) {
 		return false; // wrong version
 	}
 
-	uint32_t variant_count = f->get_32();
+	uint32_t data_size = f->get_32();
+	ERR_FAIL_COND_V(data_size == 0 || data_size > f->get_length() - f->get_position(), false);
 
-	ERR_FAIL_COND_V(variant_count != (uint32_t)group_to_variant_map[p_group].size(), false); //should not happen but check
+	r_shader_data.resize(data_size);
+	uint32_t br = f->get_buffer(r_shader_data.ptrw(), data_size);
+	if (br != data_size) {
+		r_shader_data.clear();
+		ERR_FAIL_V(false);
+	}
 
-	for (uint32_t i = 0; i < variant_count; i++) {
-		int variant_id = group_to_variant_map[p_group][i];
-		uint32_t variant_size = f->get_32();
-		ERR_FAIL_COND_V(variant_size == 0 && variants_enabled[variant_id], false);
-		if (!variants_enabled[variant_id]) {
-			continue;
-		}
-		Vector<uint8_t> variant_bytes;
-		variant_bytes.resize(variant_size);
+	return true;
+}
 
-		uint32_t br = f->get_buffer(variant_bytes.ptrw(), variant_size);
+Error ShaderRD::save_to_cache_file(const String &p_path, const Vector<uint8_t> &p_shader_data) {
+	ERR_FAIL_COND_V(p_shader_data.is_empty(), ERR_INVALID_PARAMETER);
 
-		ERR_FAIL_COND_V(br != variant_size, false);
+	// Tolerates the shard directory being created concurrently by another compile task.
+	Error err = DirAccess::make_dir_recursive_absolute(p_path.get_base_dir());
+	ERR_FAIL_COND_V(err != OK, err);
 
-		p_version->variant_data[variant_id] = variant_bytes;
+	// Write to a file private to this thread and rename it over the entry, so readers never see a partial file.
+	const String tmp_path = p_path + "." + itos(Thread::get_caller_id()) + ".tmp";
+	{
+		Ref<FileAccess> f = FileAccess::open(tmp_path, FileAccess::WRITE, &err);
+		ERR_FAIL_COND_V(f.is_null(), err);
+		f->store_buffer((const uint8_t *)shader_file_header, 4);
+		f->store_32(cache_file_version); // File version.
+		f->store_32(p_shader_data.size());
+		f->store_buffer(p_shader_data.ptr(), p_shader_data.size());
+		err = f->get_error();
+		f->close();
 	}
 
-	for (uint32_t i = 0; i < variant_count; i++) {
-		int variant_id = group_to_variant_map[p_group][i];
-		if (!variants_enabled[variant_id]) {
-			MutexLock lock(variant_set_mutex);
-			p_version->variants[variant_id] = RID();
-			continue;
-		}
-		{
-			MutexLock lock(variant_set_mutex);
-			RID shader = RD::get_singleton()->shader_create_from_bytecode(p_version->variant_data[variant_id], p_version->variants[variant_id]);
-			if (shader.is_null()) {
-				for (uint32_t j = 0; j < i; j++) {
-					int variant_free_id = group_to_variant_map[p_group][j];
-					RD::get_singleton()->free(p_version->variants[variant_free_id]);
-				}
-				ERR_FAIL_COND_V(shader.is_null(), false);
-			}
-
-			p_version->variants[variant_id] = shader;
-		}
+	if (err == OK) {
+		err = DirAccess::rename_absolute(tmp_path, p_path);
 	}
-
-	memdelete_arr(p_version->variant_data); //clear stages
-	p_version->variant_data = nullptr;
-	p_version->valid = true;
-	return true;
-}
-
-void ShaderRD::_save_to_cache(Version *p_version, int p_group) {
-	ERR_FAIL_COND(!shader_cache_dir_valid);
-	const String &path = _get_cache_file_path(p_version, p_group);
-	Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
-	ERR_FAIL_COND(f.is_null());
-	f->store_buffer((const uint8_t *)shader_file_header, 4);
-	f->store_32(cache_file_version); // File version.
-	uint32_t variant_count = group_to_variant_map[p_group].size();
-	f->store_32(variant_count); // Variant count.
-	for (uint32_t i = 0; i < variant_count; i++) {
-		int variant_id = group_to_variant_map[p_group][i];
-		f->store_32(p_version->variant_data[variant_id].size()); // Stage count.
-		f->store_buffer(p_version->variant_data[variant_id].ptr(), p_version->variant_data[variant_id].size());
+	if (err != OK) {
+		DirAccess::remove_absolute(tmp_path);
+		ERR_FAIL_V_MSG(err, "Could not write shader cache file: " + p_path);
 	}
+
+	return OK;
 }
 
 void ShaderRD::_allocate_placeholders(Version *p_version, int p_group) {
@@ -495,45 +457,39 @@ void ShaderRD::_allocate_placeholders(Version *p_version, int p_group) {
 	}
 }
 
-// Try to compile all variants for a given group.
+// Try to compile all variants for the given groups at once, loading them from the cache when possible.
 // Will skip variants that are disabled.
-void ShaderRD::_compile_version(Version *p_version, int p_group) {
-	if (!group_enabled[p_group]) {
-		return;
-	}
-
-	typedef Vector<uint8_t> ShaderStageData;
-	p_version->variant_data = memnew_arr(ShaderStageData, variant_defines.size());
-
-	p_version->dirty = false;
-
-	if (shader_cache_dir_valid) {
-		if (_load_from_cache(p_version, p_group)) {
-			return;
+void ShaderRD::_compile_version(Version *p_version, const LocalVector<int> &p_groups) {
+	CompileData compile_data;
+	compile_data.version = p_version;
+	for (int group : p_groups) {
+		if (!group_enabled[group]) {
+			continue;
+		}
+		for (int variant_id : group_to_variant_map[group]) {
+			if (variants_enabled[variant_id]) {
+				compile_data.variants.push_back(variant_id);
+			}
 		}
 	}
 
-	CompileData compile_data;
-	compile_data.version = p_version;
-	compile_data.group = p_group;
+	p_version->dirty = false;
 
 #if 1
-	WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, &compile_data, group_to_variant_map[p_group].size(), -1, true, SNAME("ShaderCompilation"));
-	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	if (!compile_data.variants.is_empty()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &ShaderRD::_compile_variant, &compile_data, compile_data.variants.size(), -1, true, SNAME("ShaderCompilation"));
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	}
 
 #else
-	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
+	for (uint32_t i = 0; i < compile_data.variants.size(); i++) {
 		_compile_variant(i, &compile_data);
 	}
 #endif
 
 	bool all_valid = true;
 
-	for (uint32_t i = 0; i < group_to_variant_map[p_group].size(); i++) {
-		int variant_id = group_to_variant_map[p_group][i];
-		if (!variants_enabled[variant_id]) {
-			continue; // Disabled.
-		}
+	for (int variant_id : compile_data.variants) {
 		if (p_version->variants[variant_id].is_null()) {
 			all_valid = false;
 			break;
@@ -551,23 +507,25 @@ void ShaderRD::_compile_version(Version *p_version, int p_group) {
 			}
 		}
 		memdelete_arr(p_version->variants);
-		if (p_version->variant_data) {
-			memdelete_arr(p_version->variant_data);
-		}
 		p_version->variants = nullptr;
-		p_version->variant_data = nullptr;
 		return;
-	} else if (shader_cache_dir_valid) {
-		// Save shader cache.
-		_save_to_cache(p_version, p_group);
 	}
 
-	memdelete_arr(p_version->variant_data); //clear stages
-	p_version->variant_data = nullptr;
-
 	p_version->valid = true;
 }
 
+void ShaderRD::_compile_enabled_groups(Version *p_version) {
+	LocalVector<int> groups;
+	for (int i = 0; i < group_enabled.size(); i++) {
+		if (!group_enabled[i]) {
+			_allocate_placeholders(p_version, i);
+			continue;
+		}
+		groups.push_back(i);
+	}
+	_compile_version(p_version, groups);
+}
+
 void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_code, const String &p_uniforms, const String &p_vertex_globals, const String &p_fragment_globals, const Vector<String> &p_custom_defines) {
 	ERR_FAIL_COND(is_compute);
 
@@ -589,13 +547,7 @@ void ShaderRD::version_set_code(RID p_version, const HashMap<String, String> &p_
 	version->dirty = true;
 	if (version->initialize_needed) {
 		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_compile_enabled_groups(version);
 		version->initialize_needed = false;
 	}
 }
@@ -622,13 +574,7 @@ void ShaderRD::version_set_compute_code(RID p_version, const HashMap<String, Str
 	version->dirty = true;
 	if (version->initialize_needed) {
 		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_compile_enabled_groups(version);
 		version->initialize_needed = false;
 	}
 }
@@ -639,13 +585,7 @@ bool ShaderRD::version_is_valid(RID p_version) {
 
 	if (version->dirty) {
 		_initialize_version(version);
-		for (int i = 0; i < group_enabled.size(); i++) {
-			if (!group_enabled[i]) {
-				_allocate_placeholders(version, i);
-				continue;
-			}
-			_compile_version(version, i);
-		}
+		_compile_enabled_groups(version);
 	}
 
 	return version->valid;
@@ -689,7 +629,10 @@ void ShaderRD::enable_group(int p_group) {
 	version_owner.get_owned_list(&all_versions);
 	for (int i = 0; i < all_versions.size(); i++) {
 		Version *version = version_owner.get_or_null(all_versions[i]);
-		_compile_version(version, p_group);
+		if (version->variants == nullptr) {
+			continue; // Not initialized yet or failed to compile, the new group is included once it compiles.
+		}
+		_compile_version(version, LocalVector<int>{ p_group });
 	}
 }
 
@@ -732,48 +675,25 @@ void ShaderRD::initialize(const Vector<String> &p_variant_defines, const String
 	}
 
 	if (!shader_cache_dir.is_empty()) {
-		group_sha256.resize(1);
 		_initialize_cache();
 	}
 }
 
 void ShaderRD::_initialize_cache() {
-	for (const KeyValue<int, LocalVector<int>> &E : group_to_variant_map) {
-		StringBuilder hash_build;
-
-		hash_build.append("[base_hash]");
-		hash_build.append(base_sha256);
-		hash_build.append("[general_defines]");
-		hash_build.append(general_defines.get_data());
-		hash_build.append("[group_id]");
-		hash_build.append(itos(E.key));
-		for (uint32_t i = 0; i < E.value.size(); i++) {
-			hash_build.append("[variant_defines:" + itos(E.value[i]) + "]");
-			hash_build.append(variant_defines[E.value[i]].text.get_data());
-		}
-
-		group_sha256[E.key] = hash_build.as_string().sha256_text();
-
-		Ref<DirAccess> d = DirAccess::open(shader_cache_dir);
-		ERR_FAIL_COND(d.is_null());
-		if (d->change_dir(name) != OK) {
-			Error err = d->make_dir(name);
-			ERR_FAIL_COND(err != OK);
-			d->change_dir(name);
-		}
-
-		// Erase other versions?
-		if (shader_cache_cleanup_on_start) {
-		}
-		//
-		if (d->change_dir(group_sha256[E.key]) != OK) {
-			Error err = d->make_dir(group_sha256[E.key]);
-			ERR_FAIL_COND(err != OK);
-		}
-		shader_cache_dir_valid = true;
+	Ref<DirAccess> d = DirAccess::open(shader_cache_dir);
+	ERR_FAIL_COND(d.is_null());
+	if (d->change_dir(name) != OK) {
+		Error err = d->make_dir(name);
+		ERR_FAIL_COND(err != OK);
+	}
 
-		print_verbose("Shader '" + name + "' (group " + itos(E.key) + ") SHA256: " + group_sha256[E.key]);
+	// Erase other versions?
+	if (shader_cache_cleanup_on_start) {
 	}
+	//
+	shader_cache_dir_valid = true;
+
+	print_verbose("Shader '" + name + "' SHA256: " + base_sha256);
 }
 
 // Same as above, but allows specifying shader compilation groups.
@@ -812,7 +732,6 @@ void ShaderRD::initialize(const Vector<VariantDefine> &p_variant_defines, const
 	}
 
 	if (!shader_cache_dir.is_empty()) {
-		group_sha256.resize(max_group_id + 1);
 		_initialize_cache();
 	}
 }
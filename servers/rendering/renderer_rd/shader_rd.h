@@ -42,6 +42,13 @@
 
 class ShaderRD {
 public:
+	enum StageType {
+		STAGE_TYPE_VERTEX,
+		STAGE_TYPE_FRAGMENT,
+		STAGE_TYPE_COMPUTE,
+		STAGE_TYPE_MAX,
+	};
+
 	struct VariantDefine {
 		int group = 0;
 		CharString text;
@@ -70,7 +77,6 @@ private:
 		HashMap<StringName, CharString> code_sections;
 		Vector<CharString> custom_defines;
 
-		Vector<uint8_t> *variant_data = nullptr;
 		RID *variants = nullptr; // Same size as variant defines.
 
 		bool valid;
@@ -82,14 +88,16 @@ private:
 
 	struct CompileData {
 		Version *version;
-		int group = 0;
+		LocalVector<int> variants; // Enabled variants of all the groups being compiled.
 	};
 
-	void _compile_variant(uint32_t p_variant, const CompileData *p_data);
+	void _compile_variant(uint32_t p_index, const CompileData *p_data);
+	Vector<uint8_t> _compile_variant_binary(uint32_t p_variant, const String *p_stage_sources);
 
 	void _initialize_version(Version *p_version);
 	void _clear_version(Version *p_version);
-	void _compile_version(Version *p_version, int p_group);
+	void _compile_version(Version *p_version, const LocalVector<int> &p_groups);
+	void _compile_enabled_groups(Version *p_version);
 	void _allocate_placeholders(Version *p_version, int p_group);
 
 	RID_Owner<Version> version_owner;
@@ -120,7 +128,6 @@ private:
 	CharString base_compute_defines;
 
 	String base_sha256;
-	LocalVector<String> group_sha256;
 
 	static String shader_cache_dir;
 	static bool shader_cache_cleanup_on_start;
@@ -129,23 +136,13 @@ private:
 	static bool shader_cache_save_debug;
 	bool shader_cache_dir_valid = false;
 
-	enum StageType {
-		STAGE_TYPE_VERTEX,
-		STAGE_TYPE_FRAGMENT,
-		STAGE_TYPE_COMPUTE,
-		STAGE_TYPE_MAX,
-	};
-
 	StageTemplate stage_templates[STAGE_TYPE_MAX];
 
 	void _build_variant_code(StringBuilder &p_builder, uint32_t p_variant, const Version *p_version, const StageTemplate &p_template);
 
 	void _add_stage(const char *p_code, StageType p_stage_type);
 
-	String _version_get_sha1(Version *p_version) const;
-	String _get_cache_file_path(Version *p_version, int p_group);
-	bool _load_from_cache(Version *p_version, int p_group);
-	void _save_to_cache(Version *p_version, int p_group);
+	String _get_cache_file_path(const String &p_variant_sha256) const;
 	void _initialize_cache();
 
 protected:
@@ -167,13 +164,7 @@ public:
 
 		if (version->dirty) {
 			_initialize_version(version);
-			for (int i = 0; i < group_enabled.size(); i++) {
-				if (!group_enabled[i]) {
-					_allocate_placeholders(version, i);
-					continue;
-				}
-				_compile_version(version, i);
-			}
+			_compile_enabled_groups(version);
 		}
 
 		if (!version->valid) {
@@ -200,6 +191,11 @@ public:
 	static void set_shader_cache_save_compressed_zstd(bool p_enable);
 	static void set_shader_cache_save_debug(bool p_enable);
 
+	// Cache entries are keyed per variant by the shader base hash and the final source of each stage (STAGE_TYPE_MAX entries).
+	static String get_variant_sha256(const String &p_base_sha256, const String *p_stage_sources);
+	static bool load_from_cache_file(const String &p_path, Vector<uint8_t> &r_shader_data);
+	static Error save_to_cache_file(const String &p_path, const Vector<uint8_t> &p_shader_data);
+
 	RS::ShaderNativeSourceCode version_get_native_source_code(RID p_version);
 
 	void initialize(const Vector<String> &p_variant_defines, const String &p_general_defines = "");
@@ -34,6 +34,15 @@ layout(location = 3) out vec2 pixel_size_interp;
 
 #endif
 
+#ifdef USE_BATCHING
+
+layout(location = 3) flat out vec4 src_rect_interp;
+layout(location = 4) flat out uint rect_flags_interp;
+layout(location = 5) flat out vec4 world_interp;
+layout(location = 6) flat out uvec4 lights_interp;
+
+#endif
+
 #ifdef MATERIAL_UNIFORMS_USED
 layout(set = 1, binding = 0, std140) uniform MaterialUniforms{
 
@@ -103,7 +112,41 @@ void main() {
 
 	uvec4 bones = bone_attrib;
 	vec4 bone_weights = weight_attrib;
-#else // !USE_ATTRIBUTES
+#elif defined(USE_BATCHING)
+
+	// Batched rects and polygon vertices come from the batch buffer, 6 vec4 each.
+	bool batch_vertices = bool(draw_data.flags & FLAGS_BATCH_VERTICES);
+	uint batch_ofs = (draw_data.batch_offset + (batch_vertices ? gl_VertexIndex : gl_InstanceIndex)) * 6;
+	vec4 color = transforms.data[batch_ofs + 0];
+	vec4 dst_rect = transforms.data[batch_ofs + 1];
+	vec4 src_rect = transforms.data[batch_ofs + 2];
+	vec4 batch_world = transforms.data[batch_ofs + 3];
+	vec4 batch_world_ofs = transforms.data[batch_ofs + 4];
+	uint rect_flags = floatBitsToUint(batch_world_ofs.z);
+	if (bool(rect_flags & FLAGS_REGION_IN_PIXELS)) {
+		src_rect *= draw_data.color_texture_pixel_size.xyxy;
+	}
+
+	vec2 uv;
+	vec2 vertex;
+	if (batch_vertices) {
+		vertex = dst_rect.xy;
+		uv = src_rect.xy;
+	} else {
+		vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
+		vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
+
+		uv = src_rect.xy + abs(src_rect.zw) * ((rect_flags & FLAGS_TRANSPOSE_RECT) != 0 ? vertex_base.yx : vertex_base.xy);
+		vertex = dst_rect.xy + abs(dst_rect.zw) * mix(vertex_base, vec2(1.0, 1.0) - vertex_base, lessThan(src_rect.zw, vec2(0.0, 0.0)));
+	}
+
+	src_rect_interp = src_rect;
+	rect_flags_interp = rect_flags;
+	world_interp = batch_world;
+	lights_interp = floatBitsToUint(transforms.data[batch_ofs + 5]);
+	uvec4 bones = uvec4(0, 0, 0, 0);
+
+#else // !USE_ATTRIBUTES && !USE_BATCHING
 
 	vec2 vertex_base_arr[4] = vec2[](vec2(0.0, 0.0), vec2(0.0, 1.0), vec2(1.0, 1.0), vec2(1.0, 0.0));
 	vec2 vertex_base = vertex_base_arr[gl_VertexIndex];
@@ -115,7 +158,11 @@ void main() {
 
 #endif // USE_ATTRIBUTES
 
+#ifdef USE_BATCHING
+	mat4 model_matrix = mat4(vec4(batch_world.xy, 0.0, 0.0), vec4(batch_world.zw, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(batch_world_ofs.xy, 0.0, 1.0));
+#else
 	mat4 model_matrix = mat4(vec4(draw_data.world_x, 0.0, 0.0), vec4(draw_data.world_y, 0.0, 0.0), vec4(0.0, 0.0, 1.0, 0.0), vec4(draw_data.world_ofs, 0.0, 1.0));
+#endif
 
 #define FLAGS_INSTANCING_MASK 0x7F
 #define FLAGS_INSTANCING_HAS_COLORS (1 << 7)
@@ -258,6 +305,15 @@ layout(location = 3) in vec2 pixel_size_interp;
 
 #endif
 
+#ifdef USE_BATCHING
+
+layout(location = 3) flat in vec4 src_rect_interp;
+layout(location = 4) flat in uint rect_flags_interp;
+layout(location = 5) flat in vec4 world_interp;
+layout(location = 6) flat in uvec4 lights_interp;
+
+#endif
+
 layout(location = 0) out vec4 frag_color;
 
 #ifdef MATERIAL_UNIFORMS_USED
@@ -485,9 +541,15 @@ void main() {
 	uv = uv * draw_data.src_rect.zw + draw_data.src_rect.xy; //apply region if needed
 
 #endif
+#ifdef USE_BATCHING
+	if (bool(rect_flags_interp & FLAGS_CLIP_RECT_UV)) {
+		uv = clamp(uv, src_rect_interp.xy, src_rect_interp.xy + abs(src_rect_interp.zw));
+	}
+#else
 	if (bool(draw_data.flags & FLAGS_CLIP_RECT_UV)) {
 		uv = clamp(uv, draw_data.src_rect.xy, draw_data.src_rect.xy + abs(draw_data.src_rect.zw));
 	}
+#endif
 
 #endif
 
@@ -526,7 +588,11 @@ void main() {
 		color *= texture(sampler2D(color_texture, texture_sampler), uv);
 	}
 
+#ifdef USE_BATCHING
+	uint light_count = (rect_flags_interp >> FLAGS_LIGHT_COUNT_SHIFT) & 0xF; //max 16 lights
+#else
 	uint light_count = (draw_data.flags >> FLAGS_LIGHT_COUNT_SHIFT) & 0xF; //max 16 lights
+#endif
 	bool using_light = light_count > 0 || canvas_data.directional_light_count > 0;
 
 	vec3 normal;
@@ -539,13 +605,18 @@ void main() {
 
 	if (normal_used || (using_light && bool(draw_data.flags & FLAGS_DEFAULT_NORMAL_MAP_USED))) {
 		normal.xy = texture(sampler2D(normal_texture, texture_sampler), uv).xy * vec2(2.0, -2.0) - vec2(1.0, -1.0);
-		if (bool(draw_data.flags & FLAGS_TRANSPOSE_RECT)) {
+#ifdef USE_BATCHING
+		uint rect_flags = rect_flags_interp;
+#else
+		uint rect_flags = draw_data.flags;
+#endif
+		if (bool(rect_flags & FLAGS_TRANSPOSE_RECT)) {
 			normal.xy = normal.yx;
 		}
-		if (bool(draw_data.flags & FLAGS_FLIP_H)) {
+		if (bool(rect_flags & FLAGS_FLIP_H)) {
 			normal.x = -normal.x;
 		}
-		if (bool(draw_data.flags & FLAGS_FLIP_V)) {
+		if (bool(rect_flags & FLAGS_FLIP_V)) {
 			normal.y = -normal.y;
 		}
 		normal.z = sqrt(max(0.0, 1.0 - dot(normal.xy, normal.xy)));
@@ -597,7 +668,11 @@ void main() {
 
 	if (normal_used) {
 		//convert by item transform
+#ifdef USE_BATCHING
+		normal.xy = mat2(normalize(world_interp.xy), normalize(world_interp.zw)) * normal.xy;
+#else
 		normal.xy = mat2(normalize(draw_data.world_x), normalize(draw_data.world_y)) * normal.xy;
+#endif
 		//convert by canvas transform
 		normal = normalize((canvas_data.canvas_normal_transform * vec4(normal, 0.0)).xyz);
 	}
@@ -659,7 +734,11 @@ void main() {
 		if (i >= light_count) {
 			break;
 		}
+#ifdef USE_BATCHING
+		uint light_base = lights_interp[i >> 2];
+#else
 		uint light_base = draw_data.lights[i >> 2];
+#endif
 		light_base >>= (i & 3) * 8;
 		light_base &= 0xFF;
 
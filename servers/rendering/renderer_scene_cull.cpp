@@ -33,6 +33,8 @@
 #include "core/config/project_settings.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "raster_occlusion_cull.h"
+#include "renderer_scene_cull_simd.h"
 #include "rendering_light_culler.h"
 #include "rendering_server_default.h"
 
@@ -920,11 +922,8 @@ void RendererSceneCull::instance_geometry_set_transparency(RID p_instance, float
 	}
 }
 
-void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
-	Instance *instance = instance_owner.get_or_null(p_instance);
-	ERR_FAIL_NULL(instance);
-
-	if (instance->transform == p_transform) {
+void RendererSceneCull::_instance_set_transform(Instance *p_instance, const Transform3D &p_transform) {
+	if (p_instance->transform == p_transform) {
 		return; //must be checked to avoid worst evil
 	}
 
@@ -936,8 +935,40 @@ void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D
 	}
 
 #endif
-	instance->transform = p_transform;
-	_instance_queue_update(instance, true);
+	p_instance->transform = p_transform;
+	_instance_queue_update(p_instance, true);
+}
+
+void RendererSceneCull::instance_set_transform(RID p_instance, const Transform3D &p_transform) {
+	Instance *instance = instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL(instance);
+
+	_instance_set_transform(instance, p_transform);
+}
+
+Transform3D RendererSceneCull::instance_get_transform(RID p_instance) const {
+	const Instance *instance = const_cast<RendererSceneCull *>(this)->instance_owner.get_or_null(p_instance);
+	ERR_FAIL_NULL_V(instance, Transform3D());
+
+	return instance->transform;
+}
+
+void RendererSceneCull::instances_set_transforms(const PackedInt64Array &p_instances, const PackedFloat32Array &p_transforms) {
+	ERR_FAIL_COND(p_transforms.size() != p_instances.size() * 12);
+
+	const int64_t *ids = p_instances.ptr();
+	const float *data = p_transforms.ptr();
+
+	for (int i = 0; i < p_instances.size(); i++) {
+		// Batches are usually sent a while after they're filled, skip instances freed in between.
+		Instance *instance = instance_owner.get_or_null(RID::from_uint64(ids[i]));
+		if (!instance) {
+			continue;
+		}
+
+		const float *xform = &data[i * 12];
+		_instance_set_transform(instance, Transform3D(xform[0], xform[1], xform[2], xform[4], xform[5], xform[6], xform[8], xform[9], xform[10], xform[3], xform[7], xform[11]));
+	}
 }
 
 void RendererSceneCull::instance_attach_object_instance_id(RID p_instance, ObjectID p_id) {
@@ -2762,7 +2793,28 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 	Transform3D inv_cam_transform = cull_data.cam_transform.inverse();
 	float z_near = cull_data.camera_matrix->get_z_near();
 
+	// Bounds are tested against the camera frustum one block at a time,
+	// copied to a SoA layout so that several instances are tested at once.
+	const uint32_t frustum_block_size = 64;
+	real_t block_bounds[6][frustum_block_size];
+	const real_t *const block_bounds_ptrs[6] = { block_bounds[0], block_bounds[1], block_bounds[2], block_bounds[3], block_bounds[4], block_bounds[5] };
+	uint8_t block_in_frustum[frustum_block_size];
+	uint64_t block_from = p_from;
+	uint64_t block_to = p_from;
+
 	for (uint64_t i = p_from; i < p_to; i++) {
+		if (i == block_to) {
+			block_from = i;
+			block_to = MIN(i + frustum_block_size, p_to);
+			for (uint64_t j = block_from; j < block_to; j++) {
+				const InstanceBounds &instance_bounds = cull_data.scenario->instance_aabbs[j];
+				for (uint32_t k = 0; k < 6; k++) {
+					block_bounds[k][j - block_from] = instance_bounds.bounds[k];
+				}
+			}
+			RendererSceneCullSIMD::cull_frustum(block_bounds_ptrs, block_to - block_from, cull_data.cull->frustum.planes_ptr, cull_data.cull->frustum.plane_count, block_in_frustum);
+		}
+
 		bool mesh_visible = false;
 
 		InstanceData &idata = cull_data.scenario->instance_data[i];
@@ -2772,13 +2824,14 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #define HIDDEN_BY_VISIBILITY_CHECKS (visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN_CLOSE_RANGE || visibility_flags == InstanceData::FLAG_VISIBILITY_DEPENDENCY_HIDDEN)
 #define LAYER_CHECK (cull_data.visible_layers & idata.layer_mask)
 #define IN_FRUSTUM(f) (cull_data.scenario->instance_aabbs[i].in_frustum(f))
+#define IN_CAMERA_FRUSTUM (block_in_frustum[i - block_from] != 0)
 #define VIS_RANGE_CHECK ((idata.visibility_index == -1) || _visibility_range_check<false>(cull_data.scenario->instance_visibility[idata.visibility_index], cull_data.cam_transform.origin, cull_data.visibility_viewport_mask) == 0)
 #define VIS_PARENT_CHECK (_visibility_parent_check(cull_data, idata))
 #define VIS_CHECK (visibility_check < 0 ? (visibility_check = (visibility_flags != InstanceData::FLAG_VISIBILITY_DEPENDENCY_NEEDS_CHECK || (VIS_RANGE_CHECK && VIS_PARENT_CHECK))) : visibility_check)
 #define OCCLUSION_CULLED (cull_data.occlusion_buffer != nullptr && (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_OCCLUSION_CULLING) == 0 && cull_data.occlusion_buffer->is_occluded(cull_data.scenario->instance_aabbs[i].bounds, cull_data.cam_transform.origin, inv_cam_transform, *cull_data.camera_matrix, z_near))
 
 		if (!HIDDEN_BY_VISIBILITY_CHECKS) {
-			if ((LAYER_CHECK && IN_FRUSTUM(cull_data.cull->frustum) && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
+			if ((LAYER_CHECK && IN_CAMERA_FRUSTUM && VIS_CHECK && !OCCLUSION_CULLED) || (cull_data.scenario->instance_data[i].flags & InstanceData::FLAG_IGNORE_ALL_CULLING)) {
 				uint32_t base_type = idata.flags & InstanceData::FLAG_BASE_TYPE_MASK;
 				if (base_type == RS::INSTANCE_LIGHT) {
 					cull_result.lights.push_back(idata.instance);
@@ -2988,6 +3041,7 @@ void RendererSceneCull::_scene_cull(CullData &cull_data, InstanceCullResult &cul
 #undef HIDDEN_BY_VISIBILITY_CHECKS
 #undef LAYER_CHECK
 #undef IN_FRUSTUM
+#undef IN_CAMERA_FRUSTUM
 #undef VIS_RANGE_CHECK
 #undef VIS_PARENT_CHECK
 #undef VIS_CHECK
@@ -4253,7 +4307,8 @@ RendererSceneCull::RendererSceneCull() {
 	thread_cull_threshold = GLOBAL_GET("rendering/limits/spatial_indexer/threaded_cull_minimum_instances");
 	thread_cull_threshold = MAX(thread_cull_threshold, (uint32_t)WorkerThreadPool::get_singleton()->get_thread_count()); //make sure there is at least one thread per CPU
 
-	dummy_occlusion_culling = memnew(RendererSceneOcclusionCull);
+	// Used unless a module provides another implementation, see the raycast module.
+	raster_occlusion_culling = memnew(RasterOcclusionCull);
 
 	light_culler = memnew(RenderingLightCuller);
 
@@ -4279,8 +4334,8 @@ RendererSceneCull::~RendererSceneCull() {
 	}
 	scene_cull_result_threads.clear();
 
-	if (dummy_occlusion_culling) {
-		memdelete(dummy_occlusion_culling);
+	if (raster_occlusion_culling) {
+		memdelete(raster_occlusion_culling);
 	}
 
 	if (light_culler) {
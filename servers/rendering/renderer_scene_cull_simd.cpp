@@ -0,0 +1,287 @@
+/**************************************************************************/
+/*  renderer_scene_cull_simd.cpp                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "renderer_scene_cull_simd.h"
+
+#include "core/math/simd.h"
+
+static _FORCE_INLINE_ bool _in_frustum(const real_t *const p_bounds[6], uint32_t p_index, const Plane *p_planes, uint32_t p_plane_count) {
+	for (uint32_t i = 0; i < p_plane_count; i++) {
+		const Plane &plane = p_planes[i];
+		const Vector3 min(
+				p_bounds[plane.normal.x > 0 ? 0 : 3][p_index],
+				p_bounds[plane.normal.y > 0 ? 1 : 4][p_index],
+				p_bounds[plane.normal.z > 0 ? 2 : 5][p_index]);
+
+		if (plane.distance_to(min) >= 0.0) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+void RendererSceneCullSIMD::cull_frustum(const real_t *const p_bounds[6], uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_in_frustum) {
+	uint32_t i = 0;
+
+#if defined(SIMD_AVX) && !defined(REAL_T_IS_DOUBLE)
+	const __m256 zero8 = _mm256_setzero_ps();
+	for (; i + 8 <= p_count; i += 8) {
+		__m256 outside = zero8;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const Plane &plane = p_planes[j];
+			const __m256 x = _mm256_loadu_ps(p_bounds[plane.normal.x > 0 ? 0 : 3] + i);
+			const __m256 y = _mm256_loadu_ps(p_bounds[plane.normal.y > 0 ? 1 : 4] + i);
+			const __m256 z = _mm256_loadu_ps(p_bounds[plane.normal.z > 0 ? 2 : 5] + i);
+
+			__m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.normal.x), x), _mm256_mul_ps(_mm256_set1_ps(plane.normal.y), y));
+			d = _mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(plane.normal.z), z));
+			d = _mm256_sub_ps(d, _mm256_set1_ps(plane.d));
+
+			outside = _mm256_or_ps(outside, _mm256_cmp_ps(d, zero8, _CMP_GE_OQ));
+			if (_mm256_movemask_ps(outside) == 0xFF) {
+				break;
+			}
+		}
+
+		const int mask = _mm256_movemask_ps(outside);
+		for (uint32_t k = 0; k < 8; k++) {
+			r_in_frustum[i + k] = ((mask >> k) & 1) ? 0 : 1;
+		}
+	}
+#endif
+
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	const __m128 zero = _mm_setzero_ps();
+	for (; i + 4 <= p_count; i += 4) {
+		__m128 outside = zero;
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const Plane &plane = p_planes[j];
+			const __m128 x = _mm_loadu_ps(p_bounds[plane.normal.x > 0 ? 0 : 3] + i);
+			const __m128 y = _mm_loadu_ps(p_bounds[plane.normal.y > 0 ? 1 : 4] + i);
+			const __m128 z = _mm_loadu_ps(p_bounds[plane.normal.z > 0 ? 2 : 5] + i);
+
+			__m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), x), _mm_mul_ps(_mm_set1_ps(plane.normal.y), y));
+			d = _mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(plane.normal.z), z));
+			d = _mm_sub_ps(d, _mm_set1_ps(plane.d));
+
+			outside = _mm_or_ps(outside, _mm_cmpge_ps(d, zero));
+			if (_mm_movemask_ps(outside) == 0xF) {
+				break;
+			}
+		}
+
+		const int mask = _mm_movemask_ps(outside);
+		for (uint32_t k = 0; k < 4; k++) {
+			r_in_frustum[i + k] = ((mask >> k) & 1) ? 0 : 1;
+		}
+	}
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	const float32x4_t zero = vdupq_n_f32(0.0f);
+	for (; i + 4 <= p_count; i += 4) {
+		uint32x4_t outside = vdupq_n_u32(0);
+		for (uint32_t j = 0; j < p_plane_count; j++) {
+			const Plane &plane = p_planes[j];
+			const float32x4_t x = vld1q_f32(p_bounds[plane.normal.x > 0 ? 0 : 3] + i);
+			const float32x4_t y = vld1q_f32(p_bounds[plane.normal.y > 0 ? 1 : 4] + i);
+			const float32x4_t z = vld1q_f32(p_bounds[plane.normal.z > 0 ? 2 : 5] + i);
+
+			float32x4_t d = vaddq_f32(vmulq_n_f32(x, plane.normal.x), vmulq_n_f32(y, plane.normal.y));
+			d = vaddq_f32(d, vmulq_n_f32(z, plane.normal.z));
+			d = vsubq_f32(d, vdupq_n_f32(plane.d));
+
+			outside = vorrq_u32(outside, vcgeq_f32(d, zero));
+			if (vminvq_u32(outside) != 0) {
+				break;
+			}
+		}
+
+		r_in_frustum[i + 0] = vgetq_lane_u32(outside, 0) ? 0 : 1;
+		r_in_frustum[i + 1] = vgetq_lane_u32(outside, 1) ? 0 : 1;
+		r_in_frustum[i + 2] = vgetq_lane_u32(outside, 2) ? 0 : 1;
+		r_in_frustum[i + 3] = vgetq_lane_u32(outside, 3) ? 0 : 1;
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		r_in_frustum[i] = _in_frustum(p_bounds, i, p_planes, p_plane_count) ? 1 : 0;
+	}
+}
+
+bool RendererSceneCullSIMD::project_bounds(const real_t p_bounds[6], const Transform3D &p_cam_inv_transform, const Projection &p_cam_projection, Vector2 &r_rect_min, Vector2 &r_rect_max) {
+	const Basis &basis = p_cam_inv_transform.basis;
+	const Vector3 &origin = p_cam_inv_transform.origin;
+	const Vector4 *columns = p_cam_projection.columns;
+
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	// Four corners per vector, the two vectors differ by their z.
+	const __m128 x = _mm_setr_ps(p_bounds[0], p_bounds[3], p_bounds[0], p_bounds[3]);
+	const __m128 y = _mm_setr_ps(p_bounds[1], p_bounds[1], p_bounds[4], p_bounds[4]);
+	const __m128 one = _mm_set1_ps(1.0f);
+	const __m128 half = _mm_set1_ps(0.5f);
+	__m128 rect_min_x = _mm_set1_ps(FLT_MAX);
+	__m128 rect_min_y = _mm_set1_ps(FLT_MAX);
+	__m128 rect_max_x = _mm_set1_ps(FLT_MIN);
+	__m128 rect_max_y = _mm_set1_ps(FLT_MIN);
+
+	for (int k = 0; k < 2; k++) {
+		const __m128 z = _mm_set1_ps(p_bounds[k == 0 ? 2 : 5]);
+
+		const __m128 view_x = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(basis[0][0]), x), _mm_mul_ps(_mm_set1_ps(basis[0][1]), y)), _mm_mul_ps(_mm_set1_ps(basis[0][2]), z)), _mm_set1_ps(origin.x));
+		const __m128 view_y = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(basis[1][0]), x), _mm_mul_ps(_mm_set1_ps(basis[1][1]), y)), _mm_mul_ps(_mm_set1_ps(basis[1][2]), z)), _mm_set1_ps(origin.y));
+		const __m128 view_z = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(basis[2][0]), x), _mm_mul_ps(_mm_set1_ps(basis[2][1]), y)), _mm_mul_ps(_mm_set1_ps(basis[2][2]), z)), _mm_set1_ps(origin.z));
+
+		const __m128 projected_x = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(columns[0][0]), view_x), _mm_mul_ps(_mm_set1_ps(columns[1][0]), view_y)), _mm_mul_ps(_mm_set1_ps(columns[2][0]), view_z)), _mm_set1_ps(columns[3][0]));
+		const __m128 projected_y = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(columns[0][1]), view_x), _mm_mul_ps(_mm_set1_ps(columns[1][1]), view_y)), _mm_mul_ps(_mm_set1_ps(columns[2][1]), view_z)), _mm_set1_ps(columns[3][1]));
+		const __m128 w = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(columns[0][3]), view_x), _mm_mul_ps(_mm_set1_ps(columns[1][3]), view_y)), _mm_mul_ps(_mm_set1_ps(columns[2][3]), view_z)), _mm_set1_ps(columns[3][3]));
+
+		if (_mm_movemask_ps(_mm_cmplt_ps(w, one)) != 0) {
+			return false;
+		}
+
+		const __m128 normalized_x = _mm_add_ps(_mm_mul_ps(_mm_div_ps(projected_x, w), half), half);
+		const __m128 normalized_y = _mm_add_ps(_mm_mul_ps(_mm_div_ps(projected_y, w), half), half);
+		rect_min_x = _mm_min_ps(rect_min_x, normalized_x);
+		rect_min_y = _mm_min_ps(rect_min_y, normalized_y);
+		rect_max_x = _mm_max_ps(rect_max_x, normalized_x);
+		rect_max_y = _mm_max_ps(rect_max_y, normalized_y);
+	}
+
+	float min_x[4], min_y[4], max_x[4], max_y[4];
+	_mm_storeu_ps(min_x, rect_min_x);
+	_mm_storeu_ps(min_y, rect_min_y);
+	_mm_storeu_ps(max_x, rect_max_x);
+	_mm_storeu_ps(max_y, rect_max_y);
+	r_rect_min = Vector2(MIN(MIN(min_x[0], min_x[1]), MIN(min_x[2], min_x[3])), MIN(MIN(min_y[0], min_y[1]), MIN(min_y[2], min_y[3])));
+	r_rect_max = Vector2(MAX(MAX(max_x[0], max_x[1]), MAX(max_x[2], max_x[3])), MAX(MAX(max_y[0], max_y[1]), MAX(max_y[2], max_y[3])));
+	return true;
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	// Four corners per vector, the two vectors differ by their z.
+	const float x_values[4] = { p_bounds[0], p_bounds[3], p_bounds[0], p_bounds[3] };
+	const float y_values[4] = { p_bounds[1], p_bounds[1], p_bounds[4], p_bounds[4] };
+	const float32x4_t x = vld1q_f32(x_values);
+	const float32x4_t y = vld1q_f32(y_values);
+	const float32x4_t one = vdupq_n_f32(1.0f);
+	const float32x4_t half = vdupq_n_f32(0.5f);
+	float32x4_t rect_min_x = vdupq_n_f32(FLT_MAX);
+	float32x4_t rect_min_y = vdupq_n_f32(FLT_MAX);
+	float32x4_t rect_max_x = vdupq_n_f32(FLT_MIN);
+	float32x4_t rect_max_y = vdupq_n_f32(FLT_MIN);
+
+	for (int k = 0; k < 2; k++) {
+		const float32x4_t z = vdupq_n_f32(p_bounds[k == 0 ? 2 : 5]);
+
+		const float32x4_t view_x = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, basis[0][0]), vmulq_n_f32(y, basis[0][1])), vmulq_n_f32(z, basis[0][2])), vdupq_n_f32(origin.x));
+		const float32x4_t view_y = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, basis[1][0]), vmulq_n_f32(y, basis[1][1])), vmulq_n_f32(z, basis[1][2])), vdupq_n_f32(origin.y));
+		const float32x4_t view_z = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(x, basis[2][0]), vmulq_n_f32(y, basis[2][1])), vmulq_n_f32(z, basis[2][2])), vdupq_n_f32(origin.z));
+
+		const float32x4_t projected_x = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(view_x, columns[0][0]), vmulq_n_f32(view_y, columns[1][0])), vmulq_n_f32(view_z, columns[2][0])), vdupq_n_f32(columns[3][0]));
+		const float32x4_t projected_y = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(view_x, columns[0][1]), vmulq_n_f32(view_y, columns[1][1])), vmulq_n_f32(view_z, columns[2][1])), vdupq_n_f32(columns[3][1]));
+		const float32x4_t w = vaddq_f32(vaddq_f32(vaddq_f32(vmulq_n_f32(view_x, columns[0][3]), vmulq_n_f32(view_y, columns[1][3])), vmulq_n_f32(view_z, columns[2][3])), vdupq_n_f32(columns[3][3]));
+
+		if (vmaxvq_u32(vcltq_f32(w, one)) != 0) {
+			return false;
+		}
+
+		const float32x4_t normalized_x = vaddq_f32(vmulq_f32(vdivq_f32(projected_x, w), half), half);
+		const float32x4_t normalized_y = vaddq_f32(vmulq_f32(vdivq_f32(projected_y, w), half), half);
+		rect_min_x = vminq_f32(rect_min_x, normalized_x);
+		rect_min_y = vminq_f32(rect_min_y, normalized_y);
+		rect_max_x = vmaxq_f32(rect_max_x, normalized_x);
+		rect_max_y = vmaxq_f32(rect_max_y, normalized_y);
+	}
+
+	r_rect_min = Vector2(vminvq_f32(rect_min_x), vminvq_f32(rect_min_y));
+	r_rect_max = Vector2(vmaxvq_f32(rect_max_x), vmaxvq_f32(rect_max_y));
+	return true;
+#else
+	Vector2 rect_min = Vector2(FLT_MAX, FLT_MAX);
+	Vector2 rect_max = Vector2(FLT_MIN, FLT_MIN);
+
+	for (int j = 0; j < 8; j++) {
+		const Vector3 corner = Vector3(p_bounds[(j & 1) ? 3 : 0], p_bounds[(j & 2) ? 4 : 1], p_bounds[(j & 4) ? 5 : 2]);
+		const Vector3 view = p_cam_inv_transform.xform(corner);
+
+		const real_t projected_x = columns[0][0] * view.x + columns[1][0] * view.y + columns[2][0] * view.z + columns[3][0];
+		const real_t projected_y = columns[0][1] * view.x + columns[1][1] * view.y + columns[2][1] * view.z + columns[3][1];
+		const real_t w = columns[0][3] * view.x + columns[1][3] * view.y + columns[2][3] * view.z + columns[3][3];
+		if (w < 1.0) {
+			return false;
+		}
+
+		const Vector2 normalized = Vector2(projected_x / w * 0.5f + 0.5f, projected_y / w * 0.5f + 0.5f);
+		rect_min = rect_min.min(normalized);
+		rect_max = rect_max.max(normalized);
+	}
+
+	r_rect_min = rect_min;
+	r_rect_max = rect_max;
+	return true;
+#endif
+}
+
+bool RendererSceneCullSIMD::any_greater(const float *p_values, uint32_t p_count, float p_threshold) {
+	uint32_t i = 0;
+
+#if defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	const __m128 threshold = _mm_set1_ps(p_threshold);
+	for (; i + 4 <= p_count; i += 4) {
+		if (_mm_movemask_ps(_mm_cmpgt_ps(_mm_loadu_ps(p_values + i), threshold)) != 0) {
+			return true;
+		}
+	}
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	const float32x4_t threshold = vdupq_n_f32(p_threshold);
+	for (; i + 4 <= p_count; i += 4) {
+		if (vmaxvq_u32(vcgtq_f32(vld1q_f32(p_values + i), threshold)) != 0) {
+			return true;
+		}
+	}
+#endif
+
+	for (; i < p_count; i++) {
+		if (p_values[i] > p_threshold) {
+			return true;
+		}
+	}
+	return false;
+}
+
+const char *RendererSceneCullSIMD::get_simd_name() {
+#if defined(SIMD_AVX) && !defined(REAL_T_IS_DOUBLE)
+	return "AVX";
+#elif defined(SIMD_SSE2) && !defined(REAL_T_IS_DOUBLE)
+	return "SSE2";
+#elif defined(SIMD_NEON) && !defined(REAL_T_IS_DOUBLE)
+	return "NEON";
+#else
+	return "scalar";
+#endif
+}
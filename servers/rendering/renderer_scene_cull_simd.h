@@ -0,0 +1,57 @@
+/**************************************************************************/
+/*  renderer_scene_cull_simd.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef RENDERER_SCENE_CULL_SIMD_H
+#define RENDERER_SCENE_CULL_SIMD_H
+
+#include "core/math/plane.h"
+#include "core/math/projection.h"
+#include "core/math/transform_3d.h"
+#include "core/math/vector2.h"
+
+// Culling kernels used by RendererSceneCull and the occlusion buffer.
+// Vectorized with SSE2 (and AVX when enabled at build time) or NEON where the target supports it
+// and real_t is single precision, scalar otherwise.
+class RendererSceneCullSIMD {
+public:
+	// Bounds laid out as six arrays (min x, min y, min z, max x, max y, max z) of p_count elements.
+	// Sets r_in_frustum[i] to 0 if the bounds are fully outside one of the planes, to 1 otherwise.
+	// This is the same conservative test as RendererSceneCull::InstanceBounds::in_frustum().
+	static void cull_frustum(const real_t *const p_bounds[6], uint32_t p_count, const Plane *p_planes, uint32_t p_plane_count, uint8_t *r_in_frustum);
+	// Projects the eight corners of the bounds (min xyz, max xyz) to normalized screen coordinates.
+	// Returns false if a corner lies behind the camera, in which case the rect is left untouched.
+	static bool project_bounds(const real_t p_bounds[6], const Transform3D &p_cam_inv_transform, const Projection &p_cam_projection, Vector2 &r_rect_min, Vector2 &r_rect_max);
+	// Returns true if one of the p_count values is greater than p_threshold.
+	static bool any_greater(const float *p_values, uint32_t p_count, float p_threshold);
+
+	static const char *get_simd_name();
+};
+
+#endif // RENDERER_SCENE_CULL_SIMD_H
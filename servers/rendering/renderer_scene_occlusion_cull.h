@@ -33,6 +33,7 @@
 
 #include "core/math/projection.h"
 #include "core/templates/local_vector.h"
+#include "servers/rendering/renderer_scene_cull_simd.h"
 #include "servers/rendering_server.h"
 
 class RendererSceneOcclusionCull {
@@ -42,8 +43,6 @@ protected:
 public:
 	class HZBuffer {
 	protected:
-		static const Vector3 corners[8];
-
 		LocalVector<float> data;
 		LocalVector<Size2i> sizes;
 		LocalVector<float *> mips;
@@ -78,28 +77,11 @@ public:
 
 			float min_depth = -closest_point_view.z * 0.95f;
 
-			Vector2 rect_min = Vector2(FLT_MAX, FLT_MAX);
-			Vector2 rect_max = Vector2(FLT_MIN, FLT_MIN);
-
-			for (int j = 0; j < 8; j++) {
-				const Vector3 &c = RendererSceneOcclusionCull::HZBuffer::corners[j];
-				Vector3 nc = Vector3(1, 1, 1) - c;
-				Vector3 corner = Vector3(p_bounds[0] * c.x + p_bounds[3] * nc.x, p_bounds[1] * c.y + p_bounds[4] * nc.y, p_bounds[2] * c.z + p_bounds[5] * nc.z);
-				Vector3 view = p_cam_inv_transform.xform(corner);
-
-				Plane vp = Plane(view, 1.0);
-				Plane projected = p_cam_projection.xform4(vp);
-
-				float w = projected.d;
-				if (w < 1.0) {
-					rect_min = Vector2(0.0f, 0.0f);
-					rect_max = Vector2(1.0f, 1.0f);
-					break;
-				}
-
-				Vector2 normalized = Vector2(projected.normal.x / w * 0.5f + 0.5f, projected.normal.y / w * 0.5f + 0.5f);
-				rect_min = rect_min.min(normalized);
-				rect_max = rect_max.max(normalized);
+			Vector2 rect_min;
+			Vector2 rect_max;
+			if (!RendererSceneCullSIMD::project_bounds(p_bounds, p_cam_inv_transform, p_cam_projection, rect_min, rect_max)) {
+				rect_min = Vector2(0.0f, 0.0f);
+				rect_max = Vector2(1.0f, 1.0f);
 			}
 
 			rect_max = rect_max.min(Vector2(1, 1));
@@ -134,14 +116,8 @@ public:
 
 				visible = false;
 				for (int y = miny; y <= maxy; y++) {
-					for (int x = minx; x <= maxx; x++) {
-						float depth = mips[lod][y * w + x];
-						if (depth > min_depth) {
-							visible = true;
-							break;
-						}
-					}
-					if (visible) {
+					if (RendererSceneCullSIMD::any_greater(&mips[lod][y * w + minx], maxx - minx + 1, min_depth)) {
+						visible = true;
 						break;
 					}
 				}
@@ -1977,6 +1977,15 @@ RenderingDevice::TextureSamples RenderingDevice::framebuffer_format_get_texture_
 	return E->value.pass_samples[p_pass];
 }
 
+uint32_t RenderingDevice::framebuffer_format_get_hash(FramebufferFormatID p_format) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<FramebufferFormatID, FramebufferFormat>::Iterator E = framebuffer_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, 0);
+
+	return E->value.E->key().hash();
+}
+
 RID RenderingDevice::framebuffer_create_empty(const Size2i &p_size, TextureSamples p_samples, FramebufferFormatID p_format_check) {
 	_THREAD_SAFE_METHOD_
 	Framebuffer framebuffer;
@@ -2212,6 +2221,17 @@ RenderingDevice::VertexFormatID RenderingDevice::vertex_format_create(const Vect
 	return id;
 }
 
+uint32_t RenderingDevice::vertex_format_get_hash(VertexFormatID p_format) {
+	_THREAD_SAFE_METHOD_
+
+	HashMap<VertexFormatID, VertexDescriptionCache>::Iterator E = vertex_formats.find(p_format);
+	ERR_FAIL_COND_V(!E, 0);
+
+	VertexDescriptionKey key;
+	key.vertex_formats = E->value.vertex_formats;
+	return key.hash();
+}
+
 RID RenderingDevice::vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets) {
 	_THREAD_SAFE_METHOD_
 
@@ -2424,6 +2444,7 @@ RID RenderingDevice::shader_create_from_bytecode(const Vector<uint8_t> &p_shader
 
 	*((ShaderDescription *)shader) = shader_desc; // ShaderDescription bundle.
 	shader->name = name;
+	shader->binary_hash = hash_murmur3_buffer(p_shader_binary.ptr(), p_shader_binary.size());
 	shader->driver_id = shader_id;
 	shader->layout_hash = driver->shader_get_layout_hash(shader_id);
 
@@ -2491,6 +2512,14 @@ uint64_t RenderingDevice::shader_get_vertex_input_attribute_mask(RID p_shader) {
 	return shader->vertex_input_mask;
 }
 
+uint32_t RenderingDevice::shader_get_binary_hash(RID p_shader) {
+	_THREAD_SAFE_METHOD_
+
+	const Shader *shader = shader_owner.get_or_null(p_shader);
+	ERR_FAIL_NULL_V(shader, 0);
+	return shader->binary_hash;
+}
+
 /******************/
 /**** UNIFORMS ****/
 /******************/
@@ -2907,128 +2936,152 @@ void RenderingDevice::uniform_set_set_invalidation_callback(RID p_uniform_set, I
 /*******************/
 
 RID RenderingDevice::render_pipeline_create(RID p_shader, FramebufferFormatID p_framebuffer_format, VertexFormatID p_vertex_format, RenderPrimitive p_render_primitive, const PipelineRasterizationState &p_rasterization_state, const PipelineMultisampleState &p_multisample_state, const PipelineDepthStencilState &p_depth_stencil_state, const PipelineColorBlendState &p_blend_state, BitField<PipelineDynamicStateFlags> p_dynamic_state_flags, uint32_t p_for_render_pass, const Vector<PipelineSpecializationConstant> &p_specialization_constants) {
-	_THREAD_SAFE_METHOD_
+	// Compiling can take a long time, so the device lock is only held to validate the request and to register the result.
+	RDD::ShaderID shader_driver_id;
+	RDD::VertexFormatID driver_vertex_format;
+	RDD::RenderPassID driver_render_pass;
+	Vector<int32_t> color_attachments;
 
-	// Needs a shader.
-	Shader *shader = shader_owner.get_or_null(p_shader);
-	ERR_FAIL_NULL_V(shader, RID());
+	{
+		_THREAD_SAFE_METHOD_
 
-	ERR_FAIL_COND_V_MSG(shader->is_compute, RID(),
-			"Compute shaders can't be used in render pipelines");
+		// Needs a shader.
+		Shader *shader = shader_owner.get_or_null(p_shader);
+		ERR_FAIL_NULL_V(shader, RID());
 
-	if (p_framebuffer_format == INVALID_ID) {
-		// If nothing provided, use an empty one (no attachments).
-		p_framebuffer_format = framebuffer_format_create(Vector<AttachmentFormat>());
-	}
-	ERR_FAIL_COND_V(!framebuffer_formats.has(p_framebuffer_format), RID());
-	const FramebufferFormat &fb_format = framebuffer_formats[p_framebuffer_format];
+		ERR_FAIL_COND_V_MSG(shader->is_compute, RID(),
+				"Compute shaders can't be used in render pipelines");
 
-	// Validate shader vs. framebuffer.
-	{
-		ERR_FAIL_COND_V_MSG(p_for_render_pass >= uint32_t(fb_format.E->key().passes.size()), RID(), "Render pass requested for pipeline creation (" + itos(p_for_render_pass) + ") is out of bounds");
-		const FramebufferPass &pass = fb_format.E->key().passes[p_for_render_pass];
-		uint32_t output_mask = 0;
-		for (int i = 0; i < pass.color_attachments.size(); i++) {
-			if (pass.color_attachments[i] != ATTACHMENT_UNUSED) {
-				output_mask |= 1 << i;
-			}
+		if (p_framebuffer_format == INVALID_ID) {
+			// If nothing provided, use an empty one (no attachments).
+			p_framebuffer_format = framebuffer_format_create(Vector<AttachmentFormat>());
 		}
-		ERR_FAIL_COND_V_MSG(shader->fragment_output_mask != output_mask, RID(),
-				"Mismatch fragment shader output mask (" + itos(shader->fragment_output_mask) + ") and framebuffer color output mask (" + itos(output_mask) + ") when binding both in render pipeline.");
-	}
+		ERR_FAIL_COND_V(!framebuffer_formats.has(p_framebuffer_format), RID());
+		const FramebufferFormat &fb_format = framebuffer_formats[p_framebuffer_format];
 
-	RDD::VertexFormatID driver_vertex_format;
-	if (p_vertex_format != INVALID_ID) {
-		// Uses vertices, else it does not.
-		ERR_FAIL_COND_V(!vertex_formats.has(p_vertex_format), RID());
-		const VertexDescriptionCache &vd = vertex_formats[p_vertex_format];
-		driver_vertex_format = vertex_formats[p_vertex_format].driver_id;
-
-		// Validate with inputs.
-		for (uint32_t i = 0; i < 64; i++) {
-			if (!(shader->vertex_input_mask & ((uint64_t)1) << i)) {
-				continue;
+		// Validate shader vs. framebuffer.
+		{
+			ERR_FAIL_COND_V_MSG(p_for_render_pass >= uint32_t(fb_format.E->key().passes.size()), RID(), "Render pass requested for pipeline creation (" + itos(p_for_render_pass) + ") is out of bounds");
+			const FramebufferPass &pass = fb_format.E->key().passes[p_for_render_pass];
+			uint32_t output_mask = 0;
+			for (int i = 0; i < pass.color_attachments.size(); i++) {
+				if (pass.color_attachments[i] != ATTACHMENT_UNUSED) {
+					output_mask |= 1 << i;
+				}
 			}
-			bool found = false;
-			for (int j = 0; j < vd.vertex_formats.size(); j++) {
-				if (vd.vertex_formats[j].location == i) {
-					found = true;
+			ERR_FAIL_COND_V_MSG(shader->fragment_output_mask != output_mask, RID(),
+					"Mismatch fragment shader output mask (" + itos(shader->fragment_output_mask) + ") and framebuffer color output mask (" + itos(output_mask) + ") when binding both in render pipeline.");
+		}
+
+		if (p_vertex_format != INVALID_ID) {
+			// Uses vertices, else it does not.
+			ERR_FAIL_COND_V(!vertex_formats.has(p_vertex_format), RID());
+			const VertexDescriptionCache &vd = vertex_formats[p_vertex_format];
+			driver_vertex_format = vertex_formats[p_vertex_format].driver_id;
+
+			// Validate with inputs.
+			for (uint32_t i = 0; i < 64; i++) {
+				if (!(shader->vertex_input_mask & ((uint64_t)1) << i)) {
+					continue;
+				}
+				bool found = false;
+				for (int j = 0; j < vd.vertex_formats.size(); j++) {
+					if (vd.vertex_formats[j].location == i) {
+						found = true;
+					}
 				}
+
+				ERR_FAIL_COND_V_MSG(!found, RID(),
+						"Shader vertex input location (" + itos(i) + ") not provided in vertex input description for pipeline creation.");
 			}
 
-			ERR_FAIL_COND_V_MSG(!found, RID(),
-					"Shader vertex input location (" + itos(i) + ") not provided in vertex input description for pipeline creation.");
+		} else {
+			ERR_FAIL_COND_V_MSG(shader->vertex_input_mask != 0, RID(),
+					"Shader contains vertex inputs, but no vertex input description was provided for pipeline creation.");
 		}
 
-	} else {
-		ERR_FAIL_COND_V_MSG(shader->vertex_input_mask != 0, RID(),
-				"Shader contains vertex inputs, but no vertex input description was provided for pipeline creation.");
-	}
-
-	ERR_FAIL_INDEX_V(p_render_primitive, RENDER_PRIMITIVE_MAX, RID());
+		ERR_FAIL_INDEX_V(p_render_primitive, RENDER_PRIMITIVE_MAX, RID());
 
-	ERR_FAIL_INDEX_V(p_rasterization_state.cull_mode, 3, RID());
+		ERR_FAIL_INDEX_V(p_rasterization_state.cull_mode, 3, RID());
 
-	if (p_multisample_state.sample_mask.size()) {
-		// Use sample mask.
-		ERR_FAIL_COND_V((int)TEXTURE_SAMPLES_COUNT[p_multisample_state.sample_count] != p_multisample_state.sample_mask.size(), RID());
-	}
+		if (p_multisample_state.sample_mask.size()) {
+			// Use sample mask.
+			ERR_FAIL_COND_V((int)TEXTURE_SAMPLES_COUNT[p_multisample_state.sample_count] != p_multisample_state.sample_mask.size(), RID());
+		}
 
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.depth_compare_operator, COMPARE_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.depth_compare_operator, COMPARE_OP_MAX, RID());
 
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.fail, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.pass, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.depth_fail, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.compare, COMPARE_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.fail, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.pass, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.depth_fail, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.front_op.compare, COMPARE_OP_MAX, RID());
 
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.fail, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.pass, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.depth_fail, STENCIL_OP_MAX, RID());
-	ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.compare, COMPARE_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.fail, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.pass, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.depth_fail, STENCIL_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_depth_stencil_state.back_op.compare, COMPARE_OP_MAX, RID());
 
-	ERR_FAIL_INDEX_V(p_blend_state.logic_op, LOGIC_OP_MAX, RID());
+		ERR_FAIL_INDEX_V(p_blend_state.logic_op, LOGIC_OP_MAX, RID());
 
-	const FramebufferPass &pass = fb_format.E->key().passes[p_for_render_pass];
-	ERR_FAIL_COND_V(p_blend_state.attachments.size() < pass.color_attachments.size(), RID());
-	for (int i = 0; i < pass.color_attachments.size(); i++) {
-		if (pass.color_attachments[i] != ATTACHMENT_UNUSED) {
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].src_color_blend_factor, BLEND_FACTOR_MAX, RID());
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].dst_color_blend_factor, BLEND_FACTOR_MAX, RID());
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].color_blend_op, BLEND_OP_MAX, RID());
+		const FramebufferPass &pass = fb_format.E->key().passes[p_for_render_pass];
+		ERR_FAIL_COND_V(p_blend_state.attachments.size() < pass.color_attachments.size(), RID());
+		for (int i = 0; i < pass.color_attachments.size(); i++) {
+			if (pass.color_attachments[i] != ATTACHMENT_UNUSED) {
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].src_color_blend_factor, BLEND_FACTOR_MAX, RID());
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].dst_color_blend_factor, BLEND_FACTOR_MAX, RID());
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].color_blend_op, BLEND_OP_MAX, RID());
 
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].src_alpha_blend_factor, BLEND_FACTOR_MAX, RID());
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].dst_alpha_blend_factor, BLEND_FACTOR_MAX, RID());
-			ERR_FAIL_INDEX_V(p_blend_state.attachments[i].alpha_blend_op, BLEND_OP_MAX, RID());
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].src_alpha_blend_factor, BLEND_FACTOR_MAX, RID());
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].dst_alpha_blend_factor, BLEND_FACTOR_MAX, RID());
+				ERR_FAIL_INDEX_V(p_blend_state.attachments[i].alpha_blend_op, BLEND_OP_MAX, RID());
+			}
 		}
-	}
 
-	for (int i = 0; i < shader->specialization_constants.size(); i++) {
-		const ShaderSpecializationConstant &sc = shader->specialization_constants[i];
-		for (int j = 0; j < p_specialization_constants.size(); j++) {
-			const PipelineSpecializationConstant &psc = p_specialization_constants[j];
-			if (psc.constant_id == sc.constant_id) {
-				ERR_FAIL_COND_V_MSG(psc.type != sc.type, RID(), "Specialization constant provided for id (" + itos(sc.constant_id) + ") is of the wrong type.");
-				break;
+		for (int i = 0; i < shader->specialization_constants.size(); i++) {
+			const ShaderSpecializationConstant &sc = shader->specialization_constants[i];
+			for (int j = 0; j < p_specialization_constants.size(); j++) {
+				const PipelineSpecializationConstant &psc = p_specialization_constants[j];
+				if (psc.constant_id == sc.constant_id) {
+					ERR_FAIL_COND_V_MSG(psc.type != sc.type, RID(), "Specialization constant provided for id (" + itos(sc.constant_id) + ") is of the wrong type.");
+					break;
+				}
 			}
 		}
+
+		shader_driver_id = shader->driver_id;
+		driver_render_pass = fb_format.render_pass;
+		color_attachments = pass.color_attachments;
 	}
 
 	RenderPipeline pipeline;
-	pipeline.driver_id = driver->render_pipeline_create(
-			shader->driver_id,
-			driver_vertex_format,
-			p_render_primitive,
-			p_rasterization_state,
-			p_multisample_state,
-			p_depth_stencil_state,
-			p_blend_state,
-			pass.color_attachments,
-			p_dynamic_state_flags,
-			fb_format.render_pass,
-			p_for_render_pass,
-			p_specialization_constants);
+	{
+		// Drivers may not support concurrent pipeline creation, e.g. when the pipeline cache is externally synchronized.
+		MutexLock lock(pipeline_create_mutex);
+		pipeline.driver_id = driver->render_pipeline_create(
+				shader_driver_id,
+				driver_vertex_format,
+				p_render_primitive,
+				p_rasterization_state,
+				p_multisample_state,
+				p_depth_stencil_state,
+				p_blend_state,
+				color_attachments,
+				p_dynamic_state_flags,
+				driver_render_pass,
+				p_for_render_pass,
+				p_specialization_constants);
+	}
 	ERR_FAIL_COND_V(!pipeline.driver_id, RID());
 
+	_THREAD_SAFE_METHOD_
+
+	// The shader must outlive the compilation, this only catches it being freed in the meantime.
+	Shader *shader = shader_owner.get_or_null(p_shader);
+	if (shader == nullptr || shader->driver_id != shader_driver_id) {
+		driver->pipeline_free(pipeline.driver_id);
+		ERR_FAIL_V_MSG(RID(), "Shader was freed while creating a render pipeline with it.");
+	}
+
 	if (pipeline_cache_enabled) {
 		_update_pipeline_cache();
 	}
@@ -3103,7 +3156,10 @@ RID RenderingDevice::compute_pipeline_create(RID p_shader, const Vector<Pipeline
 	}
 
 	ComputePipeline pipeline;
-	pipeline.driver_id = driver->compute_pipeline_create(shader->driver_id, p_specialization_constants);
+	{
+		MutexLock lock(pipeline_create_mutex);
+		pipeline.driver_id = driver->compute_pipeline_create(shader->driver_id, p_specialization_constants);
+	}
 	ERR_FAIL_COND_V(!pipeline.driver_id, RID());
 
 	if (pipeline_cache_enabled) {
@@ -5137,7 +5193,9 @@ void RenderingDevice::_update_pipeline_cache(bool p_closing) {
 	}
 
 	{
+		pipeline_create_mutex.lock();
 		size_t new_pipelines_cache_size = driver->pipeline_cache_query_size();
+		pipeline_create_mutex.unlock();
 		ERR_FAIL_COND(!new_pipelines_cache_size);
 		size_t difference = new_pipelines_cache_size - pipeline_cache_size;
 
@@ -5168,7 +5226,9 @@ void RenderingDevice::_save_pipeline_cache(void *p_data) {
 	RenderingDevice *self = static_cast<RenderingDevice *>(p_data);
 
 	self->_thread_safe_.lock();
+	self->pipeline_create_mutex.lock();
 	Vector<uint8_t> cache_blob = self->driver->pipeline_cache_serialize();
+	self->pipeline_create_mutex.unlock();
 	self->_thread_safe_.unlock();
 
 	if (cache_blob.size() == 0) {
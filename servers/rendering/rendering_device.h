@@ -365,6 +365,30 @@ private:
 		Vector<FramebufferPass> passes;
 		uint32_t view_count = 1;
 
+		// Only depends on the description, so it remains the same across runs.
+		uint32_t hash() const {
+			uint32_t h = hash_murmur3_one_32(view_count);
+			h = hash_murmur3_one_32(attachments.size(), h);
+			for (const AttachmentFormat &af : attachments) {
+				h = hash_murmur3_one_32(af.format, h);
+				h = hash_murmur3_one_32(af.samples, h);
+				h = hash_murmur3_one_32(af.usage_flags, h);
+			}
+			h = hash_murmur3_one_32(passes.size(), h);
+			for (const FramebufferPass &pass : passes) {
+				const Vector<int32_t> *lists[4] = { &pass.color_attachments, &pass.input_attachments, &pass.resolve_attachments, &pass.preserve_attachments };
+				for (const Vector<int32_t> *list : lists) {
+					h = hash_murmur3_one_32(list->size(), h);
+					for (int32_t attachment : *list) {
+						h = hash_murmur3_one_32(attachment, h);
+					}
+				}
+				h = hash_murmur3_one_32(pass.depth_attachment, h);
+				h = hash_murmur3_one_32(pass.vrs_attachment, h);
+			}
+			return hash_fmix32(h);
+		}
+
 		bool operator<(const FramebufferFormatKey &p_key) const {
 			if (view_count != p_key.view_count) {
 				return view_count < p_key.view_count;
@@ -538,6 +562,7 @@ public:
 	FramebufferFormatID framebuffer_format_create_multipass(const Vector<AttachmentFormat> &p_attachments, const Vector<FramebufferPass> &p_passes, uint32_t p_view_count = 1);
 	FramebufferFormatID framebuffer_format_create_empty(TextureSamples p_samples = TEXTURE_SAMPLES_1);
 	TextureSamples framebuffer_format_get_texture_samples(FramebufferFormatID p_format, uint32_t p_pass = 0);
+	uint32_t framebuffer_format_get_hash(FramebufferFormatID p_format);
 
 	RID framebuffer_create(const Vector<RID> &p_texture_attachments, FramebufferFormatID p_format_check = INVALID_ID, uint32_t p_view_count = 1);
 	RID framebuffer_create_multipass(const Vector<RID> &p_texture_attachments, const Vector<FramebufferPass> &p_passes, FramebufferFormatID p_format_check = INVALID_ID, uint32_t p_view_count = 1);
@@ -684,6 +709,7 @@ public:
 
 	// This ID is warranted to be unique for the same formats, does not need to be freed
 	VertexFormatID vertex_format_create(const Vector<VertexAttribute> &p_vertex_descriptions);
+	uint32_t vertex_format_get_hash(VertexFormatID p_format);
 	RID vertex_array_create(uint32_t p_vertex_count, VertexFormatID p_vertex_format, const Vector<RID> &p_src_buffers, const Vector<uint64_t> &p_offsets = Vector<uint64_t>());
 
 	RID index_buffer_create(uint32_t p_size_indices, IndexBufferFormat p_format, const Vector<uint8_t> &p_data = Vector<uint8_t>(), bool p_use_restart_indices = false);
@@ -746,6 +772,7 @@ private:
 
 	struct Shader : public ShaderDescription {
 		String name; // Used for debug.
+		uint32_t binary_hash = 0; // Stable across runs, unlike the RID.
 		RDD::ShaderID driver_id;
 		uint32_t layout_hash = 0;
 		BitField<RDD::PipelineStageBits> stage_bits;
@@ -816,6 +843,7 @@ public:
 	RID shader_create_placeholder();
 
 	uint64_t shader_get_vertex_input_attribute_mask(RID p_shader);
+	uint32_t shader_get_binary_hash(RID p_shader);
 
 	/******************/
 	/**** UNIFORMS ****/
@@ -971,6 +999,7 @@ private:
 
 	bool pipeline_cache_enabled = false;
 	size_t pipeline_cache_size = 0;
+	Mutex pipeline_create_mutex; // Serializes driver pipeline creation and cache access, render pipelines are created without the device lock.
 	String pipeline_cache_file_path;
 	WorkerThreadPool::TaskID pipeline_cache_save_task = WorkerThreadPool::INVALID_TASK_ID;
 
@@ -252,6 +252,8 @@ uint64_t RenderingServerDefault::get_rendering_info(RenderingInfo p_info) {
 		return RSG::viewport->get_total_primitives_drawn();
 	} else if (p_info == RENDERING_INFO_TOTAL_DRAW_CALLS_IN_FRAME) {
 		return RSG::viewport->get_total_draw_calls_used();
+	} else if (p_info == RENDERING_INFO_CANVAS_BATCHES_IN_FRAME || p_info == RENDERING_INFO_CANVAS_BATCHED_COMMANDS_IN_FRAME || p_info == RENDERING_INFO_CANVAS_UNBATCHED_COMMANDS_IN_FRAME) {
+		return RSG::canvas_render->get_rendering_info(p_info);
 	}
 	return RSG::utilities->get_rendering_info(p_info);
 }
@@ -1455,7 +1455,7 @@ ShaderLanguage::DataType ShaderCompiler::_get_global_shader_uniform_type(const S
 	return (ShaderLanguage::DataType)RS::global_shader_uniform_type_get_shader_datatype(gvt);
 }
 
-Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+Error ShaderCompiler::_compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
 	SL::ShaderCompileInfo info;
 	info.functions = ShaderTypes::get_singleton()->get_functions(p_mode);
 	info.render_modes = ShaderTypes::get_singleton()->get_modes(p_mode);
@@ -1563,8 +1563,147 @@ Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, Ident
 	return OK;
 }
 
+Error ShaderCompiler::_compile_and_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	// Compile against copies of the flags and uniforms, so the ones that get set can be recorded.
+	IdentifierActions recording_actions = *p_actions;
+
+	LocalVector<bool> usage_flags;
+	usage_flags.resize(p_actions->usage_flag_pointers.size());
+	uint32_t index = 0;
+	for (KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		usage_flags[index] = false;
+		E.value = &usage_flags[index++];
+	}
+
+	LocalVector<bool> write_flags;
+	write_flags.resize(p_actions->write_flag_pointers.size());
+	index = 0;
+	for (KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		write_flags[index] = false;
+		E.value = &write_flags[index++];
+	}
+
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	recording_actions.uniforms = &uniforms;
+
+	Error err = _compile(p_mode, p_code, &recording_actions, p_path, r_gen_code);
+	if (err != OK) {
+		return err;
+	}
+
+	CachedShader cached;
+	cached.mode = p_mode;
+	cached.gen_code = r_gen_code;
+	cached.render_modes = shader->render_modes;
+	index = 0;
+	for (const KeyValue<StringName, bool *> &E : recording_actions.usage_flag_pointers) {
+		if (usage_flags[index++]) {
+			cached.usage_flags.push_back(E.key);
+		}
+	}
+	index = 0;
+	for (const KeyValue<StringName, bool *> &E : recording_actions.write_flag_pointers) {
+		if (write_flags[index++]) {
+			cached.write_flags.push_back(E.key);
+		}
+	}
+	cached.uniforms = uniforms;
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : shader->uniforms) {
+		if (E.value.scope == SL::ShaderNode::Uniform::SCOPE_GLOBAL) {
+			cached.global_uniforms.push_back(Pair<StringName, SL::DataType>(E.key, E.value.type));
+		}
+	}
+
+	_apply_cached_shader(cached, p_actions, r_gen_code);
+
+	if (shader_cache.has(p_code)) {
+		shader_cache_order.erase(p_code);
+	}
+	shader_cache[p_code] = cached;
+	shader_cache_order.push_back(p_code);
+	while (shader_cache_order.size() > shader_cache_size) {
+		shader_cache.erase(shader_cache_order.front()->get());
+		shader_cache_order.pop_front();
+	}
+
+	return OK;
+}
+
+void ShaderCompiler::_apply_cached_shader(const CachedShader &p_cached, IdentifierActions *p_actions, GeneratedCode &r_gen_code) {
+	if (&r_gen_code != &p_cached.gen_code) {
+		r_gen_code = p_cached.gen_code;
+	}
+
+	// Same order as when compiling, as different render modes may set the same value.
+	for (const StringName &render_mode : p_cached.render_modes) {
+		if (p_actions->render_mode_flags.has(render_mode)) {
+			*p_actions->render_mode_flags[render_mode] = true;
+		}
+		if (p_actions->render_mode_values.has(render_mode)) {
+			Pair<int *, int> &p = p_actions->render_mode_values[render_mode];
+			*p.first = p.second;
+		}
+	}
+	for (const StringName &flag : p_cached.usage_flags) {
+		bool **pointer = p_actions->usage_flag_pointers.getptr(flag);
+		if (pointer) {
+			**pointer = true;
+		}
+	}
+	for (const StringName &flag : p_cached.write_flags) {
+		bool **pointer = p_actions->write_flag_pointers.getptr(flag);
+		if (pointer) {
+			**pointer = true;
+		}
+	}
+	for (const KeyValue<StringName, SL::ShaderNode::Uniform> &E : p_cached.uniforms) {
+		p_actions->uniforms->insert(E.key, E.value);
+	}
+}
+
+Error ShaderCompiler::compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code) {
+	if (shader_cache_size <= 0) {
+		return _compile(p_mode, p_code, p_actions, p_path, r_gen_code);
+	}
+
+	HashMap<String, CachedShader>::Iterator E = shader_cache.find(p_code);
+	if (E && E->value.mode == p_mode) {
+		bool globals_changed = false;
+		for (const Pair<StringName, SL::DataType> &global_uniform : E->value.global_uniforms) {
+			if (_get_global_shader_uniform_type(global_uniform.first) != global_uniform.second) {
+				globals_changed = true;
+				break;
+			}
+		}
+		if (!globals_changed) {
+			shader_cache_hits++;
+			_apply_cached_shader(E->value, p_actions, r_gen_code);
+			// Keep recently used shaders around.
+			shader_cache_order.erase(p_code);
+			shader_cache_order.push_back(p_code);
+			return OK;
+		}
+	}
+
+	return _compile_and_cache(p_mode, p_code, p_actions, p_path, r_gen_code);
+}
+
+void ShaderCompiler::set_shader_cache_size(int p_size) {
+	shader_cache_size = p_size;
+	while (shader_cache_order.size() > MAX(shader_cache_size, 0)) {
+		shader_cache.erase(shader_cache_order.front()->get());
+		shader_cache_order.pop_front();
+	}
+}
+
+void ShaderCompiler::clear_shader_cache() {
+	shader_cache.clear();
+	shader_cache_order.clear();
+}
+
 void ShaderCompiler::initialize(DefaultIdentifierActions p_actions) {
 	actions = p_actions;
+	clear_shader_cache(); // Generated with the previous actions.
 
 	time_name = "TIME";
 
@@ -125,11 +125,40 @@ private:
 
 	DefaultIdentifierActions actions;
 
+	// Results of previous compilations, keyed by the preprocessed code. Materials often share the exact same code,
+	// and changing a shader include only changes the code of some of the shaders using it.
+	struct CachedShader {
+		RS::ShaderMode mode = RS::SHADER_MAX;
+		GeneratedCode gen_code;
+		// Side effects on IdentifierActions, replayed on every use.
+		Vector<StringName> render_modes;
+		LocalVector<StringName> usage_flags;
+		LocalVector<StringName> write_flags;
+		HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+		// Global uniform types are looked up while parsing, so they must not have changed.
+		LocalVector<Pair<StringName, ShaderLanguage::DataType>> global_uniforms;
+	};
+
+	HashMap<String, CachedShader> shader_cache;
+	List<String> shader_cache_order; // Oldest first.
+	int shader_cache_size = 256;
+	uint32_t shader_cache_hits = 0;
+
+	Error _compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	Error _compile_and_cache(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
+	void _apply_cached_shader(const CachedShader &p_cached, IdentifierActions *p_actions, GeneratedCode &r_gen_code);
+
 	static ShaderLanguage::DataType _get_global_shader_uniform_type(const StringName &p_name);
 
 public:
 	Error compile(RS::ShaderMode p_mode, const String &p_code, IdentifierActions *p_actions, const String &p_path, GeneratedCode &r_gen_code);
 
+	// A size of 0 disables the cache.
+	void set_shader_cache_size(int p_size);
+	int get_shader_cache_size() const { return shader_cache_size; }
+	uint32_t get_shader_cache_hits() const { return shader_cache_hits; }
+	void clear_shader_cache();
+
 	void initialize(DefaultIdentifierActions p_actions);
 	ShaderCompiler();
 };
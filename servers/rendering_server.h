@@ -1305,6 +1305,8 @@ public:
 	virtual void instance_set_layer_mask(RID p_instance, uint32_t p_mask) = 0;
 	virtual void instance_set_pivot_data(RID p_instance, float p_sorting_offset, bool p_use_aabb_center) = 0;
 	virtual void instance_set_transform(RID p_instance, const Transform3D &p_transform) = 0;
+	// Instance RIDs as returned by RID::get_id(), and 12 floats per transform in the same layout as multimesh buffers.
+	virtual void instances_set_transforms(const PackedInt64Array &p_instances, const PackedFloat32Array &p_transforms) = 0;
 	virtual void instance_attach_object_instance_id(RID p_instance, ObjectID p_id) = 0;
 	virtual void instance_set_blend_shape_weight(RID p_instance, int p_shape, float p_weight) = 0;
 	virtual void instance_set_surface_override_material(RID p_instance, int p_surface, RID p_material) = 0;
@@ -1623,6 +1625,9 @@ public:
 		RENDERING_INFO_TEXTURE_MEM_USED,
 		RENDERING_INFO_BUFFER_MEM_USED,
 		RENDERING_INFO_VIDEO_MEM_USED,
+		RENDERING_INFO_CANVAS_BATCHES_IN_FRAME,
+		RENDERING_INFO_CANVAS_BATCHED_COMMANDS_IN_FRAME,
+		RENDERING_INFO_CANVAS_UNBATCHED_COMMANDS_IN_FRAME,
 		RENDERING_INFO_MAX
 	};
 
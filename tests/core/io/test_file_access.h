@@ -31,7 +31,11 @@
 #ifndef TEST_FILE_ACCESS_H
 #define TEST_FILE_ACCESS_H
 
+#include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/file_access_pack.h"
+#include "core/os/os.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -107,6 +111,63 @@ TEST_CASE("[FileAccess] Get as UTF-8 String") {
 	CHECK(s_cr == "Hello darkness\rMy old friend\rI've come to talk\rWith you again\r");
 	CHECK(s_cr_nocr == "Hello darknessMy old friendI've come to talkWith you again");
 }
+
+TEST_CASE("[FileAccess] Mapped buffer") {
+	Ref<FileAccess> f = FileAccess::open(TestUtils::get_data_path("testdata.csv"), FileAccess::READ);
+	REQUIRE(!f.is_null());
+
+	const uint8_t *mapped = f->get_mapped_buffer();
+	if (!mapped) {
+		// Memory-mapping is optional, nothing more to check on this platform.
+		return;
+	}
+
+	Vector<uint8_t> contents = f->get_buffer(f->get_length());
+	REQUIRE(contents.size() == (int64_t)f->get_length());
+	CHECK_MESSAGE(memcmp(mapped, contents.ptr(), contents.size()) == 0, "Mapped contents should match the contents read from the file.");
+	CHECK_MESSAGE(f->get_mapped_buffer() == mapped, "The mapping should be reused while the file is open.");
+
+	const String write_path = OS::get_singleton()->get_cache_path().path_join("mapped_buffer.txt");
+	Ref<FileAccess> f_write = FileAccess::open(write_path, FileAccess::WRITE);
+	REQUIRE(!f_write.is_null());
+	f_write->store_string("Not mapped");
+	CHECK_MESSAGE(f_write->get_mapped_buffer() == nullptr, "Files opened for writing should never be mapped.");
+	f_write->close();
+	DirAccess::remove_absolute(write_path);
+}
+
+TEST_CASE("[FileAccess] Mapped buffer of a memory file") {
+	const uint8_t bytes[4] = { 1, 2, 3, 4 };
+	Ref<FileAccessMemory> f;
+	f.instantiate();
+	REQUIRE(f->open_custom(bytes, 4) == OK);
+	CHECK_MESSAGE(f->get_mapped_buffer() == bytes, "Read-only memory files should expose their buffer directly.");
+}
+
+TEST_CASE("[FileAccess] Pack file served from a mapped pack") {
+	Ref<FileAccess> pack = FileAccess::open(TestUtils::get_data_path("testdata.csv"), FileAccess::READ);
+	REQUIRE(!pack.is_null());
+	const uint8_t *mapped = pack->get_mapped_buffer();
+	if (!mapped) {
+		// Memory-mapping is optional, nothing more to check on this platform.
+		return;
+	}
+	const Vector<uint8_t> expected = pack->get_buffer(pack->get_length()).slice(4, 20);
+
+	PackedData::PackedFile pf;
+	pf.pack = TestUtils::get_data_path("testdata.csv");
+	pf.offset = 4;
+	pf.size = 16;
+	pf.encrypted = false;
+	Ref<FileAccess> f = memnew(FileAccessPack("res://testdata.csv", pf, pack));
+	CHECK(f->get_mapped_buffer() == mapped + 4);
+
+	// The pack source dropping its handle, e.g. when the pack is opened again, must not invalidate the mapping.
+	pack = Ref<FileAccess>();
+	CHECK(f->is_open());
+	CHECK(f->get_length() == 16);
+	CHECK(f->get_buffer(16) == expected);
+}
 } // namespace TestFileAccess
 
 #endif // TEST_FILE_ACCESS_H
@@ -32,6 +32,7 @@
 #define TEST_RESOURCE_H
 
 #include "core/io/resource.h"
+#include "core/io/resource_format_binary.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
 #include "core/os/os.h"
@@ -161,6 +162,57 @@ TEST_CASE("[Resource] Breaking circular references on save") {
 	// Break circular reference to avoid memory leak
 	resource_c->remove_meta("next");
 }
+
+TEST_CASE("[Resource] Loading large binary payloads with sub-threads") {
+	PackedByteArray bytes;
+	bytes.resize(3 * 1024 * 1024 + 17);
+	for (int64_t i = 0; i < bytes.size(); i++) {
+		bytes.set(i, i * 7);
+	}
+	PackedVector3Array vertices;
+	vertices.resize(100000);
+	for (int64_t i = 0; i < vertices.size(); i++) {
+		vertices.set(i, Vector3(i, -i, i * 0.5));
+	}
+	PackedFloat32Array floats;
+	floats.resize(200000);
+	for (int64_t i = 0; i < floats.size(); i++) {
+		floats.set(i, i * 0.25);
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("vertices", vertices);
+	Ref<Resource> child_resource = memnew(Resource);
+	child_resource->set_meta("floats", floats);
+	Array arrays;
+	arrays.push_back(floats);
+	arrays.push_back(bytes);
+	resource->set_meta("arrays", arrays);
+	resource->set_meta("other_resource", child_resource);
+
+	const String save_path_binary = OS::get_singleton()->get_cache_path().path_join("resource_payloads.res");
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+
+	for (bool use_sub_threads : { false, true }) {
+		Ref<ResourceFormatLoaderBinary> loader;
+		loader.instantiate();
+		Error err = FAILED;
+		Ref<Resource> loaded = loader->load(save_path_binary, "", &err, use_sub_threads, nullptr, ResourceFormatLoader::CACHE_MODE_IGNORE);
+		REQUIRE(err == OK);
+		REQUIRE(loaded.is_valid());
+
+		CHECK_MESSAGE(PackedByteArray(loaded->get_meta("bytes")) == bytes, "The loaded byte payload should match the saved one.");
+		CHECK_MESSAGE(PackedVector3Array(loaded->get_meta("vertices")) == vertices, "The loaded vector payload should match the saved one.");
+		Array loaded_arrays = loaded->get_meta("arrays");
+		REQUIRE(loaded_arrays.size() == 2);
+		CHECK(PackedFloat32Array(loaded_arrays[0]) == floats);
+		CHECK(PackedByteArray(loaded_arrays[1]) == bytes);
+		Ref<Resource> loaded_child = loaded->get_meta("other_resource");
+		REQUIRE(loaded_child.is_valid());
+		CHECK_MESSAGE(PackedFloat32Array(loaded_child->get_meta("floats")) == floats, "Payloads of sub-resources should be loaded too.");
+	}
+}
 } // namespace TestResource
 
 #endif // TEST_RESOURCE_H
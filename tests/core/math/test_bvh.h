@@ -0,0 +1,187 @@
+/**************************************************************************/
+/*  test_bvh.h                                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_BVH_H
+#define TEST_BVH_H
+
+#include "core/math/bvh.h"
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBVH {
+
+struct TestItem {
+	int id = 0;
+};
+
+class TestPairFunction {
+public:
+	static bool user_pair_check(const TestItem *p_a, const TestItem *p_b) {
+		return true;
+	}
+};
+
+class TestCullFunction {
+public:
+	static bool user_cull_check(const TestItem *p_a, const TestItem *p_b) {
+		return true;
+	}
+};
+
+typedef BVH_Manager<TestItem, 1, true, 32, TestPairFunction, TestCullFunction> TestBVHManager;
+
+// Creates and moves items in a BVH and records the pair callbacks in the order they are sent.
+class PairingScene {
+	TestBVHManager bvh;
+	LocalVector<TestItem> items;
+	LocalVector<uint32_t> handles;
+	LocalVector<Vector3> positions;
+	LocalVector<Vector3> velocities;
+
+	static void *_pair(void *p_self, uint32_t p_A, TestItem *p_item_A, int p_subindex_A, uint32_t p_B, TestItem *p_item_B, int p_subindex_B) {
+		PairingScene *self = static_cast<PairingScene *>(p_self);
+		self->events.push_back(Vector3i(1, p_item_A->id, p_item_B->id));
+		return nullptr;
+	}
+
+	static void _unpair(void *p_self, uint32_t p_A, TestItem *p_item_A, int p_subindex_A, uint32_t p_B, TestItem *p_item_B, int p_subindex_B, void *p_pair_data) {
+		PairingScene *self = static_cast<PairingScene *>(p_self);
+		self->events.push_back(Vector3i(0, p_item_A->id, p_item_B->id));
+	}
+
+	AABB _get_aabb(int p_index) const {
+		return AABB(positions[p_index] - Vector3(0.5, 0.5, 0.5), Vector3(1, 1, 1));
+	}
+
+public:
+	// Pair (1) and unpair (0) callbacks, with the ids of both items.
+	Vector<Vector3i> events;
+
+	void create(int p_item_count, bool p_threaded) {
+		bvh.set_pair_callback(_pair, this);
+		bvh.set_unpair_callback(_unpair, this);
+		bvh.params_set_threaded_update(p_threaded);
+
+		RandomPCG rng(12345);
+		items.resize(p_item_count);
+		for (int i = 0; i < p_item_count; i++) {
+			items[i].id = i;
+			positions.push_back(Vector3(rng.randf(), rng.randf(), rng.randf()) * 40.0);
+			velocities.push_back(Vector3(rng.randf() - 0.5, rng.randf() - 0.5, rng.randf() - 0.5));
+			handles.push_back(bvh.create(&items[i], true, 0, 1, _get_aabb(i)));
+		}
+		bvh.update();
+	}
+
+	void step() {
+		for (uint32_t i = 0; i < handles.size(); i++) {
+			positions[i] += velocities[i];
+			bvh.move(handles[i], _get_aabb(i));
+		}
+		bvh.update();
+	}
+
+	Vector<int> cull(const AABB &p_aabb) {
+		TestItem *results[4096];
+		int count = bvh.cull_aabb(p_aabb, results, 4096, nullptr);
+
+		Vector<int> ids;
+		for (int i = 0; i < count; i++) {
+			ids.push_back(results[i]->id);
+		}
+		ids.sort();
+		return ids;
+	}
+
+	void free() {
+		for (uint32_t handle : handles) {
+			bvh.erase(handle);
+		}
+		handles.clear();
+	}
+};
+
+TEST_CASE("[BVH] Threaded update sends the same pair callbacks as the serial one") {
+	// Enough moving items for both the refit and the pair search to go to worker threads.
+	const int item_count = 2000;
+
+	PairingScene serial;
+	serial.create(item_count, false);
+	PairingScene threaded;
+	threaded.create(item_count, true);
+
+	CHECK(serial.events.size() > 0);
+	CHECK(serial.events == threaded.events);
+
+	for (int i = 0; i < 10; i++) {
+		serial.events.clear();
+		threaded.events.clear();
+
+		serial.step();
+		threaded.step();
+
+		CHECK_MESSAGE(serial.events == threaded.events, vformat("Pair callbacks differ at step %d.", i));
+	}
+
+	// The refitted trees find the same items.
+	for (int i = 0; i < 8; i++) {
+		AABB aabb(Vector3(i * 6.0, 10, i * 4.0), Vector3(8, 8, 8));
+		CHECK(serial.cull(aabb) == threaded.cull(aabb));
+	}
+
+	serial.free();
+	threaded.free();
+}
+
+TEST_CASE("[BVH][Benchmark] Serial and threaded update" * doctest::skip()) {
+	const int item_count = 20000;
+	const int steps = 60;
+
+	for (bool threaded : { false, true }) {
+		PairingScene scene;
+		scene.create(item_count, threaded);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < steps; i++) {
+			scene.step();
+		}
+		uint64_t step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / steps;
+
+		print_line(vformat("%d moving items, %s update: %d usec per step.", item_count, threaded ? "threaded" : "serial", step_usec));
+
+		scene.free();
+	}
+}
+
+} // namespace TestBVH
+
+#endif // TEST_BVH_H
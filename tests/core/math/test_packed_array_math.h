@@ -0,0 +1,275 @@
+/**************************************************************************/
+/*  test_packed_array_math.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PACKED_ARRAY_MATH_H
+#define TEST_PACKED_ARRAY_MATH_H
+
+#include "core/math/packed_array_math.h"
+#include "core/os/os.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPackedArrayMath {
+
+// Sizes around the vector width, so both the vector loops and the scalar tails are covered.
+static const int test_sizes[] = { 1, 2, 3, 4, 5, 7, 8, 9, 16, 31 };
+
+static PackedFloat32Array _make_floats(int p_size, float p_offset) {
+	PackedFloat32Array array;
+	array.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		array.set(i, Math::sin(i * 0.7f + p_offset) * (i + 1));
+	}
+	return array;
+}
+
+static PackedVector3Array _make_vectors(int p_size, float p_offset) {
+	PackedVector3Array array;
+	array.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		array.set(i, Vector3(Math::sin(i + p_offset), Math::cos(i * 1.3f + p_offset), i * 0.25f - p_offset));
+	}
+	return array;
+}
+
+TEST_CASE("[PackedArrayMath] Element-wise float operations") {
+	for (int size : test_sizes) {
+		const PackedFloat32Array a = _make_floats(size, 0.0);
+		const PackedFloat32Array b = _make_floats(size, 2.0);
+		PackedFloat32Array result;
+		result.resize(size);
+
+		PackedArrayMath::add(a.ptr(), b.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i] == a[i] + b[i]);
+		}
+
+		PackedArrayMath::multiply(a.ptr(), b.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i] == a[i] * b[i]);
+		}
+
+		PackedArrayMath::lerp(a.ptr(), b.ptr(), 0.3f, result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i] == doctest::Approx(Math::lerp(a[i], b[i], 0.3f)));
+		}
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Dequantize and interpolate") {
+	for (int size : test_sizes) {
+		LocalVector<uint16_t> from;
+		LocalVector<uint16_t> to;
+		from.resize(size);
+		to.resize(size);
+		for (int i = 0; i < size; i++) {
+			from[i] = uint16_t(i * 4099);
+			to[i] = uint16_t(65535 - i * 1021);
+		}
+		const PackedFloat32Array weight = _make_floats(size, 1.0);
+		const PackedFloat32Array position = _make_floats(size, 3.0);
+		const PackedFloat32Array extent = _make_floats(size, 5.0);
+		PackedFloat32Array result;
+		result.resize(size);
+
+		PackedArrayMath::dequantize_lerp(from.ptr(), to.ptr(), weight.ptr(), position.ptr(), extent.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			const float a = position[i] + (float(from[i]) / 65535.0f) * extent[i];
+			const float b = position[i] + (float(to[i]) / 65535.0f) * extent[i];
+			CHECK(result[i] == doctest::Approx(a + (b - a) * weight[i]));
+		}
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Reductions") {
+	for (int size : test_sizes) {
+		const PackedFloat32Array a = _make_floats(size, 0.0);
+		const PackedFloat32Array b = _make_floats(size, 2.0);
+
+		double sum = 0.0;
+		double dot = 0.0;
+		float min = a[0];
+		float max = a[0];
+		for (int i = 0; i < size; i++) {
+			sum += a[i];
+			dot += (double)a[i] * (double)b[i];
+			min = MIN(min, a[i]);
+			max = MAX(max, a[i]);
+		}
+
+		CHECK(PackedArrayMath::sum(a.ptr(), size) == doctest::Approx(sum));
+		CHECK(PackedArrayMath::dot(a.ptr(), b.ptr(), size) == doctest::Approx(dot));
+		CHECK(PackedArrayMath::min(a.ptr(), size) == min);
+		CHECK(PackedArrayMath::max(a.ptr(), size) == max);
+	}
+
+	CHECK(PackedArrayMath::sum(nullptr, 0) == 0.0);
+
+	// Large and small values, which a single precision accumulator would lose.
+	PackedFloat32Array mixed;
+	for (int i = 0; i < 9; i++) {
+		mixed.push_back(i % 2 ? 1e8f : 1.0f);
+	}
+	CHECK(PackedArrayMath::sum(mixed.ptr(), mixed.size()) == 4e8 + 5.0);
+}
+
+TEST_CASE("[PackedArrayMath] NaN in min and max") {
+	PackedFloat32Array array = _make_floats(9, 0.0);
+	const float min = PackedArrayMath::min(array.ptr(), array.size());
+	const float max = PackedArrayMath::max(array.ptr(), array.size());
+
+	array.set(1, NAN);
+	array.set(6, NAN);
+	CHECK(PackedArrayMath::min(array.ptr(), array.size()) == min);
+	CHECK(PackedArrayMath::max(array.ptr(), array.size()) == max);
+
+	array.set(0, NAN);
+	CHECK(Math::is_nan(PackedArrayMath::min(array.ptr(), array.size())));
+	CHECK(Math::is_nan(PackedArrayMath::max(array.ptr(), array.size())));
+}
+
+TEST_CASE("[PackedArrayMath] Vector3 operations") {
+	const Transform3D transform = Transform3D(Basis(Vector3(0.3, -1.2, 0.5), 0.8).scaled(Vector3(1.5, 0.5, 2.0)), Vector3(3.0, -2.0, 7.5));
+
+	for (int size : test_sizes) {
+		const PackedVector3Array a = _make_vectors(size, 0.0);
+		const PackedVector3Array b = _make_vectors(size, 1.5);
+		PackedVector3Array result;
+		result.resize(size);
+
+		PackedArrayMath::add(a.ptr(), b.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i] == a[i] + b[i]);
+		}
+
+		PackedArrayMath::multiply(a.ptr(), b.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i] == a[i] * b[i]);
+		}
+
+		PackedArrayMath::lerp(a.ptr(), b.ptr(), 0.75, result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i].is_equal_approx(a[i].lerp(b[i], 0.75)));
+		}
+
+		PackedArrayMath::xform(transform, a.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i].is_equal_approx(transform.xform(a[i])));
+		}
+
+		// In place.
+		result = a;
+		PackedArrayMath::xform(transform, result.ptr(), result.ptrw(), size);
+		for (int i = 0; i < size; i++) {
+			CHECK(result[i].is_equal_approx(transform.xform(a[i])));
+		}
+
+		const PackedVector3Array transformed = transform.xform(a);
+		REQUIRE(transformed.size() == size);
+		for (int i = 0; i < size; i++) {
+			CHECK(transformed[i].is_equal_approx(transform.xform(a[i])));
+		}
+	}
+}
+
+TEST_CASE("[PackedArrayMath] Builtin methods") {
+	const PackedFloat32Array a = _make_floats(10, 0.0);
+	const PackedFloat32Array b = _make_floats(10, 2.0);
+	Variant v = a;
+
+	CHECK(double(v.call("sum")) == doctest::Approx(PackedArrayMath::sum(a.ptr(), a.size())));
+	CHECK(double(v.call("dot", b)) == doctest::Approx(PackedArrayMath::dot(a.ptr(), b.ptr(), a.size())));
+	CHECK(double(v.call("min")) == PackedArrayMath::min(a.ptr(), a.size()));
+	CHECK(double(v.call("max")) == PackedArrayMath::max(a.ptr(), a.size()));
+
+	const PackedFloat32Array added = v.call("add", b);
+	REQUIRE(added.size() == a.size());
+	CHECK(added[9] == a[9] + b[9]);
+	const PackedFloat32Array multiplied = v.call("multiply", b);
+	REQUIRE(multiplied.size() == a.size());
+	CHECK(multiplied[9] == a[9] * b[9]);
+	const PackedFloat32Array lerped = v.call("lerp", b, 0.5);
+	REQUIRE(lerped.size() == a.size());
+	CHECK(lerped[9] == doctest::Approx(Math::lerp(a[9], b[9], 0.5f)));
+
+	CHECK(double(Variant(PackedFloat32Array()).call("sum")) == 0.0);
+	CHECK(double(Variant(PackedFloat32Array()).call("min")) == 0.0);
+
+	ERR_PRINT_OFF;
+	CHECK(PackedFloat32Array(v.call("add", PackedFloat32Array())).is_empty());
+	CHECK(double(v.call("dot", PackedFloat32Array())) == 0.0);
+	ERR_PRINT_ON;
+
+	const PackedVector3Array va = _make_vectors(5, 0.0);
+	const PackedVector3Array vb = _make_vectors(5, 1.0);
+	const PackedVector3Array vector_added = Variant(va).call("add", vb);
+	REQUIRE(vector_added.size() == va.size());
+	CHECK(vector_added[4] == va[4] + vb[4]);
+	const PackedVector3Array vector_lerped = Variant(va).call("lerp", vb, 0.25);
+	REQUIRE(vector_lerped.size() == va.size());
+	CHECK(vector_lerped[4].is_equal_approx(va[4].lerp(vb[4], 0.25)));
+}
+
+TEST_CASE("[PackedArrayMath][Benchmark] Bulk operations on 100000 elements" * doctest::skip()) {
+	const int size = 100000;
+	const int iterations = 200;
+	const PackedFloat32Array a = _make_floats(size, 0.0);
+	const PackedFloat32Array b = _make_floats(size, 2.0);
+	const PackedVector3Array points = _make_vectors(size, 0.0);
+	const Transform3D transform = Transform3D(Basis(Vector3(0, 1, 0), 0.5), Vector3(1, 2, 3));
+	Variant v = a;
+
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	double sum = 0.0;
+	for (int i = 0; i < iterations; i++) {
+		sum += double(v.call("dot", b));
+	}
+	uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("dot (%s): %.3f usec per call (%f).", PackedArrayMath::get_simd_name(), double(usec) / iterations, sum));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		PackedFloat32Array result = v.call("lerp", b, 0.5);
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("lerp (%s): %.3f usec per call.", PackedArrayMath::get_simd_name(), double(usec) / iterations));
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < iterations; i++) {
+		PackedVector3Array result = transform.xform(points);
+	}
+	usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("Transform3D * PackedVector3Array (%s): %.3f usec per call.", PackedArrayMath::get_simd_name(), double(usec) / iterations));
+}
+
+} // namespace TestPackedArrayMath
+
+#endif // TEST_PACKED_ARRAY_MATH_H
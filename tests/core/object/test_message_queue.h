@@ -0,0 +1,147 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_MESSAGE_QUEUE_H
+#define TEST_MESSAGE_QUEUE_H
+
+#include "core/object/message_queue.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMessageQueue {
+
+static LocalVector<LocalVector<int>> received;
+
+static void _record(int p_thread, int p_sequence) {
+	received[p_thread].push_back(p_sequence);
+}
+
+struct PushData {
+	CallQueue *queue = nullptr;
+	int thread = 0;
+	int count = 0;
+};
+
+static void _push_calls(void *p_userdata) {
+	PushData *data = (PushData *)p_userdata;
+	Callable callable = callable_mp_static(&_record);
+	for (int i = 0; i < data->count; i++) {
+		data->queue->push_callable(callable, data->thread, i);
+	}
+}
+
+static void _push_from_threads(CallQueue &p_queue, int p_threads, int p_count) {
+	LocalVector<Thread> threads;
+	LocalVector<PushData> data;
+	threads.resize(p_threads);
+	data.resize(p_threads);
+	for (int i = 0; i < p_threads; i++) {
+		data[i].queue = &p_queue;
+		data[i].thread = i;
+		data[i].count = p_count;
+		threads[i].start(_push_calls, &data[i]);
+	}
+	for (int i = 0; i < p_threads; i++) {
+		threads[i].wait_to_finish();
+	}
+}
+
+TEST_CASE("[MessageQueue] Pushing from several threads") {
+	const int thread_count = 4;
+	const int message_count = 5000;
+
+	CallQueue queue;
+	received.clear();
+	received.resize(thread_count);
+
+	_push_from_threads(queue, thread_count, message_count);
+	CHECK(queue.has_messages());
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+
+	for (int i = 0; i < thread_count; i++) {
+		REQUIRE(received[i].size() == message_count);
+		bool in_order = true;
+		for (int j = 0; j < message_count; j++) {
+			in_order &= received[i][j] == j;
+		}
+		CHECK_MESSAGE(in_order, "Messages from one thread should be flushed in the order they were pushed.");
+	}
+
+	// Queues are reusable after their producer threads are gone.
+	received.clear();
+	received.resize(thread_count);
+	_push_from_threads(queue, thread_count, 10);
+	CHECK(queue.flush() == OK);
+	for (int i = 0; i < thread_count; i++) {
+		CHECK(received[i].size() == 10);
+	}
+}
+
+TEST_CASE("[MessageQueue] Clearing messages pushed from threads") {
+	CallQueue queue;
+	received.clear();
+	received.resize(2);
+
+	_push_from_threads(queue, 2, 100);
+	queue.clear();
+	CHECK_FALSE(queue.has_messages());
+	CHECK(queue.flush() == OK);
+	CHECK(received[0].is_empty());
+	CHECK(received[1].is_empty());
+}
+
+TEST_CASE("[MessageQueue][Benchmark] Contended pushes" * doctest::skip()) {
+	const int message_count = 50000;
+
+	for (int thread_count : { 1, 2, 4, 8 }) {
+		CallQueue queue(nullptr, 1 << 16);
+		received.clear();
+		received.resize(thread_count);
+		for (int i = 0; i < thread_count; i++) {
+			received[i].reserve(message_count);
+		}
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_push_from_threads(queue, thread_count, message_count);
+		uint64_t pushed = OS::get_singleton()->get_ticks_usec();
+		CHECK(queue.flush() == OK);
+		uint64_t flushed = OS::get_singleton()->get_ticks_usec();
+
+		print_line(vformat("%d threads pushing %d messages each: push %.2f ms, flush %.2f ms", thread_count, message_count, (pushed - begin) / 1000.0, (flushed - pushed) / 1000.0));
+	}
+}
+
+} // namespace TestMessageQueue
+
+#endif // TEST_MESSAGE_QUEUE_H
@@ -106,6 +106,252 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+struct GraphTestData {
+	LocalVector<SafeNumeric<int>> elements;
+	SafeNumeric<int> sequence;
+	SafeNumeric<int> errors;
+	int fan_out_step[2] = {};
+	int join_step = 0;
+
+	void fill(uint32_t p_index, void *p_userdata) {
+		elements[p_index].increment();
+	}
+	void fan_out(int p_which) {
+		for (uint32_t i = 0; i < elements.size(); i++) {
+			if (elements[i].get() != 1) {
+				errors.increment();
+			}
+		}
+		fan_out_step[p_which] = sequence.increment();
+	}
+	void join(uint32_t p_index, void *p_userdata) {
+		if (fan_out_step[0] == 0 || fan_out_step[1] == 0) {
+			errors.increment();
+		}
+		elements[p_index].increment();
+	}
+};
+
+static void static_graph_test(void *p_arg) {
+	((GraphTestData *)p_arg)->join_step = ((GraphTestData *)p_arg)->sequence.increment();
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph runs tasks after their dependencies") {
+	GraphTestData data;
+	WorkerThreadPool::TaskGraph graph;
+
+	WorkerThreadPool::TaskGraph::NodeID fill = graph.add_template_group_task(&data, &GraphTestData::fill, nullptr, 256, -1, "GraphFill");
+	WorkerThreadPool::TaskGraph::NodeID fan_out_a = graph.add_template_task(&data, &GraphTestData::fan_out, 0);
+	WorkerThreadPool::TaskGraph::NodeID fan_out_b = graph.add_template_task(&data, &GraphTestData::fan_out, 1);
+	WorkerThreadPool::TaskGraph::NodeID join = graph.add_template_group_task(&data, &GraphTestData::join, nullptr, 256);
+	WorkerThreadPool::TaskGraph::NodeID last = graph.add_native_task(static_graph_test, &data);
+	graph.add_dependency(fan_out_a, fill);
+	graph.add_dependency(fan_out_b, fill);
+	graph.add_dependency(join, fan_out_a);
+	graph.add_dependency(join, fan_out_b);
+	graph.add_dependency(last, join);
+
+	for (int iterations = 0; iterations < 100; iterations++) {
+		data.elements.clear();
+		data.elements.resize(256);
+		data.sequence.set(0);
+		data.fan_out_step[0] = 0;
+		data.fan_out_step[1] = 0;
+		data.join_step = 0;
+
+		graph.submit(iterations % 2);
+		graph.wait();
+		CHECK(graph.is_completed());
+
+		bool all_run_twice = true;
+		for (uint32_t i = 0; i < data.elements.size(); i++) {
+			all_run_twice &= data.elements[i].get() == 2;
+		}
+		CHECK(all_run_twice);
+		CHECK(data.join_step == 3);
+	}
+	CHECK(data.errors.get() == 0);
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph rejects cycles") {
+	GraphTestData data;
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID a = graph.add_native_task(static_graph_test, &data);
+	WorkerThreadPool::TaskGraph::NodeID b = graph.add_native_task(static_graph_test, &data);
+	graph.add_dependency(a, b);
+	graph.add_dependency(b, a);
+
+	ERR_PRINT_OFF;
+	graph.submit();
+	ERR_PRINT_ON;
+	graph.wait();
+	CHECK(data.sequence.get() == 0);
+}
+
+TEST_CASE("[WorkerThreadPool] Task graph group size can change between submissions") {
+	GraphTestData data;
+	WorkerThreadPool::TaskGraph graph;
+	WorkerThreadPool::TaskGraph::NodeID fill = graph.add_template_group_task(&data, &GraphTestData::fill, nullptr, 0);
+
+	for (int elements : { 16, 0, 256 }) {
+		data.elements.clear();
+		data.elements.resize(256);
+		graph.set_group_task_elements(fill, elements);
+		graph.submit();
+		graph.wait();
+
+		int filled = 0;
+		for (uint32_t i = 0; i < data.elements.size(); i++) {
+			filled += data.elements[i].get();
+		}
+		CHECK(filled == elements);
+	}
+}
+
+struct NestedGraphTestData {
+	SafeNumeric<int> inner_runs;
+	SafeNumeric<int> errors;
+
+	void inner(uint32_t p_index, void *p_userdata) {
+		inner_runs.increment();
+	}
+	void outer(uint32_t p_index, void *p_userdata) {
+		WorkerThreadPool::TaskGraph graph;
+		graph.add_template_group_task(this, &NestedGraphTestData::inner, nullptr, 4);
+		graph.submit();
+		graph.wait();
+		if (!graph.is_completed()) {
+			errors.increment();
+		}
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Task graph waited for from pool threads") {
+	// Every pool thread waits for a graph at once, so they must run the graph tasks themselves.
+	NestedGraphTestData data;
+	const int thread_count = MAX(1, WorkerThreadPool::get_singleton()->get_thread_count());
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_template_group_task(&data, &NestedGraphTestData::outer, nullptr, thread_count * 4, thread_count, true);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+	CHECK(data.inner_runs.get() == thread_count * 16);
+	CHECK(data.errors.get() == 0);
+}
+
+struct ScalingTestData {
+	LocalVector<float> values;
+
+	void process(uint32_t p_index, void *p_userdata) {
+		float v = values[p_index];
+		for (int i = 0; i < 64; i++) {
+			v = Math::sqrt(v * v + 1.0f);
+		}
+		values[p_index] = v;
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Separate pools process tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	CHECK(WorkerThreadPool::get_singleton() != pool);
+	pool->init(3);
+
+	counter.clear();
+	counter.resize(64);
+	WorkerThreadPool::GroupID group = pool->add_native_group_task(static_group_test, (void *)2, 64, -1, true);
+	pool->wait_for_group_task_completion(group);
+	bool all_run_once = true;
+	for (int i = 1; i < 64; i++) {
+		all_run_once &= counter[i].get() == 1;
+	}
+	CHECK(all_run_once);
+
+	memdelete(pool);
+}
+
+TEST_CASE("[WorkerThreadPool] Queued low priority tasks are promoted as others finish") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(2); // Only one thread for low priority tasks, so most of them have to wait in the queue.
+
+	for (int iterations = 0; iterations < 20; iterations++) {
+		counter.clear();
+		counter.resize(256);
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		for (int i = 1; i < 256; i++) {
+			tasks.push_back(pool->add_native_task(static_test, (void *)(uintptr_t)i, false));
+		}
+		// Waiting only for the last one leaves the others to complete before anybody waits for them.
+		pool->wait_for_task_completion(tasks[tasks.size() - 1]);
+		for (uint32_t i = 0; i < tasks.size() - 1; i++) {
+			CHECK(pool->wait_for_task_completion(tasks[i]) == OK);
+		}
+
+		bool all_run_once = true;
+		for (int i = 1; i < 256; i++) {
+			all_run_once &= counter[i].get() == 1;
+		}
+		CHECK(all_run_once);
+	}
+
+	memdelete(pool);
+}
+
+struct NestedGroupTestData {
+	WorkerThreadPool *pool = nullptr;
+	SafeNumeric<int> inner_runs;
+
+	void inner(uint32_t p_index, void *p_userdata) {
+		inner_runs.increment();
+	}
+
+	void outer(void *p_userdata) {
+		WorkerThreadPool::GroupID group = pool->add_template_group_task(this, &NestedGroupTestData::inner, nullptr, 8, -1, false);
+		pool->wait_for_group_task_completion(group);
+	}
+};
+
+TEST_CASE("[WorkerThreadPool] Low priority group tasks waited for from low priority tasks") {
+	WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+	pool->init(2); // Only one thread for low priority tasks, taken by the waiting task.
+
+	NestedGroupTestData data;
+	data.pool = pool;
+	LocalVector<WorkerThreadPool::TaskID> tasks;
+	for (int i = 0; i < 16; i++) {
+		tasks.push_back(pool->add_template_task(&data, &NestedGroupTestData::outer, nullptr, false));
+	}
+	for (WorkerThreadPool::TaskID task : tasks) {
+		CHECK(pool->wait_for_task_completion(task) == OK);
+	}
+	CHECK(data.inner_runs.get() == 16 * 8);
+
+	memdelete(pool);
+}
+
+TEST_CASE("[WorkerThreadPool][Benchmark] Fine-grained group task scaling" * doctest::skip()) {
+	const int max_threads = OS::get_singleton()->get_default_thread_pool_size();
+	ScalingTestData data;
+	data.values.resize(4096);
+
+	LocalVector<int> thread_counts;
+	for (int thread_count = 1; thread_count < max_threads; thread_count *= 2) {
+		thread_counts.push_back(thread_count);
+	}
+	thread_counts.push_back(max_threads);
+
+	for (int thread_count : thread_counts) {
+		WorkerThreadPool *pool = memnew(WorkerThreadPool(false));
+		pool->init(thread_count);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < 1000; i++) {
+			WorkerThreadPool::GroupID group = pool->add_template_group_task(&data, &ScalingTestData::process, nullptr, data.values.size(), -1, true);
+			pool->wait_for_group_task_completion(group);
+		}
+		uint64_t end = OS::get_singleton()->get_ticks_usec();
+
+		print_line(vformat("%d threads: 1000 group tasks of %d elements in %.2f ms", thread_count, data.values.size(), (end - begin) / 1000.0));
+		memdelete(pool);
+	}
+}
+
 } // namespace TestWorkerThreadPool
 
 #endif // TEST_WORKER_THREAD_POOL_H
@@ -31,6 +31,7 @@
 #ifndef TEST_ANIMATION_H
 #define TEST_ANIMATION_H
 
+#include "core/os/os.h"
 #include "scene/resources/animation.h"
 
 #include "tests/test_macros.h"
@@ -309,6 +310,163 @@ TEST_CASE("[Animation] Create Bezier track") {
 	ERR_PRINT_ON;
 }
 
+// Adds position, rotation, scale and blend shape tracks with a key every frame of a 30 FPS animation.
+static void add_transform_tracks(const Ref<Animation> &p_animation, int p_node_count) {
+	for (int i = 0; i < p_node_count; i++) {
+		const NodePath path = NodePath(vformat("Node%d", i));
+		const int position_track = p_animation->add_track(Animation::TYPE_POSITION_3D);
+		const int rotation_track = p_animation->add_track(Animation::TYPE_ROTATION_3D);
+		const int scale_track = p_animation->add_track(Animation::TYPE_SCALE_3D);
+		const int blend_shape_track = p_animation->add_track(Animation::TYPE_BLEND_SHAPE);
+		p_animation->track_set_path(position_track, path);
+		p_animation->track_set_path(rotation_track, path);
+		p_animation->track_set_path(scale_track, path);
+		p_animation->track_set_path(blend_shape_track, NodePath(vformat("Node%d:shape", i)));
+
+		for (int frame = 0; frame <= 30; frame++) {
+			const double time = frame / 30.0;
+			const real_t phase = time * Math_TAU + i;
+			p_animation->position_track_insert_key(position_track, time, Vector3(Math::sin(phase), Math::cos(phase) * 2.0, i));
+			p_animation->rotation_track_insert_key(rotation_track, time, Quaternion(Vector3(0, 1, 0), phase * 0.5));
+			p_animation->scale_track_insert_key(scale_track, time, Vector3(1, 1, 1) * (1.5 + Math::sin(phase) * 0.5));
+			p_animation->blend_shape_track_insert_key(blend_shape_track, time, Math::sin(phase) * 0.5 + 0.5);
+		}
+	}
+}
+
+TEST_CASE("[Animation] Batched sampling of compressed tracks") {
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	add_transform_tracks(animation, 5);
+	animation->compress();
+
+	REQUIRE(animation->is_compressed());
+	for (int i = 0; i < animation->get_track_count(); i++) {
+		CHECK(animation->track_is_compressed(i));
+		CHECK(animation->track_get_compressed_index(i) >= 0);
+	}
+
+	Animation::CompressedSample sample;
+	for (double time : { 0.0, 0.01, 0.25, 1.0 / 3.0, 0.7, 1.0, 2.0 }) {
+		animation->sample_compressed_tracks(time, sample);
+
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			const int index = animation->track_get_compressed_index(i);
+			switch (animation->track_get_type(i)) {
+				case Animation::TYPE_POSITION_3D:
+				case Animation::TYPE_SCALE_3D: {
+					Vector3 expected;
+					if (animation->track_get_type(i) == Animation::TYPE_POSITION_3D) {
+						CHECK(animation->try_position_track_interpolate(i, time, &expected) == OK);
+					} else {
+						CHECK(animation->try_scale_track_interpolate(i, time, &expected) == OK);
+					}
+					Vector3 value;
+					CHECK(sample.get_vector3(index, value));
+					CHECK(value.is_equal_approx(expected));
+				} break;
+				case Animation::TYPE_ROTATION_3D: {
+					Quaternion expected;
+					CHECK(animation->try_rotation_track_interpolate(i, time, &expected) == OK);
+					Quaternion value;
+					CHECK(sample.get_quaternion(index, value));
+					CHECK(value.is_equal_approx(expected));
+				} break;
+				case Animation::TYPE_BLEND_SHAPE: {
+					float expected = 0.0;
+					CHECK(animation->try_blend_shape_track_interpolate(i, time, &expected) == OK);
+					float value = 0.0;
+					CHECK(sample.get_float(index, value));
+					CHECK(value == doctest::Approx(expected));
+				} break;
+				default: {
+				}
+			}
+		}
+	}
+
+	SUBCASE("Only the requested tracks are decoded") {
+		LocalVector<int> requested;
+		for (int i = 0; i < animation->get_track_count(); i += 3) {
+			requested.push_back(i);
+		}
+		animation->sample_compressed_tracks(0.3, sample, &requested);
+
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			const int index = animation->track_get_compressed_index(i);
+			CHECK(bool(sample.valid[index]) == (requested.find(i) != -1));
+			if (animation->track_get_type(i) == Animation::TYPE_POSITION_3D && sample.valid[index]) {
+				Vector3 expected;
+				CHECK(animation->try_position_track_interpolate(i, 0.3, &expected) == OK);
+				Vector3 value;
+				CHECK(sample.get_vector3(index, value));
+				CHECK(value.is_equal_approx(expected));
+			}
+		}
+
+		requested.clear();
+		animation->sample_compressed_tracks(0.3, sample, &requested);
+		for (int i = 0; i < animation->get_track_count(); i++) {
+			CHECK_FALSE(sample.valid[animation->track_get_compressed_index(i)]);
+		}
+	}
+
+	SUBCASE("Uncompressed animations produce an empty sample") {
+		Ref<Animation> uncompressed = memnew(Animation);
+		add_transform_tracks(uncompressed, 1);
+		uncompressed->sample_compressed_tracks(0.5, sample);
+		CHECK_FALSE(uncompressed->is_compressed());
+		CHECK(uncompressed->track_get_compressed_index(0) == -1);
+		CHECK(sample.valid.size() == 0);
+	}
+}
+
+TEST_CASE("[Animation][Benchmark] Sampling compressed tracks" * doctest::skip()) {
+	const int node_count = 64;
+	const int samples = 2000;
+
+	Ref<Animation> uncompressed = memnew(Animation);
+	add_transform_tracks(uncompressed, node_count);
+	Ref<Animation> compressed = memnew(Animation);
+	add_transform_tracks(compressed, node_count);
+	compressed->compress();
+
+	for (const Ref<Animation> &animation : { uncompressed, compressed }) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int s = 0; s < samples; s++) {
+			const double time = double(s) / samples;
+			for (int i = 0; i < animation->get_track_count(); i++) {
+				switch (animation->track_get_type(i)) {
+					case Animation::TYPE_POSITION_3D: {
+						animation->position_track_interpolate(i, time);
+					} break;
+					case Animation::TYPE_ROTATION_3D: {
+						animation->rotation_track_interpolate(i, time);
+					} break;
+					case Animation::TYPE_SCALE_3D: {
+						animation->scale_track_interpolate(i, time);
+					} break;
+					case Animation::TYPE_BLEND_SHAPE: {
+						animation->blend_shape_track_interpolate(i, time);
+					} break;
+					default: {
+					}
+				}
+			}
+		}
+		uint64_t track_usec = OS::get_singleton()->get_ticks_usec() - begin;
+		print_line(vformat("%d tracks, %s, per track: %d usec.", animation->get_track_count(), animation->is_compressed() ? "compressed" : "uncompressed", track_usec));
+	}
+
+	Animation::CompressedSample sample;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int s = 0; s < samples; s++) {
+		compressed->sample_compressed_tracks(double(s) / samples, sample);
+	}
+	uint64_t batch_usec = OS::get_singleton()->get_ticks_usec() - begin;
+	print_line(vformat("%d tracks, compressed, batched: %d usec.", compressed->get_track_count(), batch_usec));
+}
+
 } // namespace TestAnimation
 
 #endif // TEST_ANIMATION_H
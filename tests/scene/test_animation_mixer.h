@@ -0,0 +1,155 @@
+/**************************************************************************/
+/*  test_animation_mixer.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_ANIMATION_MIXER_H
+#define TEST_ANIMATION_MIXER_H
+
+#include "core/object/message_queue.h"
+#include "scene/3d/node_3d.h"
+#include "scene/animation/animation_player.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAnimationMixer {
+
+// A Node3D holding `p_target_count` children, all moved along X by one AnimationPlayer.
+static AnimationPlayer *create_animated_scene(Node *p_parent, int p_target_count, bool p_parallel) {
+	Node3D *root = memnew(Node3D);
+	p_parent->add_child(root);
+
+	Ref<Animation> animation = memnew(Animation);
+	animation->set_length(1.0);
+	for (int i = 0; i < p_target_count; i++) {
+		Node3D *target = memnew(Node3D);
+		target->set_name(vformat("Target%d", i));
+		root->add_child(target);
+
+		int position_track = animation->add_track(Animation::TYPE_POSITION_3D);
+		animation->track_set_path(position_track, NodePath(vformat("Target%d", i)));
+		animation->position_track_insert_key(position_track, 0.0, Vector3(0, i, 0));
+		animation->position_track_insert_key(position_track, 1.0, Vector3(10, i, 0));
+
+		int rotation_track = animation->add_track(Animation::TYPE_ROTATION_3D);
+		animation->track_set_path(rotation_track, NodePath(vformat("Target%d", i)));
+		animation->rotation_track_insert_key(rotation_track, 0.0, Quaternion());
+		animation->rotation_track_insert_key(rotation_track, 1.0, Quaternion(Vector3(0, 1, 0), Math_PI * 0.5));
+	}
+
+	Ref<AnimationLibrary> library = memnew(AnimationLibrary);
+	library->add_animation("move", animation);
+
+	AnimationPlayer *player = memnew(AnimationPlayer);
+	player->add_animation_library("", library);
+	player->set_parallel_evaluation(p_parallel);
+	root->add_child(player);
+	player->play("move");
+	return player;
+}
+
+static Vector3 get_target_position(AnimationPlayer *p_player, int p_index) {
+	Node3D *target = Object::cast_to<Node3D>(p_player->get_parent()->get_child(p_index));
+	return target->get_position();
+}
+
+TEST_CASE("[SceneTree][AnimationMixer] Parallel evaluation matches serial evaluation") {
+	Window *root = SceneTree::get_singleton()->get_root();
+
+	LocalVector<AnimationPlayer *> serial;
+	LocalVector<AnimationPlayer *> parallel;
+	for (int i = 0; i < 4; i++) {
+		serial.push_back(create_animated_scene(root, 3, false));
+		parallel.push_back(create_animated_scene(root, 3, true));
+	}
+	CHECK(parallel[0]->is_parallel_evaluation());
+	CHECK_FALSE(serial[0]->is_parallel_evaluation());
+
+	for (int step = 0; step < 3; step++) {
+		SceneTree::get_singleton()->process(0.25);
+	}
+
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		for (int j = 0; j < 3; j++) {
+			CHECK(get_target_position(serial[i], j).is_equal_approx(Vector3(7.5, j, 0)));
+			CHECK(get_target_position(parallel[i], j).is_equal_approx(get_target_position(serial[i], j)));
+		}
+	}
+
+	SUBCASE("Results are applied when the batch runs") {
+		parallel[0]->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+		CHECK(get_target_position(parallel[0], 1).is_equal_approx(Vector3(7.5, 1, 0)));
+		MessageQueue::get_singleton()->flush();
+		CHECK(get_target_position(parallel[0], 1).is_equal_approx(Vector3(10, 1, 0)));
+	}
+
+	SUBCASE("Seeking finishes a pending evaluation") {
+		parallel[0]->notification(Node::NOTIFICATION_INTERNAL_PROCESS);
+		parallel[0]->seek(0.5, true);
+		CHECK(get_target_position(parallel[0], 1).is_equal_approx(Vector3(5, 1, 0)));
+		MessageQueue::get_singleton()->flush();
+		CHECK(get_target_position(parallel[0], 1).is_equal_approx(Vector3(5, 1, 0)));
+	}
+
+	for (uint32_t i = 0; i < serial.size(); i++) {
+		memdelete(serial[i]->get_parent());
+		memdelete(parallel[i]->get_parent());
+	}
+}
+
+TEST_CASE("[SceneTree][AnimationMixer][Benchmark] Parallel evaluation scaling with mixer count" * doctest::skip()) {
+	const int target_count = 32;
+	const int steps = 60;
+
+	Window *root = SceneTree::get_singleton()->get_root();
+	for (int mixer_count : { 1, 4, 16, 64, 256 }) {
+		for (bool parallel : { false, true }) {
+			LocalVector<AnimationPlayer *> players;
+			for (int i = 0; i < mixer_count; i++) {
+				players.push_back(create_animated_scene(root, target_count, parallel));
+			}
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			for (int i = 0; i < steps; i++) {
+				SceneTree::get_singleton()->process(1.0 / 60.0);
+			}
+			uint64_t step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / steps;
+
+			print_line(vformat("%d mixers with %d animated nodes, %s evaluation: %d usec per frame.", mixer_count, target_count, parallel ? "parallel" : "serial", step_usec));
+
+			for (AnimationPlayer *player : players) {
+				memdelete(player->get_parent());
+			}
+		}
+	}
+}
+
+} // namespace TestAnimationMixer
+
+#endif // TEST_ANIMATION_MIXER_H
@@ -31,12 +31,67 @@
 #ifndef TEST_PACKED_SCENE_H
 #define TEST_PACKED_SCENE_H
 
+#include "core/object/worker_thread_pool.h"
+#include "scene/2d/node_2d.h"
 #include "scene/resources/packed_scene.h"
 
 #include "tests/test_macros.h"
 
 namespace TestPackedScene {
 
+// Creates a scene with `p_branches` children of the root, each having `p_leaves` children.
+static Node *_create_large_scene(int p_branches, int p_leaves) {
+	Node *scene = memnew(Node);
+	scene->set_name("LargeScene");
+
+	for (int i = 0; i < p_branches; i++) {
+		Node2D *branch = memnew(Node2D);
+		branch->set_name(vformat("Branch%d", i));
+		branch->set_position(Vector2(i, -i));
+		branch->add_to_group("branches", true);
+		if (i % 2 == 0) {
+			// Containers are set from the instantiating thread, make sure they are handled too.
+			Array data;
+			data.push_back(i);
+			branch->set_meta("data", data);
+		}
+		scene->add_child(branch);
+		branch->set_owner(scene);
+
+		for (int j = 0; j < p_leaves; j++) {
+			Node2D *leaf = memnew(Node2D);
+			leaf->set_name(vformat("Leaf%d", j));
+			leaf->set_rotation(j * 0.1);
+			branch->add_child(leaf);
+			leaf->set_owner(scene);
+		}
+	}
+
+	return scene;
+}
+
+static void _check_same_tree(Node *p_node, Node *p_expected, Node *p_owner) {
+	CHECK(p_node->get_name() == p_expected->get_name());
+	CHECK(p_node->get_class() == p_expected->get_class());
+	CHECK(p_node->get_child_count() == p_expected->get_child_count());
+	if (p_node != p_owner) {
+		CHECK(p_node->get_owner() == p_owner);
+	}
+	CHECK(p_node->is_in_group("branches") == p_expected->is_in_group("branches"));
+	CHECK(p_node->get_meta("data", Variant()) == p_expected->get_meta("data", Variant()));
+
+	Node2D *node_2d = Object::cast_to<Node2D>(p_node);
+	Node2D *expected_2d = Object::cast_to<Node2D>(p_expected);
+	if (node_2d && expected_2d) {
+		CHECK(node_2d->get_position() == expected_2d->get_position());
+		CHECK(node_2d->get_rotation() == expected_2d->get_rotation());
+	}
+
+	for (int i = 0; i < MIN(p_node->get_child_count(), p_expected->get_child_count()); i++) {
+		_check_same_tree(p_node->get_child(i), p_expected->get_child(i), p_owner);
+	}
+}
+
 TEST_CASE("[PackedScene] Pack Scene and Retrieve State") {
 	// Create a scene to pack.
 	Node *scene = memnew(Node);
@@ -215,6 +270,62 @@ TEST_CASE("[PackedScene] Recreate State") {
 	memdelete(scene);
 }
 
+TEST_CASE("[PackedScene] Threaded instantiation matches regular instantiation") {
+	Node *scene = _create_large_scene(256, 8);
+
+	PackedScene packed_scene;
+	CHECK(packed_scene.pack(scene) == OK);
+
+	const bool was_enabled = SceneState::is_threaded_instantiation_enabled();
+
+	SceneState::set_threaded_instantiation(false);
+	Node *regular = packed_scene.instantiate();
+	REQUIRE(regular != nullptr);
+
+	// Falls back to regular instantiation on machines without enough threads.
+	SceneState::set_threaded_instantiation(true);
+	const uint64_t threaded_count = SceneState::get_threaded_instantiation_count();
+	Node *threaded = packed_scene.instantiate();
+	REQUIRE(threaded != nullptr);
+	if (WorkerThreadPool::get_singleton()->get_thread_count() >= 2) {
+		CHECK_MESSAGE(SceneState::get_threaded_instantiation_count() == threaded_count + 1, "The scene should have been built on worker threads.");
+	}
+
+	_check_same_tree(threaded, regular, threaded);
+	_check_same_tree(threaded, scene, threaded);
+
+	SceneState::set_threaded_instantiation(was_enabled);
+
+	memdelete(threaded);
+	memdelete(regular);
+	memdelete(scene);
+}
+
+TEST_CASE("[PackedScene][Benchmark] Instantiate large scenes" * doctest::skip()) {
+	const bool was_enabled = SceneState::is_threaded_instantiation_enabled();
+
+	for (int branches : { 1000, 5000, 10000 }) {
+		Node *scene = _create_large_scene(branches, 4);
+		PackedScene packed_scene;
+		CHECK(packed_scene.pack(scene) == OK);
+		memdelete(scene);
+
+		for (bool threaded : { false, true }) {
+			SceneState::set_threaded_instantiation(threaded);
+
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			Node *instance = packed_scene.instantiate();
+			uint64_t end = OS::get_singleton()->get_ticks_usec();
+			REQUIRE(instance != nullptr);
+
+			print_line(vformat("Instantiating %d nodes (%s): %.2f ms", packed_scene.get_state()->get_node_count(), threaded ? "threaded" : "single-threaded", (end - begin) / 1000.0));
+			memdelete(instance);
+		}
+	}
+
+	SceneState::set_threaded_instantiation(was_enabled);
+}
+
 } // namespace TestPackedScene
 
 #endif // TEST_PACKED_SCENE_H
@@ -0,0 +1,150 @@
+/**************************************************************************/
+/*  test_skeleton_3d.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SKELETON_3D_H
+#define TEST_SKELETON_3D_H
+
+#include "core/os/os.h"
+#include "scene/3d/skeleton_3d.h"
+#include "scene/main/window.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSkeleton3D {
+
+// A chain of bones, each one unit above its parent.
+static Skeleton3D *create_chain_skeleton(int p_bone_count) {
+	Skeleton3D *skeleton = memnew(Skeleton3D);
+	for (int i = 0; i < p_bone_count; i++) {
+		skeleton->add_bone(vformat("Bone%d", i));
+		skeleton->set_bone_parent(i, i - 1);
+		skeleton->set_bone_rest(i, Transform3D(Basis(), Vector3(0, i > 0 ? 1 : 0, 0)));
+	}
+	skeleton->reset_bone_poses();
+	return skeleton;
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Only dirty bones and their children are updated") {
+	Skeleton3D *skeleton = create_chain_skeleton(4);
+	SceneTree::get_singleton()->get_root()->add_child(skeleton);
+
+	CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(0, 3, 0)));
+
+	SIGNAL_WATCH(skeleton, "bone_pose_changed");
+
+	skeleton->set_bone_pose_position(2, Vector3(2, 1, 0));
+	CHECK(skeleton->get_bone_global_pose(1).origin.is_equal_approx(Vector3(0, 1, 0)));
+	CHECK(skeleton->get_bone_global_pose(2).origin.is_equal_approx(Vector3(2, 2, 0)));
+	CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(2, 3, 0)));
+
+	Array updated_bones;
+	for (int bone : { 2, 3 }) {
+		Array args;
+		args.push_back(bone);
+		updated_bones.push_back(args);
+	}
+	SIGNAL_CHECK("bone_pose_changed", updated_bones);
+
+	skeleton->force_update_all_bone_transforms();
+	Array all_bones;
+	for (int bone = 0; bone < 4; bone++) {
+		Array args;
+		args.push_back(bone);
+		all_bones.push_back(args);
+	}
+	SIGNAL_CHECK("bone_pose_changed", all_bones);
+
+	SUBCASE("Non persistent global pose overrides are removed on the next update") {
+		skeleton->set_bone_global_pose_override(3, Transform3D(Basis(), Vector3(5, 5, 5)), 1.0);
+		CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(5, 5, 5)));
+		skeleton->set_bone_pose_position(0, Vector3());
+		CHECK(skeleton->get_bone_global_pose(3).origin.is_equal_approx(Vector3(2, 3, 0)));
+	}
+
+	SIGNAL_UNWATCH(skeleton, "bone_pose_changed");
+	memdelete(skeleton);
+}
+
+TEST_CASE("[SceneTree][Skeleton3D] Skeletons dirtied in the same frame are updated together") {
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < 8; i++) {
+		Skeleton3D *skeleton = create_chain_skeleton(16);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+	SceneTree::get_singleton()->process(0);
+
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		skeletons[i]->set_bone_pose_position(0, Vector3(i, 0, 0));
+	}
+	SceneTree::get_singleton()->process(0);
+
+	for (uint32_t i = 0; i < skeletons.size(); i++) {
+		CHECK(skeletons[i]->get_bone_global_pose_no_override(15).origin.is_equal_approx(Vector3(i, 15, 0)));
+		memdelete(skeletons[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][Skeleton3D][Benchmark] Updating a crowd of skeletons" * doctest::skip()) {
+	const int skeleton_count = 200;
+	const int bone_count = 150;
+	const int steps = 60;
+
+	LocalVector<Skeleton3D *> skeletons;
+	for (int i = 0; i < skeleton_count; i++) {
+		Skeleton3D *skeleton = create_chain_skeleton(bone_count);
+		SceneTree::get_singleton()->get_root()->add_child(skeleton);
+		skeletons.push_back(skeleton);
+	}
+	SceneTree::get_singleton()->process(0);
+
+	for (bool all_bones : { true, false }) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int step = 0; step < steps; step++) {
+			for (Skeleton3D *skeleton : skeletons) {
+				// Either every bone is animated, or only the last few, like a head look-at.
+				for (int i = all_bones ? 0 : bone_count - 5; i < bone_count; i++) {
+					skeleton->set_bone_pose_rotation(i, Quaternion(Vector3(0, 0, 1), step * 0.01));
+				}
+			}
+			SceneTree::get_singleton()->process(0);
+		}
+		uint64_t step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / steps;
+		print_line(vformat("%d skeletons with %d bones, %s posed: %d usec per frame.", skeleton_count, bone_count, all_bones ? "all bones" : "5 bones", step_usec));
+	}
+
+	for (Skeleton3D *skeleton : skeletons) {
+		memdelete(skeleton);
+	}
+}
+
+} // namespace TestSkeleton3D
+
+#endif // TEST_SKELETON_3D_H
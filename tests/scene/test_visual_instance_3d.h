@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_visual_instance_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_VISUAL_INSTANCE_3D_H
+#define TEST_VISUAL_INSTANCE_3D_H
+
+#include "scene/3d/mesh_instance_3d.h"
+#include "scene/main/window.h"
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+
+#include "tests/test_macros.h"
+
+namespace TestVisualInstance3D {
+
+static Transform3D get_instance_transform(const VisualInstance3D *p_node) {
+	return static_cast<RendererSceneCull *>(RSG::scene)->instance_get_transform(p_node->get_instance());
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] Transforms are sent when transform notifications are flushed") {
+	MeshInstance3D *nodes[3];
+	for (int i = 0; i < 3; i++) {
+		nodes[i] = memnew(MeshInstance3D);
+		SceneTree::get_singleton()->get_root()->add_child(nodes[i]);
+	}
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	for (int i = 0; i < 3; i++) {
+		nodes[i]->set_position(Vector3(i + 1, 2, 3));
+		nodes[i]->set_rotation(Vector3(0, 0.5 * i, 0));
+	}
+
+	// Batched until the flush is done.
+	for (int i = 0; i < 3; i++) {
+		CHECK(get_instance_transform(nodes[i]) == Transform3D());
+	}
+
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	for (int i = 0; i < 3; i++) {
+		CHECK(get_instance_transform(nodes[i]).is_equal_approx(nodes[i]->get_global_transform()));
+		memdelete(nodes[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] Transforms changed outside a flush are sent immediately") {
+	MeshInstance3D *node = memnew(MeshInstance3D);
+	SceneTree::get_singleton()->get_root()->add_child(node);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	node->set_position(Vector3(4, 5, 6));
+	node->force_update_transform();
+
+	CHECK(get_instance_transform(node).is_equal_approx(node->get_global_transform()));
+
+	// Nothing is left in the batch for the next flush to send.
+	node->set_position(Vector3(7, 8, 9));
+	node->force_update_transform();
+	SceneTree::get_singleton()->flush_transform_notifications();
+	CHECK(get_instance_transform(node).is_equal_approx(Transform3D(Basis(), Vector3(7, 8, 9))));
+
+	memdelete(node);
+}
+
+TEST_CASE("[SceneTree][VisualInstance3D] Nodes freed before the flush are skipped") {
+	MeshInstance3D *moved = memnew(MeshInstance3D);
+	MeshInstance3D *freed = memnew(MeshInstance3D);
+	SceneTree::get_singleton()->get_root()->add_child(moved);
+	SceneTree::get_singleton()->get_root()->add_child(freed);
+	SceneTree::get_singleton()->flush_transform_notifications();
+
+	moved->set_position(Vector3(1, 2, 3));
+	freed->set_position(Vector3(4, 5, 6));
+	memdelete(freed);
+
+	SceneTree::get_singleton()->flush_transform_notifications();
+	CHECK(get_instance_transform(moved).is_equal_approx(moved->get_global_transform()));
+
+	memdelete(moved);
+}
+
+} // namespace TestVisualInstance3D
+
+#endif // TEST_VISUAL_INSTANCE_3D_H
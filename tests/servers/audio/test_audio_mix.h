@@ -0,0 +1,207 @@
+/**************************************************************************/
+/*  test_audio_mix.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_AUDIO_MIX_H
+#define TEST_AUDIO_MIX_H
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/audio/audio_mix.h"
+
+#include "tests/test_macros.h"
+
+namespace TestAudioMix {
+
+static void _fill_random(Vector<AudioFrame> &r_buf, uint32_t p_frames, uint64_t p_seed) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(p_seed);
+	r_buf.resize(p_frames);
+	for (uint32_t i = 0; i < p_frames; i++) {
+		r_buf.write[i] = AudioFrame(rng->randf_range(-1, 1), rng->randf_range(-1, 1));
+	}
+}
+
+static bool _buffers_approx_equal(const Vector<AudioFrame> &p_a, const Vector<AudioFrame> &p_b) {
+	if (p_a.size() != p_b.size()) {
+		return false;
+	}
+	for (int i = 0; i < p_a.size(); i++) {
+		if (!Math::is_equal_approx(p_a[i].left, p_b[i].left) || !Math::is_equal_approx(p_a[i].right, p_b[i].right)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Odd frame count, so the scalar tail of the vectorized kernels is exercised too.
+constexpr uint32_t FRAMES = 515;
+
+TEST_CASE("[AudioMix] Volume ramp matches scalar mixing") {
+	Vector<AudioFrame> src;
+	Vector<AudioFrame> dst;
+	_fill_random(src, FRAMES, 1);
+	_fill_random(dst, FRAMES, 2);
+	const AudioFrame vol_start(0.25, 1.0);
+	const AudioFrame vol_final(0.75, 0.5);
+
+	Vector<AudioFrame> expected = dst;
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		float lerp_param = (float)i / FRAMES;
+		expected.write[i] += (vol_final * lerp_param + (1 - lerp_param) * vol_start) * src[i];
+	}
+
+	AudioMix::mix_ramp(dst.ptrw(), src.ptr(), vol_start, vol_final, FRAMES);
+	CHECK_MESSAGE(_buffers_approx_equal(dst, expected), "mix_ramp() should add the ramped source to the destination.");
+
+	Vector<AudioFrame> stored;
+	stored.resize(FRAMES);
+	AudioMix::ramp(stored.ptrw(), src.ptr(), vol_start, vol_final, FRAMES);
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		float lerp_param = (float)i / FRAMES;
+		expected.write[i] = (vol_final * lerp_param + (1 - lerp_param) * vol_start) * src[i];
+	}
+	CHECK_MESSAGE(_buffers_approx_equal(stored, expected), "ramp() should store the ramped source.");
+}
+
+TEST_CASE("[AudioMix] Accumulate, scale and peak") {
+	Vector<AudioFrame> src;
+	Vector<AudioFrame> dst;
+	_fill_random(src, FRAMES, 3);
+	_fill_random(dst, FRAMES, 4);
+
+	Vector<AudioFrame> expected = dst;
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		expected.write[i] += src[i];
+	}
+	AudioMix::accumulate(dst.ptrw(), src.ptr(), FRAMES);
+	CHECK(_buffers_approx_equal(dst, expected));
+
+	src.write[FRAMES - 1] = AudioFrame(-3.0, 0.5);
+	src.write[7] = AudioFrame(0.5, 2.0);
+	AudioFrame peak = AudioMix::scale_and_peak(src.ptrw(), 0.5, FRAMES);
+	CHECK(peak.left == doctest::Approx(1.5));
+	CHECK(peak.right == doctest::Approx(1.0));
+	CHECK(src[FRAMES - 1].left == doctest::Approx(-1.5));
+	CHECK(src[7].right == doctest::Approx(1.0));
+
+	AudioFrame silence[3] = { AudioFrame(0, 0), AudioFrame(0, 0), AudioFrame(0, 0) };
+	peak = AudioMix::scale_and_peak(silence, 1.0, 3);
+	CHECK(peak.left == 0);
+	CHECK(peak.right == 0);
+}
+
+TEST_CASE("[AudioMix] Stereo filter matches per-channel processing") {
+	Vector<AudioFrame> src;
+	_fill_random(src, FRAMES, 5);
+
+	AudioFilterSW filter;
+	filter.set_mode(AudioFilterSW::LOWPASS);
+	filter.set_sampling_rate(44100);
+	filter.set_cutoff(2000);
+	filter.set_resonance(1);
+	filter.set_stages(1);
+
+	AudioFilterSW::Processor ref_l, ref_r, mix_l, mix_r;
+	for (AudioFilterSW::Processor *p : { &ref_l, &ref_r, &mix_l, &mix_r }) {
+		p->set_filter(&filter, true);
+		p->update_coeffs(FRAMES);
+	}
+
+	Vector<AudioFrame> expected = src;
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		ref_l.process_one_interp(expected.write[i].left);
+		ref_r.process_one_interp(expected.write[i].right);
+	}
+
+	AudioMix::filter_stereo_interp(&mix_l, &mix_r, src.ptrw(), FRAMES);
+	CHECK(_buffers_approx_equal(src, expected));
+}
+
+TEST_CASE("[AudioMix][Benchmark] Mix streams into buses" * doctest::skip()) {
+	const uint32_t frames = 512;
+	const int iterations = 2000;
+	const AudioFrame vol_start(0.5, 0.5);
+	const AudioFrame vol_final(0.8, 0.6);
+
+	for (int streams : { 8, 64 }) {
+		for (int buses : { 1, 4 }) {
+			Vector<Vector<AudioFrame>> sources;
+			sources.resize(streams);
+			for (int i = 0; i < streams; i++) {
+				_fill_random(sources.write[i], frames, i);
+			}
+			Vector<Vector<AudioFrame>> bus_buffers;
+			bus_buffers.resize(buses);
+			for (int i = 0; i < buses; i++) {
+				bus_buffers.write[i].resize(frames);
+			}
+
+			uint64_t scalar_usec = 0;
+			uint64_t simd_usec = 0;
+			for (bool simd : { false, true }) {
+				uint64_t begin = OS::get_singleton()->get_ticks_usec();
+				for (int it = 0; it < iterations; it++) {
+					for (int b = 0; b < buses; b++) {
+						AudioFrame *bus_buf = bus_buffers.write[b].ptrw();
+						for (int s = b; s < streams; s += buses) {
+							const AudioFrame *src = sources[s].ptr();
+							if (simd) {
+								AudioMix::mix_ramp(bus_buf, src, vol_start, vol_final, frames);
+							} else {
+								for (uint32_t j = 0; j < frames; j++) {
+									float lerp_param = (float)j / frames;
+									bus_buf[j] += (vol_final * lerp_param + (1 - lerp_param) * vol_start) * src[j];
+								}
+							}
+						}
+						if (simd) {
+							AudioMix::scale_and_peak(bus_buf, 0.5, frames);
+						} else {
+							AudioFrame peak(0, 0);
+							for (uint32_t j = 0; j < frames; j++) {
+								bus_buf[j] *= 0.5;
+								peak.left = MAX(peak.left, ABS(bus_buf[j].left));
+								peak.right = MAX(peak.right, ABS(bus_buf[j].right));
+							}
+						}
+					}
+				}
+				(simd ? simd_usec : scalar_usec) = OS::get_singleton()->get_ticks_usec() - begin;
+			}
+
+			print_line(vformat("Mixing %d streams into %d buses: scalar %.2f ms, %s %.2f ms", streams, buses, scalar_usec / 1000.0, AudioMix::get_simd_name(), simd_usec / 1000.0));
+		}
+	}
+}
+
+} // namespace TestAudioMix
+
+#endif // TEST_AUDIO_MIX_H
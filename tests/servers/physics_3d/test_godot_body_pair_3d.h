@@ -0,0 +1,187 @@
+/**************************************************************************/
+/*  test_godot_body_pair_3d.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_BODY_PAIR_3D_H
+#define TEST_GODOT_BODY_PAIR_3D_H
+
+#include "core/os/os.h"
+#include "servers/physics_server_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotBodyPair3D {
+
+struct BoxStacks {
+	RID space;
+	RID floor;
+	RID floor_shape;
+	RID box_shape;
+	LocalVector<RID> boxes;
+	int height = 0;
+
+	void create(int p_stacks_x, int p_stacks_z, int p_height, int p_solver_iterations = -1) {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+
+		space = ps->space_create();
+		ps->space_set_active(space, true);
+		ps->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY, 9.8);
+		ps->area_set_param(space, PhysicsServer3D::AREA_PARAM_GRAVITY_VECTOR, Vector3(0, -1, 0));
+		if (p_solver_iterations > 0) {
+			ps->space_set_param(space, PhysicsServer3D::SPACE_PARAM_SOLVER_ITERATIONS, p_solver_iterations);
+		}
+
+		floor_shape = ps->box_shape_create();
+		ps->shape_set_data(floor_shape, Vector3(100, 0.5, 100));
+		floor = ps->body_create();
+		ps->body_set_mode(floor, PhysicsServer3D::BODY_MODE_STATIC);
+		ps->body_add_shape(floor, floor_shape);
+		ps->body_set_state(floor, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), Vector3(0, -0.5, 0)));
+		ps->body_set_space(floor, space);
+
+		box_shape = ps->box_shape_create();
+		ps->shape_set_data(box_shape, Vector3(0.5, 0.5, 0.5));
+
+		height = p_height;
+		for (int x = 0; x < p_stacks_x; x++) {
+			for (int z = 0; z < p_stacks_z; z++) {
+				for (int y = 0; y < p_height; y++) {
+					RID box = ps->body_create();
+					ps->body_set_mode(box, PhysicsServer3D::BODY_MODE_RIGID);
+					ps->body_add_shape(box, box_shape);
+					ps->body_set_state(box, PhysicsServer3D::BODY_STATE_TRANSFORM, Transform3D(Basis(), get_rest_position(x, y, z)));
+					ps->body_set_space(box, space);
+					boxes.push_back(box);
+				}
+			}
+		}
+	}
+
+	static Vector3 get_rest_position(int p_x, int p_y, int p_z) {
+		return Vector3(p_x * 3.0, 0.5 + p_y, p_z * 3.0);
+	}
+
+	Vector3 get_position(uint32_t p_index) const {
+		Transform3D xform = PhysicsServer3D::get_singleton()->body_get_state(boxes[p_index], PhysicsServer3D::BODY_STATE_TRANSFORM);
+		return xform.origin;
+	}
+
+	Vector3 get_velocity(uint32_t p_index) const {
+		return PhysicsServer3D::get_singleton()->body_get_state(boxes[p_index], PhysicsServer3D::BODY_STATE_LINEAR_VELOCITY);
+	}
+
+	// Largest distance of a box from where it started.
+	real_t get_max_drift(int p_stacks_z) const {
+		real_t max_drift = 0.0;
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			int stack = i / height;
+			Vector3 rest = get_rest_position(stack / p_stacks_z, i % height, stack % p_stacks_z);
+			max_drift = MAX(max_drift, get_position(i).distance_to(rest));
+		}
+		return max_drift;
+	}
+
+	real_t get_max_speed() const {
+		real_t max_speed = 0.0;
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			max_speed = MAX(max_speed, get_velocity(i).length());
+		}
+		return max_speed;
+	}
+
+	void step(int p_steps) {
+		for (int i = 0; i < p_steps; i++) {
+			PhysicsServer3D::get_singleton()->step(1.0 / 60.0);
+		}
+	}
+
+	void free() {
+		PhysicsServer3D *ps = PhysicsServer3D::get_singleton();
+		for (const RID &box : boxes) {
+			ps->free(box);
+		}
+		boxes.clear();
+		ps->free(floor);
+		ps->free(box_shape);
+		ps->free(floor_shape);
+		ps->free(space);
+	}
+};
+
+TEST_CASE("[SceneTree][GodotBodyPair3D] Box stack rests with the default solver iterations") {
+	BoxStacks stacks;
+	stacks.create(1, 1, 10);
+
+	stacks.step(300);
+
+	CHECK(stacks.get_max_drift(1) < 0.1);
+	CHECK(stacks.get_max_speed() < 0.05);
+
+	stacks.free();
+}
+
+TEST_CASE("[SceneTree][GodotBodyPair3D] Resting contacts keep their impulses") {
+	BoxStacks stacks;
+	stacks.create(1, 1, 2, 4);
+
+	stacks.step(120);
+
+	// The top box is supported by warm started contacts, so it doesn't sink into the bottom one over time.
+	const real_t top_height = stacks.get_position(1).y;
+	stacks.step(120);
+	CHECK(Math::abs(stacks.get_position(1).y - top_height) < 0.01);
+	CHECK(stacks.get_position(1).y > 1.4);
+	CHECK(stacks.get_max_speed() < 0.05);
+
+	stacks.free();
+}
+
+TEST_CASE("[SceneTree][GodotBodyPair3D][Benchmark] Box stacks" * doctest::skip()) {
+	const int stacks_x = 5;
+	const int stacks_z = 5;
+	const int height = 20;
+	const int steps = 600;
+
+	for (int solver_iterations : { 4, 8, 16, 32 }) {
+		BoxStacks stacks;
+		stacks.create(stacks_x, stacks_z, height, solver_iterations);
+
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		stacks.step(steps);
+		uint64_t step_usec = (OS::get_singleton()->get_ticks_usec() - begin) / steps;
+
+		print_line(vformat("%d boxes in %d stacks, %d solver iterations: %d usec per step, max drift %.3f, max speed %.3f.", stacks.boxes.size(), stacks_x * stacks_z, solver_iterations, step_usec, stacks.get_max_drift(stacks_z), stacks.get_max_speed()));
+
+		stacks.free();
+	}
+}
+
+} // namespace TestGodotBodyPair3D
+
+#endif // TEST_GODOT_BODY_PAIR_3D_H
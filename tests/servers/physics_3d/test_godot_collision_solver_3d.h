@@ -0,0 +1,191 @@
+/**************************************************************************/
+/*  test_godot_collision_solver_3d.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_GODOT_COLLISION_SOLVER_3D_H
+#define TEST_GODOT_COLLISION_SOLVER_3D_H
+
+#include "core/os/os.h"
+#include "servers/physics_3d/godot_collision_solver_3d.h"
+#include "servers/physics_3d/godot_collision_solver_3d_simd.h"
+#include "servers/physics_3d/godot_shape_3d.h"
+
+#include "tests/test_macros.h"
+
+namespace TestGodotCollisionSolver3D {
+
+static const Transform3D test_transforms[] = {
+	Transform3D(),
+	Transform3D(Basis(Vector3(0, 1, 0), Math_PI / 4.0), Vector3(0.5, 0.9, -0.25)),
+	Transform3D(Basis(Vector3(1, 1, 0).normalized(), 0.3), Vector3(0, 1.05, 0)),
+	Transform3D(Basis(Vector3(1, 2, 3).normalized(), 1.1), Vector3(-0.3, 0.2, 0.7)),
+	Transform3D(Basis(Vector3(0, 0, 1), 0.2), Vector3(1.2, 0, 0)),
+	Transform3D(Basis(), Vector3(0, 3, 0)),
+};
+
+static void _collect_contact(const Vector3 &p_point_A, int p_index_A, const Vector3 &p_point_B, int p_index_B, const Vector3 &normal, void *p_userdata) {
+	LocalVector<Vector3> *contacts = static_cast<LocalVector<Vector3> *>(p_userdata);
+	contacts->push_back(p_point_A);
+	contacts->push_back(p_point_B);
+}
+
+static GodotConvexPolygonShape3D *_create_box_convex(const Vector3 &p_half_extents) {
+	Vector<Vector3> vertices;
+	for (int i = 0; i < 8; i++) {
+		vertices.push_back(Vector3((i & 1) ? p_half_extents.x : -p_half_extents.x, (i & 2) ? p_half_extents.y : -p_half_extents.y, (i & 4) ? p_half_extents.z : -p_half_extents.z));
+	}
+
+	GodotConvexPolygonShape3D *convex = memnew(GodotConvexPolygonShape3D);
+	convex->set_data(vertices);
+	return convex;
+}
+
+TEST_CASE("[Physics][GodotCollisionSolver3D] Box projection kernel matches GodotBoxShape3D") {
+	GodotBoxShape3D *box = memnew(GodotBoxShape3D);
+	box->set_data(Vector3(0.5, 1.0, 2.0));
+
+	// Enough axes to cover both the vector loop and the scalar remainder.
+	const int axis_count = 11;
+	real_t axes_soa[3][axis_count];
+	Vector3 axes[axis_count];
+	for (int i = 0; i < axis_count; i++) {
+		axes[i] = Vector3(Math::sin(i * 1.3), Math::cos(i * 0.7), i * 0.1 - 0.5).normalized();
+		axes_soa[0][i] = axes[i].x;
+		axes_soa[1][i] = axes[i].y;
+		axes_soa[2][i] = axes[i].z;
+	}
+	const real_t *const axes_soa_ptrs[3] = { axes_soa[0], axes_soa[1], axes_soa[2] };
+
+	for (const Transform3D &xform : test_transforms) {
+		real_t min[axis_count];
+		real_t max[axis_count];
+		GodotCollisionSolver3DSIMD::project_box(xform, box->get_half_extents(), axes_soa_ptrs, axis_count, min, max);
+
+		for (int i = 0; i < axis_count; i++) {
+			real_t expected_min = 0.0;
+			real_t expected_max = 0.0;
+			box->project_range(axes[i], xform, expected_min, expected_max);
+			CHECK(Math::is_equal_approx(min[i], expected_min));
+			CHECK(Math::is_equal_approx(max[i], expected_max));
+		}
+	}
+
+	memdelete(box);
+}
+
+TEST_CASE("[Physics][GodotCollisionSolver3D] Convex polygon projection matches its transformed vertices") {
+	GodotConvexPolygonShape3D *convex = _create_box_convex(Vector3(0.5, 1.0, 2.0));
+	const Geometry3D::MeshData &mesh = convex->get_mesh();
+	REQUIRE(mesh.vertices.size() == 8);
+
+	const Vector3 axes[] = { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(1, 2, 3).normalized(), Vector3(-0.3, 0.1, 0.9).normalized() };
+	for (const Transform3D &xform : test_transforms) {
+		for (const Vector3 &axis : axes) {
+			real_t expected_min = 1e20;
+			real_t expected_max = -1e20;
+			for (const Vector3 &vertex : mesh.vertices) {
+				real_t d = axis.dot(xform.xform(vertex));
+				expected_min = MIN(expected_min, d);
+				expected_max = MAX(expected_max, d);
+			}
+
+			real_t min = 0.0;
+			real_t max = 0.0;
+			convex->project_range(axis, xform, min, max);
+			CHECK(min == doctest::Approx(expected_min).epsilon(0.0001));
+			CHECK(max == doctest::Approx(expected_max).epsilon(0.0001));
+		}
+	}
+
+	memdelete(convex);
+}
+
+TEST_CASE("[Physics][GodotCollisionSolver3D] Box and convex box collide alike") {
+	const Vector3 half_extents(0.5, 0.5, 0.5);
+	GodotBoxShape3D *box_A = memnew(GodotBoxShape3D);
+	box_A->set_data(half_extents);
+	GodotBoxShape3D *box_B = memnew(GodotBoxShape3D);
+	box_B->set_data(half_extents);
+	GodotConvexPolygonShape3D *convex_B = _create_box_convex(half_extents);
+
+	const bool expected_collisions[] = { true, true, true, true, false, false };
+	for (uint32_t i = 0; i < std::size(test_transforms); i++) {
+		const Transform3D &xform_B = test_transforms[i];
+
+		LocalVector<Vector3> box_contacts;
+		Vector3 box_sep_axis;
+		bool box_collided = GodotCollisionSolver3D::solve_static(box_A, Transform3D(), box_B, xform_B, _collect_contact, &box_contacts, &box_sep_axis);
+
+		LocalVector<Vector3> convex_contacts;
+		Vector3 convex_sep_axis;
+		bool convex_collided = GodotCollisionSolver3D::solve_static(box_A, Transform3D(), convex_B, xform_B, _collect_contact, &convex_contacts, &convex_sep_axis);
+
+		CHECK_MESSAGE(box_collided == expected_collisions[i], vformat("Box against box %d.", i));
+		CHECK_MESSAGE(convex_collided == expected_collisions[i], vformat("Box against convex box %d.", i));
+		if (box_collided && convex_collided) {
+			CHECK(box_contacts.size() > 0);
+			CHECK(convex_contacts.size() > 0);
+			CHECK(box_sep_axis.dot(convex_sep_axis) > 0.99);
+		}
+	}
+
+	memdelete(convex_B);
+	memdelete(box_B);
+	memdelete(box_A);
+}
+
+TEST_CASE("[Physics][GodotCollisionSolver3D][Benchmark] Box against box and convex" * doctest::skip()) {
+	const int iterations = 200000;
+	GodotBoxShape3D *box_A = memnew(GodotBoxShape3D);
+	box_A->set_data(Vector3(0.5, 0.5, 0.5));
+	GodotBoxShape3D *box_B = memnew(GodotBoxShape3D);
+	box_B->set_data(Vector3(0.5, 0.5, 0.5));
+	GodotConvexPolygonShape3D *convex_B = _create_box_convex(Vector3(0.5, 0.5, 0.5));
+	const Transform3D xform_B = test_transforms[2];
+
+	LocalVector<Vector3> contacts;
+	for (const GodotShape3D *shape_B : { (const GodotShape3D *)box_B, (const GodotShape3D *)convex_B }) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < iterations; i++) {
+			contacts.clear();
+			GodotCollisionSolver3D::solve_static(box_A, Transform3D(), shape_B, xform_B, _collect_contact, &contacts);
+		}
+		uint64_t usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+		print_line(vformat("Box against %s (%s): %.3f usec per pair.", shape_B == box_B ? "box" : "convex", GodotCollisionSolver3DSIMD::get_simd_name(), double(usec) / iterations));
+	}
+
+	memdelete(convex_B);
+	memdelete(box_B);
+	memdelete(box_A);
+}
+
+} // namespace TestGodotCollisionSolver3D
+
+#endif // TEST_GODOT_COLLISION_SOLVER_3D_H
@@ -0,0 +1,208 @@
+/**************************************************************************/
+/*  test_pipeline_cache_rd.h                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_PIPELINE_CACHE_RD_H
+#define TEST_PIPELINE_CACHE_RD_H
+
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_rd/pipeline_cache_rd.h"
+
+#include "tests/test_macros.h"
+
+namespace TestPipelineCacheRD {
+
+static PipelineCacheRD::ManifestKey make_key(uint32_t p_cache_hash, uint32_t p_framebuffer_format_hash, uint32_t p_bool_specializations = 0, bool p_wireframe = false) {
+	PipelineCacheRD::ManifestKey key;
+	key.cache_hash = p_cache_hash;
+	key.framebuffer_format_hash = p_framebuffer_format_hash;
+	key.vertex_format_hash = 0x1234;
+	key.render_pass = 1;
+	key.bool_specializations = p_bool_specializations;
+	key.wireframe = p_wireframe;
+	return key;
+}
+
+TEST_CASE("[PipelineCacheRD] Manifest records each version once") {
+	PipelineCacheRD::Manifest manifest;
+	CHECK_FALSE(manifest.is_dirty());
+
+	manifest.record(make_key(1, 10));
+	manifest.record(make_key(1, 10));
+	manifest.record(make_key(1, 10, 3));
+	manifest.record(make_key(1, 10, 0, true));
+	manifest.record(make_key(2, 10));
+
+	CHECK(manifest.is_dirty());
+	CHECK(manifest.get_key_count() == 4);
+
+	LocalVector<PipelineCacheRD::ManifestKey> keys = manifest.get_keys(1);
+	REQUIRE(keys.size() == 3);
+	CHECK(keys.find(make_key(1, 10)) != -1);
+	CHECK(keys.find(make_key(1, 10, 3)) != -1);
+	CHECK(keys.find(make_key(1, 10, 0, true)) != -1);
+	CHECK(manifest.get_keys(2).size() == 1);
+	CHECK(manifest.get_keys(3).is_empty());
+
+	manifest.clear();
+	CHECK(manifest.get_key_count() == 0);
+	CHECK(manifest.get_keys(1).is_empty());
+	CHECK_FALSE(manifest.is_dirty());
+}
+
+TEST_CASE("[PipelineCacheRD] Manifest save and load round trip") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("pipelines.manifest");
+
+	PipelineCacheRD::Manifest manifest;
+	manifest.record(make_key(1, 10));
+	manifest.record(make_key(1, 20, 5));
+	manifest.record(make_key(7, 10, 0, true));
+	CHECK(manifest.save(path) == OK);
+	CHECK_FALSE(manifest.is_dirty());
+
+	PipelineCacheRD::Manifest loaded;
+	loaded.record(make_key(99, 99)); // Replaced by the loaded keys.
+	CHECK(loaded.load(path) == OK);
+	CHECK_FALSE(loaded.is_dirty());
+	CHECK(loaded.get_key_count() == 3);
+	CHECK(loaded.get_keys(99).is_empty());
+
+	LocalVector<PipelineCacheRD::ManifestKey> keys = loaded.get_keys(1);
+	REQUIRE(keys.size() == 2);
+	CHECK(keys.find(make_key(1, 10)) != -1);
+	CHECK(keys.find(make_key(1, 20, 5)) != -1);
+	keys = loaded.get_keys(7);
+	REQUIRE(keys.size() == 1);
+	CHECK(keys[0] == make_key(7, 10, 0, true));
+
+	// Already known keys don't dirty it again.
+	loaded.record(make_key(1, 10));
+	CHECK_FALSE(loaded.is_dirty());
+	loaded.record(make_key(1, 30));
+	CHECK(loaded.is_dirty());
+}
+
+TEST_CASE("[PipelineCacheRD] Manifest rejects invalid files") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("pipelines_invalid.manifest");
+
+	PipelineCacheRD::Manifest manifest;
+	CHECK(manifest.load(path.path_join("missing.manifest")) != OK);
+
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_32(0xDEADBEEF);
+		f->store_32(1);
+		f->store_32(0);
+	}
+	ERR_PRINT_OFF;
+	CHECK(manifest.load(path) == ERR_FILE_UNRECOGNIZED);
+	ERR_PRINT_ON;
+
+	PipelineCacheRD::Manifest source;
+	source.record(make_key(1, 10));
+	source.record(make_key(1, 20));
+	REQUIRE(source.save(path) == OK);
+	{
+		// Drop the last key.
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(path);
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer(data.ptr(), data.size() - 6 * sizeof(uint32_t));
+	}
+	ERR_PRINT_OFF;
+	CHECK(manifest.load(path) == ERR_FILE_CORRUPT);
+	ERR_PRINT_ON;
+	CHECK(manifest.get_key_count() == 0);
+}
+
+TEST_CASE("[PipelineCacheRD] Recorded versions are replayed once their formats are registered") {
+	PipelineCacheRD::clear_formats();
+
+	const RD::VertexFormatID vertex_format = 5;
+	const RD::FramebufferFormatID framebuffer_format_a = 7;
+	const RD::FramebufferFormatID framebuffer_format_b = 8;
+
+	LocalVector<PipelineCacheRD::ManifestKey> keys;
+	keys.push_back(make_key(1, 10));
+	keys.push_back(make_key(1, 10, 3));
+	keys.push_back(make_key(1, 20, 0, true));
+
+	LocalVector<PipelineCacheRD::PrewarmVersion> versions;
+	PipelineCacheRD::resolve_prewarm_keys(keys, false, versions);
+	CHECK_MESSAGE(versions.is_empty(), "No format has been seen in this run yet.");
+	CHECK(keys.size() == 3);
+
+	CHECK(PipelineCacheRD::register_format_hashes(vertex_format, 0x1234, framebuffer_format_a, 10));
+	CHECK_FALSE_MESSAGE(PipelineCacheRD::register_format_hashes(vertex_format, 0x1234, framebuffer_format_a, 10), "Known formats must not trigger another replay.");
+
+	PipelineCacheRD::resolve_prewarm_keys(keys, false, versions);
+	REQUIRE(versions.size() == 2);
+	for (const PipelineCacheRD::PrewarmVersion &version : versions) {
+		CHECK(version.vertex_id == vertex_format);
+		CHECK(version.framebuffer_id == framebuffer_format_a);
+		CHECK(version.render_pass == 1);
+		CHECK_FALSE(version.wireframe);
+	}
+	CHECK(versions[0].bool_specializations != versions[1].bool_specializations);
+	REQUIRE(keys.size() == 1);
+	CHECK(keys[0] == make_key(1, 20, 0, true));
+
+	// Resolved keys are only replayed once.
+	versions.clear();
+	PipelineCacheRD::resolve_prewarm_keys(keys, false, versions);
+	CHECK(versions.is_empty());
+
+	CHECK(PipelineCacheRD::register_format_hashes(vertex_format, 0x1234, framebuffer_format_b, 20));
+	PipelineCacheRD::resolve_prewarm_keys(keys, false, versions);
+	REQUIRE(versions.size() == 1);
+	CHECK(versions[0].framebuffer_id == framebuffer_format_b);
+	CHECK(versions[0].wireframe);
+	CHECK(keys.is_empty());
+
+	// Caches forcing wireframe compile every recorded version as wireframe.
+	keys.push_back(make_key(1, 10));
+	versions.clear();
+	PipelineCacheRD::resolve_prewarm_keys(keys, true, versions);
+	REQUIRE(versions.size() == 1);
+	CHECK(versions[0].wireframe);
+
+	// Formats belong to a RenderingDevice, they are not resolved anymore once cleared.
+	PipelineCacheRD::clear_formats();
+	keys.push_back(make_key(1, 10));
+	versions.clear();
+	PipelineCacheRD::resolve_prewarm_keys(keys, false, versions);
+	CHECK(versions.is_empty());
+	CHECK(keys.size() == 1);
+}
+
+} // namespace TestPipelineCacheRD
+
+#endif // TEST_PIPELINE_CACHE_RD_H
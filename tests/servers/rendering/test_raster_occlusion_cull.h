@@ -0,0 +1,126 @@
+/**************************************************************************/
+/*  test_raster_occlusion_cull.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RASTER_OCCLUSION_CULL_H
+#define TEST_RASTER_OCCLUSION_CULL_H
+
+#include "servers/rendering/raster_occlusion_cull.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRasterOcclusionCull {
+
+// Creating and freeing an occlusion culler replaces the singleton, which the rendering server may already use.
+class SingletonRestorer : public RasterOcclusionCull {
+public:
+	static void restore(RendererSceneOcclusionCull *p_singleton) {
+		singleton = p_singleton;
+	}
+};
+
+TEST_CASE("[RasterOcclusionCull] Occluders hide the bounds behind them") {
+	RendererSceneOcclusionCull *previous_singleton = RendererSceneOcclusionCull::get_singleton();
+	RasterOcclusionCull *occlusion_cull = memnew(RasterOcclusionCull);
+
+	const RID scenario = RID::from_uint64(1);
+	const RID buffer = RID::from_uint64(2);
+	const RID instance = RID::from_uint64(3);
+
+	RID occluder = occlusion_cull->occluder_allocate();
+	occlusion_cull->occluder_initialize(occluder);
+	CHECK(occlusion_cull->is_occluder(occluder));
+
+	occlusion_cull->add_scenario(scenario);
+	occlusion_cull->add_buffer(buffer);
+	occlusion_cull->buffer_set_scenario(buffer, scenario);
+	occlusion_cull->buffer_set_size(buffer, Vector2i(64, 48));
+
+	Projection projection;
+	projection.set_perspective(60, 64.0 / 48.0, 0.1, 100);
+	const Transform3D camera_transform;
+	const Transform3D inv_camera_transform = camera_transform.affine_inverse();
+	const real_t z_near = projection.get_z_near();
+
+	SUBCASE("Wall in front of the camera") {
+		PackedVector3Array vertices = { Vector3(-5, -5, 0), Vector3(5, -5, 0), Vector3(5, 5, 0), Vector3(-5, 5, 0) };
+		PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+		occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+
+		const RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		REQUIRE(hz_buffer != nullptr);
+
+		const real_t behind[6] = { -1, -1, -21, 1, 1, -19 };
+		const real_t in_front[6] = { -1, -1, -6, 1, 1, -4 };
+		const real_t beside[6] = { 8, -1, -21, 12, 1, -19 };
+		CHECK(hz_buffer->is_occluded(behind, camera_transform.origin, inv_camera_transform, projection, z_near));
+		CHECK_FALSE(hz_buffer->is_occluded(in_front, camera_transform.origin, inv_camera_transform, projection, z_near));
+		CHECK_FALSE(hz_buffer->is_occluded(beside, camera_transform.origin, inv_camera_transform, projection, z_near));
+
+		// Disabled occluders are not rasterized.
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), false);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK_FALSE(hz_buffer->is_occluded(behind, camera_transform.origin, inv_camera_transform, projection, z_near));
+
+		// Neither are removed ones.
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, 0, -10)), true);
+		occlusion_cull->scenario_remove_instance(scenario, instance);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+		CHECK_FALSE(hz_buffer->is_occluded(behind, camera_transform.origin, inv_camera_transform, projection, z_near));
+	}
+
+	SUBCASE("Floor crossing the camera plane") {
+		// The floor extends behind the camera, so it has to be clipped by the near plane.
+		PackedVector3Array vertices = { Vector3(-50, 0, 5), Vector3(50, 0, 5), Vector3(50, 0, -50), Vector3(-50, 0, -50) };
+		PackedInt32Array indices = { 0, 1, 2, 0, 2, 3 };
+		occlusion_cull->occluder_set_mesh(occluder, vertices, indices);
+		occlusion_cull->scenario_set_instance(scenario, instance, occluder, Transform3D(Basis(), Vector3(0, -2, 0)), true);
+		occlusion_cull->buffer_update(buffer, camera_transform, projection, false);
+
+		const RendererSceneOcclusionCull::HZBuffer *hz_buffer = occlusion_cull->buffer_get_ptr(buffer);
+		REQUIRE(hz_buffer != nullptr);
+
+		const real_t below[6] = { -2, -12, -22, 2, -8, -18 };
+		const real_t above[6] = { -2, 1, -22, 2, 5, -18 };
+		CHECK(hz_buffer->is_occluded(below, camera_transform.origin, inv_camera_transform, projection, z_near));
+		CHECK_FALSE(hz_buffer->is_occluded(above, camera_transform.origin, inv_camera_transform, projection, z_near));
+	}
+
+	occlusion_cull->remove_buffer(buffer);
+	occlusion_cull->remove_scenario(scenario);
+	occlusion_cull->free_occluder(occluder);
+	memdelete(occlusion_cull);
+	SingletonRestorer::restore(previous_singleton);
+}
+
+} // namespace TestRasterOcclusionCull
+
+#endif // TEST_RASTER_OCCLUSION_CULL_H
@@ -0,0 +1,189 @@
+/**************************************************************************/
+/*  test_renderer_canvas_render_rd.h                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_CANVAS_RENDER_RD_H
+#define TEST_RENDERER_CANVAS_RENDER_RD_H
+
+#include "servers/rendering/renderer_rd/renderer_canvas_render_rd.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererCanvasRenderRD {
+
+typedef RendererCanvasRenderRD::BatchBuilder BatchBuilder;
+typedef RendererCanvasRenderRD::BatchKey BatchKey;
+
+static BatchKey make_key(uint64_t p_texture, uint64_t p_material = 0, bool p_use_lighting = false) {
+	BatchKey key;
+	key.texture = RID::from_uint64(p_texture);
+	key.material = RID::from_uint64(p_material);
+	key.use_lighting = p_use_lighting;
+	return key;
+}
+
+TEST_CASE("[RendererCanvasRenderRD] Batches span items with the same state") {
+	RendererCanvasRender::Item::CommandRect rects[4];
+	BatchBuilder builder;
+
+	// Two rects in each of two items.
+	builder.add_command(make_key(1), 0, &rects[0], 1);
+	builder.add_command(make_key(1), 0, &rects[1], 1);
+	builder.add_command(make_key(1), 1, &rects[2], 1);
+	builder.add_command(make_key(1), 1, &rects[3], 1);
+	builder.break_batch();
+
+	REQUIRE(builder.batches.size() == 1);
+	CHECK(builder.batches[0].command_count == 4);
+	CHECK(builder.batches[0].instance_count == 4);
+	CHECK(builder.instances.size() == 4);
+
+	REQUIRE(builder.spans.size() == 2);
+	CHECK(builder.spans[0].item == 0);
+	CHECK(builder.spans[0].first == &rects[0]);
+	CHECK(builder.spans[0].last == &rects[1]);
+	CHECK(builder.spans[0].batch == 0);
+	CHECK(builder.spans[1].item == 1);
+	CHECK(builder.spans[1].first == &rects[2]);
+	CHECK(builder.spans[1].last == &rects[3]);
+	CHECK_MESSAGE(builder.spans[1].batch == -1, "The batch must only be drawn by its first span.");
+}
+
+TEST_CASE("[RendererCanvasRenderRD] Material, texture and light changes break batches") {
+	RendererCanvasRender::Item::CommandRect rects[8];
+	BatchBuilder builder;
+
+	builder.add_command(make_key(1), 0, &rects[0], 1);
+	builder.add_command(make_key(1), 0, &rects[1], 1);
+	builder.add_command(make_key(2), 0, &rects[2], 1); // Texture change.
+	builder.add_command(make_key(2), 0, &rects[3], 1);
+	builder.add_command(make_key(2, 5), 1, &rects[4], 1); // Material change.
+	builder.add_command(make_key(2, 5), 1, &rects[5], 1);
+	builder.add_command(make_key(2, 5, true), 2, &rects[6], 1); // Lighting change.
+	builder.add_command(make_key(2, 5, true), 2, &rects[7], 1);
+	builder.break_batch();
+
+	REQUIRE(builder.batches.size() == 4);
+	for (uint32_t i = 0; i < builder.batches.size(); i++) {
+		CHECK(builder.batches[i].command_count == 2);
+		CHECK(builder.batches[i].instance_offset == i * 2);
+		REQUIRE(builder.batches[i].first_span == i);
+		CHECK(builder.spans[i].first == &rects[i * 2]);
+		CHECK(builder.spans[i].last == &rects[i * 2 + 1]);
+		CHECK(builder.spans[i].batch == int32_t(i));
+	}
+}
+
+TEST_CASE("[RendererCanvasRenderRD] Other state changes break batches") {
+	BatchKey key = make_key(1);
+
+	BatchKey clip = key;
+	RendererCanvasRender::Item clip_owner;
+	clip.clip = &clip_owner;
+	CHECK(key != clip);
+
+	BatchKey vertices = key;
+	vertices.type = RendererCanvasRenderRD::BATCH_TYPE_VERTICES;
+	CHECK(key != vertices);
+
+	BatchKey filter = key;
+	filter.filter = RS::CANVAS_ITEM_TEXTURE_FILTER_NEAREST;
+	CHECK(key != filter);
+
+	BatchKey repeat = key;
+	repeat.repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_ENABLED;
+	CHECK(key != repeat);
+
+	BatchKey msdf = key;
+	msdf.msdf = true;
+	msdf.px_range = 4.0;
+	CHECK(key != msdf);
+
+	BatchKey outline = msdf;
+	outline.outline = 2.0;
+	CHECK(msdf != outline);
+
+	CHECK(key == make_key(1));
+}
+
+TEST_CASE("[RendererCanvasRenderRD] Single commands are not kept as batches") {
+	RendererCanvasRender::Item::CommandRect rects[4];
+	BatchBuilder builder;
+
+	builder.add_command(make_key(1), 0, &rects[0], 1);
+	builder.break_batch(); // For example an unbatchable command.
+	builder.add_command(make_key(1), 0, &rects[1], 1);
+	builder.add_command(make_key(2), 0, &rects[2], 1);
+	builder.add_command(make_key(2), 1, &rects[3], 1);
+	builder.break_batch();
+
+	REQUIRE_MESSAGE(builder.batches.size() == 1, "Runs of a single command must be dropped, they are drawn as usual.");
+	CHECK(builder.batches[0].instance_offset == 0);
+	CHECK(builder.batches[0].first_span == 0);
+	CHECK(builder.instances.size() == 2);
+
+	REQUIRE(builder.spans.size() == 2);
+	CHECK(builder.spans[0].first == &rects[2]);
+	CHECK(builder.spans[0].batch == 0);
+	CHECK(builder.spans[1].first == &rects[3]);
+	CHECK(builder.spans[1].batch == -1);
+
+	builder.clear();
+	CHECK(builder.batches.is_empty());
+	CHECK(builder.spans.is_empty());
+	CHECK(builder.instances.is_empty());
+	CHECK_FALSE(builder.open);
+}
+
+TEST_CASE("[RendererCanvasRenderRD] Commands with several instances") {
+	RendererCanvasRender::Item::CommandNinePatch nine_patch;
+	RendererCanvasRender::Item::CommandPolygon polygons[2];
+	BatchBuilder builder;
+
+	RendererCanvasRenderRD::BatchInstance *instances = builder.add_command(make_key(1), 0, &nine_patch, 9);
+	CHECK(instances == builder.instances.ptr());
+
+	BatchKey vertices = make_key(1);
+	vertices.type = RendererCanvasRenderRD::BATCH_TYPE_VERTICES;
+	instances = builder.add_command(vertices, 0, &polygons[0], 6);
+	CHECK(instances == builder.instances.ptr());
+	instances = builder.add_command(vertices, 0, &polygons[1], 3);
+	CHECK(instances == builder.instances.ptr() + 6);
+	builder.break_batch();
+
+	REQUIRE(builder.batches.size() == 1);
+	CHECK(builder.batches[0].command_count == 2);
+	CHECK(builder.batches[0].instance_offset == 0);
+	CHECK(builder.batches[0].instance_count == 9);
+	CHECK(builder.instances.size() == 9);
+}
+
+} // namespace TestRendererCanvasRenderRD
+
+#endif // TEST_RENDERER_CANVAS_RENDER_RD_H
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_H
+#define TEST_RENDERER_SCENE_CULL_H
+
+#include "servers/rendering/renderer_scene_cull.h"
+#include "servers/rendering/rendering_server_globals.h"
+#include "servers/rendering_server.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCull {
+
+static Transform3D get_instance_transform(RID p_instance) {
+	return static_cast<RendererSceneCull *>(RSG::scene)->instance_get_transform(p_instance);
+}
+
+static Transform3D make_transform(int p_index) {
+	Transform3D transform;
+	transform.basis = Basis(Vector3(0, 1, 0), 0.25 * p_index).scaled(Vector3(1, 2, 3));
+	transform.origin = Vector3(p_index, -p_index, 2 * p_index);
+	return transform;
+}
+
+// Same layout as multimesh buffers.
+static void append_transform(PackedFloat32Array &r_data, const Transform3D &p_transform) {
+	for (int i = 0; i < 3; i++) {
+		r_data.push_back(p_transform.basis.rows[i][0]);
+		r_data.push_back(p_transform.basis.rows[i][1]);
+		r_data.push_back(p_transform.basis.rows[i][2]);
+		r_data.push_back(p_transform.origin[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][RenderingServer] instances_set_transforms applies a batch") {
+	RID instances[3];
+	PackedInt64Array ids;
+	PackedFloat32Array data;
+	for (int i = 0; i < 3; i++) {
+		instances[i] = RS::get_singleton()->instance_create();
+		ids.push_back(instances[i].get_id());
+		append_transform(data, make_transform(i + 1));
+	}
+
+	RS::get_singleton()->instances_set_transforms(ids, data);
+
+	for (int i = 0; i < 3; i++) {
+		CHECK(get_instance_transform(instances[i]).is_equal_approx(make_transform(i + 1)));
+		RS::get_singleton()->free(instances[i]);
+	}
+}
+
+TEST_CASE("[SceneTree][RenderingServer] instances_set_transforms skips freed instances") {
+	RID freed = RS::get_singleton()->instance_create();
+	RID kept = RS::get_singleton()->instance_create();
+
+	PackedInt64Array ids;
+	PackedFloat32Array data;
+	ids.push_back(freed.get_id());
+	append_transform(data, make_transform(1));
+	ids.push_back(kept.get_id());
+	append_transform(data, make_transform(2));
+
+	// Freed after the batch was filled, like a node deleted before the batch is sent.
+	RS::get_singleton()->free(freed);
+	RS::get_singleton()->instances_set_transforms(ids, data);
+
+	CHECK(get_instance_transform(kept).is_equal_approx(make_transform(2)));
+
+	RS::get_singleton()->free(kept);
+}
+
+TEST_CASE("[SceneTree][RenderingServer] instances_set_transforms rejects mismatched sizes") {
+	RID instance = RS::get_singleton()->instance_create();
+
+	PackedInt64Array ids;
+	PackedFloat32Array data;
+	ids.push_back(instance.get_id());
+	append_transform(data, make_transform(1));
+	data.resize(11);
+
+	ERR_PRINT_OFF;
+	RS::get_singleton()->instances_set_transforms(ids, data);
+	ERR_PRINT_ON;
+	CHECK(get_instance_transform(instance) == Transform3D());
+
+	// Extra transforms are rejected too, instead of being applied partially.
+	append_transform(data, make_transform(2));
+	data.resize(24);
+	ERR_PRINT_OFF;
+	RS::get_singleton()->instances_set_transforms(ids, data);
+	ERR_PRINT_ON;
+	CHECK(get_instance_transform(instance) == Transform3D());
+
+	RS::get_singleton()->free(instance);
+}
+
+} // namespace TestRendererSceneCull
+
+#endif // TEST_RENDERER_SCENE_CULL_H
@@ -0,0 +1,206 @@
+/**************************************************************************/
+/*  test_renderer_scene_cull_simd.h                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_RENDERER_SCENE_CULL_SIMD_H
+#define TEST_RENDERER_SCENE_CULL_SIMD_H
+
+#include "core/math/random_number_generator.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_scene_cull_simd.h"
+
+#include "tests/test_macros.h"
+
+namespace TestRendererSceneCullSIMD {
+
+static void _fill_random_bounds(LocalVector<real_t> (&r_bounds)[6], uint32_t p_count, uint64_t p_seed) {
+	Ref<RandomNumberGenerator> rng;
+	rng.instantiate();
+	rng->set_seed(p_seed);
+	for (int k = 0; k < 6; k++) {
+		r_bounds[k].resize(p_count);
+	}
+	for (uint32_t i = 0; i < p_count; i++) {
+		for (int k = 0; k < 3; k++) {
+			real_t position = rng->randf_range(-150, 150);
+			r_bounds[k][i] = position;
+			r_bounds[k + 3][i] = position + rng->randf_range(0, 10);
+		}
+	}
+}
+
+// Same test as RendererSceneCull::InstanceBounds::in_frustum(), also returns how close the bounds are to be culled.
+static bool _reference_in_frustum(const real_t p_bounds[6], const Vector<Plane> &p_planes, real_t &r_margin) {
+	r_margin = FLT_MAX;
+	for (const Plane &plane : p_planes) {
+		const Vector3 min(p_bounds[plane.normal.x > 0 ? 0 : 3], p_bounds[plane.normal.y > 0 ? 1 : 4], p_bounds[plane.normal.z > 0 ? 2 : 5]);
+		const real_t distance = plane.distance_to(min);
+		r_margin = MIN(r_margin, Math::abs(distance));
+		if (distance >= 0.0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static Vector<Plane> _camera_planes() {
+	Projection projection;
+	projection.set_perspective(75, 16.0 / 9.0, 0.05, 100);
+	Transform3D camera_transform;
+	camera_transform.origin = Vector3(3, 2, 10);
+	camera_transform.basis = Basis(Vector3(0, 1, 0), 0.3);
+	return projection.get_projection_planes(camera_transform);
+}
+
+TEST_CASE("[RendererSceneCullSIMD] Frustum culling matches the scalar test") {
+	const Vector<Plane> planes = _camera_planes();
+
+	// Odd count, so both the vectorized loop and the remainder are exercised.
+	const uint32_t count = 4099;
+	LocalVector<real_t> bounds[6];
+	_fill_random_bounds(bounds, count, 7);
+	const real_t *const bounds_ptrs[6] = { bounds[0].ptr(), bounds[1].ptr(), bounds[2].ptr(), bounds[3].ptr(), bounds[4].ptr(), bounds[5].ptr() };
+
+	LocalVector<uint8_t> in_frustum;
+	in_frustum.resize(count);
+	RendererSceneCullSIMD::cull_frustum(bounds_ptrs, count, planes.ptr(), planes.size(), in_frustum.ptr());
+
+	uint32_t inside = 0;
+	uint32_t mismatches = 0;
+	for (uint32_t i = 0; i < count; i++) {
+		const real_t instance_bounds[6] = { bounds[0][i], bounds[1][i], bounds[2][i], bounds[3][i], bounds[4][i], bounds[5][i] };
+		real_t margin;
+		const bool expected = _reference_in_frustum(instance_bounds, planes, margin);
+		// Results may only differ by rounding when the bounds touch a plane.
+		if (expected != (in_frustum[i] != 0) && margin > 1e-3) {
+			mismatches++;
+		}
+		inside += expected ? 1 : 0;
+	}
+
+	CHECK_MESSAGE(mismatches == 0, "Vectorized frustum culling should give the same results as the scalar test.");
+	CHECK_MESSAGE(inside > 0, "Some of the random bounds should be inside the frustum.");
+	CHECK_MESSAGE(inside < count, "Some of the random bounds should be outside the frustum.");
+}
+
+TEST_CASE("[RendererSceneCullSIMD] Bounds projection") {
+	Projection projection;
+	projection.set_perspective(75, 16.0 / 9.0, 0.05, 100);
+	Transform3D camera_transform;
+	camera_transform.origin = Vector3(0, 0, 10);
+	const Transform3D inv_camera_transform = camera_transform.affine_inverse();
+
+	SUBCASE("Bounds in front of the camera") {
+		const real_t bounds[6] = { -1, -0.5, -2, 2, 1.5, 1 };
+
+		Vector2 expected_min = Vector2(FLT_MAX, FLT_MAX);
+		Vector2 expected_max = Vector2(FLT_MIN, FLT_MIN);
+		for (int j = 0; j < 8; j++) {
+			const Vector3 corner = Vector3(bounds[(j & 1) ? 3 : 0], bounds[(j & 2) ? 4 : 1], bounds[(j & 4) ? 5 : 2]);
+			const Plane projected = projection.xform4(Plane(inv_camera_transform.xform(corner), 1.0));
+			const Vector2 normalized = Vector2(projected.normal.x / projected.d * 0.5f + 0.5f, projected.normal.y / projected.d * 0.5f + 0.5f);
+			expected_min = expected_min.min(normalized);
+			expected_max = expected_max.max(normalized);
+		}
+
+		Vector2 rect_min;
+		Vector2 rect_max;
+		CHECK(RendererSceneCullSIMD::project_bounds(bounds, inv_camera_transform, projection, rect_min, rect_max));
+		CHECK(rect_min.is_equal_approx(expected_min));
+		CHECK(rect_max.is_equal_approx(expected_max));
+		CHECK(rect_min.x < 0.5);
+		CHECK(rect_max.x > 0.5);
+	}
+
+	SUBCASE("Bounds crossing the camera plane") {
+		const real_t bounds[6] = { -1, -1, 9, 1, 1, 12 };
+
+		Vector2 rect_min = Vector2(-1, -1);
+		Vector2 rect_max = Vector2(-1, -1);
+		CHECK_FALSE(RendererSceneCullSIMD::project_bounds(bounds, inv_camera_transform, projection, rect_min, rect_max));
+		CHECK_MESSAGE(rect_min == Vector2(-1, -1), "The rect should be left untouched.");
+		CHECK_MESSAGE(rect_max == Vector2(-1, -1), "The rect should be left untouched.");
+	}
+}
+
+TEST_CASE("[RendererSceneCullSIMD] Depth comparisons") {
+	float values[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+	CHECK_FALSE(RendererSceneCullSIMD::any_greater(values, 0, 0));
+	CHECK_FALSE(RendererSceneCullSIMD::any_greater(values, 9, 9));
+	for (uint32_t count = 1; count <= 9; count++) {
+		CHECK(RendererSceneCullSIMD::any_greater(values, count, count - 0.5f));
+		CHECK_FALSE(RendererSceneCullSIMD::any_greater(values, count, count));
+	}
+	// A single value above the threshold, in the remainder.
+	values[8] = 20;
+	CHECK(RendererSceneCullSIMD::any_greater(values, 9, 10));
+	CHECK_FALSE(RendererSceneCullSIMD::any_greater(values, 8, 10));
+}
+
+TEST_CASE("[RendererSceneCullSIMD][Benchmark] Frustum culling" * doctest::skip()) {
+	const Vector<Plane> planes = _camera_planes();
+	const uint32_t count = 300000;
+	const int iterations = 100;
+
+	LocalVector<real_t> bounds[6];
+	_fill_random_bounds(bounds, count, 11);
+	const real_t *const bounds_ptrs[6] = { bounds[0].ptr(), bounds[1].ptr(), bounds[2].ptr(), bounds[3].ptr(), bounds[4].ptr(), bounds[5].ptr() };
+	LocalVector<uint8_t> in_frustum;
+	in_frustum.resize(count);
+
+	uint64_t scalar_usec = 0;
+	uint64_t simd_usec = 0;
+	uint32_t visible = 0;
+	for (bool simd : { false, true }) {
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int it = 0; it < iterations; it++) {
+			if (simd) {
+				RendererSceneCullSIMD::cull_frustum(bounds_ptrs, count, planes.ptr(), planes.size(), in_frustum.ptr());
+			} else {
+				for (uint32_t i = 0; i < count; i++) {
+					const real_t instance_bounds[6] = { bounds[0][i], bounds[1][i], bounds[2][i], bounds[3][i], bounds[4][i], bounds[5][i] };
+					real_t margin;
+					in_frustum[i] = _reference_in_frustum(instance_bounds, planes, margin) ? 1 : 0;
+				}
+			}
+		}
+		(simd ? simd_usec : scalar_usec) = OS::get_singleton()->get_ticks_usec() - begin;
+		visible = 0;
+		for (uint32_t i = 0; i < count; i++) {
+			visible += in_frustum[i];
+		}
+	}
+
+	print_line(vformat("Frustum culling %d instances (%d visible), scalar: %d usec, %s: %d usec.", count, visible, scalar_usec / iterations, RendererSceneCullSIMD::get_simd_name(), simd_usec / iterations));
+}
+
+} // namespace TestRendererSceneCullSIMD
+
+#endif // TEST_RENDERER_SCENE_CULL_SIMD_H
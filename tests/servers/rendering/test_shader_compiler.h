@@ -0,0 +1,125 @@
+/**************************************************************************/
+/*  test_shader_compiler.h                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_COMPILER_H
+#define TEST_SHADER_COMPILER_H
+
+#include "servers/rendering/shader_compiler.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderCompiler {
+
+struct CompileResult {
+	bool writes_color = false;
+	bool uses_time = false;
+	int blend_mode = 0;
+	HashMap<StringName, ShaderLanguage::ShaderNode::Uniform> uniforms;
+	ShaderCompiler::GeneratedCode gen_code;
+};
+
+static Error compile_canvas_item(ShaderCompiler &p_compiler, const String &p_code, CompileResult &r_result) {
+	ShaderCompiler::IdentifierActions actions;
+	actions.entry_point_stages["vertex"] = ShaderCompiler::STAGE_VERTEX;
+	actions.entry_point_stages["fragment"] = ShaderCompiler::STAGE_FRAGMENT;
+	actions.render_mode_values["blend_add"] = Pair<int *, int>(&r_result.blend_mode, 1);
+	actions.write_flag_pointers["COLOR"] = &r_result.writes_color;
+	actions.usage_flag_pointers["TIME"] = &r_result.uses_time;
+	actions.uniforms = &r_result.uniforms;
+	return p_compiler.compile(RS::SHADER_CANVAS_ITEM, p_code, &actions, "", r_result.gen_code);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Cached compilations replay their results") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const String code = R"(
+shader_type canvas_item;
+render_mode blend_add;
+
+uniform float amount = 0.5;
+
+void fragment() {
+	COLOR = vec4(amount);
+}
+)";
+
+	CompileResult first;
+	REQUIRE(compile_canvas_item(compiler, code, first) == OK);
+	CHECK(compiler.get_shader_cache_hits() == 0);
+	CHECK(first.writes_color);
+	CHECK_FALSE(first.uses_time);
+	CHECK(first.blend_mode == 1);
+	CHECK(first.uniforms.has("amount"));
+
+	CompileResult second;
+	REQUIRE(compile_canvas_item(compiler, code, second) == OK);
+	CHECK(compiler.get_shader_cache_hits() == 1);
+	CHECK(second.writes_color);
+	CHECK_FALSE(second.uses_time);
+	CHECK(second.blend_mode == 1);
+	CHECK(second.uniforms.has("amount"));
+	CHECK(second.gen_code.uniforms == first.gen_code.uniforms);
+	CHECK(second.gen_code.code["fragment"] == first.gen_code.code["fragment"]);
+	CHECK(second.gen_code.uniform_total_size == first.gen_code.uniform_total_size);
+
+	// Any change to the code is compiled again.
+	CompileResult changed;
+	REQUIRE(compile_canvas_item(compiler, code.replace("COLOR = vec4(amount);", "COLOR = vec4(amount * TIME);"), changed) == OK);
+	CHECK(compiler.get_shader_cache_hits() == 1);
+	CHECK(changed.uses_time);
+	CHECK(changed.gen_code.code["fragment"] != first.gen_code.code["fragment"]);
+
+	compiler.set_shader_cache_size(0);
+	CompileResult uncached;
+	REQUIRE(compile_canvas_item(compiler, code, uncached) == OK);
+	CHECK(compiler.get_shader_cache_hits() == 1);
+	CHECK(uncached.writes_color);
+	CHECK(uncached.gen_code.code["fragment"] == first.gen_code.code["fragment"]);
+}
+
+TEST_CASE("[SceneTree][ShaderCompiler] Failed compilations are not cached") {
+	ShaderCompiler compiler;
+	compiler.initialize(ShaderCompiler::DefaultIdentifierActions());
+
+	const String code = "shader_type canvas_item;\nvoid fragment() {\n\tCOLOR = undefined_variable;\n}\n";
+
+	ERR_PRINT_OFF;
+	CompileResult first;
+	CHECK(compile_canvas_item(compiler, code, first) != OK);
+	CompileResult second;
+	CHECK(compile_canvas_item(compiler, code, second) != OK);
+	ERR_PRINT_ON;
+	CHECK(compiler.get_shader_cache_hits() == 0);
+}
+
+} // namespace TestShaderCompiler
+
+#endif // TEST_SHADER_COMPILER_H
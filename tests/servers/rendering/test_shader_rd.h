@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  test_shader_rd.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#ifndef TEST_SHADER_RD_H
+#define TEST_SHADER_RD_H
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/os/os.h"
+#include "servers/rendering/renderer_rd/shader_rd.h"
+
+#include "tests/test_macros.h"
+
+namespace TestShaderRD {
+
+static Vector<uint8_t> make_shader_data(uint8_t p_seed, int p_size) {
+	Vector<uint8_t> data;
+	data.resize(p_size);
+	for (int i = 0; i < p_size; i++) {
+		data.write[i] = uint8_t(p_seed + i);
+	}
+	return data;
+}
+
+TEST_CASE("[ShaderRD] Cache keys are invalidated per variant") {
+	String variant_a[ShaderRD::STAGE_TYPE_MAX] = { "#define A\nvoid main() {}", "void main() {}", "" };
+	String variant_b[ShaderRD::STAGE_TYPE_MAX] = { "#define B\nvoid main() {}", "void main() {}", "" };
+
+	const String hash_a = ShaderRD::get_variant_sha256("base", variant_a);
+	const String hash_b = ShaderRD::get_variant_sha256("base", variant_b);
+	CHECK(hash_a != hash_b);
+	CHECK(ShaderRD::get_variant_sha256("base", variant_a) == hash_a);
+
+	// Editing a stage of one variant only changes the key of that variant.
+	variant_b[ShaderRD::STAGE_TYPE_FRAGMENT] = "void main() { discard; }";
+	CHECK(ShaderRD::get_variant_sha256("base", variant_a) == hash_a);
+	CHECK(ShaderRD::get_variant_sha256("base", variant_b) != hash_b);
+
+	// The same source in a different stage is a different variant.
+	String swapped[ShaderRD::STAGE_TYPE_MAX] = { variant_a[ShaderRD::STAGE_TYPE_FRAGMENT], variant_a[ShaderRD::STAGE_TYPE_VERTEX], "" };
+	CHECK(ShaderRD::get_variant_sha256("base", swapped) != hash_a);
+
+	// Changes to the shader itself invalidate every variant.
+	CHECK(ShaderRD::get_variant_sha256("other_base", variant_a) != hash_a);
+}
+
+TEST_CASE("[ShaderRD] Cache files are replaced atomically") {
+	const String dir = OS::get_singleton()->get_cache_path().path_join("test_shader_rd");
+	const String path = dir.path_join("ab").path_join("cdef.vulkan.cache");
+	DirAccess::remove_absolute(path);
+
+	Vector<uint8_t> loaded;
+	CHECK_FALSE(ShaderRD::load_from_cache_file(path, loaded));
+
+	// Creates the missing shard directory.
+	const Vector<uint8_t> first = make_shader_data(1, 64);
+	CHECK(ShaderRD::save_to_cache_file(path, first) == OK);
+	REQUIRE(ShaderRD::load_from_cache_file(path, loaded));
+	CHECK(loaded == first);
+
+	// Overwrites a stale entry, e.g. one rejected by the driver.
+	const Vector<uint8_t> second = make_shader_data(7, 32);
+	CHECK(ShaderRD::save_to_cache_file(path, second) == OK);
+	REQUIRE(ShaderRD::load_from_cache_file(path, loaded));
+	CHECK(loaded == second);
+
+	// No temporary files are left behind next to the entry.
+	Ref<DirAccess> da = DirAccess::open(path.get_base_dir());
+	REQUIRE(da.is_valid());
+	PackedStringArray files = da->get_files();
+	CHECK(files.size() == 1);
+	CHECK(files[0] == path.get_file());
+
+	DirAccess::remove_absolute(path);
+}
+
+TEST_CASE("[ShaderRD] Invalid cache files are rejected") {
+	const String path = OS::get_singleton()->get_cache_path().path_join("test_shader_rd_invalid.cache");
+
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer((const uint8_t *)"NOPE", 4);
+		f->store_32(4);
+		f->store_32(16);
+	}
+	Vector<uint8_t> loaded;
+	ERR_PRINT_OFF;
+	CHECK_FALSE(ShaderRD::load_from_cache_file(path, loaded));
+	ERR_PRINT_ON;
+
+	// Truncated data.
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_buffer((const uint8_t *)"GDSC", 4);
+		f->store_32(4);
+		f->store_32(16);
+		f->store_32(0);
+	}
+	ERR_PRINT_OFF;
+	CHECK_FALSE(ShaderRD::load_from_cache_file(path, loaded));
+	ERR_PRINT_ON;
+
+	ERR_PRINT_OFF;
+	CHECK(ShaderRD::save_to_cache_file(path, Vector<uint8_t>()) == ERR_INVALID_PARAMETER);
+	ERR_PRINT_ON;
+
+	DirAccess::remove_absolute(path);
+}
+
+} // namespace TestShaderRD
+
+#endif // TEST_SHADER_RD_H
@@ -31,6 +31,7 @@
 #ifndef TEST_NAVIGATION_SERVER_3D_H
 #define TEST_NAVIGATION_SERVER_3D_H
 
+#include "core/config/project_settings.h"
 #include "scene/3d/mesh_instance_3d.h"
 #include "scene/resources/3d/primitive_meshes.h"
 #include "servers/navigation_server_3d.h"
@@ -42,11 +43,16 @@ class CallableMock : public Object {
 	GDCLASS(CallableMock, Object);
 
 public:
+	void function0() {
+		function0_calls++;
+	}
+
 	void function1(Variant arg0) {
 		function1_calls++;
 		function1_latest_arg0 = arg0;
 	}
 
+	unsigned function0_calls{ 0 };
 	unsigned function1_calls{ 0 };
 	Variant function1_latest_arg0{};
 };
@@ -672,6 +678,57 @@ TEST_SUITE("[Navigation]") {
 		memdelete(node_3d);
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should bake tiled navigation meshes") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		navigation_mesh->set_tile_size(2.5);
+		Ref<NavigationMeshSourceGeometryData3D> source_geometry = memnew(NavigationMeshSourceGeometryData3D);
+
+		Array arr;
+		arr.resize(RS::ARRAY_MAX);
+		BoxMesh::create_mesh_array(arr, Vector3(10.0, 0.001, 10.0));
+		source_geometry->add_mesh_array(arr, Transform3D());
+		navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+		CHECK_NE(navigation_mesh->get_polygon_count(), 0);
+		CHECK_NE(navigation_mesh->get_vertices().size(), 0);
+
+		SUBCASE("Tiled bake should cover the same area as a single bake") {
+			Ref<NavigationMesh> single_navigation_mesh = memnew(NavigationMesh);
+			navigation_server->bake_from_source_geometry_data(single_navigation_mesh, source_geometry, Callable());
+			AABB tiled_aabb;
+			AABB single_aabb;
+			for (const Vector3 &vertex : navigation_mesh->get_vertices()) {
+				tiled_aabb.expand_to(vertex);
+			}
+			for (const Vector3 &vertex : single_navigation_mesh->get_vertices()) {
+				single_aabb.expand_to(vertex);
+			}
+			const real_t tolerance = navigation_mesh->get_cell_size();
+			CHECK(Math::is_equal_approx(tiled_aabb.position.x, single_aabb.position.x, tolerance));
+			CHECK(Math::is_equal_approx(tiled_aabb.position.z, single_aabb.position.z, tolerance));
+			CHECK(Math::is_equal_approx(tiled_aabb.size.x, single_aabb.size.x, tolerance));
+			CHECK(Math::is_equal_approx(tiled_aabb.size.z, single_aabb.size.z, tolerance));
+		}
+
+		SUBCASE("Rebaking unchanged geometry should give the same result") {
+			const Vector<Vector3> vertices = navigation_mesh->get_vertices();
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_EQ(navigation_mesh->get_vertices(), vertices);
+			CHECK_EQ(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+
+		SUBCASE("Rebaking should take changed geometry into account") {
+			const int polygon_count = navigation_mesh->get_polygon_count();
+			Array obstacle_arr;
+			obstacle_arr.resize(RS::ARRAY_MAX);
+			BoxMesh::create_mesh_array(obstacle_arr, Vector3(2.0, 2.0, 2.0));
+			source_geometry->add_mesh_array(obstacle_arr, Transform3D(Basis(), Vector3(2.0, 1.0, 2.0)));
+			navigation_server->bake_from_source_geometry_data(navigation_mesh, source_geometry, Callable());
+			CHECK_NE(navigation_mesh->get_polygon_count(), polygon_count);
+		}
+	}
+
 	// This test case does not check precise values on purpose - to not be too sensitivte.
 	TEST_CASE("[NavigationServer3D] Server should respond to queries against valid map properly") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
@@ -745,6 +802,49 @@ TEST_SUITE("[Navigation]") {
 			CHECK_EQ(query_result->get_path_owner_ids().size(), 0);
 		}
 
+		SUBCASE("Batched asynchronous queries should yield results on the next process") {
+			TypedArray<NavigationPathQueryParameters3D> queries_parameters;
+			TypedArray<NavigationPathQueryResult3D> queries_results;
+			for (int i = 0; i < 16; i++) {
+				Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+				query_parameters->set_map(map);
+				query_parameters->set_start_position(Vector3(0, 0, 0));
+				query_parameters->set_target_position(Vector3(10, 0, i % 2 == 0 ? 10 : -10));
+				queries_parameters.push_back(query_parameters);
+				queries_results.push_back(memnew(NavigationPathQueryResult3D));
+			}
+			CallableMock callback_mock;
+			navigation_server->query_paths_async(queries_parameters, queries_results, callable_mp(&callback_mock, &CallableMock::function0));
+			CHECK_EQ(callback_mock.function0_calls, 0);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			CHECK_EQ(callback_mock.function0_calls, 1);
+			for (int i = 0; i < queries_results.size(); i++) {
+				const Ref<NavigationPathQueryParameters3D> query_parameters = queries_parameters[i];
+				const Ref<NavigationPathQueryResult3D> query_result = queries_results[i];
+				Ref<NavigationPathQueryResult3D> expected_result = memnew(NavigationPathQueryResult3D);
+				navigation_server->query_path(query_parameters, expected_result);
+				CHECK_NE(query_result->get_path().size(), 0);
+				CHECK_EQ(query_result->get_path(), expected_result->get_path());
+			}
+		}
+
+		SUBCASE("Batched asynchronous queries should be finished before forcing a map update") {
+			TypedArray<NavigationPathQueryParameters3D> queries_parameters;
+			TypedArray<NavigationPathQueryResult3D> queries_results;
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(0, 0, 0));
+			query_parameters->set_target_position(Vector3(10, 0, 10));
+			queries_parameters.push_back(query_parameters);
+			queries_results.push_back(memnew(NavigationPathQueryResult3D));
+			CallableMock callback_mock;
+			navigation_server->query_paths_async(queries_parameters, queries_results, callable_mp(&callback_mock, &CallableMock::function0));
+			navigation_server->map_force_update(map);
+			CHECK_EQ(callback_mock.function0_calls, 1);
+			const Ref<NavigationPathQueryResult3D> query_result = queries_results[0];
+			CHECK_NE(query_result->get_path().size(), 0);
+		}
+
 		SUBCASE("Elaborate query without metadata flags should yield path only") {
 			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
 			query_parameters->set_map(map);
@@ -764,6 +864,74 @@ TEST_SUITE("[Navigation]") {
 		navigation_server->process(0.0); // Give server some cycles to commit.
 	}
 
+	TEST_CASE("[NavigationServer3D] Server should find paths across regions with hierarchical pathfinding") {
+		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
+		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);
+		Vector<Vector3> vertices;
+		vertices.push_back(Vector3(0, 0, 0));
+		vertices.push_back(Vector3(10, 0, 0));
+		vertices.push_back(Vector3(10, 0, 10));
+		vertices.push_back(Vector3(0, 0, 10));
+		navigation_mesh->set_vertices(vertices);
+		Vector<int> polygon;
+		polygon.push_back(0);
+		polygon.push_back(1);
+		polygon.push_back(2);
+		polygon.push_back(3);
+		navigation_mesh->add_polygon(polygon);
+
+		// The setting is read when the map is created.
+		const Variant use_hierarchical_pathfinding = GLOBAL_GET("navigation/pathfinding/use_hierarchical_pathfinding");
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", true);
+		RID map = navigation_server->map_create();
+		ProjectSettings::get_singleton()->set_setting("navigation/pathfinding/use_hierarchical_pathfinding", use_hierarchical_pathfinding);
+		navigation_server->map_set_active(map, true);
+
+		// A row of four regions sharing their edges.
+		LocalVector<RID> regions;
+		for (int i = 0; i < 4; i++) {
+			RID region = navigation_server->region_create();
+			navigation_server->region_set_map(region, map);
+			navigation_server->region_set_transform(region, Transform3D(Basis(), Vector3(i * 10, 0, 0)));
+			navigation_server->region_set_navigation_mesh(region, navigation_mesh);
+			regions.push_back(region);
+		}
+		navigation_server->process(0.0); // Give server some cycles to commit.
+
+		SUBCASE("Path should cross all regions of the row") {
+			Ref<NavigationPathQueryParameters3D> query_parameters = memnew(NavigationPathQueryParameters3D);
+			query_parameters->set_map(map);
+			query_parameters->set_start_position(Vector3(1, 0, 5));
+			query_parameters->set_target_position(Vector3(39, 0, 5));
+			query_parameters->set_path_postprocessing(NavigationPathQueryParameters3D::PATH_POSTPROCESSING_EDGECENTERED);
+			Ref<NavigationPathQueryResult3D> query_result = memnew(NavigationPathQueryResult3D);
+			navigation_server->query_path(query_parameters, query_result);
+			const Vector<Vector3> path = query_result->get_path();
+			REQUIRE_GE(path.size(), 2);
+			CHECK(path[0].is_equal_approx(Vector3(1, 0, 5)));
+			CHECK(path[path.size() - 1].is_equal_approx(Vector3(39, 0, 5)));
+			const TypedArray<RID> path_rids = query_result->get_path_rids();
+			for (const RID &region : regions) {
+				CHECK(path_rids.has(region));
+			}
+		}
+
+		SUBCASE("Path should update when a region of the row is disabled") {
+			navigation_server->region_set_enabled(regions[2], false);
+			navigation_server->process(0.0); // Give server some cycles to commit.
+			const Vector<Vector3> path = navigation_server->map_get_path(map, Vector3(1, 0, 5), Vector3(39, 0, 5), true);
+			REQUIRE_GE(path.size(), 2);
+			// The end of the row is not reachable anymore, so the path ends at the gap.
+			CHECK_LE(path[path.size() - 1].x, 20.0 + CMP_EPSILON);
+		}
+
+		for (const RID &region : regions) {
+			navigation_server->free(region);
+		}
+		navigation_server->free(map);
+		navigation_server->process(0.0); // Give server some cycles to commit.
+	}
+
 	TEST_CASE("[NavigationServer3D] Server should be able to bake asynchronously") {
 		NavigationServer3D *navigation_server = NavigationServer3D::get_singleton();
 		Ref<NavigationMesh> navigation_mesh = memnew(NavigationMesh);